@@ -1817,6 +1817,14 @@
  *   checks which one of them is in use and does not allow access to
  *   the other one, until Triangulation::clear_user_data() has been called.
  *
+ *   @note If a triangulation uses lean storage (see
+ *   Triangulation::set_lean_storage()), the user data is only allocated when
+ *   it is set for the first time, and Triangulation::clear_user_data()
+ *   releases it again. The first call to TriaAccessor::set_user_index() or
+ *   TriaAccessor::set_user_pointer() on the lines, quads or hexes of such a
+ *   triangulation therefore must not run concurrently with any other access
+ *   to their user data.
+ *
  *   @note The usual warning about the missing type safety of @p void pointers are
  *   obviously in place here; responsibility for correctness of types etc
  *   lies entirely with the user of the pointer.
@@ -34,6 +34,8 @@ DEAL_II_NAMESPACE_OPEN
 
 template <typename number>
 class Vector;
+template <typename Number>
+class VectorizedArray;
 template <int rank, int dim, typename Number>
 class TensorFunction;
 
@@ -208,6 +210,54 @@ public:
   virtual RangeNumberType
   value(const Point<dim> &p, const unsigned int component = 0) const;
 
+  /**
+   * Return the value of the function at all the points stored in the lanes
+   * of the vectorized point @p p, such as the points returned by
+   * FEEvaluation::quadrature_point(). This allows matrix-free codes to
+   * evaluate coefficients or boundary data at a batch of quadrature points
+   * with a single virtual function call, without unpacking the lanes:
+   * @code
+   *   const Function<dim> &coefficient = ...;
+   *   for (unsigned int q = 0; q < phi.n_q_points; ++q)
+   *     phi.submit_gradient(coefficient.value(phi.quadrature_point(q)) *
+   *                           phi.get_gradient(q),
+   *                         q);
+   * @endcode
+   * The template argument @p Number can be @p double or @p float. The
+   * function forwards to vectorized_value(), which is the function derived
+   * classes need to reimplement.
+   *
+   * @note Since the declaration of value() in a derived class hides this
+   * function, it can only be called through a reference to the base class
+   * unless the derived class makes it visible by a using declaration, as the
+   * classes in namespace Functions do.
+   */
+  template <typename Number>
+  VectorizedArray<Number>
+  value(const Point<dim, VectorizedArray<Number>> &p,
+        const unsigned int                         component = 0) const;
+
+  /**
+   * Return the value of the given component of the function at all the
+   * points stored in the lanes of @p p.
+   *
+   * The default implementation calls value() for each lane separately. Derived
+   * classes whose value can be computed with arithmetic operations on
+   * VectorizedArray should reimplement this function, together with the
+   * single precision variant below, to evaluate all lanes at once. This
+   * function is only available for real-valued functions.
+   */
+  virtual VectorizedArray<double>
+  vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                   const unsigned int component = 0) const;
+
+  /**
+   * Same as above, for points and values in single precision.
+   */
+  virtual VectorizedArray<float>
+  vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                   const unsigned int component = 0) const;
+
   /**
    * Return all components of a vector-valued function at a given point.
    *
@@ -424,9 +474,19 @@ namespace Functions
     ConstantFunction(const RangeNumberType *begin_ptr,
                      const unsigned int     n_components);
 
+    using Function<dim, RangeNumberType>::value;
+
     virtual RangeNumberType
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     virtual void
     vector_value(const Point<dim> &       p,
                  Vector<RangeNumberType> &return_value) const override;
@@ -935,6 +995,18 @@ private:
 // in the declaration.
 template <int dim, typename RangeNumberType>
 inline Function<dim, RangeNumberType>::~Function() = default;
+
+
+
+template <int dim, typename RangeNumberType>
+template <typename Number>
+inline VectorizedArray<Number>
+Function<dim, RangeNumberType>::value(
+  const Point<dim, VectorizedArray<Number>> &p,
+  const unsigned int                         component) const
+{
+  return this->vectorized_value(p, component);
+}
 #endif
 
 
@@ -20,6 +20,7 @@
 #include <deal.II/base/function.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor_function.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/vector.h>
 
@@ -28,6 +29,60 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace FunctionImplementation
+  {
+    /**
+     * Convert the value of a function to the number type of a lane of a
+     * VectorizedArray.
+     */
+    template <typename Number, typename RangeNumberType>
+    inline Number
+    to_lane_value(const RangeNumberType &value)
+    {
+      return value;
+    }
+
+
+
+    template <typename Number, typename T>
+    inline Number
+    to_lane_value(const std::complex<T> &)
+    {
+      Assert(false,
+             ExcMessage("The evaluation of functions at vectorized points "
+                        "is only available for real-valued functions."));
+      return Number();
+    }
+
+
+
+    /**
+     * Evaluate the function @p f at each lane of the vectorized point @p p.
+     */
+    template <int dim, typename RangeNumberType, typename Number>
+    VectorizedArray<Number>
+    value_per_lane(const Function<dim, RangeNumberType> &     f,
+                   const Point<dim, VectorizedArray<Number>> &p,
+                   const unsigned int                         component)
+    {
+      VectorizedArray<Number> result;
+      Point<dim>              point;
+      for (unsigned int v = 0; v < VectorizedArray<Number>::n_array_elements;
+           ++v)
+        {
+          for (unsigned int d = 0; d < dim; ++d)
+            point[d] = p[d][v];
+          result[v] = to_lane_value<Number>(f.value(point, component));
+        }
+      return result;
+    }
+  } // namespace FunctionImplementation
+} // namespace internal
+
+
+
 template <int dim, typename RangeNumberType>
 const unsigned int Function<dim, RangeNumberType>::dimension;
 
@@ -66,6 +121,26 @@ Function<dim, RangeNumberType>::value(const Point<dim> &,
 }
 
 
+template <int dim, typename RangeNumberType>
+VectorizedArray<double>
+Function<dim, RangeNumberType>::vectorized_value(
+  const Point<dim, VectorizedArray<double>> &p,
+  const unsigned int                         component) const
+{
+  return internal::FunctionImplementation::value_per_lane(*this, p, component);
+}
+
+
+template <int dim, typename RangeNumberType>
+VectorizedArray<float>
+Function<dim, RangeNumberType>::vectorized_value(
+  const Point<dim, VectorizedArray<float>> &p,
+  const unsigned int                        component) const
+{
+  return internal::FunctionImplementation::value_per_lane(*this, p, component);
+}
+
+
 template <int dim, typename RangeNumberType>
 void
 Function<dim, RangeNumberType>::vector_value(const Point<dim> &       p,
@@ -385,6 +460,36 @@ namespace Functions
 
 
 
+  template <int dim, typename RangeNumberType>
+  VectorizedArray<double>
+  ConstantFunction<dim, RangeNumberType>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &,
+    const unsigned int component) const
+  {
+    Assert(component < this->n_components,
+           ExcIndexRange(component, 0, this->n_components));
+    return make_vectorized_array(
+      internal::FunctionImplementation::to_lane_value<double>(
+        function_value_vector[component]));
+  }
+
+
+
+  template <int dim, typename RangeNumberType>
+  VectorizedArray<float>
+  ConstantFunction<dim, RangeNumberType>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &,
+    const unsigned int component) const
+  {
+    Assert(component < this->n_components,
+           ExcIndexRange(component, 0, this->n_components));
+    return make_vectorized_array(
+      internal::FunctionImplementation::to_lane_value<float>(
+        function_value_vector[component]));
+  }
+
+
+
   template <int dim, typename RangeNumberType>
   void
   ConstantFunction<dim, RangeNumberType>::vector_value(
@@ -53,6 +53,13 @@ namespace Functions
   public:
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
+    using Function<dim>::value;
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
     virtual void
     vector_value(const Point<dim> &p, Vector<double> &values) const override;
     virtual void
@@ -94,6 +101,16 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     virtual void
     value_list(const std::vector<Point<dim>> &points,
                std::vector<double> &          values,
@@ -166,6 +183,19 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    /**
+     * The values at the points stored in the lanes of a vectorized point.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Values at multiple points.
      */
@@ -231,6 +261,16 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     virtual void
     value_list(const std::vector<Point<dim>> &points,
                std::vector<double> &          values,
@@ -344,6 +384,19 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    /**
+     * The values at the points stored in the lanes of a vectorized point.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Values at multiple points.
      */
@@ -721,6 +774,20 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    /**
+     * Return the value of the function at the points stored in the lanes of
+     * a vectorized point.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Return the gradient of the specified component of the function at the
      * given point.
@@ -776,6 +843,20 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    using Function<dim>::value;
+
+    /**
+     * Return the value of the function at the points stored in the lanes of
+     * a vectorized point.
+     */
+    virtual VectorizedArray<double>
+    vectorized_value(const Point<dim, VectorizedArray<double>> &p,
+                     const unsigned int component = 0) const override;
+
+    virtual VectorizedArray<float>
+    vectorized_value(const Point<dim, VectorizedArray<float>> &p,
+                     const unsigned int component = 0) const override;
+
     /**
      * Return the gradient of the specified component of the function at the
      * given point.
@@ -0,0 +1,400 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_fully_distributed_tria_h
+#define dealii_distributed_fully_distributed_tria_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef DEAL_II_WITH_MPI
+#  include <mpi.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  /**
+   * A namespace for a triangulation class that is distributed among
+   * processors without storing the complete coarse mesh on each of them,
+   * together with the data structures and functions needed to describe and
+   * set up such a triangulation.
+   */
+  namespace fullydistributed
+  {
+    /**
+     * The information stored about one cell of the description of the part
+     * of a mesh that a processor needs, see ConstructionData.
+     */
+    template <int dim>
+    struct CellData
+    {
+      /**
+       * The binary representation of the CellId of the cell.
+       */
+      CellId::binary_type id;
+
+      /**
+       * The subdomain id of the cell. Only used for active cells.
+       */
+      types::subdomain_id subdomain_id = numbers::artificial_subdomain_id;
+
+      /**
+       * The manifold id of the cell.
+       */
+      types::manifold_id manifold_id = numbers::flat_manifold_id;
+
+      /**
+       * The manifold ids of the lines of the cell. Only used for dim>1.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::lines_per_cell>
+        manifold_line_ids;
+
+      /**
+       * The manifold ids of the quads of the cell. Only used for dim==3.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::quads_per_cell>
+        manifold_quad_ids;
+
+      /**
+       * The numbers of the faces of the cell that are at the boundary,
+       * together with their boundary ids.
+       */
+      std::vector<std::pair<unsigned int, types::boundary_id>> boundary_ids;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * The description of the part of a mesh that one processor needs to set
+     * up a parallel::fullydistributed::Triangulation: the coarse cells
+     * containing its locally owned and ghost cells, and the information about
+     * these cells and all of their ancestors on the refined levels.
+     *
+     * Such a description is usually created by
+     * create_construction_data_from_triangulation(), possibly in a separate
+     * program that partitions a large mesh once and stores the description
+     * of each partition with save_construction_data(), and then loaded by
+     * each processor with load_construction_data().
+     */
+    template <int dim, int spacedim = dim>
+    struct ConstructionData
+    {
+      /**
+       * The coarse cells needed by the processor. The vertex numbers refer to
+       * the vector coarse_cell_vertices.
+       */
+      std::vector<dealii::CellData<dim>> coarse_cells;
+
+      /**
+       * The vertices of the coarse cells.
+       */
+      std::vector<Point<spacedim>> coarse_cell_vertices;
+
+      /**
+       * The global id of each of the coarse cells, i.e., the id of the coarse
+       * cell in the CellId objects of the complete mesh.
+       */
+      std::vector<unsigned int> coarse_cell_index_to_coarse_cell_id;
+
+      /**
+       * For each level, the information about the cells on that level that
+       * are needed by the processor. These are its locally owned and ghost
+       * cells, and all their ancestors.
+       */
+      std::vector<std::vector<CellData<dim>>> cell_infos;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * Create the description of the part of the mesh @p tria needed by the
+     * processor that owns the cells with subdomain id @p my_subdomain.
+     *
+     * The partitioning is taken from the subdomain ids of the active cells of
+     * @p tria, as, for example, set by GridTools::partition_triangulation().
+     * If @p tria is a parallel::shared::Triangulation, its partitioning is
+     * used instead, even if it uses artificial cells. The ghost cells of a
+     * processor are the active cells that share a vertex with one of its
+     * locally owned cells.
+     *
+     * Since @p tria is only read, the descriptions for all processors can be
+     * created from one mesh in a serial program, and stored in files with
+     * save_construction_data().
+     *
+     * @note Ghost cells across periodic boundaries are not supported.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const types::subdomain_id                   my_subdomain);
+
+    /**
+     * Write @p construction_data to the file @p filename in a binary format.
+     */
+    template <int dim, int spacedim>
+    void
+    save_construction_data(
+      const ConstructionData<dim, spacedim> &construction_data,
+      const std::string &                    filename);
+
+    /**
+     * Read @p construction_data from the file @p filename, as written by
+     * save_construction_data().
+     */
+    template <int dim, int spacedim>
+    void
+    load_construction_data(const std::string &              filename,
+                           ConstructionData<dim, spacedim> &construction_data);
+
+
+
+#ifdef DEAL_II_WITH_MPI
+    /**
+     * A distributed triangulation for which each processor only stores its
+     * locally owned cells, a layer of ghost cells around them, and the coarse
+     * cells and refined cells these descend from. In contrast to
+     * parallel::distributed::Triangulation, no processor needs to store the
+     * complete coarse mesh, which makes this class suitable for very large
+     * unstructured coarse meshes, e.g., from external mesh generators.
+     *
+     * The triangulation is set up by create_triangulation() from a
+     * ConstructionData object describing the cells needed on the current
+     * processor. The partitioning is fixed by this description: the
+     * triangulation can not be refined or coarsened adaptively. Cells not
+     * contained in the description are artificial.
+     *
+     * CellId objects of this class use the global ids of the coarse cells as
+     * given in the description, so they identify the same cell on all
+     * processors. This allows to use the triangulation with DoFHandler,
+     * and everything built on top of it like MatrixFree and DataOut.
+     *
+     * Faces between the coarse cells present on a processor and coarse cells
+     * that are not are at the boundary of the local part of the mesh, and
+     * hence have a boundary id. These faces never touch a locally owned cell.
+     *
+     * @note Multigrid hierarchies are not supported.
+     *
+     * @ingroup distributed
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      using active_cell_iterator =
+        typename dealii::Triangulation<dim, spacedim>::active_cell_iterator;
+      using cell_iterator =
+        typename dealii::Triangulation<dim, spacedim>::cell_iterator;
+
+      /**
+       * Constructor.
+       *
+       * @param mpi_communicator The MPI communicator to be used for the
+       * triangulation.
+       */
+      explicit Triangulation(MPI_Comm mpi_communicator);
+
+      /**
+       * Destructor.
+       */
+      virtual ~Triangulation() override = default;
+
+      /**
+       * Create the triangulation from the description @p construction_data
+       * of the cells needed on the current processor. Manifolds must be
+       * attached before calling this function, since they are used when
+       * refining the coarse cells.
+       */
+      void
+      create_triangulation(
+        const ConstructionData<dim, spacedim> &construction_data);
+
+      /**
+       * This function is not supported by this class, use the other
+       * create_triangulation() function instead.
+       */
+      virtual void
+      create_triangulation(const std::vector<Point<spacedim>> &vertices,
+                           const std::vector<dealii::CellData<dim>> &cells,
+                           const SubCellData &subcelldata) override;
+
+      /**
+       * This function is not supported by this class, create the
+       * triangulation from a ConstructionData object instead.
+       */
+      virtual void
+      copy_triangulation(
+        const dealii::Triangulation<dim, spacedim> &other_tria) override;
+
+      /**
+       * This function is not supported by this class, since the partitioning
+       * is fixed by the description the triangulation was created from.
+       */
+      virtual void
+      execute_coarsening_and_refinement() override;
+
+      /**
+       * Return true if the triangulation has hanging nodes on any of the
+       * processors.
+       */
+      virtual bool
+      has_hanging_nodes() const override;
+
+      /**
+       * Return the index of the local coarse cell with the global id
+       * @p coarse_cell_id, or numbers::invalid_unsigned_int if the coarse
+       * cell is not present on the current processor.
+       */
+      virtual unsigned int
+      coarse_cell_id_to_coarse_cell_index(
+        const unsigned int coarse_cell_id) const override;
+
+      /**
+       * Return the global id of the local coarse cell with index
+       * @p coarse_cell_index.
+       */
+      virtual unsigned int
+      coarse_cell_index_to_coarse_cell_id(
+        const unsigned int coarse_cell_index) const override;
+
+      /**
+       * Return the memory consumption of this object in bytes.
+       */
+      virtual std::size_t
+      memory_consumption() const override;
+
+    private:
+      /**
+       * The global id of each local coarse cell.
+       */
+      std::vector<unsigned int> coarse_cell_index_to_coarse_cell_id_vector;
+
+      /**
+       * Pairs of global id and index of the local coarse cells, sorted by
+       * the id.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>>
+        coarse_cell_id_to_coarse_cell_index_vector;
+    };
+
+#else
+
+    /**
+     * Dummy class the compiler chooses for parallel fully distributed
+     * triangulations if we didn't actually configure deal.II with the MPI
+     * library. The existence of this class allows us to refer to
+     * parallel::fullydistributed::Triangulation objects throughout the
+     * library even if it is disabled.
+     *
+     * Since the constructor of this class is deleted, no such objects
+     * can actually be created as this would be pointless given that
+     * MPI is not available.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor. Deleted to make sure that objects of this type cannot be
+       * constructed (see also the class documentation).
+       */
+      Triangulation() = delete;
+    };
+
+#endif
+
+
+
+    template <int dim>
+    template <class Archive>
+    void
+    CellData<dim>::serialize(Archive &ar, const unsigned int /*version*/)
+    {
+      for (auto &i : id)
+        ar &i;
+      ar &subdomain_id;
+      ar &manifold_id;
+      for (auto &i : manifold_line_ids)
+        ar &i;
+      for (auto &i : manifold_quad_ids)
+        ar &i;
+      ar &boundary_ids;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <class Archive>
+    void
+    ConstructionData<dim, spacedim>::serialize(
+      Archive &ar,
+      const unsigned int /*version*/)
+    {
+      // dealii::CellData does not have a serialize() function, so write its
+      // members one by one
+      std::size_t n_coarse_cells = coarse_cells.size();
+      ar &        n_coarse_cells;
+      coarse_cells.resize(n_coarse_cells);
+      for (auto &cell : coarse_cells)
+        {
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            ar &cell.vertices[v];
+          ar &cell.material_id;
+          ar &cell.manifold_id;
+        }
+
+      ar &coarse_cell_vertices;
+      ar &coarse_cell_index_to_coarse_cell_id;
+      ar &cell_infos;
+    }
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,305 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_measured_cell_costs_h
+#define dealii_distributed_measured_cell_costs_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <chrono>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+#ifdef DEAL_II_WITH_P4EST
+
+namespace parallel
+{
+  namespace distributed
+  {
+    /**
+     * A class that collects the computational cost actually measured on each
+     * locally owned active cell of a parallel::distributed::Triangulation,
+     * and uses these measurements to repartition the triangulation once the
+     * work is distributed unevenly between the processors.
+     *
+     * The cost of cells often depends on things that are hard to predict when
+     * choosing weights for the Triangulation::Signals::cell_weight signal by
+     * hand, for example on the number of particles in a cell, the polynomial
+     * degree of an hp finite element, or the number of iterations of a local
+     * nonlinear solver. This class instead lets the application record the
+     * cost of each cell, typically the time spent working on it, and derives
+     * the weights from these records:
+     * @code
+     *   parallel::distributed::MeasuredCellCosts<dim> costs(triangulation);
+     *
+     *   for (unsigned int step = 0; step < n_steps; ++step)
+     *     {
+     *       for (const auto &cell : dof_handler.active_cell_iterators())
+     *         if (cell->is_locally_owned())
+     *           {
+     *             typename parallel::distributed::MeasuredCellCosts<
+     *               dim>::Scope timer(costs, cell);
+     *             ... // work on the cell
+     *           }
+     *
+     *       // repartition if the most loaded processor has at least 20
+     *       // percent more work than the average
+     *       if (costs.repartition_if_imbalanced(1.2).repartitioned)
+     *         ... // redistribute the DoFHandler and vectors
+     *     }
+     * @endcode
+     * Code that works on batches of cells, like MatrixFree, can divide the
+     * time measured for a batch between the cells in it, using
+     * MatrixFree::get_cell_iterator() to obtain the cells.
+     *
+     * The costs are stored by the active cell index of the cells, so they
+     * are discarded whenever the triangulation changes. The storage for the
+     * costs is sized when the object is created and whenever the
+     * triangulation changes, never while costs are recorded. Recording costs
+     * on different cells from different threads at the same time is
+     * therefore safe, recording costs on the same cell is not.
+     *
+     * @note The weights handed to the triangulation are added to the base
+     * weight of 1000 that every cell has, see
+     * Triangulation::Signals::cell_weight. This class therefore scales the
+     * costs so that the cheapest measured cell has the base weight alone.
+     * Cells for which no cost has been recorded are treated as the cheapest
+     * cells.
+     *
+     * This class is only implemented for <tt>dim&gt;1</tt>, and only
+     * available if deal.II was configured with p4est.
+     */
+    template <int dim, int spacedim = dim>
+    class MeasuredCellCosts : public Subscriptor
+    {
+    public:
+      using active_cell_iterator =
+        typename dealii::Triangulation<dim, spacedim>::active_cell_iterator;
+
+      /**
+       * The distribution of the measured costs between the processors.
+       */
+      struct Imbalance
+      {
+        /**
+         * The smallest, largest, and average sum of the costs of the locally
+         * owned cells over all processors.
+         */
+        double min_cost;
+        double max_cost;
+        double average_cost;
+
+        /**
+         * Return the ratio of the largest to the average cost, which is one
+         * for a perfectly balanced computation, or one if nothing has been
+         * measured yet.
+         */
+        double
+        ratio() const;
+      };
+
+      /**
+       * The result of a call to repartition_if_imbalanced().
+       */
+      struct Report
+      {
+        /**
+         * The imbalance of the measured costs before repartitioning.
+         */
+        Imbalance before;
+
+        /**
+         * The ratio of the largest to the average cost the processors would
+         * have if the measured costs stayed the same after repartitioning.
+         * This estimate assumes that the triangulation divides its cells as
+         * evenly by weight as possible, which p4est does up to the
+         * granularity of single cells. If the triangulation was not
+         * repartitioned, this is the ratio of the imbalance before.
+         */
+        double estimated_ratio_after;
+
+        /**
+         * Whether the triangulation was repartitioned.
+         */
+        bool repartitioned;
+      };
+
+      /**
+       * Constructor. The weight of the most expensive cells is limited to
+       * @p max_relative_weight times the weight of the cheapest cells, which
+       * avoids huge weights for cells on which hardly any time was
+       * measured.
+       */
+      MeasuredCellCosts(Triangulation<dim, spacedim> &triangulation,
+                        const double max_relative_weight = 100.);
+
+      /**
+       * Destructor.
+       */
+      ~MeasuredCellCosts() override;
+
+      /**
+       * Add @p cost, for example a time in seconds, to the cost recorded for
+       * the locally owned active @p cell.
+       */
+      void
+      add_cost(const active_cell_iterator &cell, const double cost);
+
+      /**
+       * Return the cost recorded for the active @p cell so far.
+       */
+      double
+      get_cost(const active_cell_iterator &cell) const;
+
+      /**
+       * Discard all costs recorded so far, and size the storage for the
+       * costs for the current active cells of the triangulation.
+       */
+      void
+      clear();
+
+      /**
+       * Compute the distribution of the costs recorded so far between the
+       * processors.
+       *
+       * This is a collective operation that needs to be called on all
+       * processors.
+       */
+      Imbalance
+      compute_imbalance() const;
+
+      /**
+       * Repartition the triangulation, with weights derived from the costs
+       * recorded so far, if the ratio of the largest to the average cost of
+       * the processors exceeds @p threshold. The recorded costs are
+       * discarded afterwards in either case, so that the next call is based
+       * on new measurements. The report returned is also stored, see
+       * get_reports().
+       *
+       * If the triangulation was repartitioned, the data attached to it, like
+       * the degrees of freedom of a DoFHandler, need to be redistributed as
+       * after a call to parallel::distributed::Triangulation::repartition().
+       *
+       * This is a collective operation that needs to be called on all
+       * processors.
+       */
+      Report
+      repartition_if_imbalanced(const double threshold);
+
+      /**
+       * Return the reports of all calls to repartition_if_imbalanced() so
+       * far.
+       */
+      const std::vector<Report> &
+      get_reports() const;
+
+      /**
+       * A class that measures the wall time between its construction and its
+       * destruction and adds it to the cost of a cell.
+       */
+      class Scope
+      {
+      public:
+        /**
+         * Constructor. Start measuring the time for @p cell.
+         */
+        Scope(MeasuredCellCosts &costs, const active_cell_iterator &cell);
+
+        /**
+         * Destructor. Add the time passed since the construction to the cost
+         * of the cell.
+         */
+        ~Scope();
+
+      private:
+        MeasuredCellCosts &                         costs;
+        const active_cell_iterator                  cell;
+        const std::chrono::steady_clock::time_point start;
+      };
+
+    private:
+      /**
+       * The triangulation whose cells are measured.
+       */
+      SmartPointer<Triangulation<dim, spacedim>,
+                   MeasuredCellCosts<dim, spacedim>>
+        triangulation;
+
+      /**
+       * The largest weight relative to the weight of the cheapest cells.
+       */
+      const double max_relative_weight;
+
+      /**
+       * The costs recorded for each active cell, by active cell index. The
+       * vector always has one entry per active cell of the triangulation: it
+       * is sized in the constructor and in clear(), which is called whenever
+       * the triangulation changes, e.g., after refinement.
+       */
+      std::vector<double> costs;
+
+      /**
+       * The cost that corresponds to the base weight of a cell while the
+       * triangulation is repartitioned.
+       */
+      double reference_cost;
+
+      /**
+       * The reports of all calls to repartition_if_imbalanced().
+       */
+      std::vector<Report> reports;
+
+      /**
+       * The connection to the Triangulation::Signals::any_change signal,
+       * which is also triggered by the post_refinement signal. It discards
+       * the recorded costs and sizes the storage for the new cells.
+       */
+      boost::signals2::connection tria_listener;
+
+      /**
+       * Return the additional weight of a cell derived from the recorded
+       * costs, see Triangulation::Signals::cell_weight.
+       */
+      unsigned int
+      get_weight(const typename dealii::Triangulation<dim, spacedim>::
+                   cell_iterator &cell,
+                 const typename dealii::Triangulation<dim, spacedim>::
+                   CellStatus status) const;
+
+      /**
+       * Estimate the ratio of the largest to the average cost of the
+       * processors after repartitioning with the weights returned by
+       * get_weight().
+       */
+      double
+      estimate_ratio_after_repartitioning() const;
+    };
+  } // namespace distributed
+} // namespace parallel
+
+#endif // DEAL_II_WITH_P4EST
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
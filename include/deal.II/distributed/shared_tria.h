@@ -113,8 +113,9 @@ namespace parallel
        *
        * The constructor requires that exactly one of
        * <code>partition_auto</code>, <code>partition_metis</code>,
-       * <code>partition_zorder</code>, <code>partition_zoltan</code> and
-       * <code>partition_custom_signal</code> is set. If
+       * <code>partition_zorder</code>, <code>partition_zoltan</code>,
+       * <code>partition_custom_signal</code>, and
+       * <code>partition_hilbert</code> is set. If
        * <code>partition_auto</code> is chosen, it will use
        * <code>partition_zoltan</code> (if available), then
        * <code>partition_metis</code> (if available) and finally
@@ -213,6 +214,16 @@ namespace parallel
          */
         partition_custom_signal = 0x4,
 
+        /**
+         * Partition active cells along a Hilbert space-filling curve
+         * through their centers, see
+         * GridTools::partition_triangulation_hilbert(). This does not
+         * require any external library, and takes into account the weights
+         * of the cells given by the Triangulation::Signals::cell_weight
+         * signal.
+         */
+        partition_hilbert = 0x5,
+
         /**
          * This flag needs to be set to use the geometric multigrid
          * functionality. This option requires additional computation and
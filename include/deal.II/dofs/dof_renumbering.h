@@ -30,6 +30,10 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+template <int dim, typename Number>
+class MatrixFree;
+
 /**
  * Implementation of a number of renumbering algorithms for the degrees of
  * freedom on a triangulation. The functions in this namespace compute
@@ -836,6 +840,31 @@ namespace DoFRenumbering
   void
   hierarchical(DoFHandlerType &dof_handler);
 
+  /**
+   * Renumber degrees of freedom by traversing the active cells along a
+   * Hilbert space-filling curve through their centers, see
+   * GridTools::sort_active_cells_along_hilbert_curve(), and numbering the
+   * degrees of freedom of each cell when they are first encountered.
+   * Unlike hierarchical(), the resulting order does not depend on the
+   * coarse mesh, and neighboring cells are numbered close to each other also
+   * across coarse cell boundaries. This can improve data locality in cell
+   * loops and matrix-vector products on unstructured meshes with many coarse
+   * cells. On meshes that are refined from a single coarse cell, the default
+   * numbering already has comparable locality, and matrix-vector products
+   * are not faster with this numbering. Unlike Cuthill_McKee(), this
+   * function does not reduce the bandwidth of the matrix.
+   *
+   * On parallel triangulations, each processor numbers its locally owned
+   * degrees of freedom in the order of its locally owned cells along the
+   * curve, and keeps a contiguous range of indices.
+   *
+   * @note This function generates an ordering that is independent of the previous
+   * numbering of degrees of freedom.
+   */
+  template <typename DoFHandlerType>
+  void
+  hilbert(DoFHandlerType &dof_handler);
+
   /**
    * Renumber degrees of freedom by cell. The function takes a vector of cell
    * iterators (which needs to list <i>all</i> active cells of the DoF handler
@@ -932,6 +961,58 @@ namespace DoFRenumbering
    * @}
    */
 
+  /**
+   * @name Numberings for matrix-free operator evaluation
+   * @{
+   */
+
+  /**
+   * Renumber the degrees of freedom in the order in which the cell loop of
+   * the given @p matrix_free object accesses them. The cell batches of
+   * MatrixFree are traversed in the order given by its TaskInfo partition,
+   * and within each batch cell by cell, and each locally owned degree of
+   * freedom gets the next free index when it is first encountered. As a
+   * result, the degrees of freedom of a cell batch are mostly contiguous in
+   * memory, and those shared with subsequent batches have been touched
+   * shortly before, so FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global() access consecutive memory
+   * and the vector entries stay in cache between neighboring batches. For
+   * discontinuous elements, the degrees of freedom of each cell end up
+   * contiguous, which allows MatrixFree to use its fastest access path.
+   * This pays off mainly when the current numbering is unrelated to the
+   * cell order, for example after Cuthill_McKee(). On meshes that are
+   * refined from a single coarse cell, the numbering created by
+   * DoFHandler::distribute_dofs() already follows the cells closely, and
+   * this function changes little.
+   *
+   * The @p matrix_free object must have been set up with @p dof_handler for
+   * the active cells. It is invalidated by the renumbering and needs to be
+   * initialized again, together with any AffineConstraints object and
+   * vectors that depend on the numbering of the degrees of freedom. Locally
+   * owned degrees of freedom that are not touched by any cell of
+   * @p matrix_free are numbered last, in their original order.
+   */
+  template <int dim, typename Number>
+  void
+  matrix_free_data_locality(DoFHandler<dim> &               dof_handler,
+                            const MatrixFree<dim, Number> &matrix_free);
+
+  /**
+   * Compute the renumbering vector needed by the matrix_free_data_locality()
+   * function, with one entry per locally owned degree of freedom. Does not
+   * perform the renumbering on the @p dof_handler.
+   */
+  template <int dim, typename Number>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim> &               dof_handler,
+    const MatrixFree<dim, Number> &       matrix_free);
+
+  /**
+   * @}
+   */
+
   /**
    * @name Directional numberings
    * @{
@@ -663,6 +663,44 @@ namespace DoFTools
                         const DoFHandlerType &dof_col,
                         SparsityPatternType & sparsity);
 
+  /**
+   * Compute the same entries as the first make_sparsity_pattern() function
+   * above and store them in @p sparsity_pattern, which is reinitialized and
+   * compressed by this function, without going through an intermediate
+   * DynamicSparsityPattern.
+   *
+   * The function first determines which locally owned cells couple to each
+   * degree of freedom, either directly or through @p constraints. It then
+   * works on the rows in parallel: In a first pass, it computes the exact
+   * number of entries of each row, which allows allocating exactly the
+   * memory the final pattern needs. In a second pass, it computes the
+   * entries of each row again and writes them into the pattern in sorted
+   * order. The memory needed in addition to the final pattern is roughly
+   * proportional to the number of degrees of freedom on all cells, which is
+   * typically a fraction of the size of the pattern, whereas a
+   * DynamicSparsityPattern needs a multiple of it.
+   *
+   * @param[in] dof_handler The DoFHandler or hp::DoFHandler object whose
+   * locally owned cells define the couplings.
+   * @param[out] sparsity_pattern The sparsity pattern, which has one row and
+   * column per degree of freedom afterwards. Its previous content is
+   * deleted.
+   * @param[in] constraints The constraints to be taken into account, with
+   * the same meaning as for the first make_sparsity_pattern() function.
+   * @param[in] keep_constrained_dofs Whether the rows and columns of
+   * constrained degrees of freedom keep their entries, with the same meaning
+   * as for the first make_sparsity_pattern() function.
+   *
+   * @ingroup constraints
+   */
+  template <typename DoFHandlerType, typename number = double>
+  void
+  make_exact_sparsity_pattern(
+    const DoFHandlerType &           dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
@@ -106,6 +106,15 @@ public:
   std::vector<unsigned int>
   get_poly_space_numbering_inverse() const;
 
+  /**
+   * Return the underlying polynomial space. Its functions are numbered in
+   * the same way as the shape functions of this element, so evaluating all
+   * of them at once through PolynomialType::compute() yields the values
+   * of all shape functions at a point.
+   */
+  const PolynomialType &
+  get_poly_space() const;
+
   /**
    * Return the value of the <tt>i</tt>th shape function at the point
    * <tt>p</tt>. See the FiniteElement base class for more information about
@@ -52,6 +52,14 @@ FE_Poly<PolynomialType, dim, spacedim>::get_degree() const
 }
 
 
+template <class PolynomialType, int dim, int spacedim>
+const PolynomialType &
+FE_Poly<PolynomialType, dim, spacedim>::get_poly_space() const
+{
+  return poly_space;
+}
+
+
 template <class PolynomialType, int dim, int spacedim>
 double
 FE_Poly<PolynomialType, dim, spacedim>::shape_value(const unsigned int i,
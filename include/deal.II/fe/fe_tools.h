@@ -181,6 +181,21 @@ namespace FETools
                             std::vector<types::global_dof_index> &block_data,
                             bool return_start_indices = true);
 
+  /**
+   * Return whether the shape functions of @p fe are the same functions of the
+   * reference coordinates on every cell, so that their values at a point of a
+   * cell can be computed by FiniteElement::shape_value() at the
+   * corresponding point of the reference cell, without an FEValues object.
+   * This is the case for FE_Q, FE_DGQ, FE_DGP, FE_Bernstein and
+   * FE_Q_Hierarchical, and for FESystem objects composed only of them. For
+   * all other elements, the function returns false: they may not implement
+   * FiniteElement::shape_value() or may need data from the mapping (e.g.,
+   * FE_Enriched), even if they are primitive and H1 conforming.
+   */
+  template <int dim, int spacedim>
+  bool
+  has_mapping_independent_shape_values(const FiniteElement<dim, spacedim> &fe);
+
   /**
    * @name Generation of local matrices
    * @{
@@ -1469,6 +1469,27 @@ namespace FETools
 
 
 
+  template <int dim, int spacedim>
+  bool
+  has_mapping_independent_shape_values(const FiniteElement<dim, spacedim> &fe)
+  {
+    if (const auto system = dynamic_cast<const FESystem<dim, spacedim> *>(&fe))
+      {
+        for (unsigned int b = 0; b < system->n_base_elements(); ++b)
+          if (!has_mapping_independent_shape_values(system->base_element(b)))
+            return false;
+        return true;
+      }
+
+    return (dynamic_cast<const FE_Q<dim, spacedim> *>(&fe) != nullptr ||
+            dynamic_cast<const FE_DGQ<dim, spacedim> *>(&fe) != nullptr ||
+            dynamic_cast<const FE_DGP<dim, spacedim> *>(&fe) != nullptr ||
+            dynamic_cast<const FE_Bernstein<dim, spacedim> *>(&fe) != nullptr ||
+            dynamic_cast<const FE_Q_Hierarchical<dim> *>(&fe) != nullptr);
+  }
+
+
+
   template <int dim, typename number, int spacedim>
   void
   get_interpolation_matrix(const FiniteElement<dim, spacedim> &fe1,
@@ -0,0 +1,247 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_grid_binary_mesh_format_h
+#define dealii_grid_binary_mesh_format_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  /**
+   * Definitions shared by GridOut::write_binary() and GridIn::read_binary(),
+   * see the documentation of GridOut::write_binary() for a description of
+   * the file format. All numbers are stored in little-endian byte order,
+   * independent of the byte order of the machine.
+   */
+  namespace BinaryMeshFormat
+  {
+    /**
+     * The first eight bytes of every file.
+     */
+    static const char magic[8] = {'d', 'e', 'a', 'l', 'm', 'e', 's', 'h'};
+
+    /**
+     * The version of the file format.
+     */
+    const std::uint32_t version = 2;
+
+    /**
+     * The size of the header in bytes.
+     */
+    const std::size_t header_size = 104;
+
+    /**
+     * The contents of the header of a file.
+     */
+    struct Header
+    {
+      std::uint32_t dim;
+      std::uint32_t spacedim;
+      std::uint64_t n_vertices;
+      std::uint64_t n_cells;
+      std::uint64_t n_faces;
+      std::uint64_t n_lines;
+      std::uint64_t vertices_offset;
+      std::uint64_t cells_offset;
+      std::uint64_t faces_offset;
+      std::uint64_t lines_offset;
+      std::uint64_t face_index_offset;
+      std::uint64_t line_index_offset;
+    };
+
+    /**
+     * The size in bytes of the record of a vertex.
+     */
+    inline std::size_t
+    vertex_record_size(const unsigned int spacedim)
+    {
+      return 8 * spacedim;
+    }
+
+    /**
+     * The size in bytes of the record of a cell, face, or line with
+     * @p n_vertices vertices: the vertex indices followed by the material or
+     * boundary id and the manifold id.
+     */
+    inline std::size_t
+    object_record_size(const unsigned int n_vertices)
+    {
+      return 4 * (n_vertices + 2);
+    }
+
+    /**
+     * Return whether @p n_records records of @p record_size bytes each,
+     * starting at byte @p offset, are contained in @p size bytes. The check
+     * is written such that it cannot overflow for corrupted headers.
+     */
+    inline bool
+    section_fits(const std::uint64_t offset,
+                 const std::uint64_t n_records,
+                 const std::size_t   record_size,
+                 const std::size_t   size)
+    {
+      return offset <= size && n_records <= (size - offset) / record_size;
+    }
+
+    inline void
+    write_uint32(const std::uint32_t value, char *out)
+    {
+      for (unsigned int i = 0; i < 4; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+
+    inline void
+    write_uint64(const std::uint64_t value, char *out)
+    {
+      for (unsigned int i = 0; i < 8; ++i)
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+
+    inline void
+    write_double(const double value, char *out)
+    {
+      static_assert(sizeof(double) == sizeof(std::uint64_t),
+                    "The binary mesh format requires 64 bit doubles.");
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      write_uint64(bits, out);
+    }
+
+    inline std::uint32_t
+    read_uint32(const char *in)
+    {
+      std::uint32_t value = 0;
+      for (unsigned int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(in[i]))
+                 << (8 * i);
+      return value;
+    }
+
+    inline std::uint64_t
+    read_uint64(const char *in)
+    {
+      std::uint64_t value = 0;
+      for (unsigned int i = 0; i < 8; ++i)
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i]))
+                 << (8 * i);
+      return value;
+    }
+
+    inline double
+    read_double(const char *in)
+    {
+      const std::uint64_t bits = read_uint64(in);
+      double              value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    /**
+     * Write @p header to the first header_size bytes of @p out.
+     */
+    inline void
+    write_header(const Header &header, char *out)
+    {
+      std::memcpy(out, magic, 8);
+      write_uint32(version, out + 8);
+      write_uint32(header.dim, out + 12);
+      write_uint32(header.spacedim, out + 16);
+      write_uint32(0, out + 20);
+      write_uint64(header.n_vertices, out + 24);
+      write_uint64(header.n_cells, out + 32);
+      write_uint64(header.n_faces, out + 40);
+      write_uint64(header.n_lines, out + 48);
+      write_uint64(header.vertices_offset, out + 56);
+      write_uint64(header.cells_offset, out + 64);
+      write_uint64(header.faces_offset, out + 72);
+      write_uint64(header.lines_offset, out + 80);
+      write_uint64(header.face_index_offset, out + 88);
+      write_uint64(header.line_index_offset, out + 96);
+    }
+
+    /**
+     * Read the header from the @p size bytes at @p in, and check that the
+     * sections it describes are contained in these bytes.
+     */
+    inline Header
+    read_header(const char *in, const std::size_t size)
+    {
+      AssertThrow(size >= header_size && std::memcmp(in, magic, 8) == 0,
+                  ExcMessage("The input is not a mesh in the binary format "
+                             "written by GridOut::write_binary()."));
+      AssertThrow(read_uint32(in + 8) == version,
+                  ExcMessage("The input was written in an unsupported "
+                             "version of the binary mesh format."));
+
+      Header header;
+      header.dim               = read_uint32(in + 12);
+      header.spacedim          = read_uint32(in + 16);
+      header.n_vertices        = read_uint64(in + 24);
+      header.n_cells           = read_uint64(in + 32);
+      header.n_faces           = read_uint64(in + 40);
+      header.n_lines           = read_uint64(in + 48);
+      header.vertices_offset   = read_uint64(in + 56);
+      header.cells_offset      = read_uint64(in + 64);
+      header.faces_offset      = read_uint64(in + 72);
+      header.lines_offset      = read_uint64(in + 80);
+      header.face_index_offset = read_uint64(in + 88);
+      header.line_index_offset = read_uint64(in + 96);
+
+      AssertThrow(header.dim >= 1 && header.dim <= 3 &&
+                    header.spacedim >= header.dim && header.spacedim <= 3,
+                  ExcMessage("The header of the binary mesh is corrupted."));
+      const unsigned int vertices_per_cell = 1U << header.dim;
+      const unsigned int vertices_per_face = 1U << (header.dim - 1);
+      // the index sections have one more entry than there are cells
+      AssertThrow(
+        header.n_cells < std::numeric_limits<std::uint64_t>::max() &&
+          section_fits(header.vertices_offset,
+                       header.n_vertices,
+                       vertex_record_size(header.spacedim),
+                       size) &&
+          section_fits(header.cells_offset,
+                       header.n_cells,
+                       object_record_size(vertices_per_cell),
+                       size) &&
+          section_fits(header.faces_offset,
+                       header.n_faces,
+                       object_record_size(vertices_per_face),
+                       size) &&
+          section_fits(header.lines_offset,
+                       header.n_lines,
+                       object_record_size(2),
+                       size) &&
+          section_fits(header.face_index_offset, header.n_cells + 1, 8, size) &&
+          section_fits(header.line_index_offset, header.n_cells + 1, 8, size),
+        ExcMessage("The binary mesh is truncated."));
+
+      return header;
+    }
+  } // namespace BinaryMeshFormat
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -131,6 +131,20 @@ public:
   typename Triangulation<dim, spacedim>::cell_iterator
   to_cell(const Triangulation<dim, spacedim> &tria) const;
 
+  /**
+   * Return the id of the coarse cell within whose tree the cell represented
+   * by the current object is located.
+   */
+  unsigned int
+  get_coarse_cell_id() const;
+
+  /**
+   * Return the CellId of the parent of the cell represented by the current
+   * object. The cell must not be a coarse cell.
+   */
+  CellId
+  parent_cell_id() const;
+
   /**
    * Compare two CellId objects for equality.
    */
@@ -305,6 +319,23 @@ CellId::operator<(const CellId &other) const
   return true; // other.id is longer
 }
 
+
+
+inline unsigned int
+CellId::get_coarse_cell_id() const
+{
+  return coarse_cell_id;
+}
+
+
+
+inline CellId
+CellId::parent_cell_id() const
+{
+  Assert(n_child_indices > 0, ExcMessage("A coarse cell has no parent."));
+  return CellId(coarse_cell_id, n_child_indices - 1, child_indices.data());
+}
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -332,6 +332,8 @@ public:
     vtk,
     /// Use read_assimp()
     assimp,
+    /// Use read_binary()
+    binary,
   };
 
   /**
@@ -473,6 +475,43 @@ public:
   void
   read_tecplot(std::istream &in);
 
+  /**
+   * Read grid data from a stream containing a mesh in the binary format
+   * written by GridOut::write_binary(). See the documentation of that
+   * function for a description of the format.
+   *
+   * Since the file was written from a valid triangulation, the cells are
+   * passed to the triangulation without the reordering done for the other
+   * formats. The records of the vertices and cells are decoded in parallel.
+   */
+  void
+  read_binary(std::istream &in);
+
+  /**
+   * Read grid data from the file @p filename containing a mesh in the binary
+   * format written by GridOut::write_binary(), like the previous function.
+   * Where possible, the file is mapped into memory rather than read, so
+   * that only the parts of the file that are actually needed are read from
+   * disk.
+   *
+   * If @p first_cell and @p n_cells are given, only the cells with the
+   * indices <tt>first_cell</tt> to <tt>first_cell+n_cells-1</tt> of the file
+   * are read, together with their vertices and the boundary and manifold
+   * ids of their faces and lines. Only the records of these cells, of their
+   * vertices, faces, and lines, and the corresponding entries of the index
+   * sections are accessed. This allows each process of a parallel
+   * program to read only its part of a large mesh, e.g., for the
+   * construction of a parallel::fullydistributed::Triangulation, without
+   * ever reading the complete mesh. The faces between the cells read and
+   * the other cells are then at the boundary of the triangulation, and get
+   * the boundary id the triangulation assigns by default, i.e., zero in 2d
+   * and 3d.
+   */
+  void
+  read_binary(const std::string &filename,
+              const unsigned int first_cell = 0,
+              const unsigned int n_cells    = numbers::invalid_unsigned_int);
+
   /**
    * Read in a file supported by Assimp, and generate a Triangulation
    * out of it.  If you specify a @p mesh_index, only the mesh with
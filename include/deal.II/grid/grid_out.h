@@ -935,7 +935,9 @@ public:
     /// write() calls write_vtk()
     vtk,
     /// write() calls write_vtu()
-    vtu
+    vtu,
+    /// write() calls write_binary()
+    binary
   };
 
   /**
@@ -1187,6 +1189,55 @@ public:
   void
   write_vtu(const Triangulation<dim, spacedim> &tria, std::ostream &out) const;
 
+  /**
+   * Write the active cells of the triangulation in a compact binary format
+   * that can be read back by GridIn::read_binary() much faster than any of
+   * the text based formats. As for the other formats, the cells are written
+   * as the cells of a coarse mesh, so the triangulation must not have
+   * hanging nodes if it is to be read back in.
+   *
+   * The file consists of a header followed by six sections of fixed-size
+   * records. All integers are unsigned and all numbers are stored in
+   * little-endian byte order:
+   * - The header of 104 bytes: the eight characters <tt>dealmesh</tt>, the
+   *   version of the format (32 bit, currently 2), <tt>dim</tt> and
+   *   <tt>spacedim</tt> (32 bit each), 32 bits of padding, the numbers of
+   *   vertices, cells, face records, and line records (64 bit each), and the
+   *   byte offsets of the six sections from the start of the file in the
+   *   order listed here (64 bit each).
+   * - The vertices: <tt>spacedim</tt> coordinates per vertex as 64 bit
+   *   IEEE floating point numbers. Only used vertices are written, and
+   *   they are numbered consecutively.
+   * - The cells: the indices of the vertices of each cell in the order of
+   *   the deal.II numbering, followed by the material id and the manifold id
+   *   of the cell (32 bit each).
+   * - The faces that have a boundary id other than zero or a manifold id,
+   *   grouped by the cells in the order of the cell section: the indices of
+   *   their vertices, followed by the boundary id
+   *   (numbers::internal_face_boundary_id for interior faces) and the
+   *   manifold id (32 bit each). A face is stored with each of the cells it
+   *   belongs to. In 1d, all vertices at the boundary are stored.
+   * - In 3d, the lines that have a boundary id other than zero or a manifold
+   *   id, stored in the same way as the faces.
+   * - The index of the face records: for each cell, the number of the first
+   *   face record of the cell, followed by the total number of face records
+   *   (64 bit each).
+   * - The index of the line records, in the same form.
+   *
+   * Since all records of a section have the same size, the record of any
+   * cell can be found without reading the preceding ones, and the index
+   * sections give the range of the face and line records of any range of
+   * cells. This allows GridIn::read_binary() to read only the bytes that
+   * belong to a range of the cells, e.g., on each of the processes of a
+   * parallel program.
+   *
+   * The vertices and cells are encoded in parallel.
+   */
+  template <int dim, int spacedim>
+  void
+  write_binary(const Triangulation<dim, spacedim> &tria,
+               std::ostream &                      out) const;
+
   /**
    * Write triangulation in VTU format for each processor, and add a .pvtu file
    * for visualization in Visit or Paraview that describes the collection of VTU
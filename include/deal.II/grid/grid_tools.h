@@ -50,7 +50,10 @@
 #  endif
 
 
+#  include <array>
 #  include <bitset>
+#  include <cmath>
+#  include <cstdint>
 #  include <list>
 #  include <set>
 
@@ -299,13 +302,21 @@ namespace GridTools
    *
    * This function is called by some <tt>GridIn::read_*</tt> functions. Only
    * the vertices with indices in @p considered_vertices are tested for
-   * equality. This speeds up the algorithm, which is quadratic and thus quite
-   * slow to begin with. However, if you wish to consider all vertices, simply
-   * pass an empty vector. In that case, the function fills
-   * @p considered_vertices with all vertices.
+   * equality. If you wish to consider all vertices, simply pass an empty
+   * vector. In that case, the function fills @p considered_vertices with all
+   * vertices.
    *
    * Two vertices are considered equal if their difference in each coordinate
-   * direction is less than @p tol.
+   * direction is less than @p tol. The vertices are processed in the order
+   * given by @p considered_vertices: a vertex is kept unless it is equal to
+   * an earlier vertex that has been kept, in which case it is replaced by the
+   * last such vertex.
+   *
+   * The close vertices are found by sorting the vertices into the cells of
+   * a uniform background grid with cells somewhat larger than @p tol and
+   * only comparing vertices in the same or neighboring cells. The cost is
+   * therefore $O(N \log N)$ in the number $N$ of considered vertices, and
+   * both the sorting and the search run in parallel.
    */
   template <int dim, int spacedim>
   void
@@ -685,11 +696,12 @@ namespace GridTools
    * Mapping::transform_unit_to_real(qpoints[c][0])
    * returns @p points[a].
    *
-   * The algorithm assumes it's easier to look for a point in the cell that was
-   * used previously. For this reason random points are, computationally
-   * speaking, the worst case scenario while points grouped by the cell to which
-   * they belong are the best case. Pre-sorting points, trying to minimize
-   * distances between them, might make the function extremely faster.
+   * The cells are found by GridTools::find_active_cells_around_points(),
+   * which processes the points in parallel using the R-tree of cell bounding
+   * boxes stored in the @p cache. The cells in the output are ordered by
+   * their first occurrence, and the points within each cell by their index
+   * in @p points. If one of the points is not found, an exception of type
+   * GridTools::ExcPointNotFound is thrown.
    *
    * @note The actual return type of this function, i.e., the type referenced
    * above as @p return_type, is
@@ -1159,6 +1171,12 @@ namespace GridTools
    * A version of the previous function that exploits an already existing
    * GridTools::Cache<dim,spacedim> object.
    *
+   * Unless @p marked_vertices is given, the point is first looked up in the
+   * bounding boxes of the locally owned active cells through
+   * Cache::get_cells_with_bounding_box_around_point(). The search through the
+   * neighborhoods of vertices of the previous function is only used if this
+   * does not find a cell, e.g., if the point lies in a ghost cell.
+   *
    * @author Luca Heltai, 2017
    */
   template <int dim, int spacedim>
@@ -1171,6 +1189,37 @@ namespace GridTools
                              cell_hint = typename Triangulation<dim, spacedim>::active_cell_iterator(),
     const std::vector<bool> &marked_vertices = {});
 
+  /**
+   * Find the active cells around each of the @p points, as well as the
+   * positions of the points in the reference coordinates of these cells.
+   * The points are processed in parallel.
+   *
+   * The cells are looked up in the bounding boxes of the locally owned
+   * active cells through Cache::get_cells_with_bounding_box_around_point().
+   * This does not depend on the quality of the mesh, unlike the search
+   * through the neighborhoods of the vertices closest to a point done by the
+   * other versions of find_active_cell_around_point(). Only for points that
+   * are not found in this way, e.g., points in ghost cells of a parallel
+   * triangulation, the latter search is used. The cell @p cell_hint is tried first for the
+   * first points, and each point is first tried in the cell of the point
+   * before it.
+   *
+   * In contrast to find_active_cell_around_point(), this function does not
+   * throw an exception if a point is not found. Rather, the returned iterator
+   * for such a point is invalid, i.e., its state() is not
+   * IteratorState::valid.
+   */
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator
+      &cell_hint =
+        typename Triangulation<dim, spacedim>::active_cell_iterator());
+
   /**
    * A variant of the previous find_active_cell_around_point() function that,
    * instead of returning only the first matching cell, identifies all cells
@@ -1823,6 +1872,56 @@ namespace GridTools
   partition_triangulation_zorder(const unsigned int            n_partitions,
                                  Triangulation<dim, spacedim> &triangulation);
 
+  /**
+   * Generate a partitioning of the active cells by sorting them along a
+   * Hilbert space-filling curve through the bounding box of the
+   * triangulation, and cutting this curve into @p n_partitions pieces of
+   * equal weight. Unlike partition_triangulation_zorder(), the curve runs
+   * through the centers of the active cells, so the partitions are compact
+   * also for coarse meshes with many cells, and unlike
+   * partition_triangulation(), no external library is required and the
+   * memory used is proportional to the number of active cells. The positions
+   * of the cells on the curve are computed in parallel.
+   *
+   * As for partition_triangulation_zorder(), children that are all active
+   * are assigned to the same subdomain, so that partition_multigrid_levels()
+   * can be used on the result.
+   *
+   * @note If the @p cell_weight signal has been attached to the
+   * @p triangulation, then this will be used and passed to the partitioner.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation);
+
+  /**
+   * This function does the same as the previous one, but uses the weights of
+   * the cells given in @p cell_weights, ordered by active cell index,
+   * instead of the @p cell_weight signal of the triangulation. If the
+   * vector is empty or all weights are zero, all cells are weighted
+   * equally.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(
+    const unsigned int               n_partitions,
+    const std::vector<unsigned int> &cell_weights,
+    Triangulation<dim, spacedim> &   triangulation);
+
+  /**
+   * Return all active cells of the @p triangulation, sorted along the
+   * Hilbert curve through the centers of the cells that is also used by
+   * partition_triangulation_hilbert(). Cells that are close to each other in
+   * the returned vector are also close to each other in space, which makes
+   * this order a good basis for numberings that are meant to preserve data
+   * locality, see DoFRenumbering::hilbert().
+   */
+  template <int dim, int spacedim>
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+  sort_active_cells_along_hilbert_curve(
+    const Triangulation<dim, spacedim> &triangulation);
+
   /**
    * Partitions the cells of a multigrid hierarchy by assigning level subdomain
    * ids using the "youngest child" rule, that is, each cell in the hierarchy is
@@ -3209,6 +3308,113 @@ namespace GridTools
     }
   } // namespace internal
 
+
+
+  namespace internal
+  {
+    /**
+     * A uniform background grid that is used to find the points within a
+     * given tolerance of each other, e.g., in delete_duplicated_vertices()
+     * and collect_periodic_faces(). The points are sorted by the integer
+     * coordinates of the cell they lie in, so that each point only needs to
+     * be compared with the points in its own cell and, if it lies within
+     * the tolerance of a face of its cell, in the respective neighbor cells.
+     */
+    template <int spacedim>
+    class BackgroundGrid
+    {
+    public:
+      /**
+       * Integer coordinates of a cell of the background grid.
+       */
+      using Cell = std::array<std::int64_t, spacedim>;
+
+      /**
+       * Constructor. @p lower and @p upper are the corners of a box
+       * containing the points to be sorted.
+       *
+       * The cells are chosen large compared to @p tolerance, so that most
+       * points are not close to a face of their cell and only need to look
+       * into their own cell, but small enough for the cells to contain few
+       * points and for the integer coordinates of the points in the box not
+       * to overflow. The odd factors avoid that the points of structured
+       * meshes are aligned with the faces of the background grid.
+       */
+      BackgroundGrid(const Point<spacedim> &lower,
+                     const Point<spacedim> &upper,
+                     const double           tolerance)
+        : lower(lower)
+      {
+        double extent = 0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          extent = std::max(extent, upper[d] - lower[d]);
+        cell_size = std::max(25.888 * tolerance,
+                             extent / static_cast<double>(1ULL << 40));
+        if (cell_size == 0.)
+          cell_size = 1.;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          this->lower[d] -= 0.382 * cell_size;
+      }
+
+      /**
+       * Return the cell @p p lies in. Points outside the box passed to the
+       * constructor are clipped to the range of the integer coordinates.
+       */
+      Cell
+      cell(const Point<spacedim> &p) const
+      {
+        Cell cell;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          cell[d] = static_cast<std::int64_t>(std::floor(coordinate(p, d)));
+        return cell;
+      }
+
+      /**
+       * Return the distance of @p p from the lower face of @p cell in
+       * coordinate direction @p d, where @p cell is the cell of @p p.
+       */
+      double
+      position_in_cell(const Point<spacedim> &p,
+                       const Cell &           cell,
+                       const unsigned int     d) const
+      {
+        return (coordinate(p, d) - cell[d]) * cell_size;
+      }
+
+      /**
+       * Return the edge length of the cells.
+       */
+      double
+      get_cell_size() const
+      {
+        return cell_size;
+      }
+
+    private:
+      /**
+       * Return the coordinate of @p p in direction @p d in units of cells.
+       */
+      double
+      coordinate(const Point<spacedim> &p, const unsigned int d) const
+      {
+        const double max_coordinate = static_cast<double>(1ULL << 60);
+        return std::max(
+          -max_coordinate,
+          std::min(max_coordinate, (p[d] - lower[d]) / cell_size));
+      }
+
+      /**
+       * The lower corner of the cell with coordinates zero.
+       */
+      Point<spacedim> lower;
+
+      /**
+       * The edge length of the cells.
+       */
+      double cell_size;
+    };
+  } // namespace internal
+
   template <typename Iterator>
   Point<Iterator::AccessorType::space_dimension>
   project_to_object(
@@ -22,6 +22,7 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -34,7 +35,9 @@
 
 #include <boost/signals2.hpp>
 
+#include <atomic>
 #include <cmath>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -61,6 +64,12 @@ namespace GridTools
    * obsolete, and you will have to mark them as outdated, by calling the
    * method mark_for_update() manually.
    *
+   * The `get_*` functions of this class can be called from several threads
+   * at the same time: the data structures are built under a lock by the
+   * first thread that needs them, and only read afterwards. Calling
+   * mark_for_update() while other threads use the data structures is not
+   * safe, however.
+   *
    * @author Luca Heltai, 2017.
    */
   template <int dim, int spacedim = dim>
@@ -133,6 +142,35 @@ namespace GridTools
     const Mapping<dim, spacedim> &
     get_mapping() const;
 
+    /**
+     * Return in @p cells the locally owned active cells of the stored
+     * triangulation whose bounding boxes contain the point @p p, sorted in
+     * the order of the cells. The bounding boxes are computed from the
+     * vertices returned by Mapping::get_vertices() for the stored mapping,
+     * and are enlarged by a small relative tolerance so that points on the
+     * boundary of a cell are reported for that cell as well.
+     *
+     * For a mapping that curves the cells, a cell may extend beyond the
+     * bounding box of its vertices. This function hence gives candidates
+     * for the cells around a point, but not necessarily all of them.
+     *
+     * The bounding boxes are stored in an R-tree that is built on the first
+     * call after the triangulation has changed.
+     */
+    void
+    get_cells_with_bounding_box_around_point(
+      const Point<spacedim> &p,
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+        &cells) const;
+
+    /**
+     * Return the number of bounding boxes stored in the R-tree used by
+     * get_cells_with_bounding_box_around_point(), i.e., the number of
+     * locally owned active cells. The tree is built if necessary.
+     */
+    unsigned int
+    n_cell_bounding_boxes() const;
+
 #ifdef DEAL_II_WITH_NANOFLANN
     /**
      * Return the cached vertex_kdtree object, constructed with the vertices of
@@ -144,9 +182,17 @@ namespace GridTools
 
   private:
     /**
-     * Keep track of what needs to be updated next.
+     * Keep track of what needs to be updated next. The flags are read
+     * without holding #builder_mutex, so they are stored atomically.
+     */
+    mutable std::atomic<CacheUpdateFlags> update_flags;
+
+    /**
+     * A mutex that guards building the data structures of this class on
+     * first access, so that the `get_*` functions can be called from
+     * several threads at the same time.
      */
-    mutable CacheUpdateFlags update_flags;
+    mutable Threads::Mutex builder_mutex;
 
     /**
      * A pointer to the Triangulation.
@@ -187,6 +233,25 @@ namespace GridTools
      */
     mutable std::map<unsigned int, Point<spacedim>> used_vertices;
 
+    /**
+     * The type of the R-tree of the bounding boxes of the locally owned
+     * active cells. It is only defined in the source file, so that this
+     * header does not have to include boost.geometry.
+     */
+    class CellBoundingBoxRtree;
+
+    /**
+     * An R-tree of the bounding boxes of the locally owned active cells.
+     */
+    mutable std::unique_ptr<CellBoundingBoxRtree> cell_bounding_boxes_rtree;
+
+    /**
+     * Return the R-tree of the bounding boxes, after building it if it is
+     * marked for update.
+     */
+    const CellBoundingBoxRtree &
+    get_cell_bounding_boxes_rtree() const;
+
     /**
      * Storage for the status of the triangulation signal.
      */
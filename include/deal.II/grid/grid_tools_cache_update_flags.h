@@ -63,6 +63,12 @@ namespace GridTools
      */
     update_used_vertices = 0x08,
 
+    /**
+     * Update an R-tree of the bounding boxes of the locally owned active
+     * cells.
+     */
+    update_cell_bounding_boxes_rtree = 0x10,
+
     /**
      * Update all objects.
      */
@@ -88,6 +94,8 @@ namespace GridTools
     if (u & update_vertex_kdtree)
       s << "|vertex_kdtree";
 #endif
+    if (u & update_cell_bounding_boxes_rtree)
+      s << "|cell_bounding_boxes_rtree";
     return s;
   }
 
@@ -322,6 +322,19 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * Triangulation::execute_coarsening_and_refinement() computes the locations
+ * of the new vertices of different lines, quads, and cells in parallel. It
+ * therefore calls get_new_point(), get_intermediate_point(), and the
+ * get_new_point_on_*() functions of the same manifold object from several
+ * threads at the same time. Derived classes must make sure that these
+ * functions can be called concurrently, for example by not modifying member
+ * variables in them, or by protecting such modifications, e.g., caches,
+ * with a Threads::Mutex. All manifolds in the library satisfy this
+ * requirement.
+ *
+ *
  * @ingroup manifold
  * @author Luca Heltai, Wolfgang Bangerth, 2014, 2016
  */
@@ -39,6 +39,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <vector>
 
 
@@ -1711,6 +1712,32 @@ public:
   virtual const MeshSmoothing &
   get_mesh_smoothing() const;
 
+  /**
+   * Select whether this triangulation uses lean storage. By default, the
+   * user data of all objects (see
+   * @ref GlossUserData)
+   * and the level subdomain ids of all cells are allocated whenever the mesh
+   * is created or refined, whether they are used or not. With lean storage,
+   * they are instead only allocated when they are set for the first time,
+   * and clear_user_data() releases the memory of the user data again. This
+   * reduces the memory consumption of large meshes that use neither of
+   * them, but the first call that sets the user data of lines, quads or hexes,
+   * or the first level subdomain id on a level, then modifies the
+   * triangulation as a whole and must not run concurrently with any other
+   * access to these data.
+   *
+   * Switching lean storage off allocates the data right away.
+   */
+  void
+  set_lean_storage(const bool lean_storage);
+
+  /**
+   * Return whether this triangulation uses lean storage, see
+   * set_lean_storage().
+   */
+  bool
+  has_lean_storage() const;
+
   /**
    * Assign a manifold object to a certain part of the triangulation. If
    * an object with manifold number @p number is refined, this object is used
@@ -1872,7 +1899,8 @@ public:
    * therefore also guarantee that the Manifold objects describing the boundary
    * have a lifetime at least as long as the copied triangulation.
    *
-   * This triangulation must be empty beforehand.
+   * This triangulation must be empty beforehand. Whether the triangulation
+   * uses lean storage, see set_lean_storage(), is copied as well.
    *
    * The function is made @p virtual since some derived classes might want to
    * disable or extend the functionality of this function.
@@ -2020,6 +2048,11 @@ public:
    * distorted (see the extensive discussion on
    * @ref GlossDistorted "distorted cells").
    *
+   * @note Only the locations of the new vertices, i.e., the calls to the
+   * manifolds, are computed in parallel. The smoothing of the flags, the
+   * creation of the children, and the update of the faces and neighbors run
+   * on a single thread.
+   *
    * @note This function is <tt>virtual</tt> to allow derived classes to
    * insert hooks, such as saving refinement flags and the like (see e.g. the
    * PersistentTriangulation class).
@@ -3133,6 +3166,30 @@ public:
   virtual types::subdomain_id
   locally_owned_subdomain() const;
 
+  /**
+   * Return the index of the coarse cell, i.e., the result of
+   * <code>cell-@>index()</code> for a cell on level zero, that is identified
+   * by @p coarse_cell_id in the CellId objects of this triangulation.
+   *
+   * For all triangulations that store the complete coarse mesh, the two
+   * numbers are the same. Triangulations that store only a part of the
+   * coarse mesh, like parallel::fullydistributed::Triangulation, use this
+   * function and coarse_cell_index_to_coarse_cell_id() to make CellId
+   * objects globally unique, independent of which coarse cells are present
+   * on a processor. If the coarse cell is not present, this function returns
+   * numbers::invalid_unsigned_int.
+   */
+  virtual unsigned int
+  coarse_cell_id_to_coarse_cell_index(const unsigned int coarse_cell_id) const;
+
+  /**
+   * The inverse of coarse_cell_id_to_coarse_cell_index(): return the id used
+   * in CellId objects for the coarse cell with the given index.
+   */
+  virtual unsigned int
+  coarse_cell_index_to_coarse_cell_id(
+    const unsigned int coarse_cell_index) const;
+
   /**
    * Return a reference to the current object.
    *
@@ -3262,6 +3319,30 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Return the memory consumption (in bytes) of each of the arrays storing
+   * the mesh, summed over all levels. The keys name the arrays, e.g.
+   * <tt>levels.refine_flags</tt> for the refinement flags of the cells,
+   * <tt>levels.cells.user_data</tt> for their user data, or
+   * <tt>faces.lines.manifold_id</tt> for the manifold ids of the lines in
+   * 2d and 3d. This is useful to find out which of the data structures
+   * dominate the memory consumption of large meshes.
+   *
+   * Note that with lean storage, see set_lean_storage(), the user data and
+   * the level subdomain ids are only allocated once they are set for the
+   * first time.
+   */
+  std::map<std::string, std::size_t>
+  memory_consumption_by_array() const;
+
+  /**
+   * Print the memory consumption of each of the arrays storing the mesh, as
+   * returned by memory_consumption_by_array(), as well as the total memory
+   * consumption of this object to the given output stream.
+   */
+  void
+  print_memory_consumption(std::ostream &out) const;
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization.
@@ -3631,6 +3712,15 @@ private:
   void
   reset_active_cell_indices();
 
+  /**
+   * Unless this triangulation uses lean storage, allocate the user data of
+   * all objects and the level subdomain ids of all cells, so that setting
+   * them later does not modify the triangulation as a whole. This function
+   * is called after mesh creation, refinement, and serialization.
+   */
+  void
+  allocate_optional_data();
+
   /**
    * Refine all cells on all levels which were previously flagged for
    * refinement.
@@ -3709,6 +3799,12 @@ private:
    */
   const bool check_for_distorted_cells;
 
+  /**
+   * Whether the user data and the level subdomain ids are only allocated
+   * once they are set. See set_lean_storage().
+   */
+  bool lean_storage;
+
   /**
    * Cache to hold the numbers of lines, quads, hexes, etc. These numbers are
    * set at the end of the refinement and coarsening functions and enable
@@ -3969,6 +4065,7 @@ Triangulation<dim, spacedim>::load(Archive &ar, const unsigned int)
       levels[l]->active_cell_indices.resize(levels[l]->refine_flags.size());
     reset_active_cell_indices();
   }
+  allocate_optional_data();
 
 
   bool my_check_for_distorted_cells;
@@ -1226,6 +1226,14 @@ public:
    * you can only use one of them, unless you call
    * Triangulation::clear_user_data() in between.
    *
+   * @note If the triangulation uses lean storage (see
+   * Triangulation::set_lean_storage()), the user data of all objects is only
+   * allocated when it is set for the first time. That first call then
+   * modifies the triangulation as a whole and must not run concurrently with
+   * any other access to user data. Once one user pointer or index of each
+   * kind of object (lines, quads, hexes) has been set, setting the user data
+   * of different objects from different threads is safe again.
+   *
    * See
    * @ref GlossUserData
    * for more information.
@@ -1297,7 +1305,14 @@ public:
    *
    * @note User pointers and user indices are mutually exclusive. Therefore,
    * you can only use one of them, unless you call
-   * Triangulation::clear_user_data() in between. See
+   * Triangulation::clear_user_data() in between.
+   *
+   * @note For triangulations with lean storage, the same holds for the
+   * first call to this function as for the first call to set_user_pointer():
+   * it allocates the user data and must not run concurrently with any other
+   * access to user data.
+   *
+   * See
    * @ref GlossUserData
    * for more information.
    */
@@ -3205,6 +3220,12 @@ public:
   /**
    * Set the level subdomain id of this cell. This is used for parallel
    * multigrid.
+   *
+   * @note If the triangulation uses lean storage (see
+   * Triangulation::set_lean_storage()), the level subdomain ids of a level
+   * are only allocated when the first one on that level is set. That first
+   * call then must not run concurrently with any other access to the level
+   * subdomain ids of the level.
    */
   void
   set_level_subdomain_id(
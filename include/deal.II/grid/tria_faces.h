@@ -76,6 +76,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to @p memory, see TriaObjects::add_memory_consumption().
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -105,6 +113,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to @p memory, see TriaObjects::add_memory_consumption().
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -141,6 +157,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to @p memory, see TriaObjects::add_memory_consumption().
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -27,6 +27,8 @@
 #include <boost/serialization/utility.hpp>
 
 #include <cstdint>
+#include <map>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -126,7 +128,8 @@ namespace internal
       std::vector<types::subdomain_id> subdomain_ids;
 
       /**
-       * for parallel multigrid
+       * for parallel multigrid. For triangulations with lean storage, this
+       * field is empty until the first level subdomain id is set.
        */
       std::vector<types::subdomain_id> level_subdomain_ids;
 
@@ -187,6 +190,16 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * level to the entry of @p memory named by @p prefix followed by the
+       * name of the array. The arrays of the cells are prefixed by
+       * <tt>cells.</tt> in addition.
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -243,6 +256,9 @@ namespace internal
       monitor_memory(const unsigned int true_dimension) const;
       std::size_t
       memory_consumption() const;
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
 
       /**
        * Read or write the data of this object to or from a stream for the
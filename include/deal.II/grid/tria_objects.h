@@ -23,6 +23,8 @@
 
 #include <deal.II/grid/tria_object.h>
 
+#include <map>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -253,24 +255,33 @@ namespace internal
 
       /**
        * Access to user pointers.
+       *
+       * If the user data has not been allocated yet (see
+       * allocate_user_data()), it is allocated by this call. This only
+       * happens for triangulations with lean storage, see
+       * Triangulation::set_lean_storage(), and must not happen concurrently
+       * with any other access to the user data.
        */
       void *&
       user_pointer(const unsigned int i);
 
       /**
-       * Read-only access to user pointers.
+       * Read-only access to user pointers. Returns a null pointer if no user
+       * data has been set yet.
        */
       const void *
       user_pointer(const unsigned int i) const;
 
       /**
-       * Access to user indices.
+       * Access to user indices. The user data is allocated by the first call
+       * to this function, see the non-const user_pointer() function.
        */
       unsigned int &
       user_index(const unsigned int i);
 
       /**
-       * Read-only access to user pointers.
+       * Read-only access to user indices. Returns zero if no user data has
+       * been set yet.
        */
       unsigned int
       user_index(const unsigned int i) const;
@@ -288,6 +299,21 @@ namespace internal
       void
       clear_user_data();
 
+      /**
+       * Allocate the user data of all objects. Until this function is
+       * called, or user data is set for the first time, the user data takes
+       * no memory.
+       */
+      void
+      allocate_user_data();
+
+      /**
+       * Clear all user pointers or indices like clear_user_data(), and
+       * release the memory of the user data.
+       */
+      void
+      release_user_data();
+
       /**
        * Clear all user flags.
        */
@@ -309,6 +335,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to the entry of @p memory named by @p prefix followed by the
+       * name of the array.
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -496,6 +531,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to the entry of @p memory named by @p prefix followed by the
+       * name of the array.
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -564,6 +608,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the arrays of this
+       * object to the entry of @p memory named by @p prefix followed by the
+       * name of the array.
+       */
+      void
+      add_memory_consumption(const std::string &                  prefix,
+                             std::map<std::string, std::size_t> &memory) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -632,7 +685,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data.size() < cells.size())
+        user_data.resize(cells.size());
       return user_data[i].p;
     }
 
@@ -645,8 +700,11 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      return user_data[i].p;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (i < user_data.size())
+        return user_data[i].p;
+      else
+        return nullptr;
     }
 
 
@@ -658,7 +716,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data.size() < cells.size())
+        user_data.resize(cells.size());
       return user_data[i].i;
     }
 
@@ -667,8 +727,9 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data(const unsigned int i)
     {
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      user_data[i].i = 0;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (i < user_data.size())
+        user_data[i].i = 0;
     }
 
 
@@ -689,8 +750,11 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      return user_data[i].i;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (i < user_data.size())
+        return user_data[i].i;
+      else
+        return 0;
     }
 
 
@@ -704,6 +768,23 @@ namespace internal
     }
 
 
+    template <typename G>
+    inline void
+    TriaObjects<G>::allocate_user_data()
+    {
+      user_data.resize(cells.size());
+    }
+
+
+    template <typename G>
+    inline void
+    TriaObjects<G>::release_user_data()
+    {
+      user_data_type = data_unknown;
+      std::vector<UserData>().swap(user_data);
+    }
+
+
     template <typename G>
     inline void
     TriaObjects<G>::clear_user_flags()
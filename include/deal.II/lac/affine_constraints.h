@@ -403,6 +403,16 @@ public:
    * \frac{u_3}{2} + \frac{u_2}{4} + \frac{u_4}{4}$. Note, however, that
    * cycles in this graph of constraints are not allowed, i.e. for example
    * $u_4$ may not be constrained, directly or indirectly, to $u_{13}$ again.
+   *
+   * The resolution of the chains, the sorting of the entries of each line,
+   * and the compaction of all lines into contiguous arrays that is used by
+   * the functions applying the constraints to vectors are done in parallel
+   * on all available threads.
+   *
+   * @note The contiguous arrays are a copy of the entries of the
+   * constraints, in addition to the objects returned by get_lines(). A closed
+   * object therefore needs about twice as much memory for these entries as an
+   * open one; memory_consumption() includes both.
    */
   void
   close();
@@ -1171,6 +1181,11 @@ public:
    *
    * @note If this function is called with a parallel vector @p vec, then the
    * vector must not contain ghost elements.
+   *
+   * @note For sequential vectors, the constrained entries are computed in
+   * parallel on all available threads. This is possible because after
+   * close(), no constraint refers to another constrained degree of freedom,
+   * so every entry that is written is independent of all others.
    */
   template <class VectorType>
   void
@@ -1469,6 +1484,65 @@ private:
    */
   bool sorted;
 
+  /**
+   * A copy of the entries of the constraints in compressed row storage.
+   * close() fills these arrays in the same order as the (then sorted) @p lines
+   * array, i.e., the homogeneous part of the constraint stored in
+   * <code>lines[i]</code> consists of the columns and weights with indices in
+   * the half-open range <code>[row_starts[i], row_starts[i+1])</code>. The
+   * index and the inhomogeneity of each line are only stored in @p lines.
+   *
+   * The functions that apply the constraints to vectors, such as
+   * distribute() and the vector variants of distribute_local_to_global(),
+   * read from these arrays rather than from the ConstraintLine objects: the
+   * entries of all lines are then contiguous in memory instead of being
+   * scattered over as many small heap allocations as there are lines.
+   *
+   * The @p lines remain the primary storage, since get_lines() and
+   * get_constraint_entries() give access to the ConstraintLine objects and
+   * the functions that distribute local matrices and sparsity patterns
+   * work on them. These arrays hence trade additional memory for faster
+   * access in the functions above.
+   */
+  struct CompressedLines
+  {
+    /**
+     * The position of the first entry of each line in the @p columns and
+     * @p weights arrays, plus one element marking the end of the last line.
+     */
+    std::vector<size_type> row_starts;
+
+    /**
+     * The global indices of the degrees of freedom each line refers to.
+     */
+    std::vector<size_type> columns;
+
+    /**
+     * The weights of the entries stored in @p columns.
+     */
+    std::vector<number> weights;
+
+    /**
+     * Determine an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * The constraints in compressed row storage, valid once the object has
+   * been closed.
+   */
+  CompressedLines compressed_lines;
+
+  /**
+   * Fill the @p compressed_lines from the @p lines array. Called at the end
+   * of close().
+   */
+  void
+  compress_lines();
+
   /**
    * Internal function to calculate the index of line @p line_n in the vector
    * lines_cache using local_lines.
@@ -1587,6 +1661,7 @@ inline AffineConstraints<number>::AffineConstraints(
   , lines_cache(affine_constraints.lines_cache)
   , local_lines(affine_constraints.local_lines)
   , sorted(affine_constraints.sorted)
+  , compressed_lines(affine_constraints.compressed_lines)
 {}
 
 template <typename number>
@@ -1775,11 +1850,12 @@ AffineConstraints<number>::distribute_local_to_global(
     global_vector(index) += value;
   else
     {
-      const ConstraintLine &position =
-        lines[lines_cache[calculate_line_index(index)]];
-      for (size_type j = 0; j < position.entries.size(); ++j)
-        global_vector(position.entries[j].first) +=
-          value * position.entries[j].second;
+      const size_type line = lines_cache[calculate_line_index(index)];
+      for (size_type j = compressed_lines.row_starts[line];
+           j < compressed_lines.row_starts[line + 1];
+           ++j)
+        global_vector(compressed_lines.columns[j]) +=
+          value * compressed_lines.weights[j];
     }
 }
 
@@ -1804,12 +1880,14 @@ AffineConstraints<number>::distribute_local_to_global(
                                                  global_vector);
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          for (size_type j = 0; j < position.entries.size(); ++j)
+          const size_type line =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          for (size_type j = compressed_lines.row_starts[line];
+               j < compressed_lines.row_starts[line + 1];
+               ++j)
             internal::ElementAccess<VectorType>::add(
-              (*local_vector_begin) * position.entries[j].second,
-              position.entries[j].first,
+              (*local_vector_begin) * compressed_lines.weights[j],
+              compressed_lines.columns[j],
               global_vector);
         }
     }
@@ -1850,12 +1928,14 @@ AffineConstraints<number>::get_dof_values(
         *local_vector_begin = global_vector(*local_indices_begin);
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          typename VectorType::value_type value = position.inhomogeneity;
-          for (size_type j = 0; j < position.entries.size(); ++j)
-            value += (global_vector(position.entries[j].first) *
-                      position.entries[j].second);
+          const size_type line =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          typename VectorType::value_type value = lines[line].inhomogeneity;
+          for (size_type j = compressed_lines.row_starts[line];
+               j < compressed_lines.row_starts[line + 1];
+               ++j)
+            value += (global_vector(compressed_lines.columns[j]) *
+                      compressed_lines.weights[j]);
           *local_vector_begin = value;
         }
     }
@@ -17,6 +17,7 @@
 #define dealii_affine_constraints_templates_h
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -58,15 +59,29 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace AffineConstraintsImplementation
+  {
+    /**
+     * The number of constraint lines below which the loops over all lines in
+     * close() and distribute() are not split into several tasks.
+     */
+    const unsigned int minimum_parallel_grain_size = 512;
+  } // namespace AffineConstraintsImplementation
+} // namespace internal
+
+
 
 template <typename number>
 void
 AffineConstraints<number>::copy_from(const AffineConstraints<number> &other)
 {
-  lines       = other.lines;
-  lines_cache = other.lines_cache;
-  local_lines = other.local_lines;
-  sorted      = other.sorted;
+  lines            = other.lines;
+  lines_cache      = other.lines_cache;
+  local_lines      = other.local_lines;
+  sorted           = other.sorted;
+  compressed_lines = other.compressed_lines;
 }
 
 
@@ -102,6 +117,17 @@ AffineConstraints<number>::ConstraintLine::memory_consumption() const
 
 
 
+template <typename number>
+std::size_t
+AffineConstraints<number>::CompressedLines::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(row_starts) +
+          MemoryConsumption::memory_consumption(columns) +
+          MemoryConsumption::memory_consumption(weights));
+}
+
+
+
 template <typename number>
 const typename AffineConstraints<number>::LineRange
 AffineConstraints<number>::get_lines() const
@@ -329,18 +355,29 @@ AffineConstraints<number>::close()
       Assert(i == calculate_line_index(lines[lines_cache[i]].index),
              ExcInternalError());
 
-  // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
+  const unsigned int grain_size =
+    internal::AffineConstraintsImplementation::minimum_parallel_grain_size;
+
+  // first, strip zero entries, as we have to do that only once. here and in
+  // the following steps, every line is modified independently of all others,
+  // so we can work on chunks of lines in parallel
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [this](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        // first remove zero entries. that would mean that in the linear
+        // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times
+        // 0 appears. obviously, 0*something can be omitted
+        lines[l].entries.erase(
+          std::remove_if(lines[l].entries.begin(),
+                         lines[l].entries.end(),
+                         [](const std::pair<size_type, number> &p) {
+                           return p.second == number(0.);
+                         }),
+          lines[l].entries.end());
+    },
+    grain_size);
 
 
 
@@ -360,49 +397,89 @@ AffineConstraints<number>::close()
 
   // replace references to dofs that are themselves constrained. note that
   // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
+  // constrained to third ones, we have to repeat this until no chains of
+  // constraints are left
   //
-  // the iteration replaces references to constrained degrees of freedom by
+  // the expansion replaces references to constrained degrees of freedom by
   // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
   // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
   // twice. we will throw this duplicate out in the following step, where
   // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  size_type iteration = 0;
-  while (true)
-    {
-      bool chained_constraint_replaced = false;
+  // efficient. also, we have to do it only once, rather than after each
+  // replacement
+  //
+  // to be able to do this in parallel, the expansion of each line only
+  // reads the unresolved lines, and is written into separate arrays that
+  // replace the original entries once all lines are done. if a line does
+  // not refer to any constrained dof, it is left alone
+  std::vector<typename ConstraintLine::Entries> resolved_entries(lines.size());
+  std::vector<number>                           resolved_inhomogeneities(
+    lines.size());
+  // whether the line has been expanded. we use a char rather than a bool
+  // since different threads write to different elements
+  std::vector<unsigned char> line_was_resolved(lines.size(), 0);
+#ifdef DEBUG
+  std::vector<unsigned char> cycle_detected(lines.size(), 0);
+#endif
 
-      for (ConstraintLine &line : lines)
+  // an entry needs to be replaced if it is constrained itself. ignore
+  // elements that we don't store on the current processor
+  const auto is_chained = [this](const size_type dof_index) {
+    return (((local_lines.size() == 0) ||
+             (local_lines.is_element(dof_index))) &&
+            is_constrained(dof_index));
+  };
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
         {
+          const ConstraintLine &line = lines[l];
+
+          bool has_chains = false;
+          for (const std::pair<size_type, number> &entry : line.entries)
+            if (is_chained(entry.first))
+              {
+                has_chains = true;
+                break;
+              }
+          if (has_chains == false)
+            continue;
+
+          typename ConstraintLine::Entries &entries = resolved_entries[l];
+          number &inhomogeneity = resolved_inhomogeneities[l];
+          entries                = line.entries;
+          inhomogeneity          = line.inhomogeneity;
+          line_was_resolved[l]   = 1;
+
 #ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line,
-          // because we can end up in a cycle A->B->C->A without the number of
-          // entries growing.
+          // we need to keep track of how many replacements we do in this
+          // line, because we can end up in a cycle A->B->C->A without the
+          // number of entries growing.
           size_type n_replacements = 0;
 #endif
 
           // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
+          // have appended in this go around)
           size_type entry = 0;
-          while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
+          while (entry < entries.size())
+            if (is_chained(entries[entry].first))
               {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
-
                 // look up the chain of constraints for this entry
-                const size_type dof_index = line.entries[entry].first;
-                const number    weight    = line.entries[entry].second;
+                const size_type dof_index = entries[entry].first;
+                const number    weight    = entries[entry].second;
 
-                Assert(dof_index != line.index,
-                       ExcMessage("Cycle in constraints detected!"));
+#ifdef DEBUG
+                // we can not throw an exception from within a task, so note
+                // the cycle and report it once all lines are done
+                if (dof_index == line.index)
+                  {
+                    cycle_detected[l] = 1;
+                    break;
+                  }
+#endif
 
                 const ConstraintLine &constrained_line =
                   lines[lines_cache[calculate_line_index(dof_index)]];
@@ -418,32 +495,37 @@ AffineConstraints<number>::close()
                 // of other dofs:
                 if (constrained_line.entries.size() > 0)
                   {
+#ifdef DEBUG
                     for (size_type i = 0; i < constrained_line.entries.size();
                          ++i)
-                      Assert(dof_index != constrained_line.entries[i].first,
-                             ExcMessage("Cycle in constraints detected!"));
+                      if (dof_index == constrained_line.entries[i].first)
+                        cycle_detected[l] = 1;
+                    if (cycle_detected[l] == 1)
+                      break;
+#endif
 
                     // replace first entry, then tack the rest to the end
                     // of the list
-                    line.entries[entry] = std::pair<size_type, number>(
+                    entries[entry] = std::pair<size_type, number>(
                       constrained_line.entries[0].first,
                       constrained_line.entries[0].second * weight);
 
                     for (size_type i = 1; i < constrained_line.entries.size();
                          ++i)
-                      line.entries.emplace_back(
-                        constrained_line.entries[i].first,
-                        constrained_line.entries[i].second * weight);
+                      entries.emplace_back(constrained_line.entries[i].first,
+                                           constrained_line.entries[i].second *
+                                             weight);
 
 #ifdef DEBUG
                     // keep track of how many entries we replace in this
                     // line. If we do more than there are constraints or
                     // dofs in our system, we must have a cycle.
                     ++n_replacements;
-                    Assert(n_replacements / 2 < largest_idx,
-                           ExcMessage("Cycle in constraints detected!"));
                     if (n_replacements / 2 >= largest_idx)
-                      return; // this enables us to test for this Exception.
+                      {
+                        cycle_detected[l] = 1;
+                        break;
+                      }
 #endif
                   }
                 else
@@ -453,10 +535,10 @@ AffineConstraints<number>::close()
                   // empty). in that case, we can't just overwrite the
                   // current entry, but we have to actually eliminate it
                   {
-                    line.entries.erase(line.entries.begin() + entry);
+                    entries.erase(entries.begin() + entry);
                   }
 
-                line.inhomogeneity += constrained_line.inhomogeneity * weight;
+                inhomogeneity += constrained_line.inhomogeneity * weight;
 
                 // now that we're here, do not increase index by one but
                 // rather make another pass for the present entry because
@@ -468,106 +550,121 @@ AffineConstraints<number>::close()
               // entry not further constrained. just move ahead by one
               ++entry;
         }
+    },
+    grain_size);
 
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
+#ifdef DEBUG
+  for (size_type l = 0; l < lines.size(); ++l)
+    if (cycle_detected[l] == 1)
+      {
+        Assert(false, ExcMessage("Cycle in constraints detected!"));
+        return; // this enables us to test for this Exception.
+      }
+#endif
 
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size(), ExcInternalError());
-    }
+  for (size_type l = 0; l < lines.size(); ++l)
+    if (line_was_resolved[l] == 1)
+      {
+        lines[l].entries.swap(resolved_entries[l]);
+        lines[l].inhomogeneity = resolved_inhomogeneities[l];
+      }
+  std::vector<typename ConstraintLine::Entries>().swap(resolved_entries);
 
   // finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
   // entries might have had zero weights, we replace them by a vector with
   // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
-        {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
-            {
-              // otherwise, we need to go through the list by and and
-              // resolve the duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
-
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+  const auto sort_and_merge_entries = [](ConstraintLine &line) {
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<size_type, number> &a,
+                 const std::pair<size_type, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // loop over the now sorted list and see whether any of the entries
+    // references the same dofs more than once in order to find how many
+    // non-duplicate entries we have. This lets us allocate the correct
+    // amount of memory for the constraint entries.
+    size_type duplicates = 0;
+    for (size_type i = 1; i < line.entries.size(); ++i)
+      if (line.entries[i].first == line.entries[i - 1].first)
+        duplicates++;
+
+    if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+      {
+        typename ConstraintLine::Entries new_entries;
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+        // if we have no duplicates, copy verbatim the entries. this way,
+        // the final size is of the vector is correct.
+        if (duplicates == 0)
+          new_entries = line.entries;
+        else
+          {
+            // otherwise, we need to go through the list by and and
+            // resolve the duplicates
+            new_entries.reserve(line.entries.size() - duplicates);
+            new_entries.push_back(line.entries[0]);
+            for (size_type j = 1; j < line.entries.size(); ++j)
+              if (line.entries[j].first == line.entries[j - 1].first)
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
+                  Assert(new_entries.back().first == line.entries[j].first,
                          ExcInternalError());
+                  new_entries.back().second += line.entries[j].second;
                 }
-            }
+              else
+                new_entries.push_back(line.entries[j]);
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
+            Assert(new_entries.size() == line.entries.size() - duplicates,
+                   ExcInternalError());
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+            // make sure there are really no duplicates left and that the
+            // list is still sorted
+            for (size_type j = 1; j < new_entries.size(); ++j)
+              {
+                Assert(new_entries[j].first != new_entries[j - 1].first,
+                       ExcInternalError());
+                Assert(new_entries[j].first > new_entries[j - 1].first,
+                       ExcInternalError());
+              }
+          }
+
+        // replace old list of constraints for this dof by the new one
+        line.entries.swap(new_entries);
+      }
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        sort_and_merge_entries(lines[l]);
+    },
+    grain_size);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -584,11 +681,52 @@ AffineConstraints<number>::close()
         }
 #endif
 
+  compress_lines();
+
   sorted = true;
 }
 
 
 
+template <typename number>
+void
+AffineConstraints<number>::compress_lines()
+{
+  const size_type n_lines = lines.size();
+
+  compressed_lines.row_starts.resize(n_lines + 1);
+  compressed_lines.row_starts[0] = 0;
+  for (size_type l = 0; l < n_lines; ++l)
+    compressed_lines.row_starts[l + 1] =
+      compressed_lines.row_starts[l] + lines[l].entries.size();
+
+  // give all arrays sharp sizes, since close() may be called again after
+  // merging other constraints into this object
+  std::vector<size_type>(compressed_lines.row_starts[n_lines])
+    .swap(compressed_lines.columns);
+  std::vector<number>(compressed_lines.row_starts[n_lines])
+    .swap(compressed_lines.weights);
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_lines,
+    [this](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        {
+          size_type index = compressed_lines.row_starts[l];
+          for (const std::pair<size_type, number> &entry : lines[l].entries)
+            {
+              compressed_lines.columns[index] = entry.first;
+              compressed_lines.weights[index] = entry.second;
+              ++index;
+            }
+        }
+    },
+    internal::AffineConstraintsImplementation::minimum_parallel_grain_size);
+}
+
+
+
 template <typename number>
 void
 AffineConstraints<number>::merge(
@@ -753,6 +891,8 @@ AffineConstraints<number>::shift(const size_type offset)
       for (std::pair<size_type, number> &entry : line.entries)
         entry.first += offset;
     }
+  for (size_type &column : compressed_lines.columns)
+    column += offset;
 
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
@@ -780,6 +920,11 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  {
+    CompressedLines tmp;
+    std::swap(compressed_lines, tmp);
+  }
+
   sorted = false;
 }
 
@@ -943,7 +1088,8 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          compressed_lines.memory_consumption());
 }
 
 
@@ -2024,12 +2170,12 @@ AffineConstraints<number>::distribute_local_to_global(
           calculate_line_index(local_dof_indices_col[i]);
         AssertIndexRange(line_index, lines_cache.size());
         AssertIndexRange(lines_cache[line_index], lines.size());
-        const ConstraintLine &position = lines[lines_cache[line_index]];
+        const size_type line = lines_cache[line_index];
 
         // Gauss elimination of the matrix columns with the inhomogeneity.
         // Go through them one by one and again check whether they are
         // constrained. If so, distribute the constraint
-        const auto val = position.inhomogeneity;
+        const auto val = lines[line].inhomogeneity;
         if (val != number(0.))
           for (size_type j = 0; j < m_local_dofs; ++j)
             {
@@ -2045,19 +2191,20 @@ AffineConstraints<number>::distribute_local_to_global(
               if (matrix_entry == number())
                 continue;
 
-              const ConstraintLine &position_j =
-                lines[lines_cache[calculate_line_index(
-                  local_dof_indices_row[j])]];
+              const size_type line_j =
+                lines_cache[calculate_line_index(local_dof_indices_row[j])];
 
-              for (size_type q = 0; q < position_j.entries.size(); ++q)
+              for (size_type q = compressed_lines.row_starts[line_j];
+                   q < compressed_lines.row_starts[line_j + 1];
+                   ++q)
                 {
                   Assert(!(!local_lines.size() ||
                            local_lines.is_element(
-                             position_j.entries[q].first)) ||
-                           is_constrained(position_j.entries[q].first) == false,
+                             compressed_lines.columns[q])) ||
+                           is_constrained(compressed_lines.columns[q]) == false,
                          ExcMessage("Tried to distribute to a fixed dof."));
-                  global_vector(position_j.entries[q].first) -=
-                    val * position_j.entries[q].second * matrix_entry;
+                  global_vector(compressed_lines.columns[q]) -=
+                    val * compressed_lines.weights[q] * matrix_entry;
                 }
             }
 
@@ -2066,14 +2213,16 @@ AffineConstraints<number>::distribute_local_to_global(
         // the entries of fixed dofs
         if (diagonal)
           {
-            for (size_type j = 0; j < position.entries.size(); ++j)
+            for (size_type j = compressed_lines.row_starts[line];
+                 j < compressed_lines.row_starts[line + 1];
+                 ++j)
               {
                 Assert(!(!local_lines.size() ||
-                         local_lines.is_element(position.entries[j].first)) ||
-                         is_constrained(position.entries[j].first) == false,
+                         local_lines.is_element(compressed_lines.columns[j])) ||
+                         is_constrained(compressed_lines.columns[j]) == false,
                        ExcMessage("Tried to distribute to a fixed dof."));
-                global_vector(position.entries[j].first) +=
-                  local_vector(i) * position.entries[j].second;
+                global_vector(compressed_lines.columns[j]) +=
+                  local_vector(i) * compressed_lines.weights[j];
               }
           }
       }
@@ -2226,11 +2375,13 @@ AffineConstraints<number>::distribute(VectorType &vec) const
       // following.
       IndexSet needed_elements = vec_owned_elements;
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          for (const std::pair<size_type, number> &entry : line.entries)
-            if (!vec_owned_elements.is_element(entry.first))
-              needed_elements.add_index(entry.first);
+      for (size_type l = 0; l < lines.size(); ++l)
+        if (vec_owned_elements.is_element(lines[l].index))
+          for (size_type j = compressed_lines.row_starts[l];
+               j < compressed_lines.row_starts[l + 1];
+               ++j)
+            if (!vec_owned_elements.is_element(compressed_lines.columns[j]))
+              needed_elements.add_index(compressed_lines.columns[j]);
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements(
@@ -2240,19 +2391,21 @@ AffineConstraints<number>::distribute(VectorType &vec) const
         ghosted_vector,
         std::integral_constant<bool, IsBlockVector<VectorType>::value>());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
+      for (size_type l = 0; l < lines.size(); ++l)
+        if (vec_owned_elements.is_element(lines[l].index))
           {
-            typename VectorType::value_type new_value = line.inhomogeneity;
-            for (const std::pair<size_type, number> &entry : line.entries)
+            typename VectorType::value_type new_value = lines[l].inhomogeneity;
+            for (size_type j = compressed_lines.row_starts[l];
+                 j < compressed_lines.row_starts[l + 1];
+                 ++j)
               new_value +=
                 (static_cast<typename VectorType::value_type>(
-                   internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                            entry.first)) *
-                 entry.second);
+                   internal::ElementAccess<VectorType>::get(
+                     ghosted_vector, compressed_lines.columns[j])) *
+                 compressed_lines.weights[j]);
             AssertIsFinite(new_value);
             internal::ElementAccess<VectorType>::set(new_value,
-                                                     line.index,
+                                                     lines[l].index,
                                                      vec);
           }
 
@@ -2267,25 +2420,35 @@ AffineConstraints<number>::distribute(VectorType &vec) const
     // purely sequential vector (either because the type doesn't
     // support anything else or because it's completely stored
     // locally)
+    //
+    // since no constraint refers to a constrained dof after close(), the
+    // entries we read are never written to, and we can work on chunks of
+    // lines in parallel
     {
-      for (const ConstraintLine &next_constraint : lines)
-        {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
-          AssertIsFinite(new_value);
-          internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
-                                                   vec);
-        }
+      parallel::apply_to_subranges(
+        size_type(0),
+        lines.size(),
+        [this, &vec](const size_type begin, const size_type end) {
+          for (size_type l = begin; l < end; ++l)
+            {
+              // fill entry in line lines[l].index by adding the
+              // different contributions
+              typename VectorType::value_type new_value =
+                lines[l].inhomogeneity;
+              for (size_type j = compressed_lines.row_starts[l];
+                   j < compressed_lines.row_starts[l + 1];
+                   ++j)
+                new_value += (static_cast<typename VectorType::value_type>(
+                                internal::ElementAccess<VectorType>::get(
+                                  vec, compressed_lines.columns[j])) *
+                              compressed_lines.weights[j]);
+              AssertIsFinite(new_value);
+              internal::ElementAccess<VectorType>::set(
+                new_value, lines[l].index, vec);
+            }
+        },
+        internal::AffineConstraintsImplementation::
+          minimum_parallel_grain_size);
     }
 }
 
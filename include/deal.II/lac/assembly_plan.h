@@ -0,0 +1,781 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_assembly_plan_h
+#define dealii_assembly_plan_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace AssemblyPlanImplementation
+  {
+    /**
+     * Add @p value to @p destination in a way that is safe if other threads
+     * concurrently add to the same memory location. Uses a compare-and-swap
+     * loop where the compiler provides the respective builtins, and a lock
+     * from a fixed set of mutexes selected by the address otherwise.
+     */
+    template <typename number>
+    inline void
+    atomic_add(number &destination, const number value)
+    {
+#if defined(__GNUC__)
+      number expected, desired;
+      __atomic_load(&destination, &expected, __ATOMIC_RELAXED);
+      do
+        desired = expected + value;
+      while (!__atomic_compare_exchange(&destination,
+                                        &expected,
+                                        &desired,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
+#else
+      static Threads::Mutex mutexes[256];
+      Threads::Mutex::ScopedLock lock(
+        mutexes[(reinterpret_cast<std::size_t>(&destination) /
+                 sizeof(number)) %
+                256]);
+      destination += value;
+#endif
+    }
+
+
+
+    /**
+     * Add to a matrix or vector entry, either exclusively or concurrently.
+     */
+    template <typename number>
+    inline void
+    add(number &destination, const number value, std::false_type)
+    {
+      destination += value;
+    }
+
+    template <typename number>
+    inline void
+    add(number &destination, const number value, std::true_type)
+    {
+      atomic_add(destination, value);
+    }
+
+
+
+    /**
+     * Add to the entry @p index of @p vector, either exclusively or
+     * concurrently. Concurrent access requires that the access operator of
+     * the vector returns a reference to the element.
+     */
+    template <typename VectorType>
+    inline void
+    add_vector_entry(VectorType &                          vector,
+                     const types::global_dof_index         index,
+                     const typename VectorType::value_type value,
+                     std::false_type)
+    {
+      vector(index) += value;
+    }
+
+    template <typename VectorType>
+    inline typename std::enable_if<std::is_same<
+      decltype(std::declval<VectorType &>()(types::global_dof_index())),
+      typename VectorType::value_type &>::value>::type
+    add_vector_entry(VectorType &                          vector,
+                     const types::global_dof_index         index,
+                     const typename VectorType::value_type value,
+                     std::true_type)
+    {
+      atomic_add(vector(index), value);
+    }
+
+    template <typename VectorType>
+    inline typename std::enable_if<!std::is_same<
+      decltype(std::declval<VectorType &>()(types::global_dof_index())),
+      typename VectorType::value_type &>::value>::type
+    add_vector_entry(VectorType &,
+                     const types::global_dof_index,
+                     const typename VectorType::value_type,
+                     std::true_type)
+    {
+      AssertThrow(false,
+                  ExcMessage("Concurrent access is only supported for "
+                             "vectors that give direct access to their "
+                             "elements."));
+    }
+  } // namespace AssemblyPlanImplementation
+} // namespace internal
+
+/*! @addtogroup constraints
+ *@{
+ */
+
+/**
+ * A precomputed description of how the local matrices and vectors of a fixed
+ * set of cells are written into a global SparseMatrix and a global vector,
+ * including the resolution of constraints.
+ *
+ * AffineConstraints::distribute_local_to_global() has to find out, for every
+ * cell and every assembly, which global rows are touched, how constrained
+ * degrees of freedom are resolved, and where in the rows of the sparse
+ * matrix the columns are stored. When the mesh, the degrees of freedom, the
+ * constraints and the sparsity pattern stay the same over many assemblies,
+ * as in Newton iterations or time stepping loops, all of this work gives the
+ * same answer every time. This class does it once in reinit() and stores,
+ * for every cell, the positions in the value array of the matrix that each
+ * entry of the local matrix contributes to, together with the weights that
+ * result from the constraints. The distribute_local_to_global() functions of
+ * this class then reduce to an indirect scatter without any searches.
+ *
+ * The result of the functions of this class is the same as the one of the
+ * respective functions of AffineConstraints with a single vector of local
+ * indices, including the treatment of the diagonal entries of constrained
+ * rows and of inhomogeneities.
+ *
+ * Cells are identified by an index in the range of the vector of local
+ * degree of freedom indices given to reinit(). The natural choice is the
+ * active cell index:
+ * @code
+ *   std::vector<std::vector<types::global_dof_index>> cell_dof_indices(
+ *     triangulation.n_active_cells());
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       cell_dof_indices[cell->active_cell_index()].resize(
+ *         cell->get_fe().dofs_per_cell);
+ *       cell->get_dof_indices(cell_dof_indices[cell->active_cell_index()]);
+ *     }
+ *   AssemblyPlan<double> plan;
+ *   plan.reinit(cell_dof_indices, constraints, sparsity_pattern);
+ *
+ *   // in each assembly:
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       ... compute cell_matrix and cell_rhs ...
+ *       plan.distribute_local_to_global(cell->active_cell_index(),
+ *                                       cell_matrix,
+ *                                       cell_rhs,
+ *                                       system_matrix,
+ *                                       system_rhs);
+ *     }
+ * @endcode
+ *
+ * The inhomogeneities of the constraints are read from the AffineConstraints
+ * object at the time of the scatter, so they may change between assemblies
+ * (e.g., for time dependent boundary values) as long as the set of
+ * constrained degrees of freedom and the entries of the constraints stay the
+ * same. Any other change of the constraints, the degrees of freedom or the
+ * sparsity pattern requires calling reinit() again.
+ *
+ * <h3>Thread safety</h3>
+ *
+ * The plan is not modified by the distribute_local_to_global() functions,
+ * so they can be called concurrently on the same object. As for
+ * AffineConstraints::distribute_local_to_global(), concurrent calls are
+ * only safe if they do not write into the same rows of the global objects.
+ * This is guaranteed when using WorkStream::run() with a graph coloring of
+ * the cells as computed by GraphColoring::make_graph_coloring(). The setup
+ * in reinit() is done in parallel over the cells.
+ *
+ * Alternatively, set_access_mode() with the argument
+ * AccessMode::concurrent_access switches to adding every entry with an
+ * atomic operation. Then the distribute_local_to_global() functions may be
+ * called concurrently for arbitrary cells, e.g., from the worker function
+ * of WorkStream::run() without a copier, or from a copier that runs
+ * concurrently with other copiers. This avoids both the serialization of
+ * the copier in WorkStream and the setup cost and reduced parallelism of a
+ * graph coloring, at the price of a more expensive addition of each entry:
+ * on a single thread, adding the local matrices of Q2 elements this way
+ * takes between two and four times as long as in the default mode.
+ * Processing the cells color by color in the default mode costs about as
+ * much, because the cells of one color are far apart in memory, and
+ * computing the coloring itself takes longer than the additions. Whether
+ * the concurrent mode pays off therefore depends on the number of threads
+ * and on how expensive the cell integrals are compared to the additions.
+ * Concurrent access to vectors requires
+ * that their access operator returns a reference to the element, as is the
+ * case for Vector, BlockVector and LinearAlgebra::distributed::Vector.
+ * Note that the order in which the contributions are added, and hence the
+ * result up to roundoff, may differ from run to run in this mode.
+ *
+ * @author Agent, 2026
+ */
+template <typename number = double>
+class AssemblyPlan : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The ways the global matrix and vector can be accessed by the
+   * distribute_local_to_global() functions, see the general documentation
+   * of this class.
+   */
+  enum AccessMode
+  {
+    /**
+     * Entries are added with ordinary additions. Concurrent calls must
+     * write into disjoint rows.
+     */
+    exclusive_access,
+    /**
+     * Entries are added atomically, so concurrent calls may write into the
+     * same rows.
+     */
+    concurrent_access
+  };
+
+  /**
+   * Constructor. Leaves the object empty.
+   */
+  AssemblyPlan();
+
+  /**
+   * Compute the plan for the cells whose global degrees of freedom are given
+   * by the elements of @p cell_dof_indices, for writing into matrices based
+   * on the given sparsity pattern. As for
+   * AffineConstraints::distribute_local_to_global(), the sparsity pattern
+   * must contain all entries that nonzero entries of the local matrices
+   * contribute to, as is the case if it has been built by
+   * DoFTools::make_sparsity_pattern() with the same constraints object and,
+   * possibly, a coupling table that masks out blocks in which the local
+   * matrices are zero. Contributions to entries that are not part of the
+   * pattern are skipped.
+   *
+   * Both @p constraints and @p sparsity must live as long as the plan is
+   * used; the constraints object must be closed.
+   */
+  void
+  reinit(const std::vector<std::vector<size_type>> &cell_dof_indices,
+         const AffineConstraints<number> &          constraints,
+         const SparsityPattern &                    sparsity);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of cells the plan has been set up for.
+   */
+  unsigned int
+  n_cells() const;
+
+  /**
+   * Select how the distribute_local_to_global() functions write into the
+   * global objects. The default is AccessMode::exclusive_access. The setting
+   * is kept by reinit() and clear().
+   */
+  void
+  set_access_mode(const AccessMode mode);
+
+  /**
+   * Return the current access mode.
+   */
+  AccessMode
+  get_access_mode() const;
+
+  /**
+   * Add the local matrix @p local_matrix of cell @p cell to
+   * @p global_matrix. This is equivalent to calling
+   * AffineConstraints::distribute_local_to_global() with the local matrix
+   * and the degree of freedom indices the plan has been set up with for this
+   * cell.
+   */
+  void
+  distribute_local_to_global(const unsigned int        cell,
+                             const FullMatrix<number> &local_matrix,
+                             SparseMatrix<number> &    global_matrix) const;
+
+  /**
+   * Add the local vector @p local_vector of cell @p cell to
+   * @p global_vector, resolving constraints. This is equivalent to calling
+   * AffineConstraints::distribute_local_to_global() with a local vector
+   * only, i.e., inhomogeneities are not taken into account.
+   */
+  template <typename VectorType>
+  void
+  distribute_local_to_global(const unsigned int    cell,
+                             const Vector<number> &local_vector,
+                             VectorType &          global_vector) const;
+
+  /**
+   * Add the local matrix and vector of cell @p cell to the global matrix
+   * and vector, and account for inhomogeneous constraints by eliminating the
+   * respective columns of the local matrix into the vector. This is
+   * equivalent to the function of AffineConstraints with the same
+   * arguments, see there for the meaning of
+   * @p use_inhomogeneities_for_rhs.
+   */
+  template <typename VectorType>
+  void
+  distribute_local_to_global(
+    const unsigned int        cell,
+    const FullMatrix<number> &local_matrix,
+    const Vector<number> &    local_vector,
+    SparseMatrix<number> &    global_matrix,
+    VectorType &              global_vector,
+    const bool                use_inhomogeneities_for_rhs = false) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclException1(ExcCellNotInPlan,
+                 unsigned int,
+                 << "The cell with index " << arg1
+                 << " has not been part of the set of cells the plan has been "
+                 << "set up for.");
+
+  /**
+   * Exception
+   */
+  DeclException2(ExcEntryNotInSparsityPattern,
+                 unsigned int,
+                 unsigned int,
+                 << "The entry with index " << arg2
+                 << " (counting row by row) of the local matrix of the cell "
+                 << "with index " << arg1 << " is nonzero, but the sparsity "
+                 << "pattern does not contain an entry it contributes to.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsityPattern,
+                   "The plan has been set up for a sparsity pattern different "
+                   "from the one the given matrix is based on.");
+
+private:
+  /**
+   * Return the value AffineConstraints puts on the diagonal of the
+   * constrained local row @p row: the local diagonal entry if it is
+   * nonzero, the average of the absolute values of the local diagonal
+   * otherwise.
+   */
+  static number
+  constrained_diagonal(const FullMatrix<number> &local_matrix,
+                       const unsigned int        row,
+                       const number              average_diagonal);
+
+  /**
+   * Return the average of the absolute values of the diagonal of
+   * @p local_matrix.
+   */
+  static number
+  average_diagonal(const FullMatrix<number> &local_matrix);
+
+  /**
+   * Return the contribution of the inhomogeneities of the constrained
+   * degrees of freedom of the given cell to the right hand side entry of the
+   * local row @p local_row.
+   */
+  number
+  inhomogeneity_correction(const unsigned int        cell,
+                           const unsigned int        local_row,
+                           const FullMatrix<number> &local_matrix) const;
+
+  /**
+   * Implementation of the distribute_local_to_global() functions, for
+   * either of the access modes.
+   */
+  template <typename Concurrent>
+  void
+  distribute_matrix(const unsigned int        cell,
+                    const FullMatrix<number> &local_matrix,
+                    SparseMatrix<number> &    global_matrix,
+                    Concurrent) const;
+
+  template <typename VectorType, typename Concurrent>
+  void
+  distribute_vector(const unsigned int        cell,
+                    const FullMatrix<number> *local_matrix,
+                    const Vector<number> &    local_vector,
+                    VectorType &              global_vector,
+                    const bool                use_inhomogeneities_for_rhs,
+                    Concurrent) const;
+
+  /**
+   * Check that the plan is set up for @p cell and @p global_matrix.
+   */
+  void
+  check_arguments(const unsigned int          cell,
+                  const unsigned int          n_local_dofs,
+                  const SparseMatrix<number> &global_matrix) const;
+
+  /**
+   * The access mode used by the distribute_local_to_global() functions.
+   */
+  AccessMode access_mode;
+
+  /**
+   * The constraints the plan has been computed for.
+   */
+  SmartPointer<const AffineConstraints<number>, AssemblyPlan<number>>
+    constraints;
+
+  /**
+   * The sparsity pattern the plan has been computed for.
+   */
+  SmartPointer<const SparsityPattern, AssemblyPlan<number>> sparsity;
+
+  /**
+   * The number of degrees of freedom of each cell.
+   */
+  std::vector<unsigned int> n_local_dofs;
+
+  /**
+   * Contributions of entries of the local matrix whose row and column are
+   * both unconstrained. For each cell, the range starting at
+   * <tt>direct_start[cell]</tt> lists the position in the value array of
+   * the sparse matrix and the index into the row-wise stored local matrix.
+   * For cells without constraints, these are all the contributions. The
+   * position is SparsityPattern::invalid_entry for entries that are not
+   * part of the sparsity pattern.
+   */
+  std::vector<std::size_t> direct_start;
+  std::vector<std::size_t> direct_positions;
+  std::vector<unsigned int> direct_entries;
+
+  /**
+   * Contributions of entries of the local matrix in rows or columns of
+   * constrained degrees of freedom, stored in the same way as the direct
+   * contributions but with an additional weight that is the product of the
+   * constraint coefficients of the row and the column.
+   */
+  std::vector<std::size_t> indirect_start;
+  std::vector<std::size_t> indirect_positions;
+  std::vector<unsigned int> indirect_entries;
+  std::vector<number>       indirect_weights;
+
+  /**
+   * The constrained degrees of freedom of each cell: the local row, the
+   * global index, and the position of the diagonal entry in the value array
+   * of the sparse matrix.
+   */
+  std::vector<std::size_t>  constrained_start;
+  std::vector<unsigned int> constrained_rows;
+  std::vector<size_type>    constrained_dofs;
+  std::vector<std::size_t>  constrained_diagonals;
+
+  /**
+   * Contributions of the local vector: the global index, the local row and
+   * the weight from the constraints (one for unconstrained rows).
+   */
+  std::vector<std::size_t>  vector_start;
+  std::vector<size_type>    vector_indices;
+  std::vector<unsigned int> vector_rows;
+  std::vector<number>       vector_weights;
+};
+
+/*@}*/
+/*---------------------- Inline functions -----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename number>
+inline unsigned int
+AssemblyPlan<number>::n_cells() const
+{
+  return n_local_dofs.size();
+}
+
+
+
+template <typename number>
+inline void
+AssemblyPlan<number>::set_access_mode(const AccessMode mode)
+{
+  access_mode = mode;
+}
+
+
+
+template <typename number>
+inline typename AssemblyPlan<number>::AccessMode
+AssemblyPlan<number>::get_access_mode() const
+{
+  return access_mode;
+}
+
+
+
+template <typename number>
+inline void
+AssemblyPlan<number>::check_arguments(
+  const unsigned int          cell,
+  const unsigned int          n_dofs,
+  const SparseMatrix<number> &global_matrix) const
+{
+  (void)cell;
+  (void)n_dofs;
+  (void)global_matrix;
+  Assert(cell < n_cells(), ExcCellNotInPlan(cell));
+  AssertDimension(n_dofs, n_local_dofs[cell]);
+  Assert(&global_matrix.get_sparsity_pattern() == &*sparsity,
+         ExcDifferentSparsityPattern());
+}
+
+
+
+template <typename number>
+inline number
+AssemblyPlan<number>::average_diagonal(const FullMatrix<number> &local_matrix)
+{
+  number average = number();
+  for (unsigned int i = 0; i < local_matrix.m(); ++i)
+    average += std::abs(local_matrix(i, i));
+  return average / static_cast<number>(local_matrix.m());
+}
+
+
+
+template <typename number>
+inline number
+AssemblyPlan<number>::constrained_diagonal(
+  const FullMatrix<number> &local_matrix,
+  const unsigned int        row,
+  const number              average_diagonal)
+{
+  return (std::abs(local_matrix(row, row)) != 0. ?
+            std::abs(local_matrix(row, row)) :
+            average_diagonal);
+}
+
+
+
+template <typename number>
+inline number
+AssemblyPlan<number>::inhomogeneity_correction(
+  const unsigned int        cell,
+  const unsigned int        local_row,
+  const FullMatrix<number> &local_matrix) const
+{
+  number correction = number();
+  for (std::size_t k = constrained_start[cell];
+       k < constrained_start[cell + 1];
+       ++k)
+    {
+      const number inhomogeneity =
+        constraints->get_inhomogeneity(constrained_dofs[k]);
+      if (inhomogeneity != number())
+        correction += local_matrix(local_row, constrained_rows[k]) *
+                      inhomogeneity;
+    }
+  return correction;
+}
+
+
+
+template <typename number>
+template <typename Concurrent>
+inline void
+AssemblyPlan<number>::distribute_matrix(const unsigned int        cell,
+                                        const FullMatrix<number> &local_matrix,
+                                        SparseMatrix<number> &    global_matrix,
+                                        Concurrent) const
+{
+  using internal::AssemblyPlanImplementation::add;
+
+  check_arguments(cell, local_matrix.m(), global_matrix);
+  AssertDimension(local_matrix.n(), local_matrix.m());
+  if (local_matrix.m() == 0)
+    return;
+
+  number *const       values = global_matrix.val.get();
+  const number *const local  = &local_matrix(0, 0);
+
+  for (std::size_t k = direct_start[cell]; k < direct_start[cell + 1]; ++k)
+    if (direct_positions[k] != SparsityPattern::invalid_entry)
+      add(values[direct_positions[k]], local[direct_entries[k]], Concurrent());
+    else
+      Assert(local[direct_entries[k]] == number(),
+             ExcEntryNotInSparsityPattern(cell, direct_entries[k]));
+
+  for (std::size_t k = indirect_start[cell]; k < indirect_start[cell + 1];
+       ++k)
+    if (indirect_positions[k] != SparsityPattern::invalid_entry)
+      add(values[indirect_positions[k]],
+          indirect_weights[k] * local[indirect_entries[k]],
+          Concurrent());
+    else
+      Assert(indirect_weights[k] * local[indirect_entries[k]] == number(),
+             ExcEntryNotInSparsityPattern(cell, indirect_entries[k]));
+
+  if (constrained_start[cell + 1] > constrained_start[cell])
+    {
+      const number average = average_diagonal(local_matrix);
+      for (std::size_t k = constrained_start[cell];
+           k < constrained_start[cell + 1];
+           ++k)
+        add(values[constrained_diagonals[k]],
+            constrained_diagonal(local_matrix, constrained_rows[k], average),
+            Concurrent());
+    }
+}
+
+
+
+template <typename number>
+template <typename VectorType, typename Concurrent>
+inline void
+AssemblyPlan<number>::distribute_vector(
+  const unsigned int        cell,
+  const FullMatrix<number> *local_matrix,
+  const Vector<number> &    local_vector,
+  VectorType &              global_vector,
+  const bool                use_inhomogeneities_for_rhs,
+  Concurrent) const
+{
+  using internal::AssemblyPlanImplementation::add_vector_entry;
+  using value_type = typename VectorType::value_type;
+
+  Assert(cell < n_cells(), ExcCellNotInPlan(cell));
+  AssertDimension(local_vector.size(), n_local_dofs[cell]);
+
+  // inhomogeneities are only taken into account if a local matrix is given
+  const bool have_inhomogeneities =
+    local_matrix != nullptr &&
+    constrained_start[cell + 1] > constrained_start[cell] &&
+    constraints->has_inhomogeneities();
+
+  for (std::size_t k = vector_start[cell]; k < vector_start[cell + 1]; ++k)
+    {
+      number value = local_vector(vector_rows[k]);
+      if (have_inhomogeneities)
+        value -=
+          inhomogeneity_correction(cell, vector_rows[k], *local_matrix);
+      add_vector_entry(global_vector,
+                       vector_indices[k],
+                       static_cast<value_type>(vector_weights[k] * value),
+                       Concurrent());
+    }
+
+  if (use_inhomogeneities_for_rhs && have_inhomogeneities)
+    {
+      const number average = average_diagonal(*local_matrix);
+      for (std::size_t k = constrained_start[cell];
+           k < constrained_start[cell + 1];
+           ++k)
+        add_vector_entry(
+          global_vector,
+          constrained_dofs[k],
+          static_cast<value_type>(
+            constrained_diagonal(*local_matrix, constrained_rows[k], average) *
+            constraints->get_inhomogeneity(constrained_dofs[k])),
+          Concurrent());
+    }
+}
+
+
+
+template <typename number>
+inline void
+AssemblyPlan<number>::distribute_local_to_global(
+  const unsigned int        cell,
+  const FullMatrix<number> &local_matrix,
+  SparseMatrix<number> &    global_matrix) const
+{
+  if (access_mode == concurrent_access)
+    distribute_matrix(cell, local_matrix, global_matrix, std::true_type());
+  else
+    distribute_matrix(cell, local_matrix, global_matrix, std::false_type());
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+AssemblyPlan<number>::distribute_local_to_global(
+  const unsigned int    cell,
+  const Vector<number> &local_vector,
+  VectorType &          global_vector) const
+{
+  if (access_mode == concurrent_access)
+    distribute_vector(
+      cell, nullptr, local_vector, global_vector, false, std::true_type());
+  else
+    distribute_vector(
+      cell, nullptr, local_vector, global_vector, false, std::false_type());
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+AssemblyPlan<number>::distribute_local_to_global(
+  const unsigned int        cell,
+  const FullMatrix<number> &local_matrix,
+  const Vector<number> &    local_vector,
+  SparseMatrix<number> &    global_matrix,
+  VectorType &              global_vector,
+  const bool                use_inhomogeneities_for_rhs) const
+{
+  if (access_mode == concurrent_access)
+    {
+      distribute_matrix(cell, local_matrix, global_matrix, std::true_type());
+      distribute_vector(cell,
+                        &local_matrix,
+                        local_vector,
+                        global_vector,
+                        use_inhomogeneities_for_rhs,
+                        std::true_type());
+    }
+  else
+    {
+      distribute_matrix(cell, local_matrix, global_matrix, std::false_type());
+      distribute_vector(cell,
+                        &local_matrix,
+                        local_vector,
+                        global_vector,
+                        use_inhomogeneities_for_rhs,
+                        std::false_type());
+    }
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,494 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_amg_h
+#define dealii_precondition_amg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Preconditioners
+ *@{
+ */
+
+/**
+ * An algebraic multigrid preconditioner based on smoothed aggregation that
+ * works directly on SparseMatrix objects. In contrast to
+ * TrilinosWrappers::PreconditionAMG and PETScWrappers::PreconditionBoomerAMG,
+ * this class does not need any external library and is hence also available
+ * in serial or purely thread-parallel builds of deal.II.
+ *
+ *
+ * <h3>Setup</h3>
+ *
+ * The hierarchy of coarser operators is built by repeating the following
+ * steps until either the matrix has no more than
+ * AdditionalData::coarse_size rows, the maximal number of levels is reached,
+ * or no further coarsening is possible:
+ * <ol>
+ * <li> Compute the strength-of-connection graph: an off-diagonal entry
+ * $a_{ij}$ is considered strong if $|a_{ij}| \geq \theta
+ * \sqrt{|a_{ii}a_{jj}|}$ with $\theta$ given by
+ * AdditionalData::aggregation_threshold.
+ * <li> Form aggregates of strongly connected rows. The rows are split into
+ * chunks of AdditionalData::aggregation_chunk_size consecutive indices that
+ * are aggregated independently of each other (sometimes called decoupled
+ * aggregation). Since the chunks do not depend on the number of threads,
+ * the resulting hierarchy is the same for every thread count.
+ * <li> Build the tentative prolongator that interpolates the constant vector
+ * on each aggregate, and smooth it by one damped Jacobi step on the filtered
+ * matrix, $P = (I - \omega D_F^{-1} A_F) P_\text{tent}$. The damping
+ * parameter is $\omega = \frac{4}{3} / \rho(D_F^{-1} A_F)$ where the
+ * spectral radius is bounded by Gershgorin's theorem. The product is
+ * formed with SparseMatrix::mmult(), and the restriction $P^T$ with
+ * SparseMatrix::Tmmult().
+ * <li> Compute the Galerkin product $A_c = P^T A P$ using
+ * SparseMatrix::triple_mmult().
+ * </ol>
+ * The computation of the strength graph, the aggregation, the smoothed
+ * prolongator and the Galerkin product run in parallel on the threads
+ * available through MultithreadInfo. Since the constant vector is the only
+ * near-null space vector, this class is meant for scalar elliptic problems;
+ * for elasticity or other systems, the aggregates do not represent the
+ * rigid body modes.
+ *
+ *
+ * <h3>Application</h3>
+ *
+ * The vmult() function performs AdditionalData::n_cycles V-cycles. On all
+ * but the coarsest level, either a PreconditionChebyshev smoother or damped
+ * Jacobi iterations are applied before and after the coarse grid
+ * correction. If the coarsest level has at most
+ * AdditionalData::max_coarse_direct_size rows, it is solved by a dense
+ * $LDL^T$ factorization of the coarse matrix. Pivots that vanish up to
+ * round-off are skipped, so that singular coarse matrices such as those of
+ * problems with pure Neumann boundary conditions can be handled as well.
+ * Larger coarse levels, which occur if the coarsening stalls or
+ * AdditionalData::max_levels is small, are treated by two applications of
+ * the smoother instead, which avoids the quadratic memory and cubic time of
+ * the dense factorization. All other operations are matrix-vector products
+ * and vector updates which run in parallel.
+ *
+ * Since the V-cycle is symmetric, this class can be used as a preconditioner
+ * for SolverCG. It can also serve as a coarse grid solver in the Multigrid
+ * framework by wrapping it in an MGCoarseGridIterativeSolver:
+ * @code
+ * PreconditionAMG<double> amg;
+ * amg.initialize(coarse_matrix);
+ *
+ * SolverControl         coarse_control(1000, 1e-12);
+ * SolverCG<>            coarse_solver(coarse_control);
+ * MGCoarseGridIterativeSolver<Vector<double>,
+ *                             SolverCG<>,
+ *                             SparseMatrix<double>,
+ *                             PreconditionAMG<double>>
+ *   mg_coarse(coarse_solver, coarse_matrix, amg);
+ * @endcode
+ *
+ *
+ * <h3>Statistics</h3>
+ *
+ * The wall times spent in the different phases of the setup are available
+ * through get_setup_statistics(), the memory held by the hierarchy through
+ * memory_consumption(). The function print_statistics() writes both, along
+ * with the sizes of all levels, to a stream.
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>.
+ *
+ * @author Agent, 2026
+ */
+template <typename number = double>
+class PreconditionAMG : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The smoothers that can be applied on all but the coarsest level.
+   */
+  enum SmootherType
+  {
+    /**
+     * Damped Jacobi iterations with relaxation parameter
+     * AdditionalData::jacobi_relaxation.
+     */
+    jacobi,
+    /**
+     * A PreconditionChebyshev smoother with the eigenvalue range given by
+     * AdditionalData::smoothing_range.
+     */
+    chebyshev
+  };
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       aggregation_threshold  = 1e-4,
+                   const size_type    coarse_size            = 500,
+                   const unsigned int max_levels             = 20,
+                   const SmootherType smoother_type          = chebyshev,
+                   const unsigned int smoother_sweeps        = 2,
+                   const double       smoothing_range        = 20.,
+                   const double       jacobi_relaxation      = 0.6,
+                   const double       prolongator_damping    = 4. / 3.,
+                   const unsigned int n_cycles               = 1,
+                   const size_type    aggregation_chunk_size = 4096,
+                   const size_type    max_coarse_direct_size = 2000);
+
+    /**
+     * Threshold $\theta$ for the strength of connection between two rows.
+     */
+    double aggregation_threshold;
+
+    /**
+     * The coarsening stops as soon as a level has at most this many rows.
+     */
+    size_type coarse_size;
+
+    /**
+     * Maximal number of levels in the hierarchy, including the finest one.
+     */
+    unsigned int max_levels;
+
+    /**
+     * The smoother used on all but the coarsest level.
+     */
+    SmootherType smoother_type;
+
+    /**
+     * The number of smoothing sweeps before and after the coarse grid
+     * correction. For the Chebyshev smoother, this is the polynomial degree.
+     */
+    unsigned int smoother_sweeps;
+
+    /**
+     * The smoothing range handed to PreconditionChebyshev.
+     */
+    double smoothing_range;
+
+    /**
+     * The relaxation parameter of the Jacobi smoother.
+     */
+    double jacobi_relaxation;
+
+    /**
+     * The factor by which the inverse of the estimated spectral radius of
+     * $D_F^{-1}A_F$ is multiplied to obtain the damping parameter of the
+     * prolongator smoothing.
+     */
+    double prolongator_damping;
+
+    /**
+     * The number of V-cycles performed by each vmult() call.
+     */
+    unsigned int n_cycles;
+
+    /**
+     * Number of consecutive rows that are aggregated together by one task.
+     */
+    size_type aggregation_chunk_size;
+
+    /**
+     * The largest coarsest level that is solved by a dense factorization,
+     * which needs memory quadratic and time cubic in the number of rows.
+     * Coarsest levels with more rows are only smoothed.
+     */
+    size_type max_coarse_direct_size;
+  };
+
+  /**
+   * Wall times (in seconds) spent in the different phases of initialize().
+   */
+  struct SetupStatistics
+  {
+    /**
+     * Constructor. Sets all times to zero.
+     */
+    SetupStatistics();
+
+    /**
+     * Time spent computing the strength-of-connection graphs.
+     */
+    double strength_graph_time;
+
+    /**
+     * Time spent forming the aggregates.
+     */
+    double aggregation_time;
+
+    /**
+     * Time spent building the smoothed prolongators and their transposes.
+     */
+    double prolongator_time;
+
+    /**
+     * Time spent in the Galerkin products $P^T A P$.
+     */
+    double galerkin_time;
+
+    /**
+     * Time spent setting up the smoothers and factorizing the coarse matrix.
+     */
+    double smoother_time;
+
+    /**
+     * Total time spent in initialize().
+     */
+    double total_time;
+  };
+
+  /**
+   * Constructor. Does nothing.
+   *
+   * Call the @p initialize function before using this object as
+   * preconditioner.
+   */
+  PreconditionAMG() = default;
+
+  /**
+   * Build the multigrid hierarchy for the given matrix. The matrix must be
+   * symmetric and positive definite or semidefinite, with positive diagonal
+   * entries. A reference to it is kept for the finest level, so it must live
+   * longer than this object.
+   */
+  void
+  initialize(const SparseMatrix<number> &matrix,
+             const AdditionalData &      additional_data = AdditionalData());
+
+  /**
+   * Release all memory and reset this object to the state it had after the
+   * default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., perform AdditionalData::n_cycles
+   * V-cycles with a zero initial guess.
+   */
+  void
+  vmult(Vector<number> &dst, const Vector<number> &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner. Since the V-cycle is
+   * symmetric, this is the same as vmult().
+   */
+  void
+  Tvmult(Vector<number> &dst, const Vector<number> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of levels in the hierarchy, including the finest one.
+   */
+  unsigned int
+  n_levels() const;
+
+  /**
+   * Return the operator on the given level, where level zero is the matrix
+   * passed to initialize().
+   */
+  const SparseMatrix<number> &
+  get_level_matrix(const unsigned int level) const;
+
+  /**
+   * Return the prolongation matrix from level <tt>level+1</tt> to level
+   * <tt>level</tt>.
+   */
+  const SparseMatrix<number> &
+  get_prolongation_matrix(const unsigned int level) const;
+
+  /**
+   * Return the operator complexity, i.e., the number of nonzero entries in
+   * the matrices of all levels divided by the number of nonzero entries on
+   * the finest level.
+   */
+  double
+  operator_complexity() const;
+
+  /**
+   * Return the grid complexity, i.e., the number of rows of all levels
+   * divided by the number of rows on the finest level.
+   */
+  double
+  grid_complexity() const;
+
+  /**
+   * Return the timings of the last call to initialize().
+   */
+  const SetupStatistics &
+  get_setup_statistics() const;
+
+  /**
+   * Write the sizes of all levels, the complexities, the setup timings and
+   * the memory consumption to the given stream.
+   */
+  void
+  print_statistics(std::ostream &out) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object. The matrix on the finest level is owned by the caller and not
+   * counted.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * All data stored for one level of the hierarchy. The objects are only
+   * accessed through pointers, so the sparse matrices can safely point to
+   * the sparsity patterns stored next to them.
+   */
+  struct Level
+  {
+    /**
+     * Sparsity pattern and matrix of the operator on all but the finest
+     * level.
+     */
+    SparsityPattern      sparsity;
+    SparseMatrix<number> owned_matrix;
+
+    /**
+     * Pointer to the operator on this level, either to the matrix handed to
+     * initialize() or to @p owned_matrix.
+     */
+    SmartPointer<const SparseMatrix<number>, PreconditionAMG<number>> matrix;
+
+    /**
+     * Prolongation from the next coarser level to this one and its
+     * transpose. Empty on the coarsest level.
+     */
+    SparsityPattern      prolongation_sparsity;
+    SparseMatrix<number> prolongation;
+    SparsityPattern      restriction_sparsity;
+    SparseMatrix<number> restriction;
+
+    /**
+     * Smoother data.
+     */
+    PreconditionChebyshev<SparseMatrix<number>, Vector<number>> chebyshev;
+    Vector<number> inverse_diagonal;
+
+    /**
+     * Vectors used during the V-cycle.
+     */
+    mutable Vector<number> solution;
+    mutable Vector<number> rhs;
+    mutable Vector<number> residual;
+  };
+
+  /**
+   * Perform one V-cycle starting on the given level with a zero initial
+   * guess.
+   */
+  void
+  v_cycle(const unsigned int    level,
+          Vector<number> &      dst,
+          const Vector<number> &src) const;
+
+  /**
+   * Apply the smoother on the given level. If @p zero_start is true, the
+   * content of @p dst is ignored.
+   */
+  void
+  smooth(const unsigned int    level,
+         Vector<number> &      dst,
+         const Vector<number> &src,
+         const bool            zero_start) const;
+
+  /**
+   * The levels of the hierarchy, finest first.
+   */
+  std::vector<std::unique_ptr<Level>> levels;
+
+  /**
+   * Return whether the coarsest level is solved by the dense factorization
+   * stored in @p coarse_factorization rather than by smoothing.
+   */
+  bool
+  use_direct_coarse_solver() const;
+
+  /**
+   * The $LDL^T$ factorization of the matrix on the coarsest level: the
+   * strict lower triangle holds the unit lower triangular factor $L$, the
+   * diagonal holds $D$. Empty if the coarsest level is only smoothed.
+   */
+  FullMatrix<number> coarse_factorization;
+
+  /**
+   * A copy of the parameters passed to initialize().
+   */
+  AdditionalData data;
+
+  /**
+   * Timings of the last setup.
+   */
+  SetupStatistics statistics;
+
+  /**
+   * Temporary vectors on the finest level for more than one V-cycle.
+   */
+  mutable Vector<number> cycle_residual;
+  mutable Vector<number> cycle_correction;
+
+  /**
+   * A mutex to avoid that multiple vmult() invocations by different threads
+   * overwrite the temporary vectors.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+/*@}*/
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // dealii_precondition_amg_h
@@ -24,6 +24,7 @@
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix_ez.h>
 #include <deal.II/lac/vector.h>
@@ -138,11 +139,31 @@ public:
    * This function copies the contents of the matrix into its own storage; the
    * matrix can therefore be deleted after this operation, even if subsequent
    * solves are required.
+   *
+   * The symbolic factorization (i.e., the fill-reducing ordering and the
+   * analysis of the sparsity pattern) computed by this function is kept, so
+   * that matrices with the same sparsity pattern can later be factorized
+   * with refactorize(), which only computes a new numeric factorization.
    */
   template <class Matrix>
   void
   factorize(const Matrix &matrix);
 
+  /**
+   * Compute a new numeric factorization for a matrix that has the same
+   * sparsity pattern as the one passed to the last call of factorize(),
+   * reusing the symbolic factorization computed there. In Newton iterations
+   * or time stepping schemes where the matrix changes but its sparsity
+   * pattern does not, this saves the symbolic analysis in every step.
+   *
+   * If no symbolic factorization is available, this function simply calls
+   * factorize(). In debug mode, it is checked that the sparsity pattern of
+   * @p matrix is indeed the same as the one of the previous matrix.
+   */
+  template <class Matrix>
+  void
+  refactorize(const Matrix &matrix);
+
   /**
    * Initialize memory and call SparseDirectUMFPACK::factorize.
    */
@@ -243,6 +264,28 @@ public:
   solve(BlockVector<double> &rhs_and_solution,
         const bool           transpose = false) const;
 
+  /**
+   * Solve for several right hand side vectors at once, using the same
+   * factorization for all of them. The right hand sides are processed in
+   * parallel on the available threads, which is possible because the
+   * UMFPACK solve routine only reads from the factorization.
+   *
+   * The solutions will be returned in place of the right hand side vectors.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solutions,
+        const bool                   transpose = false) const;
+
+  /**
+   * Same as before, but with the right hand sides given as the columns of
+   * a matrix, i.e., this function computes $X=A^{-1}B$ (or $X=A^{-T}B$ if
+   * @p transpose is set) where @p rhs_and_solution is $B$ on entry and $X$
+   * on exit.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution,
+        const bool          transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
@@ -335,22 +378,30 @@ private:
   clear();
 
   /**
-   * Make sure that the arrays Ai and Ap are sorted in each row. UMFPACK wants
-   * it this way. We need to have three versions of this function, one for the
-   * usual SparseMatrix, one for the SparseMatrixEZ, and one for the
+   * Copy the entries of the matrix into the arrays Ap, Ai, and Ax in the
+   * format UMFPACK wants. The rows are copied in parallel.
+   */
+  template <class Matrix>
+  void
+  copy_matrix_to_arrays(const Matrix &matrix);
+
+  /**
+   * Make sure that the arrays Ai and Ap are sorted in the given row. UMFPACK
+   * wants it this way. We need to have three versions of this function, one
+   * for the usual SparseMatrix, one for the SparseMatrixEZ, and one for the
    * BlockSparseMatrix classes
    */
   template <typename number>
   void
-  sort_arrays(const SparseMatrixEZ<number> &);
+  sort_arrays(const SparseMatrixEZ<number> &, const size_type row);
 
   template <typename number>
   void
-  sort_arrays(const SparseMatrix<number> &);
+  sort_arrays(const SparseMatrix<number> &, const size_type row);
 
   template <typename number>
   void
-  sort_arrays(const BlockSparseMatrix<number> &);
+  sort_arrays(const BlockSparseMatrix<number> &, const size_type row);
 
   /**
    * The arrays in which we store the data for the solver. SuiteSparse_long
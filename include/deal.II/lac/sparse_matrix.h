@@ -43,6 +43,8 @@ template <typename Matrix>
 class BlockMatrixBase;
 template <typename number>
 class SparseILU;
+template <typename number>
+class AssemblyPlan;
 #  ifdef DEAL_II_WITH_MPI
 namespace Utilities
 {
@@ -1231,6 +1233,18 @@ public:
    * that the sparsity pattern of @p C is modified and that this would
    * render invalid <i>all other SparseMatrix objects</i> that happen
    * to <i>also</i> use that sparsity pattern object.
+   *
+   * Both the computation of the sparsity pattern and of the entries run in
+   * parallel over the rows of @p C. The sparsity pattern is built in two
+   * passes, the first one counting the entries of each row and the second
+   * one filling them in, so that no intermediate DynamicSparsityPattern is
+   * needed. The entries of each row are summed up in a dense array.
+   *
+   * If @p rebuild_sparsity_pattern is @p false, the product is added to the
+   * entries already stored in @p C. To recompute the product after the
+   * entries of @p A or @p B have changed but their sparsity patterns have
+   * not, set @p C to zero and call this function with @p false, which only
+   * repeats the numeric phase.
    */
   template <typename numberB, typename numberC>
   void
@@ -1259,6 +1273,11 @@ public:
    * the sparsity pattern stored in <tt>C</tt>. In that case, make sure that
    * it really fits. The default is to rebuild the sparsity pattern.
    *
+   * Like mmult(), this function runs in parallel and, if
+   * @p rebuild_sparsity_pattern is @p false, adds the product to the entries
+   * already stored in @p C. It forms the transpose of <tt>this</tt> in a
+   * temporary array.
+   *
    * @note Rebuilding the sparsity pattern requires changing it. This means
    * that all other matrices that are associated with this sparsity pattern
    * will then have invalid entries.
@@ -1270,6 +1289,31 @@ public:
          const Vector<number> &       V = Vector<number>(),
          const bool                   rebuild_sparsity_pattern = true) const;
 
+  /**
+   * Perform the triple matrix product <tt>C = R * A * P</tt>, where
+   * <tt>R</tt> is the calling matrix. With <tt>R</tt> the transpose of
+   * <tt>P</tt>, this is the Galerkin product that defines coarse operators
+   * in multigrid methods.
+   *
+   * Each row of <tt>C</tt> is computed by first accumulating the
+   * respective row of <tt>R * A</tt> and then multiplying it by <tt>P</tt>,
+   * so neither <tt>R * A</tt> nor <tt>A * P</tt> is ever stored. The rows
+   * are processed in parallel.
+   *
+   * The meaning of @p rebuild_sparsity_pattern and the requirements on the
+   * sparsity pattern of @p C are the same as for mmult(). In particular,
+   * passing @p false adds the product to the entries already stored in
+   * @p C, so after the values of <tt>R</tt>, <tt>A</tt> or <tt>P</tt> have
+   * changed but their sparsity patterns have not, setting @p C to zero and
+   * passing @p false recomputes only the entries.
+   */
+  template <typename numberA, typename numberP, typename numberC>
+  void
+  triple_mmult(SparseMatrix<numberC> &      C,
+               const SparseMatrix<numberA> &A,
+               const SparseMatrix<numberP> &P,
+               const bool rebuild_sparsity_pattern = true) const;
+
   //@}
   /**
    * @name Matrix norms
@@ -1715,6 +1759,13 @@ private:
   template <typename>
   friend class SparseILU;
 
+  /**
+   * Give the precomputed scatter of AssemblyPlan direct access to the value
+   * array.
+   */
+  template <typename>
+  friend class AssemblyPlan;
+
   /**
    * To allow it calling private prepare_add() and prepare_set().
    */
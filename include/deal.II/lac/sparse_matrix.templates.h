@@ -22,6 +22,7 @@
 
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
@@ -1004,6 +1005,258 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
 
 
 
+namespace internal
+{
+  namespace SparseMatrixImplementation
+  {
+    /**
+     * Scratch data for computing one row of a product of sparse matrices: a
+     * dense array of values indexed by the column, a marker telling which
+     * columns have been touched in the current row, and the list of these
+     * columns. Rather than resetting the marker after each row, every row
+     * gets a new stamp.
+     */
+    template <typename number>
+    struct RowAccumulator
+    {
+      RowAccumulator()
+        : stamp(0)
+      {}
+
+      void
+      reinit(const size_type n_cols)
+      {
+        if (marker.size() != n_cols)
+          {
+            values.resize(n_cols);
+            marker.assign(n_cols, 0);
+            stamp = 0;
+          }
+      }
+
+      void
+      start_row()
+      {
+        ++stamp;
+        columns.clear();
+      }
+
+      void
+      add(const size_type col, const number value)
+      {
+        if (marker[col] != stamp)
+          {
+            marker[col] = stamp;
+            values[col] = value;
+            columns.push_back(col);
+          }
+        else
+          values[col] += value;
+      }
+
+      bool
+      is_touched(const size_type col) const
+      {
+        return marker[col] == stamp;
+      }
+
+      std::vector<number>      values;
+      std::vector<std::size_t> marker;
+      std::vector<size_type>   columns;
+      std::size_t              stamp;
+    };
+
+
+
+    /**
+     * Add row @p row of the product $A\,\text{diag}(V)\,B$ to the
+     * accumulator, where both matrices are given by their compressed row
+     * arrays. If the value arrays are null pointers, only the columns are
+     * recorded. If @p V is a null pointer, the diagonal scaling is omitted.
+     */
+    template <typename numberA,
+              typename numberB,
+              typename numberV,
+              typename numberC>
+    inline void
+    accumulate_product_row(const size_type          row,
+                           const std::size_t *      rowstart_A,
+                           const size_type *        colnums_A,
+                           const numberA *          val_A,
+                           const std::size_t *      rowstart_B,
+                           const size_type *        colnums_B,
+                           const numberB *          val_B,
+                           const numberV *          V,
+                           RowAccumulator<numberC> &accumulator)
+    {
+      for (std::size_t k = rowstart_A[row]; k < rowstart_A[row + 1]; ++k)
+        {
+          const size_type col = colnums_A[k];
+          if (val_A == nullptr || val_B == nullptr)
+            for (std::size_t l = rowstart_B[col]; l < rowstart_B[col + 1]; ++l)
+              accumulator.add(colnums_B[l], numberC());
+          else
+            for (std::size_t l = rowstart_B[col]; l < rowstart_B[col + 1]; ++l)
+              accumulator.add(colnums_B[l],
+                              numberC(val_A[k]) * numberC(val_B[l]) *
+                                numberC(V != nullptr ? V[col] : numberV(1)));
+        }
+    }
+
+
+
+    /**
+     * Build the sparsity pattern @p sp of a matrix product in two parallel
+     * passes. The function object @p compute_row is called with a row index
+     * and a RowAccumulator and must record all columns of that row. The
+     * first pass only counts the entries of each row, which allows to
+     * allocate exactly the memory needed, and the second pass inserts them.
+     */
+    template <typename RowFunction>
+    void
+    compute_product_pattern(const size_type    n_rows,
+                            const size_type    n_cols,
+                            const RowFunction &compute_row,
+                            SparsityPattern &  sp)
+    {
+      Threads::ThreadLocalStorage<RowAccumulator<char>> scratch;
+      std::vector<unsigned int> row_lengths(n_rows);
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          RowAccumulator<char> &accumulator = scratch.get();
+          accumulator.reinit(n_cols);
+          for (size_type row = begin; row < end; ++row)
+            {
+              accumulator.start_row();
+              compute_row(row, accumulator);
+              // square patterns store the diagonal in any case
+              row_lengths[row] =
+                accumulator.columns.size() +
+                ((n_rows == n_cols && !accumulator.is_touched(row)) ? 1 : 0);
+            }
+        },
+        minimum_parallel_grain_size);
+
+      sp.reinit(n_rows, n_cols, row_lengths);
+
+      // SparsityPattern::add_entries() only touches the memory of the given
+      // row, so different rows can be filled concurrently
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          RowAccumulator<char> &accumulator = scratch.get();
+          accumulator.reinit(n_cols);
+          for (size_type row = begin; row < end; ++row)
+            {
+              accumulator.start_row();
+              compute_row(row, accumulator);
+              std::sort(accumulator.columns.begin(),
+                        accumulator.columns.end());
+              sp.add_entries(row,
+                             accumulator.columns.begin(),
+                             accumulator.columns.end(),
+                             true);
+            }
+        },
+        minimum_parallel_grain_size);
+
+      sp.compress();
+    }
+
+
+
+    /**
+     * Compute the values of a matrix product in parallel over the rows of
+     * the result. The function object @p compute_row is called with a row
+     * index and a RowAccumulator and must add all contributions to that
+     * row. The accumulated values are then added to the entries of the
+     * result given by its compressed row arrays.
+     */
+    template <typename numberC, typename RowFunction>
+    void
+    compute_product_values(const size_type    n_rows,
+                           const size_type    n_cols,
+                           const RowFunction &compute_row,
+                           const std::size_t *rowstart_C,
+                           const size_type *  colnums_C,
+                           numberC *          val_C)
+    {
+      Threads::ThreadLocalStorage<RowAccumulator<numberC>> scratch;
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          RowAccumulator<numberC> &accumulator = scratch.get();
+          accumulator.reinit(n_cols);
+          for (size_type row = begin; row < end; ++row)
+            {
+              accumulator.start_row();
+              compute_row(row, accumulator);
+
+              std::size_t n_found = 0;
+              for (std::size_t k = rowstart_C[row]; k < rowstart_C[row + 1];
+                   ++k)
+                if (accumulator.is_touched(colnums_C[k]))
+                  {
+                    val_C[k] += accumulator.values[colnums_C[k]];
+                    ++n_found;
+                  }
+              (void)n_found;
+              Assert(n_found == accumulator.columns.size(),
+                     ExcMessage("The sparsity pattern of the result matrix "
+                                "does not contain all entries of the "
+                                "product in row " +
+                                Utilities::to_string(row) + "."));
+            }
+        },
+        minimum_parallel_grain_size);
+    }
+
+
+
+    /**
+     * Compute the compressed row arrays of the transpose of the matrix given
+     * by @p rowstart, @p colnums and @p val with @p n_cols columns. Since the
+     * rows of the original matrix are traversed in order, the rows of the
+     * transpose are sorted.
+     */
+    template <typename number>
+    void
+    compute_transpose(const size_type           n_rows,
+                      const size_type           n_cols,
+                      const std::size_t *       rowstart,
+                      const size_type *         colnums,
+                      const number *            val,
+                      std::vector<std::size_t> &rowstart_T,
+                      std::vector<size_type> &  colnums_T,
+                      std::vector<number> &     val_T)
+    {
+      rowstart_T.assign(n_cols + 1, 0);
+      for (std::size_t k = 0; k < rowstart[n_rows]; ++k)
+        ++rowstart_T[colnums[k] + 1];
+      for (size_type col = 0; col < n_cols; ++col)
+        rowstart_T[col + 1] += rowstart_T[col];
+
+      colnums_T.resize(rowstart_T[n_cols]);
+      val_T.resize(rowstart_T[n_cols]);
+      std::vector<std::size_t> next(rowstart_T.begin(), rowstart_T.end() - 1);
+      for (size_type row = 0; row < n_rows; ++row)
+        for (std::size_t k = rowstart[row]; k < rowstart[row + 1]; ++k)
+          {
+            const std::size_t index = next[colnums[k]]++;
+            colnums_T[index]        = row;
+            val_T[index]            = val[k];
+          }
+    }
+  } // namespace SparseMatrixImplementation
+} // namespace internal
+
+
+
 template <typename number>
 template <typename numberB, typename numberC>
 void
@@ -1039,12 +1292,25 @@ SparseMatrix<number>::mmult(SparseMatrix<numberC> &      C,
       C.clear();
       sp_C.reinit(0, 0, 0);
 
-      // create a sparsity pattern for the matrix C.
-      {
-        DynamicSparsityPattern dsp;
-        dsp.compute_mmult_pattern(sp_A, sp_B);
-        sp_C.copy_from(dsp);
-      }
+      // create the sparsity pattern of C directly, without going through a
+      // DynamicSparsityPattern
+      internal::SparseMatrixImplementation::compute_product_pattern(
+        m(),
+        B.n(),
+        [&](const size_type                                          row,
+            internal::SparseMatrixImplementation::RowAccumulator<char> &acc) {
+          internal::SparseMatrixImplementation::accumulate_product_row(
+            row,
+            sp_A.rowstart.get(),
+            sp_A.colnums.get(),
+            static_cast<const char *>(nullptr),
+            sp_B.rowstart.get(),
+            sp_B.colnums.get(),
+            static_cast<const char *>(nullptr),
+            static_cast<const char *>(nullptr),
+            acc);
+        },
+        sp_C);
 
       // reinit matrix C from that information
       C.reinit(sp_C);
@@ -1053,59 +1319,29 @@ SparseMatrix<number>::mmult(SparseMatrix<numberC> &      C,
   Assert(C.m() == m(), ExcDimensionMismatch(C.m(), m()));
   Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
 
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < C.m(); ++i)
-    {
-      const size_type *      rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      for (; rows != end_rows; ++rows)
-        {
-          const number     A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-          const size_type  col   = *rows;
-          const size_type *new_cols = (&sp_B.colnums[sp_B.rowstart[col]]);
-
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            {
-              C.add(i,
-                    *new_cols,
-                    numberC(A_val) *
-                      numberC(
-                        B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                      numberC(use_vector ? V(col) : 1));
-              ++new_cols;
-            }
-
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC *      new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          const numberB *const end_cols = &B.val[sp_B.rowstart[col + 1]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(col) : 1);
-
-          C.add(i,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
-        }
-    }
+  // now compute the actual entries: for each row of C, accumulate the rows
+  // of B scaled by the entries in the respective row of A into a dense
+  // array and write them to the entries of C at once
+  const SparsityPattern &sp_C = *C.cols;
+  internal::SparseMatrixImplementation::compute_product_values(
+    m(),
+    B.n(),
+    [&](const size_type                                             row,
+        internal::SparseMatrixImplementation::RowAccumulator<numberC> &acc) {
+      internal::SparseMatrixImplementation::accumulate_product_row(
+        row,
+        sp_A.rowstart.get(),
+        sp_A.colnums.get(),
+        val.get(),
+        sp_B.rowstart.get(),
+        sp_B.colnums.get(),
+        B.val.get(),
+        use_vector ? V.begin() : static_cast<const number *>(nullptr),
+        acc);
+    },
+    sp_C.rowstart.get(),
+    sp_C.colnums.get(),
+    C.val.get());
 }
 
 
@@ -1127,6 +1363,20 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC> &      C,
   const SparsityPattern &sp_A = *cols;
   const SparsityPattern &sp_B = *B.cols;
 
+  // the rows of C correspond to the columns of A, so work on the transpose
+  // of A, which is built once for both the symbolic and the numeric phase
+  std::vector<std::size_t> rowstart_T;
+  std::vector<size_type>   colnums_T;
+  std::vector<number>      val_T;
+  internal::SparseMatrixImplementation::compute_transpose(m(),
+                                                          n(),
+                                                          sp_A.rowstart.get(),
+                                                          sp_A.colnums.get(),
+                                                          val.get(),
+                                                          rowstart_T,
+                                                          colnums_T,
+                                                          val_T);
+
   // clear previous content of C
   if (rebuild_sparsity_C == true)
     {
@@ -1145,41 +1395,23 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC> &      C,
       C.clear();
       sp_C.reinit(0, 0, 0);
 
-      // create a sparsity pattern for the matrix. we will go through all the
-      // rows in the matrix A, and for each column in a row we add the whole
-      // row of matrix B with that row number. This means that we will insert
-      // a lot of entries to each row, which is best handled by the
-      // DynamicSparsityPattern class.
-      {
-        DynamicSparsityPattern dsp(n(), B.n());
-        for (size_type i = 0; i < sp_A.n_rows(); ++i)
-          {
-            const size_type *      rows = &sp_A.colnums[sp_A.rowstart[i]];
-            const size_type *const end_rows =
-              &sp_A.colnums[sp_A.rowstart[i + 1]];
-            // cast away constness to conform with dsp.add_entries interface
-            size_type *new_cols =
-              const_cast<size_type *>(&sp_B.colnums[sp_B.rowstart[i]]);
-            size_type *end_new_cols =
-              const_cast<size_type *>(&sp_B.colnums[sp_B.rowstart[i + 1]]);
-
-            if (sp_B.n_rows() == sp_B.n_cols())
-              ++new_cols;
-
-            for (; rows != end_rows; ++rows)
-              {
-                const size_type row = *rows;
-
-                // if B has a diagonal, need to add that manually. this way,
-                // we maintain sortedness.
-                if (sp_B.n_rows() == sp_B.n_cols())
-                  dsp.add(row, i);
-
-                dsp.add_entries(row, new_cols, end_new_cols, true);
-              }
-          }
-        sp_C.copy_from(dsp);
-      }
+      internal::SparseMatrixImplementation::compute_product_pattern(
+        n(),
+        B.n(),
+        [&](const size_type                                          row,
+            internal::SparseMatrixImplementation::RowAccumulator<char> &acc) {
+          internal::SparseMatrixImplementation::accumulate_product_row(
+            row,
+            rowstart_T.data(),
+            colnums_T.data(),
+            static_cast<const char *>(nullptr),
+            sp_B.rowstart.get(),
+            sp_B.colnums.get(),
+            static_cast<const char *>(nullptr),
+            static_cast<const char *>(nullptr),
+            acc);
+        },
+        sp_C);
 
       // reinit matrix C from that information
       C.reinit(sp_C);
@@ -1188,60 +1420,140 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC> &      C,
   Assert(C.m() == n(), ExcDimensionMismatch(C.m(), n()));
   Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
 
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < m(); ++i)
+  const SparsityPattern &sp_C = *C.cols;
+  internal::SparseMatrixImplementation::compute_product_values(
+    n(),
+    B.n(),
+    [&](const size_type                                             row,
+        internal::SparseMatrixImplementation::RowAccumulator<numberC> &acc) {
+      internal::SparseMatrixImplementation::accumulate_product_row(
+        row,
+        rowstart_T.data(),
+        colnums_T.data(),
+        val_T.data(),
+        sp_B.rowstart.get(),
+        sp_B.colnums.get(),
+        B.val.get(),
+        use_vector ? V.begin() : static_cast<const number *>(nullptr),
+        acc);
+    },
+    sp_C.rowstart.get(),
+    sp_C.colnums.get(),
+    C.val.get());
+}
+
+
+
+template <typename number>
+template <typename numberA, typename numberP, typename numberC>
+void
+SparseMatrix<number>::triple_mmult(SparseMatrix<numberC> &      C,
+                                   const SparseMatrix<numberA> &A,
+                                   const SparseMatrix<numberP> &P,
+                                   const bool rebuild_sparsity_C) const
+{
+  Assert(n() == A.m(), ExcDimensionMismatch(n(), A.m()));
+  Assert(A.n() == P.m(), ExcDimensionMismatch(A.n(), P.m()));
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(A.cols != nullptr, ExcNotInitialized());
+  Assert(P.cols != nullptr, ExcNotInitialized());
+  Assert(C.cols != nullptr, ExcNotInitialized());
+
+  const SparsityPattern &sp_R = *cols;
+  const SparsityPattern &sp_A = *A.cols;
+  const SparsityPattern &sp_P = *P.cols;
+
+  // the fused kernel first accumulates the row of R*A and then multiplies
+  // it by P, without ever storing the product R*A or A*P as a whole. the
+  // intermediate row uses its own accumulator that lives next to the one
+  // for the final row on each thread
+  Threads::ThreadLocalStorage<
+    internal::SparseMatrixImplementation::RowAccumulator<numberC>>
+    intermediate_scratch;
+
+  if (rebuild_sparsity_C == true)
     {
-      const size_type *      rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      const size_type *      new_cols = &sp_B.colnums[sp_B.rowstart[i]];
-      if (sp_B.n_rows() == sp_B.n_cols())
-        ++new_cols;
+      // we are about to change the sparsity pattern of C. this can not work
+      // if any of the factors uses the same sparsity pattern
+      Assert(&C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+      Assert(&C.get_sparsity_pattern() != &A.get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+      Assert(&C.get_sparsity_pattern() != &P.get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+
+      // need to change the sparsity pattern of C, so cast away const-ness.
+      SparsityPattern &sp_C =
+        *(const_cast<SparsityPattern *>(&C.get_sparsity_pattern()));
+      C.clear();
+      sp_C.reinit(0, 0, 0);
 
-      const numberB *const end_cols = &B.val[sp_B.rowstart[i + 1]];
+      internal::SparseMatrixImplementation::compute_product_pattern(
+        m(),
+        P.n(),
+        [&](const size_type                                          row,
+            internal::SparseMatrixImplementation::RowAccumulator<char> &acc) {
+          internal::SparseMatrixImplementation::RowAccumulator<numberC>
+            &intermediate = intermediate_scratch.get();
+          intermediate.reinit(A.n());
+          intermediate.start_row();
+          internal::SparseMatrixImplementation::accumulate_product_row(
+            row,
+            sp_R.rowstart.get(),
+            sp_R.colnums.get(),
+            static_cast<const char *>(nullptr),
+            sp_A.rowstart.get(),
+            sp_A.colnums.get(),
+            static_cast<const char *>(nullptr),
+            static_cast<const char *>(nullptr),
+            intermediate);
+          for (const size_type k : intermediate.columns)
+            for (std::size_t l = sp_P.rowstart[k]; l < sp_P.rowstart[k + 1];
+                 ++l)
+              acc.add(sp_P.colnums[l], 0);
+        },
+        sp_C);
 
-      for (; rows != end_rows; ++rows)
+      C.reinit(sp_C);
+    }
+
+  Assert(C.m() == m(), ExcDimensionMismatch(C.m(), m()));
+  Assert(C.n() == P.n(), ExcDimensionMismatch(C.n(), P.n()));
+
+  const SparsityPattern &sp_C = *C.cols;
+  internal::SparseMatrixImplementation::compute_product_values(
+    m(),
+    P.n(),
+    [&](const size_type                                             row,
+        internal::SparseMatrixImplementation::RowAccumulator<numberC> &acc) {
+      internal::SparseMatrixImplementation::RowAccumulator<numberC>
+        &intermediate = intermediate_scratch.get();
+      intermediate.reinit(A.n());
+      intermediate.start_row();
+      internal::SparseMatrixImplementation::accumulate_product_row(
+        row,
+        sp_R.rowstart.get(),
+        sp_R.colnums.get(),
+        val.get(),
+        sp_A.rowstart.get(),
+        sp_A.colnums.get(),
+        A.val.get(),
+        static_cast<const number *>(nullptr),
+        intermediate);
+      for (const size_type k : intermediate.columns)
         {
-          const size_type row   = *rows;
-          const number    A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            C.add(row,
-                  i,
-                  numberC(A_val) *
-                    numberC(
-                      B.val[new_cols - 1 - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                    numberC(use_vector ? V(i) : 1));
-
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC *      new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(i) : 1);
-
-          C.add(row,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
+          const numberC ra = intermediate.values[k];
+          for (std::size_t l = sp_P.rowstart[k]; l < sp_P.rowstart[k + 1];
+               ++l)
+            acc.add(sp_P.colnums[l], ra * numberC(P.val[l]));
         }
-    }
+    },
+    sp_C.rowstart.get(),
+    sp_C.colnums.get(),
+    C.val.get());
 }
 
 
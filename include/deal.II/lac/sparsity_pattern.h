@@ -524,7 +524,10 @@ public:
    * algorithms. A special sorting scheme is used for the diagonal entry of
    * quadratic matrices, which is always the first entry of each row.
    *
-   * The memory which is no more needed is released.
+   * The memory which is no more needed is released. If all entries of all
+   * rows are in use, as is the case if the pattern was initialized with the
+   * exact row lengths, the entries are sorted in place without allocating
+   * any new memory.
    *
    * SparseMatrix objects require the SparsityPattern objects they are
    * initialized with to be compressed, to reduce memory requirements.
@@ -833,9 +833,9 @@ namespace MatrixFreeOperators
      * }
      * @endcode
      * where <code>mf_data</code> is a MatrixFree object and
-     * <code>function</code> is a function which provides the following method
-     * <code>VectorizedArray<double> value(const Point<dim,
-     * VectorizedArray<double> > &p_vec)</code>.
+     * <code>function</code> is a Function object, whose
+     * Function::vectorized_value() method is called for the points of all
+     * cells in a batch at once.
      *
      * If this function is not called, the coefficient is assumed to be unity.
      *
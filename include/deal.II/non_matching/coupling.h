@@ -19,6 +19,8 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
@@ -43,6 +45,171 @@ DEAL_II_NAMESPACE_OPEN
  */
 namespace NonMatching
 {
+  /**
+   * A class that stores where the quadrature points of an immersed mesh lie
+   * in an embedding (space) mesh, so that coupling sparsity patterns and
+   * coupling matrices between the two meshes can be assembled repeatedly
+   * without locating the points again.
+   *
+   * For each active cell of the immersed triangulation and each point of the
+   * quadrature formula, the object stores the position of the quadrature
+   * point in real space, the active cell of the space triangulation around
+   * it, and its coordinates on the reference cell of that cell. The points
+   * are located with GridTools::find_active_cells_around_points() the first
+   * time. If the immersed mesh moves, e.g., because @p immersed_mapping is
+   * a MappingQEulerian object with a changing displacement, then update()
+   * computes the new positions of the points and first looks for each point
+   * in the cell it was in before and in the neighbors of that cell. Only the
+   * points not found there are searched for in the whole space mesh. For an
+   * immersed mesh that moves by a fraction of the size of the cells of the
+   * space mesh in each time step, this is much cheaper than locating all
+   * points from scratch.
+   *
+   * Points that do not lie in the space triangulation, or in the part of it
+   * known to the current process, are not an error: they are simply ignored
+   * when assembling. Together with the fact that the assembly functions
+   * taking a CouplingPlan only act on locally owned cells of the space
+   * triangulation, this allows to use a parallel::distributed::Triangulation
+   * for the space mesh, provided every process stores the whole immersed
+   * mesh (e.g., as a serial or a parallel::shared::Triangulation).
+   *
+   * @note The object stores iterators into the space triangulation. It has
+   * to be created again if the space triangulation changes, and update()
+   * needs to be called after the immersed triangulation was refined.
+   */
+  template <int dim0, int dim1, int spacedim>
+  class CouplingPlan : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. Locate the quadrature points given by @p quadrature on
+     * all active cells of the triangulation of @p immersed_dh, mapped to real
+     * space by @p immersed_mapping, in the triangulation of the @p cache.
+     * All objects are stored by reference and need to live longer than this
+     * object.
+     */
+    CouplingPlan(const GridTools::Cache<dim0, spacedim> &cache,
+                 const DoFHandler<dim1, spacedim> &      immersed_dh,
+                 const Quadrature<dim1> &                quadrature,
+                 const Mapping<dim1, spacedim> &         immersed_mapping =
+                   StaticMappingQ1<dim1, spacedim>::mapping);
+
+    /**
+     * Compute the positions of the quadrature points again and locate them,
+     * starting from the cells they were in before. This needs to be called
+     * whenever the immersed mesh has moved.
+     */
+    void
+    update();
+
+    /**
+     * Return the GridTools::Cache object of the space triangulation.
+     */
+    const GridTools::Cache<dim0, spacedim> &
+    get_cache() const;
+
+    /**
+     * Return the DoFHandler on the immersed triangulation.
+     */
+    const DoFHandler<dim1, spacedim> &
+    get_immersed_dof_handler() const;
+
+    /**
+     * Return the quadrature formula used on the immersed cells.
+     */
+    const Quadrature<dim1> &
+    get_quadrature() const;
+
+    /**
+     * Return the mapping of the immersed triangulation.
+     */
+    const Mapping<dim1, spacedim> &
+    get_immersed_mapping() const;
+
+    /**
+     * Return the position in real space of the quadrature point @p q on the
+     * immersed cell with active cell index @p immersed_cell_index.
+     */
+    const Point<spacedim> &
+    get_point(const unsigned int immersed_cell_index,
+              const unsigned int q) const;
+
+    /**
+     * Return the active cell of the space triangulation around the
+     * quadrature point @p q on the immersed cell with active cell index
+     * @p immersed_cell_index. The returned iterator is invalid, i.e., its
+     * state() is not IteratorState::valid, if the point was not found.
+     */
+    const typename Triangulation<dim0, spacedim>::active_cell_iterator &
+    get_space_cell(const unsigned int immersed_cell_index,
+                   const unsigned int q) const;
+
+    /**
+     * Return the coordinates of the quadrature point @p q on the immersed
+     * cell with active cell index @p immersed_cell_index on the reference
+     * cell of the cell returned by get_space_cell().
+     */
+    const Point<dim0> &
+    get_reference_point(const unsigned int immersed_cell_index,
+                        const unsigned int q) const;
+
+    /**
+     * Return the number of points that were not found in the cells they
+     * were in before, or in the neighbors of these cells, and had to be
+     * searched for in the whole space triangulation in the last call to
+     * update() or the constructor.
+     */
+    unsigned int
+    n_searched_points() const;
+
+  private:
+    /**
+     * The cache of the space triangulation.
+     */
+    SmartPointer<const GridTools::Cache<dim0, spacedim>, CouplingPlan> cache;
+
+    /**
+     * The DoFHandler on the immersed triangulation.
+     */
+    SmartPointer<const DoFHandler<dim1, spacedim>, CouplingPlan> immersed_dh;
+
+    /**
+     * The quadrature formula used on the immersed cells.
+     */
+    const Quadrature<dim1> quadrature;
+
+    /**
+     * The mapping of the immersed triangulation.
+     */
+    SmartPointer<const Mapping<dim1, spacedim>, CouplingPlan>
+      immersed_mapping;
+
+    /**
+     * The quadrature points of all immersed cells in real space, stored
+     * cell by cell in the order of the active cell index.
+     */
+    std::vector<Point<spacedim>> points;
+
+    /**
+     * The cells of the space triangulation around the points.
+     */
+    std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+      space_cells;
+
+    /**
+     * The reference coordinates of the points in the space cells.
+     */
+    std::vector<Point<dim0>> reference_points;
+
+    /**
+     * The number of points searched for in the whole space triangulation in
+     * the last call to update().
+     */
+    unsigned int n_searched;
+  };
+
+
+
   /**
    * Create a coupling sparsity pattern for non-matching, overlapping grids.
    *
@@ -136,6 +303,27 @@ namespace NonMatching
     const Mapping<dim1, spacedim> &  immersed_mapping =
       StaticMappingQ1<dim1, spacedim>::mapping);
 
+  /**
+   * Same as above, but the quadrature points of the immersed mesh are not
+   * located again: their positions in the space triangulation are taken from
+   * the @p plan, which also provides the cache of the space triangulation,
+   * the immersed DoFHandler, the quadrature formula and the immersed mapping.
+   * Quadrature points that the @p plan did not find are ignored.
+   */
+  template <int dim0,
+            int dim1,
+            int spacedim,
+            typename Sparsity,
+            typename number = double>
+  void
+  create_coupling_sparsity_pattern(
+    const CouplingPlan<dim0, dim1, spacedim> &plan,
+    const DoFHandler<dim0, spacedim> &        space_dh,
+    Sparsity &                                sparsity,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const ComponentMask &            space_comps = ComponentMask(),
+    const ComponentMask &            immersed_comps = ComponentMask());
+
 
   /**
    * Create a coupling mass matrix for non-matching, overlapping grids.
@@ -221,6 +409,26 @@ namespace NonMatching
     const ComponentMask &          immersed_comps = ComponentMask(),
     const Mapping<dim1, spacedim> &immersed_mapping =
       StaticMappingQ1<dim1, spacedim>::mapping);
+
+  /**
+   * Same as above, but the quadrature points of the immersed mesh are not
+   * located again: their positions in the space triangulation are taken from
+   * the @p plan, which also provides the cache of the space triangulation,
+   * the immersed DoFHandler, the quadrature formula and the immersed mapping.
+   * Quadrature points that the @p plan did not find are ignored.
+   *
+   * The local matrices are computed in parallel over the immersed cells.
+   */
+  template <int dim0, int dim1, int spacedim, typename Matrix>
+  void
+  create_coupling_mass_matrix(
+    const CouplingPlan<dim0, dim1, spacedim> &            plan,
+    const DoFHandler<dim0, spacedim> &                    space_dh,
+    Matrix &                                              matrix,
+    const AffineConstraints<typename Matrix::value_type> &constraints =
+      AffineConstraints<typename Matrix::value_type>(),
+    const ComponentMask &space_comps    = ComponentMask(),
+    const ComponentMask &immersed_comps = ComponentMask());
 } // namespace NonMatching
 DEAL_II_NAMESPACE_CLOSE
 
@@ -161,6 +161,12 @@ namespace internal
      */
     std::vector<double> JxW_values;
 
+    /**
+     * The integral of the squared jump of the gradient over the present face
+     * for each of the solution vectors.
+     */
+    std::vector<double> face_integral;
+
     /**
      * The subdomain id we are to care for.
      */
@@ -255,6 +261,7 @@ namespace internal
     , coefficient_values(face_quadratures.max_n_quadrature_points(),
                          dealii::Vector<double>(fe.n_components()))
     , JxW_values(face_quadratures.max_n_quadrature_points())
+    , face_integral(n_solution_vectors)
     , subdomain_id(subdomain_id)
     , material_id(material_id)
     , neumann_bc(neumann_bc)
@@ -299,47 +306,89 @@ namespace internal
 
 
   /**
-   * Copy data from the local_face_integrals map of a single ParallelData
-   * object into a global such map. This is the copier stage of a WorkStream
+   * The integrals over the faces that are computed while working on one
+   * cell, i.e., the copy data of the WorkStream pipeline. For each face, we
+   * store its index and the integrals for all solution vectors one after the
+   * other. In contrast to a map from faces to integrals, clearing this object
+   * and filling it again for the next cell does not need to allocate memory.
+   */
+  struct LocalFaceIntegrals
+  {
+    /**
+     * Remove all faces, but keep the memory.
+     */
+    void
+    clear()
+    {
+      face_indices.clear();
+      integrals.clear();
+    }
+
+    /**
+     * Add the integrals @p face_integral, multiplied by @p factor, for the
+     * face with index @p face_index.
+     */
+    void
+    add(const unsigned int         face_index,
+        const std::vector<double> &face_integral,
+        const double               factor)
+    {
+      face_indices.push_back(face_index);
+      for (const double value : face_integral)
+        integrals.push_back(value * factor);
+    }
+
+    std::vector<unsigned int> face_indices;
+    std::vector<double>       integrals;
+  };
+
+
+
+  /**
+   * Copy the integrals computed on a single cell into the global array of
+   * face integrals, which stores the integrals for all solution vectors of
+   * the face with index @p f starting at position
+   * <tt>f*n_solution_vectors</tt>. This is the copier stage of a WorkStream
    * pipeline.
    */
-  template <typename DoFHandlerType>
-  void
-  copy_local_to_global(
-    const std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-      &local_face_integrals,
-    std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-      &face_integrals)
+  inline void
+  copy_local_to_global(const LocalFaceIntegrals &local_face_integrals,
+                       const unsigned int        n_solution_vectors,
+                       std::vector<double> &     face_integrals)
   {
-    // now copy locally computed elements into the global map
-    for (typename std::map<typename DoFHandlerType::face_iterator,
-                           std::vector<double>>::const_iterator p =
-           local_face_integrals.begin();
-         p != local_face_integrals.end();
-         ++p)
-      {
-        // double check that the element does not already exists in the
-        // global map
-        Assert(face_integrals.find(p->first) == face_integrals.end(),
-               ExcInternalError());
+    AssertDimension(local_face_integrals.integrals.size(),
+                    local_face_integrals.face_indices.size() *
+                      n_solution_vectors);
 
-        for (unsigned int i = 0; i < p->second.size(); ++i)
+    for (unsigned int f = 0; f < local_face_integrals.face_indices.size(); ++f)
+      {
+        const unsigned int face_index = local_face_integrals.face_indices[f];
+        for (unsigned int n = 0; n < n_solution_vectors; ++n)
           {
-            Assert(numbers::is_finite(p->second[i]), ExcInternalError());
-            Assert(p->second[i] >= 0, ExcInternalError());
-          }
+            const double value =
+              local_face_integrals.integrals[f * n_solution_vectors + n];
+            Assert(numbers::is_finite(value), ExcInternalError());
+            Assert(value >= 0, ExcInternalError());
+
+            // every face is integrated by exactly one cell, so double check
+            // that the entry has not been written before
+            AssertIndexRange(face_index * n_solution_vectors + n,
+                             face_integrals.size());
+            Assert(face_integrals[face_index * n_solution_vectors + n] < 0,
+                   ExcInternalError());
 
-        face_integrals[p->first] = p->second;
+            face_integrals[face_index * n_solution_vectors + n] = value;
+          }
       }
   }
 
 
   /**
    * Actually do the computation based on the evaluated gradients in
-   * ParallelData.
+   * ParallelData, and store the result in ParallelData::face_integral.
    */
   template <typename DoFHandlerType, typename number>
-  std::vector<double>
+  void
   integrate_over_face(ParallelData<DoFHandlerType, number> &parallel_data,
                       const typename DoFHandlerType::face_iterator &face,
                       dealii::hp::FEFaceValues<DoFHandlerType::dimension,
@@ -472,16 +521,18 @@ namespace internal
       fe_face_values_cell.get_present_fe_values().get_JxW_values();
 
     // take the square of the phi[i] for integration, and sum up
-    std::vector<double> face_integral(n_solution_vectors, 0);
     for (unsigned int n = 0; n < n_solution_vectors; ++n)
-      for (unsigned int component = 0; component < n_components; ++component)
-        if (parallel_data.component_mask[component] == true)
-          for (unsigned int p = 0; p < n_q_points; ++p)
-            face_integral[n] += numbers::NumberTraits<number>::abs_square(
-                                  parallel_data.phi[n][p][component]) *
-                                parallel_data.JxW_values[p];
-
-    return face_integral;
+      {
+        parallel_data.face_integral[n] = 0;
+        for (unsigned int component = 0; component < n_components;
+             ++component)
+          if (parallel_data.component_mask[component] == true)
+            for (unsigned int p = 0; p < n_q_points; ++p)
+              parallel_data.face_integral[n] +=
+                numbers::NumberTraits<number>::abs_square(
+                  parallel_data.phi[n][p][component]) *
+                parallel_data.JxW_values[p];
+      }
   }
 
   /**
@@ -697,8 +748,7 @@ namespace internal
     const std::vector<const InputVector *> &solutions,
     ParallelData<DoFHandlerType, typename InputVector::value_type>
       &parallel_data,
-    std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-      &                                                  local_face_integrals,
+    LocalFaceIntegrals &                                 local_face_integrals,
     const typename DoFHandlerType::active_cell_iterator &cell,
     const unsigned int                                   face_no,
     dealii::hp::FEFaceValues<DoFHandlerType::dimension,
@@ -780,11 +830,10 @@ namespace internal
       }
 
     // now go to the generic function that does all the other things
-    local_face_integrals[face] =
-      integrate_over_face(parallel_data, face, fe_face_values_cell);
-
-    for (unsigned int i = 0; i < local_face_integrals[face].size(); i++)
-      local_face_integrals[face][i] *= factor;
+    integrate_over_face(parallel_data, face, fe_face_values_cell);
+    local_face_integrals.add(face->index(),
+                             parallel_data.face_integral,
+                             factor);
   }
 
 
@@ -800,8 +849,7 @@ namespace internal
     const std::vector<const InputVector *> &solutions,
     ParallelData<DoFHandlerType, typename InputVector::value_type>
       &parallel_data,
-    std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-      &                                                  local_face_integrals,
+    LocalFaceIntegrals &                                 local_face_integrals,
     const typename DoFHandlerType::active_cell_iterator &cell,
     const unsigned int                                   face_no,
     dealii::hp::FEFaceValues<DoFHandlerType::dimension,
@@ -838,6 +886,10 @@ namespace internal
     Assert(neighbor_neighbor < GeometryInfo<dim>::faces_per_cell,
            ExcInternalError());
 
+    // the integrals over the subfaces are stored one after the other,
+    // starting at this position
+    const unsigned int first_subface = local_face_integrals.face_indices.size();
+
     // loop over all subfaces
     for (unsigned int subface_no = 0; subface_no < face->n_children();
          ++subface_no)
@@ -882,33 +934,27 @@ namespace internal
         parallel_data.neighbor_normal_vectors =
           fe_subface_values.get_present_fe_values().get_all_normal_vectors();
 
-        local_face_integrals[neighbor_child->face(neighbor_neighbor)] =
-          integrate_over_face(parallel_data, face, fe_face_values);
-        for (unsigned int i = 0;
-             i < local_face_integrals[neighbor_child->face(neighbor_neighbor)]
-                   .size();
-             i++)
-          local_face_integrals[neighbor_child->face(neighbor_neighbor)][i] *=
-            factor;
+        integrate_over_face(parallel_data, face, fe_face_values);
+        Assert(neighbor_child->face(neighbor_neighbor) ==
+                 face->child(subface_no),
+               ExcInternalError());
+        local_face_integrals.add(face->child(subface_no)->index(),
+                                 parallel_data.face_integral,
+                                 factor);
       }
 
     // finally loop over all subfaces to collect the contributions of the
     // subfaces and store them with the mother face
-    std::vector<double> sum(n_solution_vectors, 0);
-    for (unsigned int subface_no = 0; subface_no < face->n_children();
-         ++subface_no)
+    for (unsigned int n = 0; n < n_solution_vectors; ++n)
       {
-        Assert(local_face_integrals.find(face->child(subface_no)) !=
-                 local_face_integrals.end(),
-               ExcInternalError());
-        Assert(local_face_integrals[face->child(subface_no)][0] >= 0,
-               ExcInternalError());
-
-        for (unsigned int n = 0; n < n_solution_vectors; ++n)
-          sum[n] += local_face_integrals[face->child(subface_no)][n];
+        parallel_data.face_integral[n] = 0;
+        for (unsigned int subface_no = 0; subface_no < face->n_children();
+             ++subface_no)
+          parallel_data.face_integral[n] +=
+            local_face_integrals
+              .integrals[(first_subface + subface_no) * n_solution_vectors + n];
       }
-
-    local_face_integrals[face] = sum;
+    local_face_integrals.add(face->index(), parallel_data.face_integral, 1.);
   }
 
 
@@ -924,15 +970,13 @@ namespace internal
     const typename DoFHandlerType::active_cell_iterator &cell,
     ParallelData<DoFHandlerType, typename InputVector::value_type>
       &parallel_data,
-    std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-      &                                     local_face_integrals,
+    LocalFaceIntegrals &                    local_face_integrals,
     const std::vector<const InputVector *> &solutions,
     const typename KellyErrorEstimator<
       DoFHandlerType::dimension,
       DoFHandlerType::space_dimension>::Strategy strategy)
   {
-    const unsigned int dim                = DoFHandlerType::dimension;
-    const unsigned int n_solution_vectors = solutions.size();
+    const unsigned int dim = DoFHandlerType::dimension;
 
     const types::subdomain_id subdomain_id = parallel_data.subdomain_id;
     const unsigned int        material_id  = parallel_data.material_id;
@@ -973,8 +1017,12 @@ namespace internal
             (parallel_data.neumann_bc->find(face->boundary_id()) ==
              parallel_data.neumann_bc->end()))
           {
-            local_face_integrals[face] =
-              std::vector<double>(n_solution_vectors, 0.);
+            std::fill(parallel_data.face_integral.begin(),
+                      parallel_data.face_integral.end(),
+                      0.);
+            local_face_integrals.add(face->index(),
+                                     parallel_data.face_integral,
+                                     1.);
             continue;
           }
 
@@ -1278,12 +1326,13 @@ KellyErrorEstimator<dim, spacedim>::estimate(
 
   const unsigned int n_solution_vectors = solutions.size();
 
-  // Map of integrals indexed by the corresponding face. In this map we store
-  // the integrated jump of the gradient for each face.  At the end of the
-  // function, we again loop over the cells and collect the contributions of
-  // the different faces of the cell.
-  std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-    face_integrals;
+  // The integrated jumps of the gradient for each face and solution vector,
+  // indexed by the index of the face. Every face is integrated once, by one
+  // of the adjacent cells, and the entries of faces that are not integrated
+  // remain negative. At the end of the function, we again loop over the
+  // cells and collect the contributions of the different faces of the cell.
+  std::vector<double> face_integrals(
+    dof_handler.get_triangulation().n_raw_faces() * n_solution_vectors, -1.);
 
   // all the data needed in the error estimator by each of the threads is
   // gathered in the following structures
@@ -1299,8 +1348,7 @@ KellyErrorEstimator<dim, spacedim>::estimate(
                   &neumann_bc,
                   component_mask,
                   coefficients);
-  std::map<typename DoFHandlerType::face_iterator, std::vector<double>>
-    sample_local_face_integrals;
+  internal::LocalFaceIntegrals sample_local_face_integrals;
 
   // now let's work on all those cells:
   WorkStream::run(
@@ -1313,8 +1361,9 @@ KellyErrorEstimator<dim, spacedim>::estimate(
               std::placeholders::_3,
               std::ref(solutions),
               strategy),
-    std::bind(&internal::copy_local_to_global<DoFHandlerType>,
+    std::bind(&internal::copy_local_to_global,
               std::placeholders::_1,
+              n_solution_vectors,
               std::ref(face_integrals)),
     parallel_data,
     sample_local_face_integrals);
@@ -1348,21 +1397,21 @@ KellyErrorEstimator<dim, spacedim>::estimate(
              face_no < GeometryInfo<dim>::faces_per_cell;
              ++face_no)
           {
-            Assert(face_integrals.find(cell->face(face_no)) !=
-                     face_integrals.end(),
-                   ExcInternalError());
-            const double factor = internal::cell_factor<DoFHandlerType>(
+            const unsigned int face_index = cell->face(face_no)->index();
+            const double       factor = internal::cell_factor<DoFHandlerType>(
               cell, face_no, dof_handler, strategy);
 
             for (unsigned int n = 0; n < n_solution_vectors; ++n)
               {
                 // make sure that we have written a meaningful value into this
                 // slot
-                Assert(face_integrals[cell->face(face_no)][n] >= 0,
+                Assert(face_integrals[face_index * n_solution_vectors + n] >=
+                         0,
                        ExcInternalError());
 
                 (*errors[n])(present_cell) +=
-                  (face_integrals[cell->face(face_no)][n] * factor);
+                  (face_integrals[face_index * n_solution_vectors + n] *
+                   factor);
               }
           }
 
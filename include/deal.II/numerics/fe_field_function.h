@@ -32,6 +32,8 @@
 
 #include <boost/optional.hpp>
 
+#include <functional>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -68,6 +70,39 @@ namespace Functions
    * element function (you might want this for the adjoint interpolation), you
    * can also use the function @p compute_point_locations alone.
    *
+   * <h3>Evaluating at many points</h3>
+   *
+   * The list versions of the evaluation functions (e.g., value_list() or
+   * vector_value_list()) first locate all points at once, using the search
+   * structures of a GridTools::Cache object stored in this class, and group
+   * them by the cells that contain them. Then they evaluate the finite
+   * element function on all points of a cell in one go, working on several
+   * cells in parallel. For the values of elements whose shape functions do
+   * not depend on the mapping (see
+   * FETools::has_mapping_independent_shape_values()), such as FE_Q, the
+   * shape functions are evaluated directly at the reference coordinates of
+   * the points, which avoids setting up an FEValues object for every cell.
+   * If the same points are evaluated repeatedly, e.g.,
+   * for probes that sample a time-dependent solution in every time step, the
+   * search can be done only once: compute_point_locations() returns the
+   * locations as a PointLocations object that can be passed to the
+   * evaluation functions, also of other FEFieldFunction objects that are
+   * based on the same DoFHandler and Mapping. Since this class only stores
+   * a reference to the solution vector, the result of the evaluation always
+   * reflects the current content of the vector:
+   * @code
+   *   Functions::FEFieldFunction<dim> solution_function(dof_handler, solution);
+   *   const auto locations =
+   *     solution_function.compute_point_locations(probe_points);
+   *
+   *   std::vector<double> probe_values(probe_points.size());
+   *   for (unsigned int step = 0; step < n_steps; ++step)
+   *     {
+   *       ...update solution...;
+   *       solution_function.value_list(locations, probe_values);
+   *     }
+   * @endcode
+   *
    * An example of how to use this function is the following:
    *
    * @code
@@ -184,6 +219,36 @@ namespace Functions
     set_active_cell(
       const typename DoFHandlerType::active_cell_iterator &newcell);
 
+    /**
+     * The locations of a set of points in the mesh, as computed by
+     * compute_point_locations(). The points are grouped by the cells that
+     * contain them.
+     */
+    struct PointLocations
+    {
+      /**
+       * The cells that contain at least one of the points.
+       */
+      std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+
+      /**
+       * For each of the @p cells, the coordinates of the points in the
+       * reference cell.
+       */
+      std::vector<std::vector<Point<dim>>> reference_points;
+
+      /**
+       * For each of the @p cells, the position of the points in the list of
+       * points given to compute_point_locations().
+       */
+      std::vector<std::vector<unsigned int>> point_indices;
+
+      /**
+       * The number of points given to compute_point_locations().
+       */
+      unsigned int n_points;
+    };
+
     /**
      * Get one vector value at the given point. It is inefficient to use
      * single points. If you need more than one at a time, use the
@@ -265,6 +330,26 @@ namespace Functions
                       std::vector<Vector<typename VectorType::value_type>>
                         &values) const override;
 
+    /**
+     * Same as value_list(), but for points whose locations have already been
+     * computed by compute_point_locations(). The array @p values needs to
+     * have as many entries as there were points.
+     */
+    void
+    value_list(const PointLocations &                        locations,
+               std::vector<typename VectorType::value_type> &values,
+               const unsigned int component = 0) const;
+
+    /**
+     * Same as vector_value_list(), but for points whose locations have
+     * already been computed by compute_point_locations(). The array @p values
+     * needs to have as many entries as there were points.
+     */
+    void
+    vector_value_list(const PointLocations &locations,
+                      std::vector<Vector<typename VectorType::value_type>>
+                        &values) const;
+
     /**
      * Return the gradient of all components of the function at the given
      * point.  It is inefficient to use single points. If you need more than
@@ -323,6 +408,17 @@ namespace Functions
       std::vector<std::vector<Tensor<1, dim, typename VectorType::value_type>>>
         &gradients) const override;
 
+    /**
+     * Same as vector_gradient_list(), but for points whose locations have
+     * already been computed by compute_point_locations(). The array
+     * @p gradients needs to have as many entries as there were points.
+     */
+    void
+    vector_gradient_list(
+      const PointLocations &locations,
+      std::vector<std::vector<Tensor<1, dim, typename VectorType::value_type>>>
+        &gradients) const;
+
     /**
      * Return the gradient of the specified component of the function at all
      * the given points.  This is rather efficient if all the points lie on
@@ -436,6 +532,15 @@ namespace Functions
       std::vector<std::vector<Point<dim>>> &                      qpoints,
       std::vector<std::vector<unsigned int>> &                    maps) const;
 
+    /**
+     * Locate the given @p points and return the result in a form that can be
+     * passed to the list versions of the evaluation functions, so that the
+     * search needs to be done only once for points that are evaluated
+     * repeatedly.
+     */
+    PointLocations
+    compute_point_locations(const std::vector<Point<dim>> &points) const;
+
   private:
     /**
      * Typedef holding the local cell_hint.
@@ -479,6 +584,40 @@ namespace Functions
     get_reference_coordinates(
       const typename DoFHandlerType::active_cell_iterator &cell,
       const Point<dim> &                                   point) const;
+
+    /**
+     * Evaluate the finite element function on the points of all cells in
+     * @p locations, working on several cells in parallel. For each cell,
+     * an FEValues object with the given @p update_flags is set up for all
+     * points of that cell, and @p evaluate is called with it and the
+     * indices of the points.
+     */
+    void
+    evaluate_on_cells(
+      const PointLocations &locations,
+      const UpdateFlags     update_flags,
+      const std::function<void(const FEValues<dim, dim> &,
+                               const std::vector<unsigned int> &)> &evaluate)
+      const;
+
+    /**
+     * Compute the values of all components of the finite element function
+     * on the points of all cells in @p locations, working on several cells
+     * in parallel. For each cell, @p store is called with the indices of the
+     * points and their values.
+     *
+     * If all elements of the DoFHandler have shape functions that do not
+     * depend on the mapping, the values are computed from
+     * FiniteElement::shape_value() at the reference points. Otherwise,
+     * evaluate_on_cells() is used.
+     */
+    void
+    evaluate_values_on_cells(
+      const PointLocations &locations,
+      const std::function<
+        void(const std::vector<unsigned int> &,
+             const std::vector<Vector<typename VectorType::value_type>> &)>
+        &store) const;
   };
 } // namespace Functions
 
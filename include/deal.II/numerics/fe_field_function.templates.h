@@ -18,17 +18,18 @@
 
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
 
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
 #include <deal.II/hp/fe_collection.h>
-#include <deal.II/hp/fe_values.h>
-#include <deal.II/hp/mapping_collection.h>
-#include <deal.II/hp/q_collection.h>
 
 #include <deal.II/numerics/fe_field_function.h>
 #include <deal.II/numerics/vector_tools.h>
@@ -266,44 +267,28 @@ namespace Functions
   {
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
+    vector_value_list(compute_point_locations(points), values);
+  }
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim>   mapping_collection(mapping);
-    const hp::FECollection<dim> &fe_collection = dh->get_fe_collection();
-    hp::QCollection<dim>         quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / ((double)nq));
 
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection,
-                           fe_collection,
-                           quadrature_collection,
-                           update_values);
-    // Now gather all the information we need
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector<Vector<typename VectorType::value_type>> vvalues(
-          nq, Vector<typename VectorType::value_type>(this->n_components));
-        fe_v.get_present_fe_values().get_function_values(data_vector, vvalues);
-        for (unsigned int q = 0; q < nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::vector_value_list(
+    const PointLocations &                                locations,
+    std::vector<Vector<typename VectorType::value_type>> &values) const
+  {
+    using number = typename VectorType::value_type;
+    Assert(locations.n_points == values.size(),
+           ExcDimensionMismatch(locations.n_points, values.size()));
+
+    evaluate_values_on_cells(
+      locations,
+      [&](const std::vector<unsigned int> &  indices,
+          const std::vector<Vector<number>> &vvalues) {
+        for (unsigned int q = 0; q < indices.size(); ++q)
+          values[indices[q]] = vvalues[q];
+      });
   }
 
 
@@ -317,12 +302,30 @@ namespace Functions
   {
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
-    std::vector<Vector<typename VectorType::value_type>> vvalues(
-      points.size(),
-      Vector<typename VectorType::value_type>(this->n_components));
-    vector_value_list(points, vvalues);
-    for (unsigned int q = 0; q < points.size(); ++q)
-      values[q] = vvalues[q](component);
+    value_list(compute_point_locations(points), values, component);
+  }
+
+
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::value_list(
+    const PointLocations &                        locations,
+    std::vector<typename VectorType::value_type> &values,
+    const unsigned int                            component) const
+  {
+    using number = typename VectorType::value_type;
+    Assert(locations.n_points == values.size(),
+           ExcDimensionMismatch(locations.n_points, values.size()));
+    AssertIndexRange(component, this->n_components);
+
+    evaluate_values_on_cells(
+      locations,
+      [&](const std::vector<unsigned int> &  indices,
+          const std::vector<Vector<number>> &vvalues) {
+        for (unsigned int q = 0; q < indices.size(); ++q)
+          values[indices[q]] = vvalues[q](component);
+      });
   }
 
 
@@ -336,55 +339,37 @@ namespace Functions
   {
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
+    vector_gradient_list(compute_point_locations(points), values);
+  }
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim>   mapping_collection(mapping);
-    const hp::FECollection<dim> &fe_collection = dh->get_fe_collection();
-    hp::QCollection<dim>         quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / ((double)nq));
 
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection,
-                           fe_collection,
-                           quadrature_collection,
-                           update_gradients);
-    // Now gather all the information we need
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector<
-          std::vector<Tensor<1, dim, typename VectorType::value_type>>>
-          vgrads(nq,
-                 std::vector<Tensor<1, dim, typename VectorType::value_type>>(
-                   this->n_components));
-        fe_v.get_present_fe_values().get_function_gradients(data_vector,
-                                                            vgrads);
-        for (unsigned int q = 0; q < nq; ++q)
-          {
-            const unsigned int s = vgrads[q].size();
-            values[maps[i][q]].resize(s);
-            for (unsigned int l = 0; l < s; l++)
-              values[maps[i][q]][l] = vgrads[q][l];
-          }
-      }
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::vector_gradient_list(
+    const PointLocations &locations,
+    std::vector<std::vector<Tensor<1, dim, typename VectorType::value_type>>>
+      &values) const
+  {
+    using number = typename VectorType::value_type;
+    Assert(locations.n_points == values.size(),
+           ExcDimensionMismatch(locations.n_points, values.size()));
+
+    const unsigned int n_components = this->n_components;
+    evaluate_on_cells(
+      locations,
+      update_gradients,
+      [&](const FEValues<dim> &fe_v, const std::vector<unsigned int> &indices) {
+        std::vector<std::vector<Tensor<1, dim, number>>> vgrads(
+          indices.size(), std::vector<Tensor<1, dim, number>>(n_components));
+        fe_v.get_function_gradients(data_vector, vgrads);
+        for (unsigned int q = 0; q < indices.size(); ++q)
+          values[indices[q]] = vgrads[q];
+      });
   }
 
+
+
   template <int dim, typename DoFHandlerType, typename VectorType>
   void
   FEFieldFunction<dim, DoFHandlerType, VectorType>::gradient_list(
@@ -404,55 +389,32 @@ namespace Functions
   }
 
 
+
   template <int dim, typename DoFHandlerType, typename VectorType>
   void
   FEFieldFunction<dim, DoFHandlerType, VectorType>::vector_laplacian_list(
     const std::vector<Point<dim>> &                       points,
     std::vector<Vector<typename VectorType::value_type>> &values) const
   {
+    using number = typename VectorType::value_type;
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim>   mapping_collection(mapping);
-    const hp::FECollection<dim> &fe_collection = dh->get_fe_collection();
-    hp::QCollection<dim>         quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / ((double)nq));
-
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection,
-                           fe_collection,
-                           quadrature_collection,
-                           update_hessians);
-    // Now gather all the information we need
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector<Vector<typename VectorType::value_type>> vvalues(
-          nq, Vector<typename VectorType::value_type>(this->n_components));
-        fe_v.get_present_fe_values().get_function_laplacians(data_vector,
-                                                             vvalues);
-        for (unsigned int q = 0; q < nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+    const unsigned int n_components = this->n_components;
+    evaluate_on_cells(
+      compute_point_locations(points),
+      update_hessians,
+      [&](const FEValues<dim> &fe_v, const std::vector<unsigned int> &indices) {
+        std::vector<Vector<number>> vvalues(indices.size(),
+                                            Vector<number>(n_components));
+        fe_v.get_function_laplacians(data_vector, vvalues);
+        for (unsigned int q = 0; q < indices.size(); ++q)
+          values[indices[q]] = vvalues[q];
+      });
   }
 
+
+
   template <int dim, typename DoFHandlerType, typename VectorType>
   void
   FEFieldFunction<dim, DoFHandlerType, VectorType>::laplacian_list(
@@ -494,6 +456,161 @@ namespace Functions
   }
 
 
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  typename FEFieldFunction<dim, DoFHandlerType, VectorType>::PointLocations
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::compute_point_locations(
+    const std::vector<Point<dim>> &points) const
+  {
+    PointLocations locations;
+    compute_point_locations(points,
+                            locations.cells,
+                            locations.reference_points,
+                            locations.point_indices);
+    locations.n_points = points.size();
+    return locations;
+  }
+
+
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::evaluate_on_cells(
+    const PointLocations &locations,
+    const UpdateFlags     update_flags,
+    const std::function<void(const FEValues<dim> &,
+                             const std::vector<unsigned int> &)> &evaluate)
+    const
+  {
+    // check for artificial cells up front, since we cannot throw from
+    // within the tasks below
+    for (const auto &cell : locations.cells)
+      AssertThrow(!cell->is_artificial(),
+                  VectorTools::ExcPointNotAvailableHere());
+
+    // every cell gets its own FEValues object that evaluates the shape
+    // functions on all points of the cell at once. the cells write to
+    // disjoint entries of the output, so they can be worked on in parallel
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(locations.cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const Quadrature<dim> quadrature(locations.reference_points[i]);
+            FEValues<dim>         fe_v(mapping,
+                               locations.cells[i]->get_fe(),
+                               quadrature,
+                               update_flags);
+            fe_v.reinit(locations.cells[i]);
+            evaluate(fe_v, locations.point_indices[i]);
+          }
+      },
+      16);
+  }
+
+
+
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::evaluate_values_on_cells(
+    const PointLocations &locations,
+    const std::function<
+      void(const std::vector<unsigned int> &,
+           const std::vector<Vector<typename VectorType::value_type>> &)>
+      &store) const
+  {
+    using number                    = typename VectorType::value_type;
+    const unsigned int n_components = this->n_components;
+
+    bool use_reference_values = true;
+    for (unsigned int i = 0; i < dh->get_fe_collection().size(); ++i)
+      if (!FETools::has_mapping_independent_shape_values(
+            dh->get_fe_collection()[i]))
+        use_reference_values = false;
+
+    if (use_reference_values == false)
+      {
+        evaluate_on_cells(
+          locations,
+          update_values,
+          [&](const FEValues<dim> &            fe_v,
+              const std::vector<unsigned int> &indices) {
+            std::vector<Vector<number>> vvalues(indices.size(),
+                                                Vector<number>(n_components));
+            fe_v.get_function_values(data_vector, vvalues);
+            store(indices, vvalues);
+          });
+        return;
+      }
+
+    for (const auto &cell : locations.cells)
+      AssertThrow(!cell->is_artificial(),
+                  VectorTools::ExcPointNotAvailableHere());
+
+    // the shape functions are the same on all cells, so we only need the
+    // values of the degrees of freedom of each cell. the elements are
+    // primitive, so every shape function contributes to a single component.
+    // for scalar tensor product elements such as FE_Q and FE_DGQ, evaluate
+    // all shape functions at a point at once through the polynomial space,
+    // as FEValues does. this only evaluates the one-dimensional polynomials
+    // once, rather than once for every shape function
+    using TensorProductElement =
+      FE_Poly<TensorProductPolynomials<dim>, dim, dim>;
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(locations.cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        Vector<number>              dof_values;
+        std::vector<Vector<number>> vvalues;
+        std::vector<double>         shape_values;
+        std::vector<Tensor<1, dim>> grads;
+        std::vector<Tensor<2, dim>> grad_grads;
+        std::vector<Tensor<3, dim>> third_derivatives;
+        std::vector<Tensor<4, dim>> fourth_derivatives;
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const FiniteElement<dim> &fe = locations.cells[i]->get_fe();
+            dof_values.reinit(fe.dofs_per_cell);
+            locations.cells[i]->get_dof_values(data_vector, dof_values);
+
+            const TensorProductElement *tensor_product_fe =
+              dynamic_cast<const TensorProductElement *>(&fe);
+            if (tensor_product_fe != nullptr)
+              shape_values.resize(fe.dofs_per_cell);
+
+            const std::vector<Point<dim>> &points =
+              locations.reference_points[i];
+            vvalues.resize(points.size());
+            for (unsigned int q = 0; q < points.size(); ++q)
+              {
+                vvalues[q].reinit(n_components);
+                if (tensor_product_fe != nullptr)
+                  {
+                    tensor_product_fe->get_poly_space().compute(
+                      points[q],
+                      shape_values,
+                      grads,
+                      grad_grads,
+                      third_derivatives,
+                      fourth_derivatives);
+                    number value = 0;
+                    for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+                      value += dof_values(j) * shape_values[j];
+                    vvalues[q](0) = value;
+                  }
+                else
+                  for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+                    vvalues[q](fe.system_to_component_index(j).first) +=
+                      dof_values(j) * fe.shape_value(j, points[q]);
+              }
+            store(locations.point_indices[i], vvalues);
+          }
+      },
+      16);
+  }
+
+
   template <int dim, typename DoFHandlerType, typename VectorType>
   boost::optional<Point<dim>>
   FEFieldFunction<dim, DoFHandlerType, VectorType>::get_reference_coordinates(
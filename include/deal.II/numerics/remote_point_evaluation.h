@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_remote_point_evaluation_h
+#define dealii_remote_point_evaluation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class that evaluates finite element functions on a distributed mesh at
+ * an arbitrary set of points, where every process may ask for different
+ * points, and the points do not need to lie on the locally owned part of the
+ * mesh.
+ *
+ * The points are located once, in reinit(): the processes exchange the
+ * bounding boxes of their locally owned part of the mesh (see
+ * GridTools::exchange_local_bounding_boxes()), send each point to the
+ * processes whose bounding boxes contain it, as found by a query in an R-tree
+ * of the boxes of all processes, and the receiving processes find the cells
+ * around the points through the R-tree of a GridTools::Cache object (see
+ * GridTools::distributed_compute_point_locations()). The result is a
+ * fixed communication pattern: each process knows which points it evaluates
+ * for which other process, and from which processes it receives values.
+ *
+ * Every call to evaluate() then only evaluates the given vector on the
+ * locally owned cells that contain points, and sends the values back with
+ * one round of non-blocking point-to-point messages between the processes
+ * that actually exchange data, without any collective communication. This
+ * makes the class suitable for repeated evaluation of changing solution
+ * vectors at fixed points, e.g., for probes, for the coupling of
+ * non-matching meshes, or for the transfer from meshes to particles:
+ * @code
+ *   RemotePointEvaluation<dim> evaluator;
+ *   evaluator.reinit(probe_points, triangulation, mapping);
+ *
+ *   std::vector<Vector<double>> probe_values;
+ *   for (unsigned int step = 0; step < n_steps; ++step)
+ *     {
+ *       ...update solution and its ghost values...;
+ *       evaluator.evaluate(dof_handler, solution, probe_values);
+ *     }
+ * @endcode
+ *
+ * If a point lies on the boundary between the locally owned parts of several
+ * processes, the value computed by the process with the lowest rank is used.
+ * Points that lie outside the mesh are not found on any process, which can
+ * be checked with point_found().
+ *
+ * If the triangulation is not derived from parallel::Triangulation, all
+ * points are located and evaluated on the current process.
+ *
+ * @note reinit() is a collective operation on the communicator of the
+ * triangulation, and so is evaluate(), though the latter only communicates
+ * between processes that exchange points. The object needs to be set up
+ * again if the mesh or the mapping changes.
+ *
+ * @ingroup numerics
+ */
+template <int dim, int spacedim = dim>
+class RemotePointEvaluation : public Subscriptor
+{
+public:
+  /**
+   * Constructor. The object needs to be initialized with reinit() before it
+   * can be used.
+   */
+  RemotePointEvaluation();
+
+  /**
+   * Locate the given @p points, which are the points the current process
+   * wants to evaluate, on the locally owned parts of the @p triangulation
+   * of all processes and set up the communication pattern for evaluate().
+   * The @p mapping is used to find the cells around the points and to
+   * evaluate the finite element functions later on.
+   */
+  void
+  reinit(const std::vector<Point<spacedim>> &points,
+         const Triangulation<dim, spacedim> &triangulation,
+         const Mapping<dim, spacedim> &      mapping =
+           StaticMappingQ1<dim, spacedim>::mapping);
+
+  /**
+   * Evaluate the finite element function given by @p dof_handler and
+   * @p vector at the points given to reinit() on the current process and
+   * return the values of all components in @p values, which is resized to
+   * the number of points. Entries for points that were not found remain
+   * zero.
+   *
+   * The @p dof_handler needs to be based on the triangulation given to
+   * reinit(). For a distributed @p vector, the ghost values of the locally
+   * relevant degrees of freedom need to be up to date, as they are read on
+   * the locally owned cells.
+   */
+  template <typename VectorType>
+  void
+  evaluate(const DoFHandler<dim, spacedim> &                     dof_handler,
+           const VectorType &                                    vector,
+           std::vector<Vector<typename VectorType::value_type>> &values) const;
+
+  /**
+   * Return whether the point with index @p point_index in the list given to
+   * reinit() was found on any process.
+   */
+  bool
+  point_found(const unsigned int point_index) const;
+
+  /**
+   * Return whether all points given to reinit() on the current process were
+   * found.
+   */
+  bool
+  all_points_found() const;
+
+  /**
+   * Return the number of points that the current process evaluates for
+   * itself and for other processes.
+   */
+  unsigned int
+  n_evaluation_points() const;
+
+private:
+  /**
+   * Send the values computed on the current process, stored in
+   * @p send_buffer in the order of the ranks in @p send_ranks, and receive
+   * the values computed for the current process in @p receive_buffer, in the
+   * order of the ranks in @p receive_ranks. Each point occupies
+   * @p bytes_per_point bytes.
+   */
+  void
+  exchange(const std::vector<char> &send_buffer,
+           std::vector<char> &      receive_buffer,
+           const unsigned int       bytes_per_point) const;
+
+  /**
+   * The MPI communicator of the triangulation, or MPI_COMM_SELF for a serial
+   * triangulation.
+   */
+  MPI_Comm communicator;
+
+  /**
+   * Pointer to the triangulation given to reinit().
+   */
+  SmartPointer<const Triangulation<dim, spacedim>, RemotePointEvaluation>
+    triangulation;
+
+  /**
+   * Pointer to the mapping given to reinit().
+   */
+  SmartPointer<const Mapping<dim, spacedim>, RemotePointEvaluation> mapping;
+
+  /**
+   * The locally owned cells that contain points to be evaluated on the
+   * current process, for itself or for other processes.
+   */
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+    cells;
+
+  /**
+   * For each of the @p cells, the reference coordinates of the points in the
+   * cell.
+   */
+  std::vector<std::vector<Point<dim>>> reference_points;
+
+  /**
+   * For each of the @p cells, the position of the values at each of the
+   * reference points in the buffer that is sent to other processes.
+   */
+  std::vector<std::vector<unsigned int>> send_positions;
+
+  /**
+   * The processes the current process sends values to, in increasing order,
+   * and the offsets of their points in the send buffer. The last entry of
+   * @p send_offsets is the total number of points evaluated on the current
+   * process.
+   */
+  std::vector<unsigned int> send_ranks;
+  std::vector<unsigned int> send_offsets;
+
+  /**
+   * The processes the current process receives values from, in increasing
+   * order, and the offsets of their points in the receive buffer.
+   */
+  std::vector<unsigned int> receive_ranks;
+  std::vector<unsigned int> receive_offsets;
+
+  /**
+   * For each point in the receive buffer, the index of the point in the list
+   * given to reinit(), or numbers::invalid_unsigned_int if the value of the
+   * point is already provided by a process with lower rank.
+   */
+  std::vector<unsigned int> receive_point_indices;
+
+  /**
+   * Whether each of the points given to reinit() was found.
+   */
+  std::vector<bool> found;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -319,6 +319,19 @@ class AffineConstraints;
  * the boundary is needed, the pointer stored within the triangulation object
  * is accessed.
  *
+ * The functions interpolate(), create_right_hand_side(), and
+ * integrate_difference() work on the cells in parallel, using the
+ * WorkStream framework. The function objects passed to them are therefore
+ * evaluated on several threads at the same time. Functions that change
+ * member variables when evaluated, for example to cache data, need to
+ * protect them by a Threads::Mutex or store them in a
+ * Threads::ThreadLocalStorage object. Functions::FEFieldFunction does the
+ * latter for its cell hint and relies on GridTools::Cache, which builds its
+ * data structures in a thread-safe way.
+ * The contributions of the cells are added into the result one after the
+ * other in the order of the cells, so the results do not depend on how the
+ * cells are scheduled onto the threads.
+ *
  * @note Instantiations for this template are provided for some vector types,
  * in particular <code>Vector&lt;float&gt;, Vector&lt;double&gt;,
  * BlockVector&lt;float&gt;, BlockVector&lt;double&gt;</code>; others can be
@@ -2594,6 +2607,13 @@ namespace VectorTools
    *   is <i>not</i> continuous, then you will get unpredictable values for
    *   points on or close to the boundary of the cell, as one would expect
    *   when trying to evaluate point values of discontinuous functions.
+   *
+   * @note Every call of this function searches for the cell around the
+   *   point anew. To evaluate a finite element function at many points, use
+   *   Functions::FEFieldFunction::value_list() or
+   *   Functions::FEFieldFunction::vector_value_list() instead. They locate all
+   *   points at once, evaluate all points in a cell together, and can reuse
+   *   the locations for repeated evaluations.
    */
   template <int dim, typename VectorType, int spacedim>
   void
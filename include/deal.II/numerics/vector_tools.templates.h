@@ -23,6 +23,7 @@
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/tria_base.h>
 
@@ -265,6 +266,49 @@ namespace VectorTools
     }
 
 
+    // Scratch data for the parallel loop over all cells in interpolate():
+    // an FEValues object for the generalized support points and storage for
+    // the function values in them, separately for each finite element
+    template <int dim, int spacedim, typename number>
+    struct InterpolateScratchData
+    {
+      InterpolateScratchData(
+        const hp::MappingCollection<dim, spacedim> &mapping,
+        const hp::FECollection<dim, spacedim> &     fe,
+        const hp::QCollection<dim> &                support_quadrature)
+        : fe_values(mapping,
+                    fe,
+                    support_quadrature,
+                    update_quadrature_points | update_jacobians |
+                      update_inverse_jacobians)
+        , function_values(fe.size())
+      {}
+
+      InterpolateScratchData(const InterpolateScratchData &data)
+        : fe_values(data.fe_values.get_mapping_collection(),
+                    data.fe_values.get_fe_collection(),
+                    data.fe_values.get_quadrature_collection(),
+                    data.fe_values.get_update_flags())
+        , function_values(data.function_values.size())
+      {}
+
+      hp::FEValues<dim, spacedim>              fe_values;
+      std::vector<std::vector<Vector<number>>> function_values;
+    };
+
+
+    // The values computed for the degrees of freedom of one cell, and
+    // whether the component mask selects them. The list of degrees of
+    // freedom is empty if the cell is skipped.
+    template <typename number>
+    struct InterpolateCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<number>                  dof_values;
+      std::vector<bool>                    selected;
+    };
+
+
     // Internal implementation of interpolate that takes a generic functor
     // function such that function(cell) is of type
     // Function<spacedim, typename VectorType::value_type>*
@@ -334,18 +378,6 @@ namespace VectorTools
       const hp::FECollection<dim, spacedim> &fe(
         dof_handler.get_fe_collection());
 
-      std::vector<types::global_dof_index> dofs_on_cell(fe.max_dofs_per_cell());
-
-      // Temporary storage for cell-wise interpolation operation. We store a
-      // variant for every fe we encounter to speed up resizing operations.
-      // The first vector is used for local function evaluation. The vector
-      // dof_values is used to store intermediate cell-wise interpolation
-      // results (see the detailed explanation in the for loop further down
-      // below).
-
-      std::vector<std::vector<Vector<number>>> fe_function_values(fe.size());
-      std::vector<std::vector<number>>         fe_dof_values(fe.size());
-
       // We will need two temporary global vectors that store the new values
       // and weights.
       VectorType interpolation;
@@ -375,140 +407,161 @@ namespace VectorTools
       // locations as well as Jacobians and their inverses.
       // the latter are only needed for Hcurl or Hdiv conforming elements,
       // but we'll just always include them.
-      hp::FEValues<dim, spacedim> fe_values(mapping_collection,
-                                            fe,
-                                            support_quadrature,
-                                            update_quadrature_points |
-                                              update_jacobians |
-                                              update_inverse_jacobians);
+      InterpolateScratchData<dim, spacedim, number> sample_scratch_data(
+        mapping_collection, fe, support_quadrature);
+      InterpolateCopyData<number> sample_copy_data;
 
       //
-      // Now loop over all locally owned, active cells.
+      // Now loop over all locally owned, active cells. The local values are
+      // computed in parallel, but added to the global vectors one cell
+      // after the other in the order of the cells.
       //
 
-      for (auto cell : dof_handler.active_cell_iterators())
-        {
-          // If this cell is not locally owned, do nothing.
-          if (!cell->is_locally_owned())
-            continue;
-
-          const unsigned int fe_index = cell->active_fe_index();
-
-          // Do nothing if there are no local degrees of freedom.
-          if (fe[fe_index].dofs_per_cell == 0)
-            continue;
-
-          // Skip processing of the current cell if the function object is
-          // invalid. This is used by interpolate_by_material_id to skip
-          // interpolating over cells with unknown material id.
-          if (!function(cell))
-            continue;
-
-          // Get transformed, generalized support points
-          fe_values.reinit(cell);
-          const std::vector<Point<spacedim>> &generalized_support_points =
-            fe_values.get_present_fe_values().get_quadrature_points();
-
-          // Get indices of the dofs on this cell
-          const auto n_dofs = fe[fe_index].dofs_per_cell;
-          dofs_on_cell.resize(n_dofs);
-          cell->get_dof_indices(dofs_on_cell);
-
-          // Prepare temporary storage
-          auto &function_values = fe_function_values[fe_index];
-          auto &dof_values      = fe_dof_values[fe_index];
-
-          const auto n_components = fe[fe_index].n_components();
-          function_values.resize(generalized_support_points.size(),
-                                 Vector<number>(n_components));
-          dof_values.resize(n_dofs);
-
-          // Get all function values:
-          Assert(n_components == function(cell)->n_components,
-                 ExcDimensionMismatch(dof_handler.get_fe().n_components(),
-                                      function(cell)->n_components));
-          function(cell)->vector_value_list(generalized_support_points,
-                                            function_values);
+      using active_cell_iterator =
+        typename DoFHandlerType<dim, spacedim>::active_cell_iterator;
 
-          {
-            // Before we can average, we have to transform all function values
-            // from the real cell back to the unit cell. We query the finite
-            // element for the correct transformation. Matters get a bit more
-            // complicated because we have to apply said transformation for
-            // every base element.
-
-            const unsigned int offset =
-              apply_transform(fe[fe_index],
-                              /* starting_offset = */ 0,
-                              fe_values,
-                              function_values);
-            (void)offset;
-            Assert(offset == n_components, ExcInternalError());
-          }
+      auto worker = [&](const active_cell_iterator &                  cell,
+                        InterpolateScratchData<dim, spacedim, number> &data,
+                        InterpolateCopyData<number> &copy_data) {
+        copy_data.dof_indices.clear();
 
-          FETools::convert_generalized_support_point_values_to_dof_values(
-            fe[fe_index], function_values, dof_values);
+        // If this cell is not locally owned, do nothing.
+        if (!cell->is_locally_owned())
+          return;
 
-          for (unsigned int i = 0; i < n_dofs; ++i)
-            {
-              const auto &nonzero_components =
-                fe[fe_index].get_nonzero_components(i);
-
-              // Figure out whether the component mask applies. We assume
-              // that we are allowed to set degrees of freedom if at least
-              // one of the components (of the dof) is selected.
-              bool selected = false;
-              for (unsigned int c = 0; c < nonzero_components.size(); ++c)
-                selected =
-                  selected || (nonzero_components[c] && component_mask[c]);
-
-              if (selected)
-                {
-#ifdef DEBUG
-                  // make sure that all selected base elements are indeed
-                  // interpolatory
+        const unsigned int fe_index = cell->active_fe_index();
 
-                  if (const auto fe_system =
-                        dynamic_cast<const FESystem<dim> *>(&fe[fe_index]))
-                    {
-                      const auto index =
-                        fe_system->system_to_base_index(i).first.first;
-                      Assert(fe_system->base_element(index)
-                               .has_generalized_support_points(),
-                             ExcMessage("The component mask supplied to "
-                                        "VectorTools::interpolate selects a "
-                                        "non-interpolatory element."));
-                    }
-#endif
+        // Do nothing if there are no local degrees of freedom.
+        if (fe[fe_index].dofs_per_cell == 0)
+          return;
 
-                  // Add local values to the global vectors
-                  ::dealii::internal::ElementAccess<VectorType>::add(
-                    dof_values[i], dofs_on_cell[i], interpolation);
-                  ::dealii::internal::ElementAccess<VectorType>::add(
-                    typename VectorType::value_type(1.0),
-                    dofs_on_cell[i],
-                    weights);
-                }
-              else
+        // Skip processing of the current cell if the function object is
+        // invalid. This is used by interpolate_by_material_id to skip
+        // interpolating over cells with unknown material id.
+        if (!function(cell))
+          return;
+
+        // Get transformed, generalized support points
+        data.fe_values.reinit(cell);
+        const std::vector<Point<spacedim>> &generalized_support_points =
+          data.fe_values.get_present_fe_values().get_quadrature_points();
+
+        // Get indices of the dofs on this cell
+        const auto n_dofs = fe[fe_index].dofs_per_cell;
+        copy_data.dof_indices.resize(n_dofs);
+        cell->get_dof_indices(copy_data.dof_indices);
+
+        // Prepare temporary storage. The first vector is used for local
+        // function evaluation, the vector dof_values stores intermediate
+        // cell-wise interpolation results (see the detailed explanation
+        // above)
+        auto &function_values = data.function_values[fe_index];
+        auto &dof_values      = copy_data.dof_values;
+
+        const auto n_components = fe[fe_index].n_components();
+        function_values.resize(generalized_support_points.size(),
+                               Vector<number>(n_components));
+        dof_values.resize(n_dofs);
+
+        // Get all function values:
+        Assert(n_components == function(cell)->n_components,
+               ExcDimensionMismatch(dof_handler.get_fe().n_components(),
+                                    function(cell)->n_components));
+        function(cell)->vector_value_list(generalized_support_points,
+                                          function_values);
+
+        {
+          // Before we can average, we have to transform all function values
+          // from the real cell back to the unit cell. We query the finite
+          // element for the correct transformation. Matters get a bit more
+          // complicated because we have to apply said transformation for
+          // every base element.
+
+          const unsigned int offset =
+            apply_transform(fe[fe_index],
+                            /* starting_offset = */ 0,
+                            data.fe_values,
+                            function_values);
+          (void)offset;
+          Assert(offset == n_components, ExcInternalError());
+        }
+
+        FETools::convert_generalized_support_point_values_to_dof_values(
+          fe[fe_index], function_values, dof_values);
+
+        copy_data.selected.resize(n_dofs);
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          {
+            const auto &nonzero_components =
+              fe[fe_index].get_nonzero_components(i);
+
+            // Figure out whether the component mask applies. We assume
+            // that we are allowed to set degrees of freedom if at least
+            // one of the components (of the dof) is selected.
+            bool selected = false;
+            for (unsigned int c = 0; c < nonzero_components.size(); ++c)
+              selected =
+                selected || (nonzero_components[c] && component_mask[c]);
+            copy_data.selected[i] = selected;
+
+#ifdef DEBUG
+            // make sure that all selected base elements are indeed
+            // interpolatory
+            if (selected)
+              if (const auto fe_system =
+                    dynamic_cast<const FESystem<dim> *>(&fe[fe_index]))
                 {
-                  // If a component is ignored, copy the dof values
-                  // from the vector "vec", but only if they are locally
-                  // available
-                  if (locally_owned_dofs.is_element(dofs_on_cell[i]))
-                    {
-                      const auto value =
-                        ::dealii::internal::ElementAccess<VectorType>::get(
-                          vec, dofs_on_cell[i]);
-                      ::dealii::internal::ElementAccess<VectorType>::add(
-                        value, dofs_on_cell[i], interpolation);
-                      ::dealii::internal::ElementAccess<VectorType>::add(
-                        typename VectorType::value_type(1.0),
-                        dofs_on_cell[i],
-                        weights);
-                    }
+                  const auto index =
+                    fe_system->system_to_base_index(i).first.first;
+                  Assert(fe_system->base_element(index)
+                           .has_generalized_support_points(),
+                         ExcMessage("The component mask supplied to "
+                                    "VectorTools::interpolate selects a "
+                                    "non-interpolatory element."));
                 }
-            }
-        } /* loop over dof_handler.active_cell_iterators() */
+#endif
+          }
+      };
+
+      auto copier = [&](const InterpolateCopyData<number> &copy_data) {
+        for (unsigned int i = 0; i < copy_data.dof_indices.size(); ++i)
+          {
+            const types::global_dof_index dof_index = copy_data.dof_indices[i];
+            if (copy_data.selected[i])
+              {
+                // Add local values to the global vectors
+                ::dealii::internal::ElementAccess<VectorType>::add(
+                  copy_data.dof_values[i], dof_index, interpolation);
+                ::dealii::internal::ElementAccess<VectorType>::add(
+                  typename VectorType::value_type(1.0), dof_index, weights);
+              }
+            else
+              {
+                // If a component is ignored, copy the dof values
+                // from the vector "vec", but only if they are locally
+                // available
+                if (locally_owned_dofs.is_element(dof_index))
+                  {
+                    const auto value =
+                      ::dealii::internal::ElementAccess<VectorType>::get(
+                        vec, dof_index);
+                    ::dealii::internal::ElementAccess<VectorType>::add(
+                      value, dof_index, interpolation);
+                    ::dealii::internal::ElementAccess<VectorType>::add(
+                      typename VectorType::value_type(1.0),
+                      dof_index,
+                      weights);
+                  }
+              }
+          }
+      };
+
+      WorkStream::run(dof_handler.begin_active(),
+                      static_cast<active_cell_iterator>(dof_handler.end()),
+                      worker,
+                      copier,
+                      sample_scratch_data,
+                      sample_copy_data);
 
       interpolation.compress(VectorOperation::add);
       weights.compress(VectorOperation::add);
@@ -1899,123 +1952,195 @@ namespace VectorTools
 
 
 
-  template <int dim, int spacedim, typename VectorType>
-  void
-  create_right_hand_side(
-    const Mapping<dim, spacedim> &                             mapping,
-    const DoFHandler<dim, spacedim> &                          dof_handler,
-    const Quadrature<dim> &                                    quadrature,
-    const Function<spacedim, typename VectorType::value_type> &rhs_function,
-    VectorType &                                               rhs_vector,
-    const AffineConstraints<typename VectorType::value_type> & constraints)
+  namespace internal
   {
-    using Number = typename VectorType::value_type;
+    // Scratch data for the parallel loop over all cells in
+    // create_right_hand_side()
+    template <int dim, int spacedim, typename Number>
+    struct RHSScratchData
+    {
+      RHSScratchData(const hp::MappingCollection<dim, spacedim> &mapping,
+                     const hp::FECollection<dim, spacedim> &     fe,
+                     const hp::QCollection<dim> &                quadrature,
+                     const UpdateFlags                           update_flags)
+        : x_fe_values(mapping, fe, quadrature, update_flags)
+      {}
+
+      RHSScratchData(const RHSScratchData &data)
+        : x_fe_values(data.x_fe_values.get_mapping_collection(),
+                      data.x_fe_values.get_fe_collection(),
+                      data.x_fe_values.get_quadrature_collection(),
+                      data.x_fe_values.get_update_flags())
+      {}
+
+      hp::FEValues<dim, spacedim> x_fe_values;
+      std::vector<Number>         rhs_values;
+      std::vector<Vector<Number>> rhs_vector_values;
+    };
 
-    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-    Assert(fe.n_components() == rhs_function.n_components,
-           ExcDimensionMismatch(fe.n_components(), rhs_function.n_components));
-    Assert(rhs_vector.size() == dof_handler.n_dofs(),
-           ExcDimensionMismatch(rhs_vector.size(), dof_handler.n_dofs()));
-    rhs_vector = typename VectorType::value_type(0.);
 
-    UpdateFlags update_flags =
-      UpdateFlags(update_values | update_quadrature_points | update_JxW_values);
-    FEValues<dim, spacedim> fe_values(mapping, fe, quadrature, update_flags);
+    // The contribution of one cell to the right hand side. The list of
+    // degrees of freedom is empty for cells that are not locally owned.
+    template <typename Number>
+    struct RHSCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      Vector<Number>                       cell_vector;
+    };
 
-    const unsigned int dofs_per_cell = fe_values.dofs_per_cell,
-                       n_q_points    = fe_values.n_quadrature_points,
-                       n_components  = fe.n_components();
 
-    std::vector<types::global_dof_index> dofs(dofs_per_cell);
-    Vector<Number>                       cell_vector(dofs_per_cell);
+    // Implementation of create_right_hand_side() for both the DoFHandler and
+    // the hp::DoFHandler classes. The cell contributions are computed in
+    // parallel, but added to the global vector one cell after the other in
+    // the order of the cells.
+    template <int dim,
+              int spacedim,
+              typename DoFHandlerType,
+              typename VectorType>
+    void
+    do_create_right_hand_side(
+      const hp::MappingCollection<dim, spacedim> &               mapping,
+      const DoFHandlerType &                                     dof_handler,
+      const hp::QCollection<dim> &                               quadrature,
+      const Function<spacedim, typename VectorType::value_type> &rhs_function,
+      VectorType &                                               rhs_vector,
+      const AffineConstraints<typename VectorType::value_type> & constraints)
+    {
+      using Number = typename VectorType::value_type;
 
-    typename DoFHandler<dim, spacedim>::active_cell_iterator
-      cell = dof_handler.begin_active(),
-      endc = dof_handler.end();
+      const hp::FECollection<dim, spacedim> &fe =
+        dof_handler.get_fe_collection();
+      Assert(fe.n_components() == rhs_function.n_components,
+             ExcDimensionMismatch(fe.n_components(),
+                                  rhs_function.n_components));
+      Assert(rhs_vector.size() == dof_handler.n_dofs(),
+             ExcDimensionMismatch(rhs_vector.size(), dof_handler.n_dofs()));
+      rhs_vector = Number(0.);
+
+      const UpdateFlags update_flags = UpdateFlags(
+        update_values | update_quadrature_points | update_JxW_values);
+      RHSScratchData<dim, spacedim, Number> sample_scratch_data(mapping,
+                                                                fe,
+                                                                quadrature,
+                                                                update_flags);
+
+      const unsigned int n_components = fe.n_components();
+
+      using active_cell_iterator =
+        typename DoFHandlerType::active_cell_iterator;
+
+      auto worker = [&](const active_cell_iterator &             cell,
+                        RHSScratchData<dim, spacedim, Number> &data,
+                        RHSCopyData<Number> &                  copy_data) {
+        copy_data.dof_indices.clear();
+        if (!cell->is_locally_owned())
+          return;
 
-    if (n_components == 1)
-      {
-        std::vector<Number> rhs_values(n_q_points);
+        data.x_fe_values.reinit(cell);
 
-        for (; cell != endc; ++cell)
-          if (cell->is_locally_owned())
-            {
-              fe_values.reinit(cell);
+        const FEValues<dim, spacedim> &fe_values =
+          data.x_fe_values.get_present_fe_values();
+        const FiniteElement<dim, spacedim> &cell_fe = fe_values.get_fe();
 
-              const std::vector<double> &weights = fe_values.get_JxW_values();
-              rhs_function.value_list(fe_values.get_quadrature_points(),
-                                      rhs_values);
+        const unsigned int dofs_per_cell = fe_values.dofs_per_cell,
+                           n_q_points    = fe_values.n_quadrature_points;
+        const std::vector<double> &weights = fe_values.get_JxW_values();
 
-              cell_vector = 0;
-              for (unsigned int point = 0; point < n_q_points; ++point)
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  cell_vector(i) += rhs_values[point] *
-                                    fe_values.shape_value(i, point) *
-                                    weights[point];
+        Vector<Number> &cell_vector = copy_data.cell_vector;
+        cell_vector.reinit(dofs_per_cell);
 
-              cell->get_dof_indices(dofs);
+        if (n_components == 1)
+          {
+            data.rhs_values.resize(n_q_points);
+            rhs_function.value_list(fe_values.get_quadrature_points(),
+                                    data.rhs_values);
+
+            for (unsigned int point = 0; point < n_q_points; ++point)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                cell_vector(i) += data.rhs_values[point] *
+                                  fe_values.shape_value(i, point) *
+                                  weights[point];
+          }
+        else
+          {
+            data.rhs_vector_values.resize(n_q_points,
+                                          Vector<Number>(n_components));
+            rhs_function.vector_value_list(fe_values.get_quadrature_points(),
+                                           data.rhs_vector_values);
+
+            // Use the faster code if the
+            // FiniteElement is primitive
+            if (cell_fe.is_primitive())
+              {
+                for (unsigned int point = 0; point < n_q_points; ++point)
+                  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                    {
+                      const unsigned int component =
+                        cell_fe.system_to_component_index(i).first;
 
-              constraints.distribute_local_to_global(cell_vector,
-                                                     dofs,
-                                                     rhs_vector);
-            }
-      }
-    else
-      {
-        std::vector<Vector<Number>> rhs_values(n_q_points,
-                                               Vector<Number>(n_components));
+                      cell_vector(i) +=
+                        data.rhs_vector_values[point](component) *
+                        fe_values.shape_value(i, point) * weights[point];
+                    }
+              }
+            else
+              {
+                // Otherwise do it the way
+                // proposed for vector valued
+                // elements
+                for (unsigned int point = 0; point < n_q_points; ++point)
+                  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                    for (unsigned int comp_i = 0; comp_i < n_components;
+                         ++comp_i)
+                      if (cell_fe.get_nonzero_components(i)[comp_i])
+                        {
+                          cell_vector(i) +=
+                            data.rhs_vector_values[point](comp_i) *
+                            fe_values.shape_value_component(i, point, comp_i) *
+                            weights[point];
+                        }
+              }
+          }
 
-        for (; cell != endc; ++cell)
-          if (cell->is_locally_owned())
-            {
-              fe_values.reinit(cell);
+        copy_data.dof_indices.resize(dofs_per_cell);
+        cell->get_dof_indices(copy_data.dof_indices);
+      };
 
-              const std::vector<double> &weights = fe_values.get_JxW_values();
-              rhs_function.vector_value_list(fe_values.get_quadrature_points(),
-                                             rhs_values);
+      auto copier = [&](const RHSCopyData<Number> &copy_data) {
+        if (copy_data.dof_indices.size() > 0)
+          constraints.distribute_local_to_global(copy_data.cell_vector,
+                                                 copy_data.dof_indices,
+                                                 rhs_vector);
+      };
 
-              cell_vector = 0;
-              // Use the faster code if the
-              // FiniteElement is primitive
-              if (fe.is_primitive())
-                {
-                  for (unsigned int point = 0; point < n_q_points; ++point)
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        const unsigned int component =
-                          fe.system_to_component_index(i).first;
+      WorkStream::run(dof_handler.begin_active(),
+                      static_cast<active_cell_iterator>(dof_handler.end()),
+                      worker,
+                      copier,
+                      sample_scratch_data,
+                      RHSCopyData<Number>());
+    }
+  } // namespace internal
 
-                        cell_vector(i) += rhs_values[point](component) *
-                                          fe_values.shape_value(i, point) *
-                                          weights[point];
-                      }
-                }
-              else
-                {
-                  // Otherwise do it the way
-                  // proposed for vector valued
-                  // elements
-                  for (unsigned int point = 0; point < n_q_points; ++point)
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      for (unsigned int comp_i = 0; comp_i < n_components;
-                           ++comp_i)
-                        if (fe.get_nonzero_components(i)[comp_i])
-                          {
-                            cell_vector(i) +=
-                              rhs_values[point](comp_i) *
-                              fe_values.shape_value_component(i,
-                                                              point,
-                                                              comp_i) *
-                              weights[point];
-                          }
-                }
-              cell->get_dof_indices(dofs);
 
-              constraints.distribute_local_to_global(cell_vector,
-                                                     dofs,
-                                                     rhs_vector);
-            }
-      }
+
+  template <int dim, int spacedim, typename VectorType>
+  void
+  create_right_hand_side(
+    const Mapping<dim, spacedim> &                             mapping,
+    const DoFHandler<dim, spacedim> &                          dof_handler,
+    const Quadrature<dim> &                                    quadrature,
+    const Function<spacedim, typename VectorType::value_type> &rhs_function,
+    VectorType &                                               rhs_vector,
+    const AffineConstraints<typename VectorType::value_type> & constraints)
+  {
+    internal::do_create_right_hand_side(
+      hp::MappingCollection<dim, spacedim>(mapping),
+      dof_handler,
+      hp::QCollection<dim>(quadrature),
+      rhs_function,
+      rhs_vector,
+      constraints);
   }
 
 
@@ -2049,132 +2174,12 @@ namespace VectorTools
     VectorType &                                               rhs_vector,
     const AffineConstraints<typename VectorType::value_type> & constraints)
   {
-    using Number = typename VectorType::value_type;
-
-    const hp::FECollection<dim, spacedim> &fe = dof_handler.get_fe_collection();
-    Assert(fe.n_components() == rhs_function.n_components,
-           ExcDimensionMismatch(fe.n_components(), rhs_function.n_components));
-    Assert(rhs_vector.size() == dof_handler.n_dofs(),
-           ExcDimensionMismatch(rhs_vector.size(), dof_handler.n_dofs()));
-    rhs_vector = 0;
-
-    UpdateFlags update_flags =
-      UpdateFlags(update_values | update_quadrature_points | update_JxW_values);
-    hp::FEValues<dim, spacedim> x_fe_values(mapping,
-                                            fe,
-                                            quadrature,
-                                            update_flags);
-
-    const unsigned int n_components = fe.n_components();
-
-    std::vector<types::global_dof_index> dofs(fe.max_dofs_per_cell());
-    Vector<Number>                       cell_vector(fe.max_dofs_per_cell());
-
-    typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
-      cell = dof_handler.begin_active(),
-      endc = dof_handler.end();
-
-    if (n_components == 1)
-      {
-        std::vector<Number> rhs_values;
-
-        for (; cell != endc; ++cell)
-          if (cell->is_locally_owned())
-            {
-              x_fe_values.reinit(cell);
-
-              const FEValues<dim, spacedim> &fe_values =
-                x_fe_values.get_present_fe_values();
-
-              const unsigned int dofs_per_cell = fe_values.dofs_per_cell,
-                                 n_q_points    = fe_values.n_quadrature_points;
-              rhs_values.resize(n_q_points);
-              dofs.resize(dofs_per_cell);
-              cell_vector.reinit(dofs_per_cell);
-
-              const std::vector<Number> &weights = fe_values.get_JxW_values();
-              rhs_function.value_list(fe_values.get_quadrature_points(),
-                                      rhs_values);
-
-              cell_vector = 0;
-              for (unsigned int point = 0; point < n_q_points; ++point)
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  cell_vector(i) += rhs_values[point] *
-                                    fe_values.shape_value(i, point) *
-                                    weights[point];
-
-              cell->get_dof_indices(dofs);
-
-              constraints.distribute_local_to_global(cell_vector,
-                                                     dofs,
-                                                     rhs_vector);
-            }
-      }
-    else
-      {
-        std::vector<Vector<Number>> rhs_values;
-
-        for (; cell != endc; ++cell)
-          if (cell->is_locally_owned())
-            {
-              x_fe_values.reinit(cell);
-
-              const FEValues<dim, spacedim> &fe_values =
-                x_fe_values.get_present_fe_values();
-
-              const unsigned int dofs_per_cell = fe_values.dofs_per_cell,
-                                 n_q_points    = fe_values.n_quadrature_points;
-              rhs_values.resize(n_q_points, Vector<Number>(n_components));
-              dofs.resize(dofs_per_cell);
-              cell_vector.reinit(dofs_per_cell);
-
-              const std::vector<Number> &weights = fe_values.get_JxW_values();
-              rhs_function.vector_value_list(fe_values.get_quadrature_points(),
-                                             rhs_values);
-
-              cell_vector = 0;
-
-              // Use the faster code if the
-              // FiniteElement is primitive
-              if (cell->get_fe().is_primitive())
-                {
-                  for (unsigned int point = 0; point < n_q_points; ++point)
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        const unsigned int component =
-                          cell->get_fe().system_to_component_index(i).first;
-
-                        cell_vector(i) += rhs_values[point](component) *
-                                          fe_values.shape_value(i, point) *
-                                          weights[point];
-                      }
-                }
-              else
-                {
-                  // Otherwise do it the way proposed
-                  // for vector valued elements
-                  for (unsigned int point = 0; point < n_q_points; ++point)
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      for (unsigned int comp_i = 0; comp_i < n_components;
-                           ++comp_i)
-                        if (cell->get_fe().get_nonzero_components(i)[comp_i])
-                          {
-                            cell_vector(i) +=
-                              rhs_values[point](comp_i) *
-                              fe_values.shape_value_component(i,
-                                                              point,
-                                                              comp_i) *
-                              weights[point];
-                          }
-                }
-
-              cell->get_dof_indices(dofs);
-
-              constraints.distribute_local_to_global(cell_vector,
-                                                     dofs,
-                                                     rhs_vector);
-            }
-      }
+    internal::do_create_right_hand_side(mapping,
+                                        dof_handler,
+                                        quadrature,
+                                        rhs_function,
+                                        rhs_vector,
+                                        constraints);
   }
 
 
@@ -7806,6 +7811,14 @@ namespace VectorTools
     };
 
 
+    // the result of integrate_difference_inner() for one cell
+    struct IDCopyData
+    {
+      unsigned int active_cell_index;
+      double       value;
+    };
+
+
     template <int dim, int spacedim, typename Number>
     IDScratchData<dim, spacedim, Number>::IDScratchData(
       const dealii::hp::MappingCollection<dim, spacedim> &mapping,
@@ -8253,40 +8266,58 @@ namespace VectorTools
                                                 q,
                                                 update_flags);
 
-      // loop over all cells
-      for (typename DoFHandlerType::active_cell_iterator cell =
-             dof.begin_active();
-           cell != dof.end();
-           ++cell)
-        if (cell->is_locally_owned())
+      // loop over all cells. the cells are independent of each other, so
+      // they are worked on in parallel, and each result is written into its
+      // own entry of the output vector
+      using active_cell_iterator =
+        typename DoFHandlerType::active_cell_iterator;
+
+      auto worker = [&](const active_cell_iterator &            cell,
+                        IDScratchData<dim, spacedim, Number> &data,
+                        IDCopyData &                          copy_data) {
+        copy_data.active_cell_index = cell->active_cell_index();
+
+        // the cell is a ghost cell or is artificial. write a zero into the
+        // corresponding value of the returned vector
+        if (!cell->is_locally_owned())
           {
-            // initialize for this cell
-            data.x_fe_values.reinit(cell);
-
-            const dealii::FEValues<dim, spacedim> &fe_values =
-              data.x_fe_values.get_present_fe_values();
-            const unsigned int n_q_points = fe_values.n_quadrature_points;
-            data.resize_vectors(n_q_points, n_components);
-
-            if (update_flags & update_values)
-              fe_values.get_function_values(fe_function, data.function_values);
-            if (update_flags & update_gradients)
-              fe_values.get_function_gradients(fe_function,
-                                               data.function_grads);
-
-            difference(cell->active_cell_index()) =
-              integrate_difference_inner<dim, spacedim, Number>(exact_solution,
-                                                                norm,
-                                                                weight,
-                                                                update_flags,
-                                                                exponent,
-                                                                n_components,
-                                                                data);
+            copy_data.value = 0;
+            return;
           }
-        else
-          // the cell is a ghost cell or is artificial. write a zero into the
-          // corresponding value of the returned vector
-          difference(cell->active_cell_index()) = 0;
+
+        // initialize for this cell
+        data.x_fe_values.reinit(cell);
+
+        const dealii::FEValues<dim, spacedim> &fe_values =
+          data.x_fe_values.get_present_fe_values();
+        const unsigned int n_q_points = fe_values.n_quadrature_points;
+        data.resize_vectors(n_q_points, n_components);
+
+        if (update_flags & update_values)
+          fe_values.get_function_values(fe_function, data.function_values);
+        if (update_flags & update_gradients)
+          fe_values.get_function_gradients(fe_function, data.function_grads);
+
+        copy_data.value =
+          integrate_difference_inner<dim, spacedim, Number>(exact_solution,
+                                                            norm,
+                                                            weight,
+                                                            update_flags,
+                                                            exponent,
+                                                            n_components,
+                                                            data);
+      };
+
+      auto copier = [&](const IDCopyData &copy_data) {
+        difference(copy_data.active_cell_index) = copy_data.value;
+      };
+
+      WorkStream::run(dof.begin_active(),
+                      static_cast<active_cell_iterator>(dof.end()),
+                      worker,
+                      copier,
+                      data,
+                      IDCopyData());
     }
 
   } // namespace internal
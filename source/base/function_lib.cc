@@ -19,6 +19,7 @@
 #include <deal.II/base/point.h>
 #include <deal.II/base/std_cxx17/cmath.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/vector.h>
 
@@ -29,6 +30,76 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Functions
 {
+  namespace
+  {
+    // Evaluate some of the functions below at points with the number type
+    // used for the vectorized_value() functions
+    template <int dim, typename Number>
+    Number
+    pillow_value(const Point<dim, Number> &p, const double offset)
+    {
+      switch (dim)
+        {
+          case 1:
+            return 1. - p(0) * p(0) + offset;
+          case 2:
+            return (1. - p(0) * p(0)) * (1. - p(1) * p(1)) + offset;
+          case 3:
+            return (1. - p(0) * p(0)) * (1. - p(1) * p(1)) *
+                     (1. - p(2) * p(2)) +
+                   offset;
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+      return Number();
+    }
+
+
+
+    template <int dim, typename Number>
+    Number
+    cosine_value(const Point<dim, Number> &p)
+    {
+      switch (dim)
+        {
+          case 1:
+            return std::cos(numbers::PI_2 * p(0));
+          case 2:
+            return std::cos(numbers::PI_2 * p(0)) *
+                   std::cos(numbers::PI_2 * p(1));
+          case 3:
+            return std::cos(numbers::PI_2 * p(0)) *
+                   std::cos(numbers::PI_2 * p(1)) *
+                   std::cos(numbers::PI_2 * p(2));
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+      return Number();
+    }
+
+
+
+    template <int dim, typename Number>
+    Number
+    exp_value(const Point<dim, Number> &p)
+    {
+      switch (dim)
+        {
+          case 1:
+            return std::exp(p(0));
+          case 2:
+            return std::exp(p(0)) * std::exp(p(1));
+          case 3:
+            return std::exp(p(0)) * std::exp(p(1)) * std::exp(p(2));
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+      return Number();
+    }
+  } // namespace
+
+
+
   template <int dim>
   double
   SquareFunction<dim>::value(const Point<dim> &p, const unsigned int) const
@@ -37,6 +108,26 @@ namespace Functions
   }
 
 
+  template <int dim>
+  VectorizedArray<double>
+  SquareFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    return p.square();
+  }
+
+
+  template <int dim>
+  VectorizedArray<float>
+  SquareFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int) const
+  {
+    return p.square();
+  }
+
+
   template <int dim>
   void
   SquareFunction<dim>::vector_value(const Point<dim> &p,
@@ -134,6 +225,30 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  Q1WedgeFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    Assert(dim >= 2, ExcInternalError());
+    return p(0) * p(1);
+  }
+
+
+
+  template <int dim>
+  VectorizedArray<float>
+  Q1WedgeFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int) const
+  {
+    Assert(dim >= 2, ExcInternalError());
+    return p(0) * p(1);
+  }
+
+
+
   template <int dim>
   void
   Q1WedgeFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -275,6 +390,24 @@ namespace Functions
     return 0.;
   }
 
+  template <int dim>
+  VectorizedArray<double>
+  PillowFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    return pillow_value(p, offset);
+  }
+
+  template <int dim>
+  VectorizedArray<float>
+  PillowFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int) const
+  {
+    return pillow_value(p, offset);
+  }
+
   template <int dim>
   void
   PillowFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -449,6 +582,24 @@ namespace Functions
     return 0.;
   }
 
+  template <int dim>
+  VectorizedArray<double>
+  CosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    return cosine_value(p);
+  }
+
+  template <int dim>
+  VectorizedArray<float>
+  CosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int) const
+  {
+    return cosine_value(p);
+  }
+
   template <int dim>
   void
   CosineFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -1038,6 +1189,24 @@ namespace Functions
     return 0.;
   }
 
+  template <int dim>
+  VectorizedArray<double>
+  ExpFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int) const
+  {
+    return exp_value(p);
+  }
+
+  template <int dim>
+  VectorizedArray<float>
+  ExpFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int) const
+  {
+    return exp_value(p);
+  }
+
   template <int dim>
   void
   ExpFunction<dim>::value_list(const std::vector<Point<dim>> &points,
@@ -1945,6 +2114,32 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  FourierCosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(component == 0, ExcIndexRange(component, 0, 1));
+    return std::cos(fourier_coefficients * p);
+  }
+
+
+
+  template <int dim>
+  VectorizedArray<float>
+  FourierCosineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int                        component) const
+  {
+    (void)component;
+    Assert(component == 0, ExcIndexRange(component, 0, 1));
+    return std::cos(fourier_coefficients * p);
+  }
+
+
+
   template <int dim>
   Tensor<1, dim>
   FourierCosineFunction<dim>::gradient(const Point<dim> & p,
@@ -1995,6 +2190,32 @@ namespace Functions
 
 
 
+  template <int dim>
+  VectorizedArray<double>
+  FourierSineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(component == 0, ExcIndexRange(component, 0, 1));
+    return std::sin(fourier_coefficients * p);
+  }
+
+
+
+  template <int dim>
+  VectorizedArray<float>
+  FourierSineFunction<dim>::vectorized_value(
+    const Point<dim, VectorizedArray<float>> &p,
+    const unsigned int                        component) const
+  {
+    (void)component;
+    Assert(component == 0, ExcIndexRange(component, 0, 1));
+    return std::sin(fourier_coefficients * p);
+  }
+
+
+
   template <int dim>
   Tensor<1, dim>
   FourierSineFunction<dim>::gradient(const Point<dim> & p,
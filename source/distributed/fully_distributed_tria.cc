@@ -0,0 +1,442 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const types::subdomain_id                   my_subdomain)
+    {
+      // a shared triangulation might have artificial cells, so ask it for the
+      // true owners of the cells
+      const auto *shared_tria =
+        dynamic_cast<const parallel::shared::Triangulation<dim, spacedim> *>(
+          &tria);
+      const auto owner =
+        [&](const typename dealii::Triangulation<dim, spacedim>::
+              active_cell_iterator &cell) -> types::subdomain_id {
+        if (shared_tria != nullptr)
+          return shared_tria->get_true_subdomain_ids_of_cells()
+            [cell->active_cell_index()];
+        else
+          return cell->subdomain_id();
+      };
+
+      // the relevant active cells are the locally owned ones and the ones
+      // sharing a vertex with them
+      std::vector<bool> vertex_is_owned(tria.n_vertices(), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        if (owner(cell) == my_subdomain)
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            vertex_is_owned[cell->vertex_index(v)] = true;
+
+      // flag the relevant active cells and all of their ancestors
+      std::vector<std::vector<bool>> cell_is_relevant(tria.n_levels());
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        cell_is_relevant[level].resize(tria.n_raw_cells(level), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          bool is_relevant = false;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            if (vertex_is_owned[cell->vertex_index(v)])
+              {
+                is_relevant = true;
+                break;
+              }
+          if (is_relevant == false)
+            continue;
+
+          // stop as soon as we reach an ancestor that another descendant has
+          // already flagged, since its own ancestors are flagged as well
+          cell_is_relevant[cell->level()][cell->index()] = true;
+          typename dealii::Triangulation<dim, spacedim>::cell_iterator
+            ancestor = cell;
+          while (ancestor->level() > 0)
+            {
+              ancestor = ancestor->parent();
+              if (cell_is_relevant[ancestor->level()][ancestor->index()])
+                break;
+              cell_is_relevant[ancestor->level()][ancestor->index()] = true;
+            }
+        }
+
+      ConstructionData<dim, spacedim> construction_data;
+
+      // copy the relevant coarse cells, numbering their vertices compactly
+      std::vector<unsigned int> new_vertex_index(tria.n_vertices(),
+                                                 numbers::invalid_unsigned_int);
+      for (const auto &cell : tria.cell_iterators_on_level(0))
+        if (cell_is_relevant[0][cell->index()])
+          {
+            dealii::CellData<dim> coarse_cell;
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              {
+                const unsigned int vertex = cell->vertex_index(v);
+                if (new_vertex_index[vertex] == numbers::invalid_unsigned_int)
+                  {
+                    new_vertex_index[vertex] =
+                      construction_data.coarse_cell_vertices.size();
+                    construction_data.coarse_cell_vertices.push_back(
+                      cell->vertex(v));
+                  }
+                coarse_cell.vertices[v] = new_vertex_index[vertex];
+              }
+            coarse_cell.material_id = cell->material_id();
+            coarse_cell.manifold_id = cell->manifold_id();
+            construction_data.coarse_cells.push_back(coarse_cell);
+            construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+              tria.coarse_cell_index_to_coarse_cell_id(cell->index()));
+          }
+
+      // then describe the relevant cells on all levels
+      construction_data.cell_infos.resize(tria.n_levels());
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        for (const auto &cell : tria.cell_iterators_on_level(level))
+          if (cell_is_relevant[level][cell->index()])
+            {
+              CellData<dim> cell_info;
+              cell_info.id = cell->id().template to_binary<dim>();
+              if (cell->active())
+                cell_info.subdomain_id = owner(cell);
+              cell_info.manifold_id = cell->manifold_id();
+              cell_info.manifold_line_ids.fill(numbers::flat_manifold_id);
+              cell_info.manifold_quad_ids.fill(numbers::flat_manifold_id);
+              if (dim > 1)
+                for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                     ++l)
+                  cell_info.manifold_line_ids[l] = cell->line(l)->manifold_id();
+              if (dim == 3)
+                for (unsigned int q = 0; q < GeometryInfo<dim>::quads_per_cell;
+                     ++q)
+                  cell_info.manifold_quad_ids[q] = cell->quad(q)->manifold_id();
+              for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                   ++f)
+                if (cell->at_boundary(f))
+                  cell_info.boundary_ids.emplace_back(
+                    f, cell->face(f)->boundary_id());
+
+              construction_data.cell_infos[level].push_back(cell_info);
+            }
+
+      return construction_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    save_construction_data(
+      const ConstructionData<dim, spacedim> &construction_data,
+      const std::string &                    filename)
+    {
+      std::ofstream out(filename, std::ios::binary);
+      AssertThrow(out, ExcFileNotOpen(filename));
+      boost::archive::binary_oarchive archive(out);
+      archive << construction_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    load_construction_data(const std::string &              filename,
+                           ConstructionData<dim, spacedim> &construction_data)
+    {
+      std::ifstream in(filename, std::ios::binary);
+      AssertThrow(in, ExcFileNotOpen(filename));
+      boost::archive::binary_iarchive archive(in);
+      archive >> construction_data;
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    namespace
+    {
+      /**
+       * Set the manifold ids of the quads of @p cell. This is a separate
+       * function because cells in 1d do not have quads to be accessed.
+       */
+      template <int dim, int spacedim>
+      void
+      set_quad_manifold_ids(
+        const TriaIterator<CellAccessor<dim, spacedim>> &cell,
+        const std::array<types::manifold_id,
+                         GeometryInfo<dim>::quads_per_cell> &manifold_ids)
+      {
+        for (unsigned int q = 0; q < GeometryInfo<dim>::quads_per_cell; ++q)
+          cell->quad(q)->set_manifold_id(manifold_ids[q]);
+      }
+
+
+
+      template <int spacedim>
+      void
+      set_quad_manifold_ids(
+        const TriaIterator<CellAccessor<1, spacedim>> &,
+        const std::array<types::manifold_id,
+                         GeometryInfo<1>::quads_per_cell> &)
+      {}
+    } // namespace
+
+
+
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::Triangulation(MPI_Comm mpi_communicator)
+      : parallel::Triangulation<dim, spacedim>(mpi_communicator)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const ConstructionData<dim, spacedim> &construction_data)
+    {
+      AssertThrow(construction_data.coarse_cells.size() ==
+                    construction_data.coarse_cell_index_to_coarse_cell_id
+                      .size(),
+                  ExcDimensionMismatch(
+                    construction_data.coarse_cells.size(),
+                    construction_data.coarse_cell_index_to_coarse_cell_id
+                      .size()));
+
+      // set up the translation between global ids and local indices of the
+      // coarse cells first, since the CellId objects below rely on it
+      coarse_cell_index_to_coarse_cell_id_vector =
+        construction_data.coarse_cell_index_to_coarse_cell_id;
+      coarse_cell_id_to_coarse_cell_index_vector.clear();
+      for (unsigned int i = 0;
+           i < coarse_cell_index_to_coarse_cell_id_vector.size();
+           ++i)
+        coarse_cell_id_to_coarse_cell_index_vector.emplace_back(
+          coarse_cell_index_to_coarse_cell_id_vector[i], i);
+      std::sort(coarse_cell_id_to_coarse_cell_index_vector.begin(),
+                coarse_cell_id_to_coarse_cell_index_vector.end());
+
+      dealii::Triangulation<dim, spacedim>::create_triangulation(
+        construction_data.coarse_cell_vertices,
+        construction_data.coarse_cells,
+        SubCellData());
+
+      // recreate the refinement hierarchy level by level. the manifold and
+      // boundary ids need to be set before refining, such that the children
+      // are placed on the correct manifolds and inherit the boundary ids
+      for (unsigned int level = 0; level < construction_data.cell_infos.size();
+           ++level)
+        {
+          for (const auto &cell_info : construction_data.cell_infos[level])
+            {
+              const cell_iterator cell = CellId(cell_info.id).to_cell(*this);
+
+              cell->set_manifold_id(cell_info.manifold_id);
+              if (dim > 1)
+                for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                     ++l)
+                  cell->line(l)->set_manifold_id(
+                    cell_info.manifold_line_ids[l]);
+              if (dim == 3)
+                set_quad_manifold_ids(cell, cell_info.manifold_quad_ids);
+              for (const auto &boundary_id : cell_info.boundary_ids)
+                cell->face(boundary_id.first)
+                  ->set_boundary_id(boundary_id.second);
+            }
+
+          if (level + 1 == construction_data.cell_infos.size())
+            break;
+
+          for (const auto &cell_info : construction_data.cell_infos[level + 1])
+            {
+              const cell_iterator parent =
+                CellId(cell_info.id).parent_cell_id().to_cell(*this);
+              if (parent->active())
+                parent->set_refine_flag();
+            }
+          dealii::Triangulation<dim, spacedim>::
+            execute_coarsening_and_refinement();
+        }
+
+      // all cells not described are artificial
+      for (const auto &cell : this->active_cell_iterators())
+        cell->set_subdomain_id(numbers::artificial_subdomain_id);
+      for (const auto &level_cell_infos : construction_data.cell_infos)
+        for (const auto &cell_info : level_cell_infos)
+          {
+            const cell_iterator cell = CellId(cell_info.id).to_cell(*this);
+            if (cell->active())
+              cell->set_subdomain_id(cell_info.subdomain_id);
+          }
+
+      this->update_number_cache();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const std::vector<Point<spacedim>> & /*vertices*/,
+      const std::vector<dealii::CellData<dim>> & /*cells*/,
+      const SubCellData & /*subcelldata*/)
+    {
+      AssertThrow(false,
+                  ExcMessage(
+                    "parallel::fullydistributed::Triangulation can only be "
+                    "created from a ConstructionData object."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::copy_triangulation(
+      const dealii::Triangulation<dim, spacedim> & /*other_tria*/)
+    {
+      AssertThrow(false,
+                  ExcMessage(
+                    "parallel::fullydistributed::Triangulation can only be "
+                    "created from a ConstructionData object. Use "
+                    "create_construction_data_from_triangulation() to "
+                    "describe the part of another triangulation needed "
+                    "on the current processor."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
+    {
+      AssertThrow(false,
+                  ExcMessage(
+                    "parallel::fullydistributed::Triangulation does not "
+                    "support adaptive refinement or coarsening."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::has_hanging_nodes() const
+    {
+      // a hanging node exists if a locally owned cell has a face neighbor on
+      // a different level. this covers all hanging nodes since every face
+      // with a hanging node is adjacent to a locally owned cell on some
+      // processor
+      bool have_hanging_nodes = false;
+      for (const auto &cell : this->active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                 ++f)
+              if (cell->at_boundary(f) == false &&
+                  (cell->neighbor_is_coarser(f) ||
+                   cell->face(f)->has_children()))
+                {
+                  have_hanging_nodes = true;
+                  break;
+                }
+            if (have_hanging_nodes)
+              break;
+          }
+
+      return 0 < Utilities::MPI::max(have_hanging_nodes ? 1 : 0,
+                                     this->mpi_communicator);
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+      const unsigned int coarse_cell_id) const
+    {
+      const auto entry = std::lower_bound(
+        coarse_cell_id_to_coarse_cell_index_vector.begin(),
+        coarse_cell_id_to_coarse_cell_index_vector.end(),
+        coarse_cell_id,
+        [](const std::pair<unsigned int, unsigned int> &pair,
+           const unsigned int                            id) {
+          return pair.first < id;
+        });
+      if (entry == coarse_cell_id_to_coarse_cell_index_vector.end() ||
+          entry->first != coarse_cell_id)
+        return numbers::invalid_unsigned_int;
+      return entry->second;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+      const unsigned int coarse_cell_index) const
+    {
+      AssertIndexRange(coarse_cell_index,
+                       coarse_cell_index_to_coarse_cell_id_vector.size());
+      return coarse_cell_index_to_coarse_cell_id_vector[coarse_cell_index];
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    Triangulation<dim, spacedim>::memory_consumption() const
+    {
+      return parallel::Triangulation<dim, spacedim>::memory_consumption() +
+             MemoryConsumption::memory_consumption(
+               coarse_cell_index_to_coarse_cell_id_vector) +
+             MemoryConsumption::memory_consumption(
+               coarse_cell_id_to_coarse_cell_index_vector);
+    }
+
+#endif
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "fully_distributed_tria.inst"
+
+DEAL_II_NAMESPACE_CLOSE
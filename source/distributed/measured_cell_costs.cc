@@ -0,0 +1,330 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/measured_cell_costs.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+#ifdef DEAL_II_WITH_P4EST
+
+namespace parallel
+{
+  namespace distributed
+  {
+    template <int dim, int spacedim>
+    double
+    MeasuredCellCosts<dim, spacedim>::Imbalance::ratio() const
+    {
+      return (average_cost > 0. ? max_cost / average_cost : 1.);
+    }
+
+
+
+    template <int dim, int spacedim>
+    MeasuredCellCosts<dim, spacedim>::MeasuredCellCosts(
+      Triangulation<dim, spacedim> &triangulation,
+      const double                  max_relative_weight)
+      : triangulation(&triangulation, typeid(*this).name())
+      , max_relative_weight(max_relative_weight)
+      , reference_cost(0.)
+    {
+      Assert(max_relative_weight >= 1.,
+             ExcMessage("The largest relative weight must be at least one."));
+      clear();
+      tria_listener =
+        triangulation.signals.any_change.connect([this]() { clear(); });
+    }
+
+
+
+    template <int dim, int spacedim>
+    MeasuredCellCosts<dim, spacedim>::~MeasuredCellCosts()
+    {
+      tria_listener.disconnect();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    MeasuredCellCosts<dim, spacedim>::add_cost(
+      const active_cell_iterator &cell,
+      const double                cost)
+    {
+      Assert(&cell->get_triangulation() == triangulation,
+             ExcMessage("The cell does not belong to the triangulation "
+                        "whose costs are measured."));
+      Assert(cell->is_locally_owned(),
+             ExcMessage("Costs can only be recorded for locally owned "
+                        "cells."));
+      Assert(cost >= 0., ExcMessage("Costs must not be negative."));
+      AssertDimension(costs.size(), triangulation->n_active_cells());
+
+      // the vector is never resized here, so that threads working on
+      // different cells do not interfere
+      costs[cell->active_cell_index()] += cost;
+    }
+
+
+
+    template <int dim, int spacedim>
+    double
+    MeasuredCellCosts<dim, spacedim>::get_cost(
+      const active_cell_iterator &cell) const
+    {
+      AssertDimension(costs.size(), triangulation->n_active_cells());
+      return costs[cell->active_cell_index()];
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    MeasuredCellCosts<dim, spacedim>::clear()
+    {
+      costs.assign(triangulation->n_active_cells(), 0.);
+    }
+
+
+
+    template <int dim, int spacedim>
+    typename MeasuredCellCosts<dim, spacedim>::Imbalance
+    MeasuredCellCosts<dim, spacedim>::compute_imbalance() const
+    {
+      // costs are only recorded on locally owned cells
+      double local_cost = 0.;
+      for (const double cost : costs)
+        local_cost += cost;
+
+      const Utilities::MPI::MinMaxAvg result =
+        Utilities::MPI::min_max_avg(local_cost,
+                                    triangulation->get_communicator());
+      Imbalance imbalance;
+      imbalance.min_cost     = result.min;
+      imbalance.max_cost     = result.max;
+      imbalance.average_cost = result.avg;
+      return imbalance;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    MeasuredCellCosts<dim, spacedim>::get_weight(
+      const typename dealii::Triangulation<dim, spacedim>::cell_iterator
+        &cell,
+      const typename dealii::Triangulation<dim, spacedim>::CellStatus) const
+    {
+      if (reference_cost <= 0.)
+        return 0;
+
+      // if the cell is going to be coarsened, the signal is called for the
+      // parent, whose cost is that of its children
+      double cost = 0.;
+      if (cell->active())
+        cost = costs[cell->active_cell_index()];
+      else
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          if (cell->child(c)->active())
+            cost += costs[cell->child(c)->active_cell_index()];
+
+      const double relative =
+        std::min(cost / reference_cost, max_relative_weight);
+      return (relative > 1. ? static_cast<unsigned int>(
+                                std::round(1000. * (relative - 1.))) :
+                              0);
+    }
+
+
+
+    template <int dim, int spacedim>
+    double
+    MeasuredCellCosts<dim, spacedim>::estimate_ratio_after_repartitioning()
+      const
+    {
+      const MPI_Comm communicator = triangulation->get_communicator();
+      const unsigned int n_processes =
+        Utilities::MPI::n_mpi_processes(communicator);
+
+      // collect the locally owned cells in the order in which p4est
+      // arranges them along its space filling curve: the trees in p4est's
+      // order, and the cells within a tree in Z-order
+      std::vector<typename dealii::Triangulation<dim, spacedim>::cell_iterator>
+        cells_on_curve;
+      const std::function<void(
+        const typename dealii::Triangulation<dim, spacedim>::cell_iterator &)>
+        collect =
+          [&](const typename dealii::Triangulation<dim, spacedim>::cell_iterator
+                &cell) {
+            if (cell->has_children())
+              for (unsigned int c = 0; c < cell->n_children(); ++c)
+                collect(cell->child(c));
+            else if (cell->is_locally_owned())
+              cells_on_curve.push_back(cell);
+          };
+      for (const types::global_dof_index coarse_cell_index :
+           triangulation->get_p4est_tree_to_coarse_cell_permutation())
+        collect(typename dealii::Triangulation<dim, spacedim>::cell_iterator(
+          &*triangulation, 0, coarse_cell_index));
+
+      // each processor owns a contiguous part of the curve. find out where
+      // the part of this processor starts in terms of the weights
+      double local_weight = 0.;
+      for (const auto &cell : cells_on_curve)
+        local_weight +=
+          1000. +
+          get_weight(cell,
+                     dealii::Triangulation<dim, spacedim>::CELL_PERSIST);
+      double weight_before = 0.;
+      const int ierr = MPI_Exscan(&local_weight,
+                                  &weight_before,
+                                  1,
+                                  MPI_DOUBLE,
+                                  MPI_SUM,
+                                  communicator);
+      AssertThrowMPI(ierr);
+      if (Utilities::MPI::this_mpi_process(communicator) == 0)
+        weight_before = 0.;
+      const double total_weight =
+        Utilities::MPI::sum(local_weight, communicator);
+
+      // then assign each cell to the processor whose equal share of the
+      // total weight it falls into, and add up the costs
+      std::vector<double> new_costs(n_processes, 0.);
+      for (const auto &cell : cells_on_curve)
+        {
+          const unsigned int new_owner = std::min<unsigned int>(
+            static_cast<unsigned int>(weight_before * n_processes /
+                                      total_weight),
+            n_processes - 1);
+          new_costs[new_owner] += costs[cell->active_cell_index()];
+          weight_before +=
+            1000. +
+            get_weight(cell,
+                       dealii::Triangulation<dim, spacedim>::CELL_PERSIST);
+        }
+      Utilities::MPI::sum(new_costs, communicator, new_costs);
+
+      const double max_cost =
+        *std::max_element(new_costs.begin(), new_costs.end());
+      double sum_costs = 0.;
+      for (const double cost : new_costs)
+        sum_costs += cost;
+      return (sum_costs > 0. ? max_cost / (sum_costs / n_processes) : 1.);
+    }
+
+
+
+    template <int dim, int spacedim>
+    typename MeasuredCellCosts<dim, spacedim>::Report
+    MeasuredCellCosts<dim, spacedim>::repartition_if_imbalanced(
+      const double threshold)
+    {
+      const MPI_Comm communicator = triangulation->get_communicator();
+
+      Report report;
+      report.before        = compute_imbalance();
+      report.repartitioned = (report.before.ratio() > threshold);
+
+      if (report.repartitioned)
+        {
+          // the cheapest measured cell gets the base weight, but the
+          // weights of the most expensive ones are limited
+          double min_cost = std::numeric_limits<double>::max();
+          double max_cost = 0.;
+          for (const double cost : costs)
+            if (cost > 0.)
+              {
+                min_cost = std::min(min_cost, cost);
+                max_cost = std::max(max_cost, cost);
+              }
+          min_cost       = Utilities::MPI::min(min_cost, communicator);
+          max_cost       = Utilities::MPI::max(max_cost, communicator);
+          reference_cost = std::max(min_cost, max_cost / max_relative_weight);
+
+          report.estimated_ratio_after = estimate_ratio_after_repartitioning();
+
+          const boost::signals2::connection weight_connection =
+            triangulation->signals.cell_weight.connect(
+              [this](
+                const typename dealii::Triangulation<dim, spacedim>::
+                  cell_iterator &cell,
+                const typename dealii::Triangulation<dim, spacedim>::CellStatus
+                  status) { return get_weight(cell, status); });
+          triangulation->repartition();
+          weight_connection.disconnect();
+
+          reference_cost = 0.;
+        }
+      else
+        report.estimated_ratio_after = report.before.ratio();
+
+      clear();
+      reports.push_back(report);
+      return report;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const std::vector<typename MeasuredCellCosts<dim, spacedim>::Report> &
+    MeasuredCellCosts<dim, spacedim>::get_reports() const
+    {
+      return reports;
+    }
+
+
+
+    template <int dim, int spacedim>
+    MeasuredCellCosts<dim, spacedim>::Scope::Scope(
+      MeasuredCellCosts &         costs,
+      const active_cell_iterator &cell)
+      : costs(costs)
+      , cell(cell)
+      , start(std::chrono::steady_clock::now())
+    {}
+
+
+
+    template <int dim, int spacedim>
+    MeasuredCellCosts<dim, spacedim>::Scope::~Scope()
+    {
+      costs.add_cost(cell,
+                     std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count());
+    }
+  } // namespace distributed
+} // namespace parallel
+
+
+// explicit instantiations
+#  include "measured_cell_costs.inst"
+
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
@@ -107,6 +107,24 @@ namespace internal
   }
 
 
+
+  /**
+   * Return whether @p tria is a parallel triangulation of which each
+   * processor only stores a part, i.e., whether it is derived from
+   * parallel::Triangulation but is not a parallel::shared::Triangulation.
+   * Such triangulations use the ParallelDistributed policy.
+   */
+  template <int dim, int spacedim>
+  bool
+  is_partially_stored(const dealii::Triangulation<dim, spacedim> &tria)
+  {
+    return (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+              &tria) != nullptr &&
+            dynamic_cast<const parallel::shared::Triangulation<dim, spacedim>
+                           *>(&tria) == nullptr);
+  }
+
+
   namespace DoFHandlerImplementation
   {
     // access class
@@ -854,9 +872,7 @@ DoFHandler<dim, spacedim>::DoFHandler(const Triangulation<dim, spacedim> &tria)
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
-             &tria) == nullptr)
+  else if (internal::is_partially_stored(tria) == false)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                Sequential<DoFHandler<dim, spacedim>>>(*this);
@@ -906,9 +922,7 @@ DoFHandler<dim, spacedim>::initialize(const Triangulation<dim, spacedim> &t,
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(&t) !=
-           nullptr)
+  else if (internal::is_partially_stored(t))
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelDistributed<DoFHandler<dim, spacedim>>>(
@@ -1241,8 +1255,7 @@ DoFHandler<dim, spacedim>::distribute_dofs(
   // only if this is a sequential
   // triangulation. it doesn't work
   // correctly yet if it is parallel
-  if (dynamic_cast<const parallel::distributed::Triangulation<dim, spacedim> *>(
-        &*tria) == nullptr)
+  if (internal::is_partially_stored(*tria) == false)
     block_info_object.initialize(*this, false, true);
 }
 
@@ -1283,8 +1296,7 @@ DoFHandler<dim, spacedim>::distribute_mg_dofs()
   // only if this is a sequential
   // triangulation. it doesn't work
   // correctly yet if it is parallel
-  if (dynamic_cast<const parallel::distributed::Triangulation<dim, spacedim> *>(
-        &*tria) == nullptr)
+  if (internal::is_partially_stored(*tria) == false)
     block_info_object.initialize(*this, true, false);
 }
 
@@ -1342,9 +1354,7 @@ DoFHandler<dim, spacedim>::renumber_dofs(
                new_numbers.size() == n_locally_owned_dofs(),
              ExcMessage("Incorrect size of the input array."));
     }
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
-             &*tria) != nullptr)
+  else if (internal::is_partially_stored(*tria))
     {
       AssertDimension(new_numbers.size(), n_locally_owned_dofs());
     }
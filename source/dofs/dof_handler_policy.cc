@@ -4618,6 +4618,16 @@ namespace internal
 
 
 
+      } // namespace
+
+#endif // DEAL_II_WITH_P4EST
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+      namespace
+      {
         /**
          * A function that communicates the DoF indices from that subset of
          * locally owned cells that have their user indices set to the
@@ -4640,9 +4650,8 @@ namespace internal
         void
         communicate_dof_indices_on_marked_cells(
           const DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+            &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -4653,9 +4662,8 @@ namespace internal
         void
         communicate_dof_indices_on_marked_cells(
           const hp::DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+            &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -4666,14 +4674,9 @@ namespace internal
         void
         communicate_dof_indices_on_marked_cells(
           const DoFHandlerType &dof_handler,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+            &)
         {
-#  ifndef DEAL_II_WITH_MPI
-          (void)vertices_with_ghost_neighbors;
-          Assert(false, ExcNotImplemented());
-#  else
           const unsigned int dim = DoFHandlerType::dimension;
           const unsigned int spacedim = DoFHandlerType::space_dimension;
 
@@ -4816,9 +4819,9 @@ namespace internal
           // different tags for phase 1 and 2, but the cost of a
           // barrier is negligible compared to everything else we do
           // here
-          if (const auto *triangulation = dynamic_cast<
-                const parallel::distributed::Triangulation<dim, spacedim> *>(
-                &dof_handler.get_triangulation()))
+          if (const auto *triangulation =
+                dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+                  &dof_handler.get_triangulation()))
             {
               const int ierr = MPI_Barrier(triangulation->get_communicator());
               AssertThrowMPI(ierr);
@@ -4830,14 +4833,13 @@ namespace internal
                        "The function communicate_dof_indices_on_marked_cells() "
                        "only works with parallel distributed triangulations."));
             }
-#  endif
         }
 
 
 
       } // namespace
 
-#endif // DEAL_II_WITH_P4EST
+#endif // DEAL_II_WITH_MPI
 
 
 
@@ -4853,15 +4855,15 @@ namespace internal
       NumberCache
       ParallelDistributed<DoFHandlerType>::distribute_dofs() const
       {
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -5052,9 +5054,7 @@ namespace internal
           // done twice
           communicate_dof_indices_on_marked_cells(
             *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+            vertices_with_ghost_neighbors);
 
           // in case of hp::DoFHandlers, we may have received valid
           // indices of degrees of freedom that are dominated by a fe
@@ -5070,9 +5070,7 @@ namespace internal
           //                    one more time.
           communicate_dof_indices_on_marked_cells(
             *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+            vertices_with_ghost_neighbors);
 
           // at this point, we must have taken care of the data transfer
           // on all cells we had previously marked. verify this
@@ -5121,7 +5119,7 @@ namespace internal
         }
 #  endif // DEBUG
         return number_cache;
-#endif   // DEAL_II_WITH_P4EST
+#endif   // DEAL_II_WITH_MPI
       }
 
 
@@ -5419,15 +5417,15 @@ namespace internal
         Assert(new_numbers.size() == dof_handler->n_locally_owned_dofs(),
                ExcInternalError());
 
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -5527,15 +5525,11 @@ namespace internal
           // done twice
           communicate_dof_indices_on_marked_cells(
             *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+            vertices_with_ghost_neighbors);
 
           communicate_dof_indices_on_marked_cells(
             *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+            vertices_with_ghost_neighbors);
 
           triangulation->load_user_flags(user_flags);
         }
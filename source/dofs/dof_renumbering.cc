@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
@@ -28,6 +29,7 @@
 
 #include <deal.II/fe/fe.h>
 
+#include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_iterator.h>
 
@@ -40,6 +42,8 @@
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <deal.II/multigrid/mg_tools.h>
 
 #include <boost/config.hpp>
@@ -769,19 +773,22 @@ namespace DoFRenumbering
             }
       }
 
-    // set up a map where for each
-    // component the respective degrees
-    // of freedom are collected.
+    // determine the target component of each locally owned degree of
+    // freedom, stored at the position of the dof within the set of locally
+    // owned dofs. the new indices are then assigned by a counting sort over
+    // these positions, which preserves the order of the dofs within each
+    // component.
     //
-    // note that this map is sorted by
-    // component but that within each
-    // component it is NOT sorted by
-    // dof index. note also that some
-    // dof indices are entered
-    // multiply, so we will have to
-    // take care of that
-    std::vector<std::vector<types::global_dof_index>> component_to_dof_map(
-      fe_collection.n_components());
+    // note that we no longer have to care about non-primitive shape
+    // functions since they have been associated with their first vector
+    // component above; the buckets corresponding to the second and
+    // following vector components of a non-primitive FE will simply be
+    // empty. The same holds if several components were joined into a single
+    // target.
+    const IndexSet &locally_owned_dofs =
+      start->get_dof_handler().locally_owned_dofs();
+    std::vector<unsigned int> component_of_dof(new_indices.size(),
+                                               numbers::invalid_unsigned_int);
     for (CellIterator cell = start; cell != end; ++cell)
       {
         if (is_level_operation)
@@ -798,57 +805,51 @@ namespace DoFRenumbering
               continue;
           }
         // on each cell: get dof indices
-        // and insert them into the global
-        // list using their component
+        // and note their component
         const unsigned int fe_index = cell->active_fe_index();
         const unsigned int dofs_per_cell =
           fe_collection[fe_index].dofs_per_cell;
         local_dof_indices.resize(dofs_per_cell);
         cell->get_active_or_mg_dof_indices(local_dof_indices);
         for (unsigned int i = 0; i < dofs_per_cell; ++i)
-          if (start->get_dof_handler().locally_owned_dofs().is_element(
-                local_dof_indices[i]))
-            component_to_dof_map[component_list[fe_index][i]].push_back(
-              local_dof_indices[i]);
+          if (locally_owned_dofs.is_element(local_dof_indices[i]))
+            {
+              const types::global_dof_index position =
+                locally_owned_dofs.index_within_set(local_dof_indices[i]);
+              Assert(position < new_indices.size(), ExcInternalError());
+              component_of_dof[position] = component_list[fe_index][i];
+            }
       }
 
-    // now we've got all indices sorted
-    // into buckets labeled by their
-    // target component number. we've
-    // only got to traverse this list
-    // and assign the new indices
-    //
-    // however, we first want to sort
-    // the indices entered into the
-    // buckets to preserve the order
-    // within each component and during
-    // this also remove duplicate
-    // entries
-    //
-    // note that we no longer have to
-    // care about non-primitive shape
-    // functions since the buckets
-    // corresponding to the second and
-    // following vector components of a
-    // non-primitive FE will simply be
-    // empty, everything being shoved
-    // into the first one. The same
-    // holds if several components were
-    // joined into a single target.
-    for (unsigned int component = 0; component < fe_collection.n_components();
-         ++component)
-      {
-        std::sort(component_to_dof_map[component].begin(),
-                  component_to_dof_map[component].end());
-        component_to_dof_map[component].erase(
-          std::unique(component_to_dof_map[component].begin(),
-                      component_to_dof_map[component].end()),
-          component_to_dof_map[component].end());
-      }
+    // count the dofs of each component separately for chunks of the
+    // positions, so that the new indices can later be assigned to all
+    // chunks in parallel
+    const unsigned int n_buckets = fe_collection.n_components();
+    const types::global_dof_index chunk_size = 8192;
+    const unsigned int            n_chunks =
+      (component_of_dof.size() + chunk_size - 1) / chunk_size;
+    std::vector<types::global_dof_index> chunk_counts(n_chunks * n_buckets, 0);
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int chunk = begin; chunk < end; ++chunk)
+          for (types::global_dof_index p = chunk * chunk_size;
+               p < std::min<types::global_dof_index>((chunk + 1) * chunk_size,
+                                                     component_of_dof.size());
+               ++p)
+            if (component_of_dof[p] != numbers::invalid_unsigned_int)
+              ++chunk_counts[chunk * n_buckets + component_of_dof[p]];
+      },
+      1);
 
     // calculate the number of locally owned
     // DoFs per bucket
-    const unsigned int n_buckets = fe_collection.n_components();
+    std::vector<types::global_dof_index> local_dof_count(n_buckets, 0);
+    for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+      for (unsigned int c = 0; c < n_buckets; ++c)
+        local_dof_count[c] += chunk_counts[chunk * n_buckets + c];
+
     std::vector<types::global_dof_index> shifts(n_buckets);
 
     if (const parallel::Triangulation<dim, spacedim> *tria =
@@ -856,12 +857,6 @@ namespace DoFRenumbering
             &start->get_dof_handler().get_triangulation())))
       {
 #ifdef DEAL_II_WITH_MPI
-        std::vector<types::global_dof_index> local_dof_count(n_buckets);
-
-        for (unsigned int c = 0; c < n_buckets; ++c)
-          local_dof_count[c] = component_to_dof_map[c].size();
-
-
         // gather information from all CPUs
         std::vector<types::global_dof_index> all_dof_counts(
           fe_collection.n_components() *
@@ -904,40 +899,42 @@ namespace DoFRenumbering
       {
         shifts[0] = 0;
         for (unsigned int c = 1; c < fe_collection.n_components(); ++c)
-          shifts[c] = shifts[c - 1] + component_to_dof_map[c - 1].size();
+          shifts[c] = shifts[c - 1] + local_dof_count[c - 1];
       }
 
 
 
-    // now concatenate all the
-    // components in the order the user
-    // desired to see
-    types::global_dof_index next_free_index = 0;
-    for (unsigned int component = 0; component < fe_collection.n_components();
-         ++component)
+    // now concatenate all the components in the order the user desired to
+    // see. turn the counts of the chunks into the first index each chunk
+    // assigns to the dofs of each component, and then number the dofs of
+    // all chunks in parallel
+    for (unsigned int c = 0; c < n_buckets; ++c)
       {
-        const typename std::vector<types::global_dof_index>::const_iterator
-          begin_of_component = component_to_dof_map[component].begin(),
-          end_of_component   = component_to_dof_map[component].end();
-
-        next_free_index = shifts[component];
-
-        for (typename std::vector<types::global_dof_index>::const_iterator
-               dof_index = begin_of_component;
-             dof_index != end_of_component;
-             ++dof_index)
+        types::global_dof_index next_free_index = shifts[c];
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
           {
-            Assert(
-              start->get_dof_handler().locally_owned_dofs().index_within_set(
-                *dof_index) < new_indices.size(),
-              ExcInternalError());
-            new_indices[start->get_dof_handler()
-                          .locally_owned_dofs()
-                          .index_within_set(*dof_index)] = next_free_index++;
+            const types::global_dof_index count =
+              chunk_counts[chunk * n_buckets + c];
+            chunk_counts[chunk * n_buckets + c] = next_free_index;
+            next_free_index += count;
           }
       }
-
-    return next_free_index;
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int chunk = begin; chunk < end; ++chunk)
+          for (types::global_dof_index p = chunk * chunk_size;
+               p < std::min<types::global_dof_index>((chunk + 1) * chunk_size,
+                                                     component_of_dof.size());
+               ++p)
+            if (component_of_dof[p] != numbers::invalid_unsigned_int)
+              new_indices[p] =
+                chunk_counts[chunk * n_buckets + component_of_dof[p]]++;
+      },
+      1);
+
+    return shifts[n_buckets - 1] + local_dof_count[n_buckets - 1];
   }
 
 
@@ -1444,6 +1441,73 @@ namespace DoFRenumbering
 
 
 
+  template <typename DoFHandlerType>
+  void
+  hilbert(DoFHandlerType &dof_handler)
+  {
+    const int dim      = DoFHandlerType::dimension;
+    const int spacedim = DoFHandlerType::space_dimension;
+
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs(), numbers::invalid_dof_index);
+    const IndexSet locally_owned = dof_handler.locally_owned_dofs();
+
+    // as in hierarchical(), compute the first index of the contiguous range
+    // this processor gets in the new numbering
+    types::global_dof_index my_starting_index = 0;
+    if (const parallel::Triangulation<dim, spacedim> *tria =
+          dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+            &dof_handler.get_triangulation()))
+      {
+        const std::vector<types::global_dof_index>
+          &n_locally_owned_dofs_per_processor =
+            dof_handler.n_locally_owned_dofs_per_processor();
+        my_starting_index =
+          std::accumulate(n_locally_owned_dofs_per_processor.begin(),
+                          n_locally_owned_dofs_per_processor.begin() +
+                            tria->locally_owned_subdomain(),
+                          types::global_dof_index(0));
+      }
+
+    // the positions of the cells on the curve are computed in parallel by
+    // GridTools. then number the locally owned degrees of freedom in the
+    // order in which they are first encountered along the curve
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells = GridTools::sort_active_cells_along_hilbert_curve(
+        dof_handler.get_triangulation());
+
+    types::global_dof_index              next_free_dof_offset = 0;
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (const auto &tria_cell : cells)
+      if (tria_cell->is_locally_owned())
+        {
+          const typename DoFHandlerType::active_cell_iterator cell(
+            &dof_handler.get_triangulation(),
+            tria_cell->level(),
+            tria_cell->index(),
+            &dof_handler);
+          local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          for (const types::global_dof_index dof : local_dof_indices)
+            if (locally_owned.is_element(dof))
+              {
+                const types::global_dof_index local_index =
+                  locally_owned.index_within_set(dof);
+                if (renumbering[local_index] == numbers::invalid_dof_index)
+                  renumbering[local_index] =
+                    my_starting_index + next_free_dof_offset++;
+              }
+        }
+
+    Assert(next_free_dof_offset == dof_handler.n_locally_owned_dofs(),
+           ExcInternalError());
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
   template <typename DoFHandlerType>
   void
   sort_selected_dofs_back(DoFHandlerType &         dof_handler,
@@ -2205,6 +2269,98 @@ namespace DoFRenumbering
            ExcInternalError());
   }
 
+
+
+  template <int dim, typename Number>
+  void
+  matrix_free_data_locality(DoFHandler<dim> &               dof_handler,
+                            const MatrixFree<dim, Number> &matrix_free)
+  {
+    std::vector<types::global_dof_index> renumbering;
+    compute_matrix_free_data_locality(renumbering, dof_handler, matrix_free);
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim> &               dof_handler,
+    const MatrixFree<dim, Number> &       matrix_free)
+  {
+    // find out under which index the matrix_free object stores the given
+    // DoFHandler
+    unsigned int dof_handler_index = numbers::invalid_unsigned_int;
+    for (unsigned int i = 0; i < matrix_free.n_components(); ++i)
+      if (&matrix_free.get_dof_handler(i) == &dof_handler)
+        {
+          dof_handler_index = i;
+          break;
+        }
+    Assert(dof_handler_index != numbers::invalid_unsigned_int,
+           ExcMessage("The given DoFHandler is not used by the MatrixFree "
+                      "object."));
+
+    const IndexSet locally_owned = dof_handler.locally_owned_dofs();
+    new_dof_indices.clear();
+    new_dof_indices.resize(locally_owned.n_elements(),
+                           numbers::invalid_dof_index);
+
+    // the first index of this processor in the new numbering, as in
+    // hierarchical()
+    types::global_dof_index my_starting_index = 0;
+    if (const parallel::Triangulation<dim> *tria =
+          dynamic_cast<const parallel::Triangulation<dim> *>(
+            &dof_handler.get_triangulation()))
+      {
+        const std::vector<types::global_dof_index>
+          &n_locally_owned_dofs_per_processor =
+            dof_handler.n_locally_owned_dofs_per_processor();
+        my_starting_index =
+          std::accumulate(n_locally_owned_dofs_per_processor.begin(),
+                          n_locally_owned_dofs_per_processor.begin() +
+                            tria->locally_owned_subdomain(),
+                          types::global_dof_index(0));
+      }
+
+    // go through the locally owned cell batches in the order of the cell
+    // loop, which already groups the batches by the partitions of the
+    // TaskInfo object, and number the degrees of freedom on first touch
+    types::global_dof_index              next_free_index = 0;
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (unsigned int batch = 0; batch < matrix_free.n_macro_cells(); ++batch)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(batch);
+           ++v)
+        {
+          const typename DoFHandler<dim>::cell_iterator cell =
+            matrix_free.get_cell_iterator(batch, v, dof_handler_index);
+          Assert(cell->active(),
+                 ExcMessage("This function can only be used with MatrixFree "
+                            "objects that work on the active cells."));
+          local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          for (const types::global_dof_index dof : local_dof_indices)
+            if (locally_owned.is_element(dof))
+              {
+                const types::global_dof_index local_index =
+                  locally_owned.index_within_set(dof);
+                if (new_dof_indices[local_index] == numbers::invalid_dof_index)
+                  new_dof_indices[local_index] =
+                    my_starting_index + next_free_index++;
+              }
+        }
+
+    // number the remaining degrees of freedom at the end
+    for (types::global_dof_index &index : new_dof_indices)
+      if (index == numbers::invalid_dof_index)
+        index = my_starting_index + next_free_index++;
+
+    Assert(next_free_index == locally_owned.n_elements(), ExcInternalError());
+  }
+
 } // namespace DoFRenumbering
 
 
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -113,6 +114,214 @@ namespace DoFTools
 
 
 
+  template <typename DoFHandlerType, typename number>
+  void
+  make_exact_sparsity_pattern(const DoFHandlerType &           dof,
+                              SparsityPattern &                sparsity,
+                              const AffineConstraints<number> &constraints,
+                              const bool keep_constrained_dofs)
+  {
+    using size_type                 = types::global_dof_index;
+    const size_type    n_dofs       = dof.n_dofs();
+    const unsigned int invalid_cell = numbers::invalid_unsigned_int;
+
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+    for (const auto &cell : dof.active_cell_iterators())
+      if (cell->is_locally_owned())
+        cells.push_back(cell);
+    const unsigned int n_cells = cells.size();
+
+    // get the degrees of freedom of all cells, stored one cell after the
+    // other
+    std::vector<std::size_t> cell_dofs_start(n_cells + 1, 0);
+    for (unsigned int c = 0; c < n_cells; ++c)
+      cell_dofs_start[c + 1] =
+        cell_dofs_start[c] + cells[c]->get_fe().dofs_per_cell;
+    std::vector<size_type> cell_dofs(cell_dofs_start[n_cells]);
+
+    // for cells with constrained degrees of freedom, also compute the
+    // sorted list of unconstrained degrees of freedom that they couple with
+    // each other in the same way as
+    // AffineConstraints::add_entries_local_to_global()
+    std::vector<unsigned char> cell_is_constrained(n_cells, 0);
+    parallel::apply_to_subranges(
+      0U,
+      n_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<size_type> dofs_on_this_cell;
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            dofs_on_this_cell.resize(cell_dofs_start[c + 1] -
+                                     cell_dofs_start[c]);
+            cells[c]->get_dof_indices(dofs_on_this_cell);
+            std::copy(dofs_on_this_cell.begin(),
+                      dofs_on_this_cell.end(),
+                      cell_dofs.begin() + cell_dofs_start[c]);
+            for (const size_type i : dofs_on_this_cell)
+              if (constraints.is_constrained(i))
+                cell_is_constrained[c] = 1;
+          }
+      },
+      64);
+
+    std::vector<unsigned int> resolved_dofs_index(n_cells, invalid_cell);
+    unsigned int              n_constrained_cells = 0;
+    for (unsigned int c = 0; c < n_cells; ++c)
+      if (cell_is_constrained[c])
+        resolved_dofs_index[c] = n_constrained_cells++;
+    std::vector<unsigned char>().swap(cell_is_constrained);
+
+    std::vector<std::vector<size_type>> resolved_dofs(n_constrained_cells);
+    parallel::apply_to_subranges(
+      0U,
+      n_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
+          if (resolved_dofs_index[c] != invalid_cell)
+            {
+              std::vector<size_type> &resolved =
+                resolved_dofs[resolved_dofs_index[c]];
+              for (std::size_t k = cell_dofs_start[c];
+                   k < cell_dofs_start[c + 1];
+                   ++k)
+                if (constraints.is_constrained(cell_dofs[k]))
+                  {
+                    for (const auto &entry :
+                         *constraints.get_constraint_entries(cell_dofs[k]))
+                      resolved.push_back(entry.first);
+                  }
+                else
+                  resolved.push_back(cell_dofs[k]);
+              std::sort(resolved.begin(), resolved.end());
+              resolved.erase(std::unique(resolved.begin(), resolved.end()),
+                             resolved.end());
+            }
+      },
+      64);
+
+    // now invert this information: for each row, find the cells that
+    // contribute entries to it, which are the cells on which the degree of
+    // freedom lives and those which couple to it through constraints
+    const auto get_rows_of_cell = [&](const unsigned int      c,
+                                      std::vector<size_type> &rows) {
+      rows.assign(cell_dofs.begin() + cell_dofs_start[c],
+                  cell_dofs.begin() + cell_dofs_start[c + 1]);
+      if (resolved_dofs_index[c] != invalid_cell)
+        for (const size_type i : resolved_dofs[resolved_dofs_index[c]])
+          if (std::find(cell_dofs.begin() + cell_dofs_start[c],
+                        cell_dofs.begin() + cell_dofs_start[c + 1],
+                        i) == cell_dofs.begin() + cell_dofs_start[c + 1])
+            rows.push_back(i);
+    };
+
+    std::vector<size_type>   rows_of_cell;
+    std::vector<std::size_t> row_cells_start(n_dofs + 1, 0);
+    for (unsigned int c = 0; c < n_cells; ++c)
+      {
+        get_rows_of_cell(c, rows_of_cell);
+        for (const size_type row : rows_of_cell)
+          ++row_cells_start[row + 1];
+      }
+    std::partial_sum(row_cells_start.begin(),
+                     row_cells_start.end(),
+                     row_cells_start.begin());
+    std::vector<unsigned int> row_cells(row_cells_start[n_dofs]);
+    {
+      std::vector<std::size_t> next_position(row_cells_start.begin(),
+                                             row_cells_start.end() - 1);
+      for (unsigned int c = 0; c < n_cells; ++c)
+        {
+          get_rows_of_cell(c, rows_of_cell);
+          for (const size_type row : rows_of_cell)
+            row_cells[next_position[row]++] = c;
+        }
+    }
+
+    // compute the sorted list of columns of one row. this is done twice for
+    // every row, once to find the number of entries and once to fill them
+    // in, which avoids storing all entries twice at any time
+    const auto compute_row = [&](const size_type          row,
+                                 std::vector<size_type> &columns) {
+      columns.clear();
+      // square matrices store the diagonal entry in any case
+      columns.push_back(row);
+
+      const bool row_is_constrained = constraints.is_constrained(row);
+      for (std::size_t k = row_cells_start[row]; k < row_cells_start[row + 1];
+           ++k)
+        {
+          const unsigned int c = row_cells[k];
+          const auto dofs_begin = cell_dofs.begin() + cell_dofs_start[c];
+          const auto dofs_end   = cell_dofs.begin() + cell_dofs_start[c + 1];
+
+          if (resolved_dofs_index[c] == invalid_cell)
+            {
+              columns.insert(columns.end(), dofs_begin, dofs_end);
+              continue;
+            }
+
+          const std::vector<size_type> &resolved =
+            resolved_dofs[resolved_dofs_index[c]];
+          if (std::binary_search(resolved.begin(), resolved.end(), row))
+            columns.insert(columns.end(), resolved.begin(), resolved.end());
+
+          // constrained degrees of freedom couple to the ones on the cell,
+          // or only to themselves
+          if (row_is_constrained)
+            {
+              if (keep_constrained_dofs)
+                columns.insert(columns.end(), dofs_begin, dofs_end);
+            }
+          else if (keep_constrained_dofs &&
+                   std::find(dofs_begin, dofs_end, row) != dofs_end)
+            for (auto dof = dofs_begin; dof != dofs_end; ++dof)
+              if (constraints.is_constrained(*dof))
+                columns.push_back(*dof);
+        }
+
+      std::sort(columns.begin(), columns.end());
+      columns.erase(std::unique(columns.begin(), columns.end()),
+                    columns.end());
+    };
+
+    std::vector<unsigned int> row_lengths(n_dofs);
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_dofs,
+      [&](const size_type begin, const size_type end) {
+        std::vector<size_type> columns;
+        for (size_type row = begin; row < end; ++row)
+          {
+            compute_row(row, columns);
+            row_lengths[row] = columns.size();
+          }
+      },
+      256);
+
+    sparsity.reinit(n_dofs, n_dofs, row_lengths);
+    std::vector<unsigned int>().swap(row_lengths);
+
+    // writing into different rows of the pattern is independent
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_dofs,
+      [&](const size_type begin, const size_type end) {
+        std::vector<size_type> columns;
+        for (size_type row = begin; row < end; ++row)
+          {
+            compute_row(row, columns);
+            sparsity.add_entries(row, columns.begin(), columns.end(), true);
+          }
+      },
+      256);
+
+    // all rows are filled up to their exact length, so this does not copy
+    // the entries
+    sparsity.compress();
+  }
+
+
+
   template <typename DoFHandlerType,
             typename SparsityPatternType,
             typename number>
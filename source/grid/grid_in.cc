@@ -15,9 +15,11 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/grid/binary_mesh_format.h>
 #include <deal.II/grid/grid_in.h>
 #include <deal.II/grid/grid_reordering.h>
 #include <deal.II/grid/grid_tools.h>
@@ -26,10 +28,24 @@
 #include <boost/io/ios_state.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
+#include <iterator>
+#include <locale>
 #include <map>
+#include <sstream>
+
+#ifdef DEAL_II_HAVE_UNISTD_H
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
 
 
 #ifdef DEAL_II_WITH_NETCDF
@@ -91,8 +107,865 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Like assign_1d_boundary_ids(), but for the manifold ids of vertices.
+   */
+  template <int spacedim>
+  void
+  assign_1d_manifold_ids(
+    const std::map<unsigned int, types::manifold_id> &manifold_ids,
+    Triangulation<1, spacedim> &                      triangulation)
+  {
+    if (manifold_ids.size() > 0)
+      for (const auto &cell : triangulation.active_cell_iterators())
+        for (unsigned int f = 0; f < GeometryInfo<1>::faces_per_cell; ++f)
+          {
+            const auto entry = manifold_ids.find(cell->vertex_index(f));
+            if (entry != manifold_ids.end())
+              cell->face(f)->set_manifold_id(entry->second);
+          }
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  assign_1d_manifold_ids(const std::map<unsigned int, types::manifold_id> &,
+                         Triangulation<dim, spacedim> &)
+  {
+    Assert(dim != 1, ExcInternalError());
+  }
+
+
+
+  /**
+   * Read-only access to the contents of a file. Where possible, the file is
+   * mapped into memory, so that only the parts of it that are accessed are
+   * actually read from disk. Otherwise, the whole file is read.
+   */
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string &filename);
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &
+    operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    const char *
+    data() const
+    {
+      return begin;
+    }
+
+    std::size_t
+    size() const
+    {
+      return n_bytes;
+    }
+
+  private:
+    const char *      begin;
+    std::size_t       n_bytes;
+    void *            mapping;
+    std::vector<char> buffer;
+  };
+
+
+
+  MappedFile::MappedFile(const std::string &filename)
+    : begin(nullptr)
+    , n_bytes(0)
+    , mapping(nullptr)
+  {
+#ifdef DEAL_II_HAVE_UNISTD_H
+    const int file_descriptor = open(filename.c_str(), O_RDONLY);
+    AssertThrow(file_descriptor != -1, ExcFileNotOpen(filename));
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+      {
+        void *address = mmap(nullptr,
+                             file_status.st_size,
+                             PROT_READ,
+                             MAP_PRIVATE,
+                             file_descriptor,
+                             0);
+        if (address != MAP_FAILED)
+          {
+            mapping = address;
+            begin   = static_cast<const char *>(address);
+            n_bytes = file_status.st_size;
+          }
+      }
+    // the mapping remains valid after closing the file
+    close(file_descriptor);
+    if (mapping != nullptr)
+      return;
+#endif
+
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    AssertThrow(in, ExcFileNotOpen(filename));
+    buffer.assign(std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>());
+    begin   = buffer.data();
+    n_bytes = buffer.size();
+  }
+
+
+
+  MappedFile::~MappedFile()
+  {
+#ifdef DEAL_II_HAVE_UNISTD_H
+    if (mapping != nullptr)
+      munmap(mapping, n_bytes);
+#endif
+  }
+
+
+
+  /**
+   * The data of a face or line read from a file in the binary mesh format.
+   */
+  struct BinaryObjectRecord
+  {
+    std::array<unsigned int, 4> vertices;
+    types::boundary_id          boundary_id;
+    types::manifold_id          manifold_id;
+  };
+
+
+
+  /**
+   * Read the faces or lines with @p n_object_vertices vertices of the cells
+   * with indices <tt>[first_cell, end_cell)</tt> of a file in the binary
+   * mesh format at @p data. The records of the cells are found through the
+   * index section at @p index_offset, so only the bytes of these cells are
+   * accessed. Objects shared by several of the cells are returned once. The
+   * vertex indices of the objects are translated by the sorted array
+   * @p global_vertex_indices of the vertices read, or kept if it is empty.
+   */
+  std::vector<BinaryObjectRecord>
+  read_binary_objects(const char *                     data,
+                      const std::uint64_t              records_offset,
+                      const std::uint64_t              index_offset,
+                      const std::uint64_t              n_objects,
+                      const unsigned int               n_object_vertices,
+                      const std::uint64_t              n_vertices,
+                      const unsigned int               first_cell,
+                      const unsigned int               end_cell,
+                      const std::vector<unsigned int> &global_vertex_indices)
+  {
+    namespace Format = internal::BinaryMeshFormat;
+
+    const char *        index = data + index_offset;
+    const std::uint64_t first_object =
+      Format::read_uint64(index + 8 * static_cast<std::size_t>(first_cell));
+    const std::uint64_t end_object =
+      Format::read_uint64(index + 8 * static_cast<std::size_t>(end_cell));
+    AssertThrow(first_object <= end_object && end_object <= n_objects,
+                ExcMessage("The binary mesh is corrupted."));
+
+    const std::size_t record_size =
+      Format::object_record_size(n_object_vertices);
+    std::vector<BinaryObjectRecord> objects;
+    objects.reserve(end_object - first_object);
+    for (std::uint64_t i = first_object; i < end_object; ++i)
+      {
+        const char *record =
+          data + records_offset + static_cast<std::size_t>(i) * record_size;
+        BinaryObjectRecord object;
+        object.vertices.fill(numbers::invalid_unsigned_int);
+        for (unsigned int v = 0; v < n_object_vertices; ++v)
+          {
+            object.vertices[v] = Format::read_uint32(record + 4 * v);
+            AssertThrow(object.vertices[v] < n_vertices,
+                        ExcMessage("The binary mesh is corrupted."));
+          }
+        object.boundary_id =
+          Format::read_uint32(record + 4 * n_object_vertices);
+        object.manifold_id =
+          Format::read_uint32(record + 4 * n_object_vertices + 4);
+        objects.push_back(object);
+      }
+
+    // objects shared by several cells are stored with each of them. the
+    // records of an object are identical, so keep the first one of those
+    // with the same vertices
+    const auto key = [n_object_vertices](const BinaryObjectRecord &object) {
+      std::array<unsigned int, 4> key = object.vertices;
+      std::sort(key.begin(), key.begin() + n_object_vertices);
+      return key;
+    };
+    std::stable_sort(objects.begin(),
+                     objects.end(),
+                     [&](const BinaryObjectRecord &a,
+                         const BinaryObjectRecord &b) {
+                       return key(a) < key(b);
+                     });
+    objects.erase(std::unique(objects.begin(),
+                              objects.end(),
+                              [&](const BinaryObjectRecord &a,
+                                  const BinaryObjectRecord &b) {
+                                return key(a) == key(b);
+                              }),
+                  objects.end());
+
+    if (global_vertex_indices.size() > 0)
+      for (auto &object : objects)
+        for (unsigned int v = 0; v < n_object_vertices; ++v)
+          object.vertices[v] =
+            std::lower_bound(global_vertex_indices.begin(),
+                             global_vertex_indices.end(),
+                             object.vertices[v]) -
+            global_vertex_indices.begin();
+
+    return objects;
+  }
+
+
+
+  /**
+   * Decode the cells with indices <tt>[first_cell, first_cell+n_cells)</tt>
+   * of the mesh in the binary mesh format stored in the @p size bytes at
+   * @p data, together with their vertices and the boundary and manifold ids
+   * of their faces and lines.
+   */
+  template <int dim, int spacedim>
+  void
+  read_binary_mesh(const char *                                data,
+                   const std::size_t                           size,
+                   const unsigned int                          first_cell,
+                   const unsigned int                          n_cells,
+                   std::vector<Point<spacedim>> &              vertices,
+                   std::vector<CellData<dim>> &                cells,
+                   SubCellData &                               subcelldata,
+                   std::map<unsigned int, types::boundary_id> &boundary_ids_1d,
+                   std::map<unsigned int, types::manifold_id> &manifold_ids_1d)
+  {
+    namespace Format = internal::BinaryMeshFormat;
+
+    const Format::Header header = Format::read_header(data, size);
+    AssertThrow(header.dim == dim && header.spacedim == spacedim,
+                ExcMessage("The binary mesh was written for a triangulation "
+                           "of dimension " +
+                           Utilities::to_string(header.dim) +
+                           " in space dimension " +
+                           Utilities::to_string(header.spacedim) + "."));
+    AssertThrow(first_cell <= header.n_cells,
+                ExcIndexRange(first_cell, 0, header.n_cells + 1));
+
+    const unsigned int end_cell =
+      (n_cells == numbers::invalid_unsigned_int ||
+       first_cell + static_cast<std::uint64_t>(n_cells) > header.n_cells) ?
+        header.n_cells :
+        first_cell + n_cells;
+    const bool read_all = (first_cell == 0 && end_cell == header.n_cells);
+
+    // the minimal number of records decoded by one task
+    const unsigned int grain_size = 1024;
+
+    const unsigned int vertices_per_cell = GeometryInfo<dim>::vertices_per_cell;
+    const std::size_t  cell_record_size =
+      Format::object_record_size(vertices_per_cell);
+    cells.resize(end_cell - first_cell);
+    std::atomic<bool> invalid_vertex(false);
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            const char *record =
+              data + header.cells_offset +
+              (first_cell + static_cast<std::size_t>(c)) * cell_record_size;
+            for (unsigned int v = 0; v < vertices_per_cell; ++v)
+              {
+                cells[c].vertices[v] = Format::read_uint32(record + 4 * v);
+                if (cells[c].vertices[v] >= header.n_vertices)
+                  invalid_vertex = true;
+              }
+            cells[c].material_id =
+              Format::read_uint32(record + 4 * vertices_per_cell);
+            cells[c].manifold_id =
+              Format::read_uint32(record + 4 * vertices_per_cell + 4);
+          }
+      },
+      grain_size);
+    AssertThrow(invalid_vertex == false,
+                ExcMessage("The binary mesh is corrupted."));
+
+    // when only reading part of the cells, only read the vertices they use,
+    // and number them consecutively. global_vertex_indices translates the
+    // new numbers to the ones in the file
+    std::vector<unsigned int> global_vertex_indices;
+    if (read_all == false)
+      {
+        global_vertex_indices.reserve(cells.size() * vertices_per_cell);
+        for (const auto &cell : cells)
+          global_vertex_indices.insert(global_vertex_indices.end(),
+                                       std::begin(cell.vertices),
+                                       std::end(cell.vertices));
+        std::sort(global_vertex_indices.begin(), global_vertex_indices.end());
+        global_vertex_indices.erase(std::unique(global_vertex_indices.begin(),
+                                                global_vertex_indices.end()),
+                                    global_vertex_indices.end());
+
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cells.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int c = begin; c < end; ++c)
+              for (unsigned int v = 0; v < vertices_per_cell; ++v)
+                cells[c].vertices[v] =
+                  std::lower_bound(global_vertex_indices.begin(),
+                                   global_vertex_indices.end(),
+                                   cells[c].vertices[v]) -
+                  global_vertex_indices.begin();
+          },
+          grain_size);
+      }
+
+    const std::size_t vertex_record_size = Format::vertex_record_size(spacedim);
+    vertices.resize(read_all ? header.n_vertices :
+                               global_vertex_indices.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(vertices.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const std::size_t vertex =
+              read_all ? i : global_vertex_indices[i];
+            const char *record =
+              data + header.vertices_offset + vertex * vertex_record_size;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              vertices[i][d] = Format::read_double(record + 8 * d);
+          }
+      },
+      grain_size);
+
+    const std::vector<BinaryObjectRecord> faces =
+      read_binary_objects(data,
+                          header.faces_offset,
+                          header.face_index_offset,
+                          header.n_faces,
+                          GeometryInfo<dim>::vertices_per_face,
+                          header.n_vertices,
+                          first_cell,
+                          end_cell,
+                          global_vertex_indices);
+    for (const auto &face : faces)
+      switch (dim)
+        {
+          case 1:
+            if (face.boundary_id != numbers::internal_face_boundary_id)
+              boundary_ids_1d[face.vertices[0]] = face.boundary_id;
+            if (face.manifold_id != numbers::flat_manifold_id)
+              manifold_ids_1d[face.vertices[0]] = face.manifold_id;
+            break;
+          case 2:
+            {
+              CellData<1> line;
+              line.vertices[0] = face.vertices[0];
+              line.vertices[1] = face.vertices[1];
+              line.boundary_id = face.boundary_id;
+              line.manifold_id = face.manifold_id;
+              subcelldata.boundary_lines.push_back(line);
+              break;
+            }
+          case 3:
+            {
+              CellData<2> quad;
+              for (unsigned int v = 0; v < 4; ++v)
+                quad.vertices[v] = face.vertices[v];
+              // in 3d, the triangulation sets the boundary id of every
+              // given quad and line that is at the boundary. the interior
+              // objects of the file can be at the boundary of a part of the
+              // mesh, so give them the default boundary id instead
+              quad.boundary_id =
+                (face.boundary_id == numbers::internal_face_boundary_id ?
+                   0 :
+                   face.boundary_id);
+              quad.manifold_id = face.manifold_id;
+              subcelldata.boundary_quads.push_back(quad);
+              break;
+            }
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+
+    const std::vector<BinaryObjectRecord> lines =
+      read_binary_objects(data,
+                          header.lines_offset,
+                          header.line_index_offset,
+                          header.n_lines,
+                          2,
+                          header.n_vertices,
+                          first_cell,
+                          end_cell,
+                          global_vertex_indices);
+    for (const auto &object : lines)
+      {
+        CellData<1> line;
+        line.vertices[0] = object.vertices[0];
+        line.vertices[1] = object.vertices[1];
+        line.boundary_id =
+          (object.boundary_id == numbers::internal_face_boundary_id ?
+             0 :
+             object.boundary_id);
+        line.manifold_id = object.manifold_id;
+        subcelldata.boundary_lines.push_back(line);
+      }
+  }
 } // namespace
 
+
+namespace internal
+{
+  namespace GridInImplementation
+  {
+    /**
+     * A block of lines of a text file, stored contiguously so that the lines
+     * can be parsed in parallel. Every line, including the last one, is
+     * terminated by a newline character.
+     */
+    struct TextLines
+    {
+      std::string              text;
+      std::vector<std::size_t> line_starts;
+
+      std::size_t
+      size() const
+      {
+        return line_starts.size() - 1;
+      }
+
+      const char *
+      begin(const std::size_t line) const
+      {
+        return text.data() + line_starts[line];
+      }
+
+      std::string
+      get_line(const std::size_t line) const
+      {
+        return std::string(text, line_starts[line],
+                           line_starts[line + 1] - line_starts[line] - 1);
+      }
+    };
+
+
+
+    inline bool
+    is_blank(const char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+
+
+    /**
+     * Read the next @p n_lines lines of @p in that contain anything but
+     * white space. The remainder of the line the stream is currently
+     * positioned in is skipped if it is empty, as is the case after the
+     * number of entries of a section has been read with <tt>operator>></tt>.
+     */
+    TextLines
+    read_lines(std::istream &in, const std::size_t n_lines)
+    {
+      TextLines   lines;
+      std::string line;
+      lines.line_starts.reserve(n_lines + 1);
+      while (lines.line_starts.size() < n_lines && std::getline(in, line))
+        if (std::find_if_not(line.begin(), line.end(), is_blank) != line.end())
+          {
+            lines.line_starts.push_back(lines.text.size());
+            lines.text += line;
+            lines.text += '\n';
+          }
+      lines.line_starts.push_back(lines.text.size());
+      AssertThrow(lines.size() == n_lines, ExcIO());
+      return lines;
+    }
+
+
+
+    /**
+     * Like read_lines(), but read as many lines as are necessary to obtain
+     * @p n_tokens white space separated tokens, as for the coordinates of
+     * points of which a file may contain several per line. The number of
+     * tokens before each line is stored in @p tokens_before_line. The last
+     * line must not contain more than the requested number of tokens.
+     */
+    TextLines
+    read_lines_with_tokens(std::istream &             in,
+                           const std::size_t          n_tokens,
+                           std::vector<std::size_t> &tokens_before_line)
+    {
+      TextLines   lines;
+      std::string line;
+      std::size_t n_read = 0;
+      tokens_before_line.clear();
+      while (n_read < n_tokens && std::getline(in, line))
+        {
+          std::size_t n_in_line = 0;
+          for (std::size_t i = 0; i < line.size(); ++i)
+            if (!is_blank(line[i]) && (i == 0 || is_blank(line[i - 1])))
+              ++n_in_line;
+          if (n_in_line == 0)
+            continue;
+
+          tokens_before_line.push_back(n_read);
+          lines.line_starts.push_back(lines.text.size());
+          lines.text += line;
+          lines.text += '\n';
+          n_read += n_in_line;
+        }
+      lines.line_starts.push_back(lines.text.size());
+      AssertThrow(n_read == n_tokens, ExcIO());
+      return lines;
+    }
+
+
+
+    /**
+     * Parse an integer that may be preceded by white space at @p p, and move
+     * @p p past it. Unlike <tt>operator>></tt>, this does not depend on the
+     * locale of the program. Return whether a number was found.
+     */
+    template <typename Integer>
+    bool
+    parse_integer(const char *&p, Integer &value)
+    {
+      while (is_blank(*p))
+        ++p;
+      const bool negative = (*p == '-');
+      if (*p == '-' || *p == '+')
+        ++p;
+      if (*p < '0' || *p > '9')
+        return false;
+      long long result = 0;
+      for (; *p >= '0' && *p <= '9'; ++p)
+        result = 10 * result + (*p - '0');
+      value = static_cast<Integer>(negative ? -result : result);
+      return true;
+    }
+
+
+
+    /**
+     * Parse a floating point number that may be preceded by white space at
+     * @p p, and move @p p past it. Return whether a number was found.
+     *
+     * Like parse_integer(), this does not depend on the locale of the
+     * program, which for std::strtod() may use a decimal comma. Numbers with
+     * at most 19 significant digits and a small exponent are converted
+     * exactly by a single multiplication or division by a power of ten. All
+     * others are converted by a stream with the classic locale, which is
+     * slower but also correctly rounded.
+     */
+    bool
+    parse_double(const char *&p, double &value)
+    {
+      while (is_blank(*p))
+        ++p;
+      const char *const begin = p;
+
+      const bool negative = (*p == '-');
+      if (*p == '-' || *p == '+')
+        ++p;
+
+      // collect the significant digits in an integer and count the power of
+      // ten by which it has to be scaled
+      std::uint64_t mantissa      = 0;
+      unsigned int  n_significant = 0;
+      int           exponent      = 0;
+      bool          found_digit   = false;
+      bool          exact         = true;
+      for (bool after_point = false;; ++p)
+        {
+          if (*p == '.' && !after_point)
+            {
+              after_point = true;
+              continue;
+            }
+          if (*p < '0' || *p > '9')
+            break;
+
+          found_digit = true;
+          if (n_significant < 19)
+            {
+              mantissa = 10 * mantissa + (*p - '0');
+              if (mantissa != 0)
+                ++n_significant;
+              if (after_point)
+                --exponent;
+            }
+          else
+            {
+              if (*p != '0')
+                exact = false;
+              if (!after_point)
+                ++exponent;
+            }
+        }
+      if (!found_digit)
+        {
+          p = begin;
+          return false;
+        }
+
+      if (*p == 'e' || *p == 'E')
+        {
+          const char *exponent_begin = p + 1;
+          int         exponent_part  = 0;
+          if (parse_integer(exponent_begin, exponent_part) &&
+              !is_blank(*(p + 1)))
+            {
+              exponent += exponent_part;
+              p = exponent_begin;
+            }
+        }
+
+      static const double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                             1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                             1e18, 1e19, 1e20, 1e21, 1e22};
+      // both factors are exactly representable if the mantissa has at most 53
+      // bits and the power of ten is at most 10^22, so the result is
+      // correctly rounded
+      if (exact && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 &&
+          exponent <= 22)
+        {
+          value = (exponent < 0 ?
+                     static_cast<double>(mantissa) / powers_of_ten[-exponent] :
+                     static_cast<double>(mantissa) * powers_of_ten[exponent]);
+          if (negative)
+            value = -value;
+          return true;
+        }
+
+      std::istringstream in(std::string(begin, p));
+      in.imbue(std::locale::classic());
+      in >> value;
+      return !in.fail();
+    }
+
+
+
+    /**
+     * Parse a word that may be preceded by white space at @p p, and move @p p
+     * past it.
+     */
+    bool
+    parse_word(const char *&p, std::string &word)
+    {
+      while (is_blank(*p))
+        ++p;
+      const char *begin = p;
+      while (*p != '\n' && !is_blank(*p))
+        ++p;
+      word.assign(begin, p);
+      return p != begin;
+    }
+
+
+
+    /**
+     * Return whether there is nothing but white space left in the line at
+     * @p p.
+     */
+    bool
+    at_end_of_line(const char *p)
+    {
+      while (is_blank(*p))
+        ++p;
+      return *p == '\n';
+    }
+
+
+
+    /**
+     * Store @p line in @p first_invalid_line if it is smaller than the number
+     * stored there so far.
+     */
+    void
+    record_invalid_line(const unsigned int         line,
+                        std::atomic<unsigned int> &first_invalid_line)
+    {
+      unsigned int current = first_invalid_line;
+      while (line < current &&
+             !first_invalid_line.compare_exchange_weak(current, line))
+        ;
+    }
+
+
+
+    /**
+     * Parse the lines of a vertex section of a Gmsh or UCD file, each of which
+     * contains the number of the vertex followed by three coordinates, in
+     * parallel. Return the number of the first line that could not be parsed,
+     * or numbers::invalid_unsigned_int.
+     */
+    unsigned int
+    parse_numbered_vertices(const TextLines &                   lines,
+                            std::vector<int> &                  vertex_numbers,
+                            std::vector<std::array<double, 3>> &coordinates)
+    {
+      vertex_numbers.resize(lines.size());
+      coordinates.resize(lines.size());
+      std::atomic<unsigned int> first_invalid_line(
+        numbers::invalid_unsigned_int);
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(lines.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const char *p = lines.begin(i);
+              if (!parse_integer(p, vertex_numbers[i]) ||
+                  !parse_double(p, coordinates[i][0]) ||
+                  !parse_double(p, coordinates[i][1]) ||
+                  !parse_double(p, coordinates[i][2]))
+                record_invalid_line(i, first_invalid_line);
+            }
+        },
+        1000);
+      return first_invalid_line;
+    }
+
+
+
+    /**
+     * The contents of a line of the element section of a Gmsh file, or the
+     * cell section of a UCD file. Only the first eight node numbers of an
+     * element are stored, which is all the elements deal.II can read have.
+     */
+    struct ElementRecord
+    {
+      unsigned int                number;
+      unsigned int                type;
+      std::string                 type_name;
+      unsigned int                material_id;
+      unsigned int                n_declared_nodes;
+      unsigned int                n_nodes;
+      std::array<unsigned int, 8> nodes;
+    };
+
+
+
+    /**
+     * Read the node numbers remaining in the line at @p p into @p element.
+     */
+    bool
+    parse_element_nodes(const char *p, ElementRecord &element)
+    {
+      element.n_nodes = 0;
+      unsigned int node;
+      while (parse_integer(p, node))
+        {
+          if (element.n_nodes < element.nodes.size())
+            element.nodes[element.n_nodes] = node;
+          ++element.n_nodes;
+        }
+      return at_end_of_line(p);
+    }
+
+
+
+    /**
+     * Parse the lines of an element section of a Gmsh file in parallel, see
+     * GridIn::read_msh() for the format. Return the number of the first line
+     * that could not be parsed, or numbers::invalid_unsigned_int.
+     */
+    unsigned int
+    parse_gmsh_elements(const TextLines &           lines,
+                        const unsigned int          gmsh_file_format,
+                        std::vector<ElementRecord> &elements)
+    {
+      elements.resize(lines.size());
+      std::atomic<unsigned int> first_invalid_line(
+        numbers::invalid_unsigned_int);
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(lines.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              ElementRecord &element = elements[i];
+              const char *   p       = lines.begin(i);
+              bool           valid = parse_integer(p, element.number) &&
+                           parse_integer(p, element.type);
+              if (gmsh_file_format == 1)
+                {
+                  unsigned int dummy;
+                  valid = valid && parse_integer(p, element.material_id) &&
+                          parse_integer(p, dummy) &&
+                          parse_integer(p, element.n_declared_nodes);
+                }
+              else
+                {
+                  unsigned int n_tags = 0, tag;
+                  valid                  = valid && parse_integer(p, n_tags);
+                  element.material_id    = 0;
+                  for (unsigned int t = 0; valid && t < n_tags; ++t)
+                    {
+                      valid = parse_integer(p, tag);
+                      if (t == 0)
+                        element.material_id = tag;
+                    }
+                  element.n_declared_nodes = numbers::invalid_unsigned_int;
+                }
+              valid = valid && parse_element_nodes(p, element);
+              if (!valid)
+                record_invalid_line(i, first_invalid_line);
+            }
+        },
+        1000);
+      return first_invalid_line;
+    }
+
+
+
+    /**
+     * Parse the lines of the cell section of a UCD file in parallel, see
+     * GridIn::read_ucd() for the format. Return the number of the first line
+     * that could not be parsed, or numbers::invalid_unsigned_int.
+     */
+    unsigned int
+    parse_ucd_cells(const TextLines &           lines,
+                    std::vector<ElementRecord> &elements)
+    {
+      elements.resize(lines.size());
+      std::atomic<unsigned int> first_invalid_line(
+        numbers::invalid_unsigned_int);
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(lines.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              ElementRecord &element = elements[i];
+              const char *   p       = lines.begin(i);
+              if (!parse_integer(p, element.number) ||
+                  !parse_integer(p, element.material_id) ||
+                  !parse_word(p, element.type_name) ||
+                  !parse_element_nodes(p, element))
+                record_invalid_line(i, first_invalid_line);
+            }
+        },
+        1000);
+      return first_invalid_line;
+    }
+  } // namespace GridInImplementation
+} // namespace internal
+
+
 template <int dim, int spacedim>
 GridIn<dim, spacedim>::GridIn()
   : tria(nullptr, typeid(*this).name())
@@ -114,6 +987,9 @@ void
 GridIn<dim, spacedim>::read_vtk(std::istream &in)
 {
   Assert((dim == 2) || (dim == 3), ExcNotImplemented());
+
+  namespace Parser = internal::GridInImplementation;
+
   std::string line;
 
   // verify that the first, third and fourth lines match
@@ -160,16 +1036,42 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
       in.ignore(256,
                 '\n'); // ignoring the number beside the total no. of points.
 
+      // VTK format always specifies vertex coordinates with 3 components.
+      // a file may contain several points per line, so read as many lines
+      // as contain all coordinates, and parse the lines in parallel
+      std::vector<std::size_t> tokens_before_line;
+      const Parser::TextLines  lines =
+        Parser::read_lines_with_tokens(in, 3 * n_vertices, tokens_before_line);
+      std::vector<double>       coordinates(3 * n_vertices);
+      std::atomic<unsigned int> first_invalid_line(
+        numbers::invalid_unsigned_int);
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(lines.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const char *p = lines.begin(i);
+              for (std::size_t k = tokens_before_line[i];
+                   !Parser::at_end_of_line(p);
+                   ++k)
+                if (!Parser::parse_double(p, coordinates[k]))
+                  {
+                    Parser::record_invalid_line(i, first_invalid_line);
+                    break;
+                  }
+            }
+        },
+        1000);
+      AssertThrow(first_invalid_line == numbers::invalid_unsigned_int,
+                  ExcMessage("While reading VTK file, failed to read the "
+                             "coordinates in the line <" +
+                             lines.get_line(first_invalid_line) + ">"));
+
+      vertices.resize(n_vertices);
       for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-        {
-          // VTK format always specifies vertex coordinates with 3 components
-          Point<3> x;
-          in >> x(0) >> x(1) >> x(2);
-
-          vertices.emplace_back();
-          for (unsigned int d = 0; d < spacedim; ++d)
-            vertices.back()(d) = x(d);
-        }
+        for (unsigned int d = 0; d < spacedim; ++d)
+          vertices[vertex](d) = coordinates[3 * vertex + d];
     }
 
   else
@@ -182,8 +1084,6 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
   /// sections////////////////////
   std::string checkline;
   int         no;
-  in.ignore(256,
-            '\n'); // this move pointer to the next line ignoring unwanted no.
   no = in.tellg();
   getline(in, checkline);
   if (checkline.compare("") != 0)
@@ -672,6 +1572,8 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
   Assert(tria != nullptr, ExcNoTriangulationSelected());
   AssertThrow(in, ExcIO());
 
+  namespace Parser = internal::GridInImplementation;
+
   // skip comments at start of file
   skip_comment_lines(in, '#');
 
@@ -692,23 +1594,40 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
   // vertices vector
   std::map<int, int> vertex_indices;
 
-  for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-    {
-      int    vertex_number;
-      double x[3];
+  // read the list of vertices as a whole and parse its lines in parallel
+  {
+    const Parser::TextLines            lines =
+      Parser::read_lines(in, n_vertices);
+    std::vector<int>                   vertex_numbers;
+    std::vector<std::array<double, 3>> coordinates;
+    const unsigned int                 invalid_line =
+      Parser::parse_numbered_vertices(lines, vertex_numbers, coordinates);
+    AssertThrow(invalid_line == numbers::invalid_unsigned_int,
+                ExcMessage("The line <" + lines.get_line(invalid_line) +
+                           "> of the UCD file does not describe a vertex."));
+
+    for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
+      {
+        // store vertex
+        for (unsigned int d = 0; d < spacedim; ++d)
+          vertices[vertex](d) = coordinates[vertex][d];
+        // store mapping. vertices are usually numbered in ascending order,
+        // which makes the hint correct
+        vertex_indices
+          .emplace_hint(vertex_indices.end(), vertex_numbers[vertex], vertex)
+          ->second = vertex;
+      }
+  }
 
-      // read vertex
-      AssertThrow(in, ExcIO());
-      in >> vertex_number >> x[0] >> x[1] >> x[2];
-
-      // store vertex
-      for (unsigned int d = 0; d < spacedim; ++d)
-        vertices[vertex](d) = x[d];
-      // store mapping; note that
-      // vertices_indices[i] is automatically
-      // created upon first usage
-      vertex_indices[vertex_number] = vertex;
-    };
+  // the same for the list of cells
+  const Parser::TextLines            cell_lines =
+    Parser::read_lines(in, n_cells);
+  std::vector<Parser::ElementRecord> elements;
+  const unsigned int                 invalid_line =
+    Parser::parse_ucd_cells(cell_lines, elements);
+  AssertThrow(invalid_line == numbers::invalid_unsigned_int,
+              ExcMessage("The line <" + cell_lines.get_line(invalid_line) +
+                         "> of the UCD file does not describe a cell."));
 
   // set up array of cells
   std::vector<CellData<dim>> cells;
@@ -716,22 +1635,21 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
 
   for (unsigned int cell = 0; cell < n_cells; ++cell)
     {
-      // note that since in the input
-      // file we found the number of
-      // cells at the top, there
-      // should still be input here,
-      // so check this:
-      AssertThrow(in, ExcIO());
+      const Parser::ElementRecord &element = elements[cell];
 
-      std::string cell_type;
+      const std::string &cell_type = element.type_name;
 
       // we use an unsigned int because we
       // fill this variable through an read-in process
-      unsigned int material_id;
+      const unsigned int material_id = element.material_id;
 
-      in >> dummy // cell number
-        >> material_id;
-      in >> cell_type;
+      // make sure that the line of the cell contains at least the given
+      // number of vertices
+      const auto check_n_nodes = [&](const unsigned int n_nodes) {
+        AssertThrow(element.n_nodes >= n_nodes,
+                    ExcMessage("The line <" + cell_lines.get_line(cell) +
+                               "> of the UCD file has too few vertices."));
+      };
 
       if (((cell_type == "line") && (dim == 1)) ||
           ((cell_type == "quad") && (dim == 2)) ||
@@ -739,10 +1657,11 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
         // found a cell
         {
           // allocate and read indices
+          check_n_nodes(GeometryInfo<dim>::vertices_per_cell);
           cells.emplace_back();
           for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell;
                ++i)
-            in >> cells.back().vertices[i];
+            cells.back().vertices[i] = element.nodes[i];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::material_id>::max(),
@@ -779,9 +1698,10 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
       else if ((cell_type == "line") && ((dim == 2) || (dim == 3)))
         // boundary info
         {
+          check_n_nodes(2);
           subcelldata.boundary_lines.emplace_back();
-          in >> subcelldata.boundary_lines.back().vertices[0] >>
-            subcelldata.boundary_lines.back().vertices[1];
+          subcelldata.boundary_lines.back().vertices[0] = element.nodes[0];
+          subcelldata.boundary_lines.back().vertices[1] = element.nodes[1];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
@@ -837,11 +1757,10 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
       else if ((cell_type == "quad") && (dim == 3))
         // boundary info
         {
+          check_n_nodes(4);
           subcelldata.boundary_quads.emplace_back();
-          in >> subcelldata.boundary_quads.back().vertices[0] >>
-            subcelldata.boundary_quads.back().vertices[1] >>
-            subcelldata.boundary_quads.back().vertices[2] >>
-            subcelldata.boundary_quads.back().vertices[3];
+          for (unsigned int i = 0; i < 4; ++i)
+            subcelldata.boundary_quads.back().vertices[i] = element.nodes[i];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
@@ -1329,9 +2248,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   Assert(tria != nullptr, ExcNoTriangulationSelected());
   AssertThrow(in, ExcIO());
 
+  namespace Parser = internal::GridInImplementation;
+
   unsigned int n_vertices;
   unsigned int n_cells;
-  unsigned int dummy;
   std::string  line;
 
   in >> line;
@@ -1386,27 +2306,35 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
     }
 
-  // now read the nodes list
+  // now read the nodes list. the list is read as a whole and its lines are
+  // then parsed in parallel
   in >> n_vertices;
   std::vector<Point<spacedim>> vertices(n_vertices);
   // set up mapping between numbering
   // in msh-file (nod) and in the
   // vertices vector
   std::map<int, int> vertex_indices;
-
-  for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-    {
-      int    vertex_number;
-      double x[3];
-
-      // read vertex
-      in >> vertex_number >> x[0] >> x[1] >> x[2];
-
-      for (unsigned int d = 0; d < spacedim; ++d)
-        vertices[vertex](d) = x[d];
-      // store mapping
-      vertex_indices[vertex_number] = vertex;
-    }
+  {
+    const Parser::TextLines            lines =
+      Parser::read_lines(in, n_vertices);
+    std::vector<int>                   vertex_numbers;
+    std::vector<std::array<double, 3>> coordinates;
+    const unsigned int                 invalid_line =
+      Parser::parse_numbered_vertices(lines, vertex_numbers, coordinates);
+    AssertThrow(invalid_line == numbers::invalid_unsigned_int,
+                ExcInvalidGMSHInput(lines.get_line(invalid_line)));
+
+    for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
+      {
+        for (unsigned int d = 0; d < spacedim; ++d)
+          vertices[vertex](d) = coordinates[vertex][d];
+        // store mapping. vertices are usually numbered in ascending order,
+        // which makes the hint correct
+        vertex_indices
+          .emplace_hint(vertex_indices.end(), vertex_numbers[vertex], vertex)
+          ->second = vertex;
+      }
+  }
 
   // Assert we reached the end of the block
   in >> line;
@@ -1420,7 +2348,15 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   AssertThrow(line == begin_elements_marker[gmsh_file_format - 1],
               ExcInvalidGMSHInput(line));
 
+  // read the elements as a whole as well, and parse them in parallel
   in >> n_cells;
+  const Parser::TextLines            element_lines =
+    Parser::read_lines(in, n_cells);
+  std::vector<Parser::ElementRecord> elements;
+  const unsigned int                 invalid_line =
+    Parser::parse_gmsh_elements(element_lines, gmsh_file_format, elements);
+  AssertThrow(invalid_line == numbers::invalid_unsigned_int,
+              ExcInvalidGMSHInput(element_lines.get_line(invalid_line)));
 
   // set up array of cells and subcells (faces). In 1d, there is currently no
   // standard way in deal.II to pass boundary indicators attached to individual
@@ -1431,14 +2367,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
   for (unsigned int cell = 0; cell < n_cells; ++cell)
     {
-      // note that since in the input
-      // file we found the number of
-      // cells at the top, there
-      // should still be input here,
-      // so check this:
-      AssertThrow(in, ExcIO());
+      const Parser::ElementRecord &element = elements[cell];
 
-      unsigned int cell_type;
       unsigned int material_id;
       unsigned int nod_num;
 
@@ -1455,37 +2385,25 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
         material id.
       */
 
-      unsigned int elm_number;
-      in >> elm_number // ELM-NUMBER
-        >> cell_type;  // ELM-TYPE
+      const unsigned int elm_number = element.number; // ELM-NUMBER
+      const unsigned int cell_type  = element.type;   // ELM-TYPE
 
       switch (gmsh_file_format)
         {
           case 1:
             {
-              in >> material_id // REG-PHYS
-                >> dummy        // reg_elm
-                >> nod_num;
+              material_id = element.material_id; // REG-PHYS
+              nod_num     = element.n_declared_nodes;
               break;
             }
 
           case 2:
             {
-              // read the tags; ignore all but the first one which we will
+              // of the tags, we only keep the first one which we will
               // interpret as the material_id (for cells) or boundary_id
               // (for faces)
-              unsigned int n_tags;
-              in >> n_tags;
-              if (n_tags > 0)
-                in >> material_id;
-              else
-                material_id = 0;
-
-              for (unsigned int i = 1; i < n_tags; ++i)
-                in >> dummy;
-
-              nod_num = GeometryInfo<dim>::vertices_per_cell;
-
+              material_id = element.material_id;
+              nod_num     = GeometryInfo<dim>::vertices_per_cell;
               break;
             }
 
@@ -1493,6 +2411,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             AssertThrow(false, ExcNotImplemented());
         }
 
+      // make sure that the line of the element contains at least the
+      // given number of nodes
+      const auto check_n_nodes = [&](const unsigned int n_nodes) {
+        AssertThrow(element.n_nodes >= n_nodes,
+                    ExcInvalidGMSHInput(element_lines.get_line(cell)));
+      };
+
 
       /*       `ELM-TYPE'
                defines the geometrical type of the N-th element:
@@ -1518,10 +2443,11 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                                  "number required for this object"));
 
           // allocate and read indices
+          check_n_nodes(GeometryInfo<dim>::vertices_per_cell);
           cells.emplace_back();
           for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell;
                ++i)
-            in >> cells.back().vertices[i];
+            cells.back().vertices[i] = element.nodes[i];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::material_id>::max(),
@@ -1555,9 +2481,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
         // boundary info
         {
+          check_n_nodes(2);
           subcelldata.boundary_lines.emplace_back();
-          in >> subcelldata.boundary_lines.back().vertices[0] >>
-            subcelldata.boundary_lines.back().vertices[1];
+          subcelldata.boundary_lines.back().vertices[0] = element.nodes[0];
+          subcelldata.boundary_lines.back().vertices[1] = element.nodes[1];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
@@ -1597,11 +2524,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       else if ((cell_type == 3) && (dim == 3))
         // boundary info
         {
+          check_n_nodes(4);
           subcelldata.boundary_quads.emplace_back();
-          in >> subcelldata.boundary_quads.back().vertices[0] >>
-            subcelldata.boundary_quads.back().vertices[1] >>
-            subcelldata.boundary_quads.back().vertices[2] >>
-            subcelldata.boundary_quads.back().vertices[3];
+          for (unsigned int i = 0; i < 4; ++i)
+            subcelldata.boundary_quads.back().vertices[i] = element.nodes[i];
 
           // to make sure that the cast won't fail
           Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
@@ -1639,24 +2565,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
         }
       else if (cell_type == 15)
         {
-          // read the indices of nodes given
-          unsigned int node_index = 0;
-          switch (gmsh_file_format)
-            {
-              case 1:
-                {
-                  for (unsigned int i = 0; i < nod_num; ++i)
-                    in >> node_index;
-                  break;
-                }
-              case 2:
-                {
-                  in >> node_index;
-                  break;
-                }
-              default:
-                Assert(false, ExcInternalError());
-            }
+          // a point has a single node
+          check_n_nodes(1);
+          const unsigned int node_index = element.nodes[0];
 
           // we only care about boundary indicators assigned to individual
           // vertices in 1d (because otherwise the vertices are not faces)
@@ -3025,6 +3936,77 @@ GridIn<3>::debug_output_grid(const std::vector<CellData<3>> &cells,
 
 
 
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_binary(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+  AssertThrow(in, ExcIO());
+
+  const std::vector<char> buffer((std::istreambuf_iterator<char>(in)),
+                                 std::istreambuf_iterator<char>());
+
+  std::vector<Point<spacedim>>               vertices;
+  std::vector<CellData<dim>>                 cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  std::map<unsigned int, types::manifold_id> manifold_ids_1d;
+  read_binary_mesh(buffer.data(),
+                   buffer.size(),
+                   0,
+                   numbers::invalid_unsigned_int,
+                   vertices,
+                   cells,
+                   subcelldata,
+                   boundary_ids_1d,
+                   manifold_ids_1d);
+
+  tria->create_triangulation(vertices, cells, subcelldata);
+  if (dim == 1)
+    {
+      assign_1d_boundary_ids(boundary_ids_1d, *tria);
+      assign_1d_manifold_ids(manifold_ids_1d, *tria);
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_binary(const std::string &filename,
+                                   const unsigned int first_cell,
+                                   const unsigned int n_cells)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+
+  std::vector<Point<spacedim>>               vertices;
+  std::vector<CellData<dim>>                 cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  std::map<unsigned int, types::manifold_id> manifold_ids_1d;
+  {
+    const MappedFile file(filename);
+    read_binary_mesh(file.data(),
+                     file.size(),
+                     first_cell,
+                     n_cells,
+                     vertices,
+                     cells,
+                     subcelldata,
+                     boundary_ids_1d,
+                     manifold_ids_1d);
+  }
+
+  tria->create_triangulation(vertices, cells, subcelldata);
+  if (dim == 1)
+    {
+      assign_1d_boundary_ids(boundary_ids_1d, *tria);
+      assign_1d_manifold_ids(manifold_ids_1d, *tria);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridIn<dim, spacedim>::read(const std::string &filename, Format format)
@@ -3038,8 +4020,6 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
   else
     name = search.find(filename, default_suffix(format));
 
-  std::ifstream in(name.c_str());
-
   if (format == Default)
     {
       const std::string::size_type slashpos = name.find_last_of('/');
@@ -3053,8 +4033,13 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
     }
   if (format == netcdf)
     read_netcdf(filename);
+  else if (format == binary)
+    read_binary(name);
   else
-    read(in, format);
+    {
+      std::ifstream in(name.c_str());
+      read(in, format);
+    }
 }
 
 
@@ -3113,6 +4098,10 @@ GridIn<dim, spacedim>::read(std::istream &in, Format format)
                           "functions, instead."));
         return;
 
+      case binary:
+        read_binary(in);
+        return;
+
       case Default:
         break;
     }
@@ -3146,6 +4135,8 @@ GridIn<dim, spacedim>::default_suffix(const Format format)
         return ".nc";
       case tecplot:
         return ".dat";
+      case binary:
+        return ".dmsh";
       default:
         Assert(false, ExcNotImplemented());
         return ".unknown_format";
@@ -3204,6 +4195,9 @@ GridIn<dim, spacedim>::parse_format(const std::string &format_name)
     // and throw an exception, anyway.
     return tecplot;
 
+  if (format_name == "binary" || format_name == "dmsh")
+    return binary;
+
   AssertThrow(false, ExcInvalidState());
   // return something weird
   return Format(Default);
@@ -3215,7 +4209,7 @@ template <int dim, int spacedim>
 std::string
 GridIn<dim, spacedim>::get_format_names()
 {
-  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot|assimp";
+  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot|assimp|binary";
 }
 
 namespace
@@ -15,6 +15,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/qprojector.h>
@@ -22,6 +23,7 @@
 
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/grid/binary_mesh_format.h>
 #include <deal.II/grid/grid_out.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
@@ -597,6 +599,8 @@ GridOut::default_suffix(const OutputFormat output_format)
         return ".vtk";
       case vtu:
         return ".vtu";
+      case binary:
+        return ".dmsh";
       default:
         Assert(false, ExcNotImplemented());
         return "";
@@ -649,6 +653,9 @@ GridOut::parse_output_format(const std::string &format_name)
   if (format_name == "vtu")
     return vtu;
 
+  if (format_name == "binary" || format_name == "dmsh")
+    return binary;
+
   AssertThrow(false, ExcInvalidState());
   // return something weird
   return OutputFormat(-1);
@@ -659,7 +666,7 @@ GridOut::parse_output_format(const std::string &format_name)
 std::string
 GridOut::get_output_format_names()
 {
-  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu";
+  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu|binary";
 }
 
 
@@ -2934,6 +2941,78 @@ namespace
     v[4] = "level_subdomain";
     return v;
   }
+
+
+
+  /**
+   * Append the record of an object with the @p n_vertices vertices
+   * @p vertex_indices, the material or boundary id @p id, and the manifold
+   * id @p manifold_id in the binary mesh format to @p records.
+   */
+  void
+  append_binary_record(const unsigned int *     vertex_indices,
+                       const unsigned int       n_vertices,
+                       const types::boundary_id id,
+                       const types::manifold_id manifold_id,
+                       std::vector<char> &      records)
+  {
+    namespace Format = internal::BinaryMeshFormat;
+
+    const std::size_t start = records.size();
+    records.resize(start + Format::object_record_size(n_vertices));
+    char *record = &records[start];
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      Format::write_uint32(vertex_indices[v], record + 4 * v);
+    Format::write_uint32(id, record + 4 * n_vertices);
+    Format::write_uint32(manifold_id, record + 4 * n_vertices + 4);
+  }
+
+
+
+  /**
+   * Append the records of the lines of the 3d cell @p cell that have a
+   * boundary id other than zero or a manifold id in the binary mesh format
+   * to @p records, and return their number. Lines are only stored
+   * separately in 3d, so this function does nothing in the other cases.
+   */
+  template <int dim, int spacedim>
+  unsigned int
+  append_binary_lines(const TriaActiveIterator<CellAccessor<dim, spacedim>> &,
+                      const std::vector<unsigned int> &,
+                      std::vector<char> &)
+  {
+    return 0;
+  }
+
+
+
+  template <int spacedim>
+  unsigned int
+  append_binary_lines(
+    const TriaActiveIterator<CellAccessor<3, spacedim>> &cell,
+    const std::vector<unsigned int> &                    new_vertex_index,
+    std::vector<char> &                                  records)
+  {
+    unsigned int n_lines = 0;
+    for (unsigned int l = 0; l < GeometryInfo<3>::lines_per_cell; ++l)
+      {
+        const auto line = cell->line(l);
+        if ((line->at_boundary() && line->boundary_id() != 0) ||
+            line->manifold_id() != numbers::flat_manifold_id)
+          {
+            const unsigned int vertex_indices[2] = {
+              new_vertex_index[line->vertex_index(0)],
+              new_vertex_index[line->vertex_index(1)]};
+            append_binary_record(vertex_indices,
+                                 2,
+                                 line->boundary_id(),
+                                 line->manifold_id(),
+                                 records);
+            ++n_lines;
+          }
+      }
+    return n_lines;
+  }
 } // namespace
 
 
@@ -2998,6 +3077,172 @@ GridOut::write_vtu(const Triangulation<dim, spacedim> &tria,
 
 
 
+template <int dim, int spacedim>
+void
+GridOut::write_binary(const Triangulation<dim, spacedim> &tria,
+                      std::ostream &                      out) const
+{
+  namespace Format = internal::BinaryMeshFormat;
+
+  AssertThrow(out, ExcIO());
+
+  // number the used vertices consecutively
+  const std::vector<Point<spacedim>> &vertices    = tria.get_vertices();
+  const std::vector<bool> &           vertex_used = tria.get_used_vertices();
+  std::vector<unsigned int>           new_vertex_index(
+    vertices.size(), numbers::invalid_unsigned_int);
+  std::vector<unsigned int> used_vertices;
+  used_vertices.reserve(tria.n_used_vertices());
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    if (vertex_used[v])
+      {
+        new_vertex_index[v] = used_vertices.size();
+        used_vertices.push_back(v);
+      }
+
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+    cells;
+  cells.reserve(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    cells.push_back(cell);
+
+  // faces and lines only need to be stored if they have a non-default
+  // boundary or manifold id. in 1d, the triangulation assigns the boundary
+  // ids zero and one to the left and right end of a line, so all vertices
+  // at the boundary are stored. the records are stored with every cell they
+  // belong to, and the index sections contain the number of the first
+  // record of each cell, so that a range of cells can be read without
+  // looking at the records of the other cells. since there are usually few
+  // of them compared to the cells, collect them serially
+  std::vector<char>          face_records;
+  std::vector<char>          line_records;
+  std::vector<std::uint64_t> face_index(cells.size() + 1, 0);
+  std::vector<std::uint64_t> line_index(cells.size() + 1, 0);
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      face_index[c + 1] = face_index[c];
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          const auto face = cells[c]->face(f);
+          if ((face->at_boundary() && (dim == 1 || face->boundary_id() != 0)) ||
+              face->manifold_id() != numbers::flat_manifold_id)
+            {
+              unsigned int
+                vertex_indices[GeometryInfo<dim>::vertices_per_face];
+              for (unsigned int v = 0;
+                   v < GeometryInfo<dim>::vertices_per_face;
+                   ++v)
+                vertex_indices[v] = new_vertex_index[face->vertex_index(v)];
+              append_binary_record(vertex_indices,
+                                   GeometryInfo<dim>::vertices_per_face,
+                                   face->boundary_id(),
+                                   face->manifold_id(),
+                                   face_records);
+              ++face_index[c + 1];
+            }
+        }
+
+      line_index[c + 1] =
+        line_index[c] +
+        append_binary_lines(cells[c], new_vertex_index, line_records);
+    }
+
+  const std::size_t vertex_record_size = Format::vertex_record_size(spacedim);
+  const std::size_t cell_record_size =
+    Format::object_record_size(GeometryInfo<dim>::vertices_per_cell);
+
+  Format::Header header;
+  header.dim             = dim;
+  header.spacedim        = spacedim;
+  header.n_vertices      = used_vertices.size();
+  header.n_cells         = cells.size();
+  header.n_faces         = face_index.back();
+  header.n_lines         = line_index.back();
+  header.vertices_offset = Format::header_size;
+  header.cells_offset =
+    header.vertices_offset + header.n_vertices * vertex_record_size;
+  header.faces_offset = header.cells_offset + header.n_cells * cell_record_size;
+  header.lines_offset = header.faces_offset + face_records.size();
+  header.face_index_offset = header.lines_offset + line_records.size();
+  header.line_index_offset = header.face_index_offset + 8 * face_index.size();
+
+  std::vector<char> buffer(Format::header_size);
+  Format::write_header(header, buffer.data());
+  out.write(buffer.data(), buffer.size());
+
+  // encode the vertices and cells chunk by chunk, to limit the size of the
+  // buffer, and the records within each chunk in parallel
+  const unsigned int chunk_size = 65536;
+  for (unsigned int begin = 0; begin < used_vertices.size();
+       begin += chunk_size)
+    {
+      const unsigned int end =
+        std::min<unsigned int>(begin + chunk_size, used_vertices.size());
+      buffer.resize((end - begin) * vertex_record_size);
+      parallel::apply_to_subranges(
+        begin,
+        end,
+        [&](const unsigned int range_begin, const unsigned int range_end) {
+          for (unsigned int i = range_begin; i < range_end; ++i)
+            {
+              char *record = &buffer[(i - begin) * vertex_record_size];
+              for (unsigned int d = 0; d < spacedim; ++d)
+                Format::write_double(vertices[used_vertices[i]][d],
+                                     record + 8 * d);
+            }
+        },
+        1024);
+      out.write(buffer.data(), buffer.size());
+    }
+
+  for (unsigned int begin = 0; begin < cells.size(); begin += chunk_size)
+    {
+      const unsigned int end =
+        std::min<unsigned int>(begin + chunk_size, cells.size());
+      buffer.resize((end - begin) * cell_record_size);
+      parallel::apply_to_subranges(
+        begin,
+        end,
+        [&](const unsigned int range_begin, const unsigned int range_end) {
+          for (unsigned int i = range_begin; i < range_end; ++i)
+            {
+              char *record = &buffer[(i - begin) * cell_record_size];
+              for (unsigned int v = 0;
+                   v < GeometryInfo<dim>::vertices_per_cell;
+                   ++v)
+                Format::write_uint32(
+                  new_vertex_index[cells[i]->vertex_index(v)], record + 4 * v);
+              Format::write_uint32(
+                cells[i]->material_id(),
+                record + 4 * GeometryInfo<dim>::vertices_per_cell);
+              Format::write_uint32(
+                cells[i]->manifold_id(),
+                record + 4 * GeometryInfo<dim>::vertices_per_cell + 4);
+            }
+        },
+        1024);
+      out.write(buffer.data(), buffer.size());
+    }
+
+  out.write(face_records.data(), face_records.size());
+  out.write(line_records.data(), line_records.size());
+
+  buffer.resize(8 * face_index.size());
+  for (unsigned int i = 0; i < face_index.size(); ++i)
+    Format::write_uint64(face_index[i], &buffer[8 * i]);
+  out.write(buffer.data(), buffer.size());
+  for (unsigned int i = 0; i < line_index.size(); ++i)
+    Format::write_uint64(line_index[i], &buffer[8 * i]);
+  out.write(buffer.data(), buffer.size());
+
+  // make sure everything now gets to disk
+  out.flush();
+
+  AssertThrow(out, ExcIO());
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridOut::write_mesh_per_processor_as_vtu(
@@ -4626,6 +4871,10 @@ GridOut::write(const Triangulation<dim, spacedim> &tria,
       case vtu:
         write_vtu(tria, out);
         return;
+
+      case binary:
+        write_binary(tria, out);
+        return;
     }
 
   Assert(false, ExcInternalError());
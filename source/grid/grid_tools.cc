@@ -15,6 +15,7 @@
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -53,11 +54,18 @@
 
 #include <deal.II/numerics/matrix_tools.h>
 
+#ifdef DEAL_II_WITH_THREADS
+#  include <tbb/parallel_sort.h>
+#endif
+
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <numeric>
@@ -528,6 +536,154 @@ namespace GridTools
 
 
 
+  namespace
+  {
+    /**
+     * For each position p in @p considered_vertices, find the positions
+     * q < p of the vertices that are closer than @p tol in each coordinate
+     * direction. The result is written in compressed form into
+     * @p close_start and @p close_positions.
+     *
+     * The vertices are sorted by the cell of a uniform background grid whose
+     * cells are considerably larger than @p tol. The candidates for each
+     * vertex are then the ones in its own cell and, only if the vertex is
+     * within @p tol of a face of its cell, in the respective neighbor
+     * cells. These are found by binary search in the sorted list. The
+     * search and the filling of the result run in parallel.
+     */
+    template <int spacedim>
+    void
+    find_close_vertices(const std::vector<Point<spacedim>> &vertices,
+                        const std::vector<unsigned int> &considered_vertices,
+                        const double                     tol,
+                        std::vector<unsigned int> &      close_start,
+                        std::vector<unsigned int> &      close_positions)
+    {
+      const unsigned int n_considered = considered_vertices.size();
+      const unsigned int grain_size   = 2048;
+
+      // sort the vertices by the cell of a background grid they lie in
+      Point<spacedim> lower = vertices[considered_vertices[0]],
+                      upper = vertices[considered_vertices[0]];
+      for (const unsigned int v : considered_vertices)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            lower[d] = std::min(lower[d], vertices[v][d]);
+            upper[d] = std::max(upper[d], vertices[v][d]);
+          }
+      const internal::BackgroundGrid<spacedim> grid(lower, upper, tol);
+      using GridCell = typename internal::BackgroundGrid<spacedim>::Cell;
+
+      std::vector<std::pair<GridCell, unsigned int>> sorted(n_considered);
+      parallel::apply_to_subranges(
+        0U,
+        n_considered,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int p = begin; p < end; ++p)
+            {
+              sorted[p].first  = grid.cell(vertices[considered_vertices[p]]);
+              sorted[p].second = p;
+            }
+        },
+        grain_size);
+#ifdef DEAL_II_WITH_THREADS
+      tbb::parallel_sort(sorted.begin(), sorted.end());
+#else
+      std::sort(sorted.begin(), sorted.end());
+#endif
+
+      // visit the vertices in the relevant cells around position p that
+      // come before p, and call the given function for the ones that are
+      // close. a neighbor in direction d only needs to be looked at if the
+      // vertex is close to the respective face; the factor two guards
+      // against roundoff in the computation of the cell coordinates
+      const auto for_each_close_vertex = [&](const unsigned int p,
+                                             const GridCell &   cell,
+                                             const std::function<void(
+                                               const unsigned int)> &action) {
+        const Point<spacedim> &   vertex = vertices[considered_vertices[p]];
+        const double              cell_size = grid.get_cell_size();
+        std::array<int, spacedim> first_offset, last_offset;
+        unsigned int              n_neighbors = 1;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const double position = grid.position_in_cell(vertex, cell, d);
+            first_offset[d]       = (position < 2. * tol ? -1 : 0);
+            last_offset[d]        = (cell_size - position < 2. * tol ? 1 : 0);
+            n_neighbors *= 3;
+          }
+
+        for (unsigned int n = 0; n < n_neighbors; ++n)
+          {
+            GridCell neighbor = cell;
+            bool     relevant = true;
+            for (unsigned int d = 0, code = n; d < spacedim; ++d, code /= 3)
+              {
+                const int offset = static_cast<int>(code % 3) - 1;
+                relevant &=
+                  (offset >= first_offset[d] && offset <= last_offset[d]);
+                neighbor[d] += offset;
+              }
+            if (relevant == false)
+              continue;
+
+            auto it = std::lower_bound(sorted.begin(),
+                                       sorted.end(),
+                                       std::make_pair(neighbor, 0U));
+            for (; it != sorted.end() && it->first == neighbor &&
+                   it->second < p;
+                 ++it)
+              {
+                const Point<spacedim> &other =
+                  vertices[considered_vertices[it->second]];
+                bool equal = true;
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  equal &= (std::abs(other[d] - vertex[d]) < tol);
+                if (equal)
+                  action(it->second);
+              }
+          }
+      };
+
+      // count the close vertices of each position, then fill them in
+      close_start.assign(n_considered + 1, 0);
+      parallel::apply_to_subranges(
+        0U,
+        n_considered,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int k = begin; k < end; ++k)
+            for_each_close_vertex(sorted[k].second,
+                                  sorted[k].first,
+                                  [&](const unsigned int) {
+                                    ++close_start[sorted[k].second + 1];
+                                  });
+        },
+        grain_size);
+      std::partial_sum(close_start.begin(),
+                       close_start.end(),
+                       close_start.begin());
+
+      close_positions.resize(close_start.back());
+      parallel::apply_to_subranges(
+        0U,
+        n_considered,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int k = begin; k < end; ++k)
+            {
+              unsigned int index = close_start[sorted[k].second];
+              for_each_close_vertex(sorted[k].second,
+                                    sorted[k].first,
+                                    [&](const unsigned int q) {
+                                      close_positions[index++] = q;
+                                    });
+            }
+        },
+        grain_size);
+    }
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   void
   delete_duplicated_vertices(std::vector<Point<spacedim>> &vertices,
@@ -549,36 +705,37 @@ namespace GridTools
       considered_vertices = new_vertex_numbers;
 
     Assert(considered_vertices.size() <= vertices.size(), ExcInternalError());
+    for (const unsigned int v : considered_vertices)
+      {
+        (void)v;
+        Assert(v < vertices.size(), ExcInternalError());
+      }
 
-
-    // now loop over all vertices to be
-    // considered and try to find an identical
-    // one
-    for (unsigned int i = 0; i < considered_vertices.size(); ++i)
+    // the vertices are processed in the order given by considered_vertices.
+    // a vertex that is not close to any earlier vertex that has been kept is
+    // kept itself. all other vertices are identified with the last of the
+    // kept earlier vertices they are close to. finding the close vertices
+    // only requires a sort and a local search, and is done in parallel,
+    // leaving a cheap sequential pass over the list to decide which vertices
+    // are kept
+    if (considered_vertices.size() > 1)
       {
-        Assert(considered_vertices[i] < vertices.size(), ExcInternalError());
-        if (new_vertex_numbers[considered_vertices[i]] !=
-            considered_vertices[i])
-          // this vertex has been identified with
-          // another one already, skip it in the
-          // test
-          continue;
-        // this vertex is not identified with
-        // another one so far. search in the list
-        // of remaining vertices. if a duplicate
-        // vertex is found, set the new vertex
-        // index for that vertex to this vertex'
-        // index.
-        for (unsigned int j = i + 1; j < considered_vertices.size(); ++j)
+        std::vector<unsigned int> close_start, close_positions;
+        find_close_vertices(
+          vertices, considered_vertices, tol, close_start, close_positions);
+
+        std::vector<bool> is_kept(considered_vertices.size(), true);
+        for (unsigned int p = 0; p < considered_vertices.size(); ++p)
           {
-            bool equal = true;
-            for (unsigned int d = 0; d < spacedim; ++d)
-              equal &= (std::abs(vertices[considered_vertices[j]](d) -
-                                 vertices[considered_vertices[i]](d)) < tol);
-            if (equal)
+            int last_kept = -1;
+            for (unsigned int k = close_start[p]; k < close_start[p + 1]; ++k)
+              if (is_kept[close_positions[k]])
+                last_kept = std::max<int>(last_kept, close_positions[k]);
+            if (last_kept >= 0)
               {
-                new_vertex_numbers[considered_vertices[j]] =
-                  considered_vertices[i];
+                is_kept[p] = false;
+                new_vertex_numbers[considered_vertices[p]] =
+                  considered_vertices[last_kept];
               }
           }
       }
@@ -2650,8 +2807,166 @@ namespace GridTools
                                                    n_partitions);
         }
     }
+
+
+
+    /**
+     * If all children of a cell are active, assign them to the processor
+     * that owns the largest number of them (ties are broken by picking the
+     * lower rank).
+     */
+    template <int dim, int spacedim>
+    void
+    assign_active_siblings_to_common_owner(
+      Triangulation<dim, spacedim> &triangulation)
+    {
+      typename Triangulation<dim, spacedim>::cell_iterator
+        cell = triangulation.begin(),
+        endc = triangulation.end();
+      for (; cell != endc; ++cell)
+        {
+          if (cell->active())
+            continue;
+          bool                                 all_children_active = true;
+          std::map<unsigned int, unsigned int> map_cpu_n_cells;
+          for (unsigned int n = 0; n < cell->n_children(); ++n)
+            if (!cell->child(n)->active())
+              {
+                all_children_active = false;
+                break;
+              }
+            else
+              ++map_cpu_n_cells[cell->child(n)->subdomain_id()];
+
+          if (!all_children_active)
+            continue;
+
+          unsigned int new_owner = cell->child(0)->subdomain_id();
+          for (std::map<unsigned int, unsigned int>::iterator it =
+                 map_cpu_n_cells.begin();
+               it != map_cpu_n_cells.end();
+               ++it)
+            if (it->second > map_cpu_n_cells[new_owner])
+              new_owner = it->first;
+
+          for (unsigned int n = 0; n < cell->n_children(); ++n)
+            cell->child(n)->set_subdomain_id(new_owner);
+        }
+    }
+
+
+
+    /**
+     * Return the position of the point with the given integer coordinates,
+     * each of which has @p bits bits, along the Hilbert curve through the
+     * cube of all such points. This follows J. Skilling, "Programming the
+     * Hilbert curve", AIP Conference Proceedings 707 (2004), which first
+     * transforms the coordinates in place and then interleaves their bits.
+     */
+    template <std::size_t spacedim>
+    std::uint64_t
+    hilbert_curve_position(std::array<std::uint64_t, spacedim> x,
+                           const unsigned int                  bits)
+    {
+      if (spacedim == 1)
+        return x[0];
+
+      const std::uint64_t highest_bit = std::uint64_t(1) << (bits - 1);
+
+      // undo the excess work of the inverse transform
+      for (std::uint64_t q = highest_bit; q > 1; q >>= 1)
+        {
+          const std::uint64_t p = q - 1;
+          for (unsigned int i = 0; i < spacedim; ++i)
+            if (x[i] & q)
+              x[0] ^= p;
+            else
+              {
+                const std::uint64_t t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+              }
+        }
+
+      // Gray encode
+      for (unsigned int i = 1; i < spacedim; ++i)
+        x[i] ^= x[i - 1];
+      std::uint64_t t = 0;
+      for (std::uint64_t q = highest_bit; q > 1; q >>= 1)
+        if (x[spacedim - 1] & q)
+          t ^= q - 1;
+      for (unsigned int i = 0; i < spacedim; ++i)
+        x[i] ^= t;
+
+      // interleave the bits, starting with the most significant ones
+      std::uint64_t position = 0;
+      for (int b = bits - 1; b >= 0; --b)
+        for (unsigned int i = 0; i < spacedim; ++i)
+          position = (position << 1) | ((x[i] >> b) & 1);
+      return position;
+    }
   } // namespace
 
+
+
+  template <int dim, int spacedim>
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+  sort_active_cells_along_hilbert_curve(
+    const Triangulation<dim, spacedim> &triangulation)
+  {
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells;
+    cells.reserve(triangulation.n_active_cells());
+    for (const auto &cell : triangulation.active_cell_iterators())
+      cells.push_back(cell);
+
+    // compute the positions of the cell centers on the curve in parallel,
+    // using as many bits per coordinate as fit into the 64 bit index
+    const std::pair<Point<spacedim>, Point<spacedim>> corners =
+      compute_bounding_box(triangulation).get_boundary_points();
+    const unsigned int bits_per_coordinate =
+      (spacedim == 1 ? 32 : 64 / spacedim);
+    const double max_coordinate =
+      static_cast<double>((std::uint64_t(1) << bits_per_coordinate) - 1);
+    std::vector<std::pair<std::uint64_t, unsigned int>> curve_positions(
+      cells.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const Point<spacedim>               center = cells[i]->center();
+            std::array<std::uint64_t, spacedim> coordinates;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const double extent = corners.second[d] - corners.first[d];
+                const double relative =
+                  (extent > 0. ? (center[d] - corners.first[d]) / extent : 0.);
+                coordinates[d] = static_cast<std::uint64_t>(
+                  std::max(0., std::min(1., relative)) * max_coordinate);
+              }
+            curve_positions[i] = {
+              hilbert_curve_position(coordinates, bits_per_coordinate), i};
+          }
+      },
+      1000);
+#ifdef DEAL_II_WITH_THREADS
+    tbb::parallel_sort(curve_positions.begin(), curve_positions.end());
+#else
+    std::sort(curve_positions.begin(), curve_positions.end());
+#endif
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      sorted_cells;
+    sorted_cells.reserve(cells.size());
+    for (const auto &position : curve_positions)
+      sorted_cells.push_back(cells[position.second]);
+    return sorted_cells;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   partition_triangulation_zorder(const unsigned int            n_partitions,
@@ -2717,44 +3032,88 @@ namespace GridTools
     // if all children of a cell are active (e.g. we
     // have a cell that is refined once and no part
     // is refined further), p4est places all of them
-    // on the same processor. The new owner will be
-    // the processor with the largest number of children
-    // (ties are broken by picking the lower rank).
-    // Duplicate this logic here.
-    {
-      typename Triangulation<dim, spacedim>::cell_iterator
-        cell = triangulation.begin(),
-        endc = triangulation.end();
-      for (; cell != endc; ++cell)
-        {
-          if (cell->active())
-            continue;
-          bool                                 all_children_active = true;
-          std::map<unsigned int, unsigned int> map_cpu_n_cells;
-          for (unsigned int n = 0; n < cell->n_children(); ++n)
-            if (!cell->child(n)->active())
-              {
-                all_children_active = false;
-                break;
-              }
-            else
-              ++map_cpu_n_cells[cell->child(n)->subdomain_id()];
+    // on the same processor. Duplicate this logic here.
+    assign_active_siblings_to_common_owner(triangulation);
+  }
 
-          if (!all_children_active)
-            continue;
 
-          unsigned int new_owner = cell->child(0)->subdomain_id();
-          for (std::map<unsigned int, unsigned int>::iterator it =
-                 map_cpu_n_cells.begin();
-               it != map_cpu_n_cells.end();
-               ++it)
-            if (it->second > map_cpu_n_cells[new_owner])
-              new_owner = it->first;
 
-          for (unsigned int n = 0; n < cell->n_children(); ++n)
-            cell->child(n)->set_subdomain_id(new_owner);
-        }
-    }
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation)
+  {
+    std::vector<unsigned int> cell_weights;
+
+    // Get cell weighting if a signal has been attached to the triangulation
+    if (!triangulation.signals.cell_weight.empty())
+      {
+        cell_weights.resize(triangulation.n_active_cells());
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell_weights[cell->active_cell_index()] =
+            triangulation.signals.cell_weight(
+              cell, Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST);
+      }
+
+    // Call the other more general function
+    partition_triangulation_hilbert(n_partitions, cell_weights, triangulation);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(
+    const unsigned int               n_partitions,
+    const std::vector<unsigned int> &cell_weights,
+    Triangulation<dim, spacedim> &   triangulation)
+  {
+    Assert((dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcMessage("Objects of type parallel::distributed::Triangulation "
+                      "are already partitioned implicitly and can not be "
+                      "partitioned again explicitly."));
+    Assert(n_partitions > 0, ExcInvalidNumberOfPartitions(n_partitions));
+    Assert(cell_weights.size() == 0 ||
+             cell_weights.size() == triangulation.n_active_cells(),
+           ExcDimensionMismatch(cell_weights.size(),
+                                triangulation.n_active_cells()));
+
+    // check for an easy return
+    if (n_partitions == 1)
+      {
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell->set_subdomain_id(0);
+        return;
+      }
+
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells = sort_active_cells_along_hilbert_curve(triangulation);
+
+    // then cut the curve into pieces of equal weight. without weights, or
+    // if all of them are zero, every cell counts the same
+    std::uint64_t total_weight = 0;
+    for (const unsigned int weight : cell_weights)
+      total_weight += weight;
+    const bool use_weights = (total_weight > 0);
+    if (!use_weights)
+      total_weight = cells.size();
+
+    std::uint64_t weight_before = 0;
+    for (const auto &cell : cells)
+      {
+        cell->set_subdomain_id(static_cast<types::subdomain_id>(
+          std::min<std::uint64_t>(weight_before * n_partitions / total_weight,
+                                  n_partitions - 1)));
+        weight_before +=
+          (use_weights ? cell_weights[cell->active_cell_index()] : 1);
+      }
+
+    // as for the Z-order, keep cells whose siblings are all active on the
+    // same processor, which is also what partition_multigrid_levels()
+    // assumes for the cells on coarser levels
+    assign_active_siblings_to_common_owner(triangulation);
   }
 
 
@@ -3987,6 +4346,143 @@ namespace GridTools
 
 
 
+  namespace
+  {
+    /**
+     * Look for a locally owned active cell around the point @p p among the
+     * cells whose bounding boxes stored in @p cache contain the point. The
+     * cell @p cell_hint is tried first if it is one of the candidates, the
+     * other candidates are tried in the order of the cells to make the
+     * result independent of the layout of the tree. As in the search
+     * through the neighborhoods of vertices, a cell for which the point lies
+     * at most a distance of 1e-10 outside the unit cell is accepted if no
+     * cell contains the point. If no cell is found, the returned iterator is
+     * invalid.
+     *
+     * The vector @p candidates is only used as scratch space, to avoid
+     * allocating memory when calling this function for many points.
+     */
+    template <int dim, int spacedim>
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>
+    find_locally_owned_cell_in_bounding_boxes(
+      const Cache<dim, spacedim> &cache,
+      const Point<spacedim> &     p,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator
+        &cell_hint,
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+        &candidates)
+    {
+      const Mapping<dim, spacedim> &mapping = cache.get_mapping();
+
+      cache.get_cells_with_bounding_box_around_point(p, candidates);
+      if (cell_hint.state() == IteratorState::valid)
+        {
+          const auto hint =
+            std::find(candidates.begin(), candidates.end(), cell_hint);
+          if (hint != candidates.end())
+            std::rotate(candidates.begin(), hint, std::next(hint));
+        }
+
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                Point<dim>>
+             cell_and_position_approx;
+      double best_distance = 1e-10;
+      for (const auto &candidate : candidates)
+        {
+          try
+            {
+              const Point<dim> p_unit =
+                mapping.transform_real_to_unit_cell(candidate, p);
+              if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                return std::make_pair(candidate, p_unit);
+
+              const double dist =
+                GeometryInfo<dim>::distance_to_unit_cell(p_unit);
+              if (dist < best_distance)
+                {
+                  best_distance                   = dist;
+                  cell_and_position_approx.first  = candidate;
+                  cell_and_position_approx.second = p_unit;
+                }
+            }
+          catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+            {}
+        }
+      return cell_and_position_approx;
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator
+      &cell_hint)
+  {
+    // build all data structures of the cache before starting the threads,
+    // so that the threads do not wait for each other to build them
+    const auto &mesh            = cache.get_triangulation();
+    const auto &mapping         = cache.get_mapping();
+    const auto &vertex_to_cells = cache.get_vertex_to_cell_map();
+    const auto &vertex_to_cell_centers =
+      cache.get_vertex_to_cell_centers_directions();
+    cache.n_cell_bounding_boxes();
+
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                Point<dim>>>
+      cells_and_positions(points.size());
+
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(points.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          candidates;
+        // consecutive points often lie in the same cell, so use the cell of
+        // the previous point as a hint for the next one
+        auto hint = cell_hint;
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            cells_and_positions[i] =
+              find_locally_owned_cell_in_bounding_boxes<dim, spacedim>(
+                cache, points[i], hint, candidates);
+
+            // the point is not in a locally owned cell (or in a curved cell
+            // that extends beyond the bounding box of its vertices): fall
+            // back to the search through the neighborhoods of vertices,
+            // which may also find ghost cells
+            if (cells_and_positions[i].first.state() != IteratorState::valid)
+              try
+                {
+                  cells_and_positions[i] =
+                    find_active_cell_around_point(mapping,
+                                                  mesh,
+                                                  points[i],
+                                                  vertex_to_cells,
+                                                  vertex_to_cell_centers,
+                                                  hint);
+                }
+              catch (ExcPointNotFound<spacedim> &)
+                {}
+
+            if (cells_and_positions[i].first.state() == IteratorState::valid)
+              hint = cells_and_positions[i].first;
+          }
+      },
+      64);
+
+    return cells_and_positions;
+  }
+
+
+
   template <int dim, int spacedim>
 #ifndef DOXYGEN
   std::tuple<
@@ -4015,78 +4511,29 @@ namespace GridTools
     if (np == 0)
       return cell_qpoint_map;
 
-    // We begin by finding the cell/transform of the first point
-    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
-              Point<dim>>
-      my_pair;
-    if (cell_hint.state() == IteratorState::valid)
-      my_pair =
-        GridTools::find_active_cell_around_point(cache, points[0], cell_hint);
-    else
-      my_pair = GridTools::find_active_cell_around_point(cache, points[0]);
+    const auto cells_and_positions =
+      find_active_cells_around_points(cache, points, cell_hint);
 
-    std::get<0>(cell_qpoint_map).emplace_back(my_pair.first);
-    std::get<1>(cell_qpoint_map).emplace_back(1, my_pair.second);
-    std::get<2>(cell_qpoint_map).emplace_back(1, 0);
-
-    // Now the second easy case.
-    if (np == 1)
-      return cell_qpoint_map;
-    // Computing the cell center and diameter
-    Point<spacedim> cell_center = std::get<0>(cell_qpoint_map)[0]->center();
-    double cell_diameter        = std::get<0>(cell_qpoint_map)[0]->diameter() *
-                           (0.5 + std::numeric_limits<double>::epsilon());
-
-    // Cycle over all points left
-    for (unsigned int p = 1; p < np; ++p)
+    // Group the points by the cells they lie in, numbering the cells in the
+    // order in which they are first encountered
+    std::unordered_map<unsigned int, unsigned int> cell_to_index;
+    for (unsigned int p = 0; p < np; ++p)
       {
-        // Checking if the point is close to the cell center, in which
-        // case calling find active cell with a cell hint
-        if (cell_center.distance(points[p]) < cell_diameter)
-          my_pair = GridTools::find_active_cell_around_point(
-            cache, points[p], std::get<0>(cell_qpoint_map).back());
-        else
-          my_pair = GridTools::find_active_cell_around_point(cache, points[p]);
+        const auto &cell = cells_and_positions[p].first;
+        AssertThrow(cell.state() == IteratorState::valid,
+                    ExcPointNotFound<spacedim>(points[p]));
 
-        // Assuming the cell is probably the last cell added
-        if (my_pair.first == std::get<0>(cell_qpoint_map).back())
+        const auto index = cell_to_index.emplace(
+          cell->active_cell_index(), std::get<0>(cell_qpoint_map).size());
+        if (index.second == true)
           {
-            // Found in the last cell: adding the data
-            std::get<1>(cell_qpoint_map).back().emplace_back(my_pair.second);
-            std::get<2>(cell_qpoint_map).back().emplace_back(p);
-          }
-        else
-          {
-            // Check if it is in another cell already found
-            typename std::vector<typename Triangulation<dim, spacedim>::
-                                   active_cell_iterator>::iterator cells_it =
-              std::find(std::get<0>(cell_qpoint_map).begin(),
-                        std::get<0>(cell_qpoint_map).end() - 1,
-                        my_pair.first);
-
-            if (cells_it == std::get<0>(cell_qpoint_map).end() - 1)
-              {
-                // Cell not found: adding a new cell
-                std::get<0>(cell_qpoint_map).emplace_back(my_pair.first);
-                std::get<1>(cell_qpoint_map).emplace_back(1, my_pair.second);
-                std::get<2>(cell_qpoint_map).emplace_back(1, p);
-                // Updating center and radius of the cell
-                cell_center = std::get<0>(cell_qpoint_map).back()->center();
-                cell_diameter =
-                  std::get<0>(cell_qpoint_map).back()->diameter() *
-                  (0.5 + std::numeric_limits<double>::epsilon());
-              }
-            else
-              {
-                unsigned int current_cell =
-                  cells_it - std::get<0>(cell_qpoint_map).begin();
-                // Cell found: just adding the point index and qpoint to the
-                // list
-                std::get<1>(cell_qpoint_map)[current_cell].emplace_back(
-                  my_pair.second);
-                std::get<2>(cell_qpoint_map)[current_cell].emplace_back(p);
-              }
+            std::get<0>(cell_qpoint_map).emplace_back(cell);
+            std::get<1>(cell_qpoint_map).emplace_back();
+            std::get<2>(cell_qpoint_map).emplace_back();
           }
+        std::get<1>(cell_qpoint_map)[index.first->second].emplace_back(
+          cells_and_positions[p].second);
+        std::get<2>(cell_qpoint_map)[index.first->second].emplace_back(p);
       }
 
     // Debug Checking
@@ -4167,62 +4614,18 @@ namespace GridTools
         // Now the easy case.
         if (np == 0)
           return cell_qpoint_map;
-        // We begin by finding the cell/transform of the first point
-        auto my_pair =
-          GridTools::find_active_cell_around_point(cache, points[0]);
-
-        auto last_cell = cell_qpoint_map.emplace(
-          std::make_pair(my_pair.first,
-                         std::make_pair(std::vector<Point<dim>>{my_pair.second},
-                                        std::vector<unsigned int>{0})));
-        // Now the second easy case.
-        if (np == 1)
-          return cell_qpoint_map;
-        // Computing the cell center and diameter
-        Point<spacedim> cell_center   = my_pair.first->center();
-        double          cell_diameter = my_pair.first->diameter() *
-                               (0.5 + std::numeric_limits<double>::epsilon());
 
-        // Cycle over all points left
-        for (unsigned int p = 1; p < np; ++p)
+        const auto cells_and_positions =
+          GridTools::find_active_cells_around_points(cache, points);
+        for (unsigned int p = 0; p < np; ++p)
           {
-            // Checking if the point is close to the cell center, in which
-            // case calling find active cell with a cell hint
-            if (cell_center.distance(points[p]) < cell_diameter)
-              my_pair = GridTools::find_active_cell_around_point(
-                cache, points[p], last_cell.first->first);
-            else
-              my_pair =
-                GridTools::find_active_cell_around_point(cache, points[p]);
+            const auto &cell = cells_and_positions[p].first;
+            AssertThrow(cell.state() == IteratorState::valid,
+                        ExcPointNotFound<spacedim>(points[p]));
 
-            if (last_cell.first->first == my_pair.first)
-              {
-                last_cell.first->second.first.emplace_back(my_pair.second);
-                last_cell.first->second.second.emplace_back(p);
-              }
-            else
-              {
-                // Check if it is in another cell already found
-                last_cell = cell_qpoint_map.emplace(std::make_pair(
-                  my_pair.first,
-                  std::make_pair(std::vector<Point<dim>>{my_pair.second},
-                                 std::vector<unsigned int>{p})));
-
-                if (last_cell.second == false)
-                  {
-                    // Cell already present: adding the new point
-                    last_cell.first->second.first.emplace_back(my_pair.second);
-                    last_cell.first->second.second.emplace_back(p);
-                  }
-                else
-                  {
-                    // New cell was added, updating center and diameter
-                    cell_center = my_pair.first->center();
-                    cell_diameter =
-                      my_pair.first->diameter() *
-                      (0.5 + std::numeric_limits<double>::epsilon());
-                  }
-              }
+            auto &cell_data = cell_qpoint_map[cell];
+            cell_data.first.emplace_back(cells_and_positions[p].second);
+            cell_data.second.emplace_back(p);
           }
 
 #ifdef DEBUG
@@ -4780,8 +5183,22 @@ namespace GridTools
       &                      cell_hint,
     const std::vector<bool> &marked_vertices)
   {
-    const auto &mesh            = cache.get_triangulation();
-    const auto &mapping         = cache.get_mapping();
+    const auto &mesh    = cache.get_triangulation();
+    const auto &mapping = cache.get_mapping();
+
+    // the bounding boxes of the cells know nothing about marked vertices, so
+    // a restricted search has to go through the neighborhoods of vertices
+    if (marked_vertices.size() == 0)
+      {
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                   candidates;
+        const auto cell_and_position =
+          find_locally_owned_cell_in_bounding_boxes<dim, spacedim>(
+            cache, p, cell_hint, candidates);
+        if (cell_and_position.first.state() == IteratorState::valid)
+          return cell_and_position;
+      }
+
     const auto &vertex_to_cells = cache.get_vertex_to_cell_map();
     const auto &vertex_to_cell_centers =
       cache.get_vertex_to_cell_centers_directions();
@@ -13,13 +13,54 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/config.h>
+
+// boost.geometry triggers warnings in the templates of boost's concept
+// checks when they are instantiated. whether these are reported depends on
+// where the concept check headers are first included, so include
+// boost.geometry before any other header pulls them in
+DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/boost_adaptors/bounding_box.h>
+
+#include <boost/geometry/index/rtree.hpp>
+DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  /**
+   * The R-tree of the bounding boxes of the locally owned active cells. Its
+   * entries are pairs of the bounding box of a cell and the cell itself.
+   */
+  template <int dim, int spacedim>
+  class Cache<dim, spacedim>::CellBoundingBoxRtree
+    : public boost::geometry::index::rtree<
+        std::pair<BoundingBox<spacedim>,
+                  typename Triangulation<dim, spacedim>::active_cell_iterator>,
+        boost::geometry::index::rstar<16>>
+  {
+  public:
+    using value_type =
+      std::pair<BoundingBox<spacedim>,
+                typename Triangulation<dim, spacedim>::active_cell_iterator>;
+    using base_type =
+      boost::geometry::index::rtree<value_type,
+                                    boost::geometry::index::rstar<16>>;
+
+    using base_type::base_type;
+  };
+
+
+
   template <int dim, int spacedim>
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
@@ -46,7 +87,8 @@ namespace GridTools
   void
   Cache<dim, spacedim>::mark_for_update(const CacheUpdateFlags &flags)
   {
-    update_flags |= flags;
+    Threads::Mutex::ScopedLock lock(builder_mutex);
+    update_flags = update_flags | flags;
   }
 
 
@@ -56,10 +98,16 @@ namespace GridTools
     std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_vertex_to_cell_map() const
   {
+    // check the flag again after acquiring the lock, since another thread
+    // may have built the map in the meantime
     if (update_flags & update_vertex_to_cell_map)
       {
-        vertex_to_cells = GridTools::vertex_to_cell_map(*tria);
-        update_flags    = update_flags & ~update_vertex_to_cell_map;
+        Threads::Mutex::ScopedLock lock(builder_mutex);
+        if (update_flags & update_vertex_to_cell_map)
+          {
+            vertex_to_cells = GridTools::vertex_to_cell_map(*tria);
+            update_flags    = update_flags & ~update_vertex_to_cell_map;
+          }
       }
     return vertex_to_cells;
   }
@@ -72,9 +120,18 @@ namespace GridTools
   {
     if (update_flags & update_vertex_to_cell_centers_directions)
       {
-        vertex_to_cell_centers = GridTools::vertex_to_cell_centers_directions(
-          *tria, get_vertex_to_cell_map());
-        update_flags = update_flags & ~update_vertex_to_cell_centers_directions;
+        // get the map before acquiring the lock, which is not recursive
+        const auto &vertex_to_cell_map = get_vertex_to_cell_map();
+
+        Threads::Mutex::ScopedLock lock(builder_mutex);
+        if (update_flags & update_vertex_to_cell_centers_directions)
+          {
+            vertex_to_cell_centers =
+              GridTools::vertex_to_cell_centers_directions(*tria,
+                                                           vertex_to_cell_map);
+            update_flags =
+              update_flags & ~update_vertex_to_cell_centers_directions;
+          }
       }
     return vertex_to_cell_centers;
   }
@@ -87,14 +144,118 @@ namespace GridTools
   {
     if (update_flags & update_used_vertices)
       {
-        used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
-        update_flags  = update_flags & ~update_used_vertices;
+        Threads::Mutex::ScopedLock lock(builder_mutex);
+        if (update_flags & update_used_vertices)
+          {
+            used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
+            update_flags  = update_flags & ~update_used_vertices;
+          }
       }
     return used_vertices;
   }
 
 
 
+  template <int dim, int spacedim>
+  const typename Cache<dim, spacedim>::CellBoundingBoxRtree &
+  Cache<dim, spacedim>::get_cell_bounding_boxes_rtree() const
+  {
+    if (update_flags & update_cell_bounding_boxes_rtree)
+      {
+        std::vector<typename CellBoundingBoxRtree::value_type> boxes;
+        for (const auto &cell : tria->active_cell_iterators())
+          if (cell->is_locally_owned())
+            boxes.emplace_back(BoundingBox<spacedim>(), cell);
+
+        // the boxes of different cells are independent of each other, so
+        // compute them in parallel. this helps for mappings that compute the
+        // vertices from a displacement vector, such as MappingQ1Eulerian;
+        // MappingFEField::get_vertices() holds a mutex, however, so for it
+        // only the computation of the boxes from the vertices runs in
+        // parallel
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(boxes.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const auto vertices = mapping->get_vertices(boxes[i].second);
+                Point<spacedim> lower = vertices[0], upper = vertices[0];
+                for (unsigned int v = 1; v < vertices.size(); ++v)
+                  for (unsigned int d = 0; d < spacedim; ++d)
+                    {
+                      lower[d] = std::min(lower[d], vertices[v][d]);
+                      upper[d] = std::max(upper[d], vertices[v][d]);
+                    }
+
+                // enlarge the box by the same relative tolerance that
+                // GridTools::find_active_cell_around_point() accepts for
+                // points outside the unit cell
+                double extent = 0;
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  extent = std::max(extent, upper[d] - lower[d]);
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  {
+                    lower[d] -= 1e-10 * extent;
+                    upper[d] += 1e-10 * extent;
+                  }
+                boxes[i].first =
+                  BoundingBox<spacedim>(std::make_pair(lower, upper));
+              }
+          },
+          256);
+
+        // constructing the tree from a range uses the packing algorithm,
+        // which gives a better tree than inserting the boxes one by one
+        std::unique_ptr<CellBoundingBoxRtree> rtree =
+          std_cxx14::make_unique<CellBoundingBoxRtree>(boxes.begin(),
+                                                       boxes.end());
+
+        // the tree is built without holding the lock, since a thread waiting
+        // for the parallel computation above may be given other tasks that
+        // need the tree. only install it if no other thread has done so in
+        // the meantime, so that references to the tree handed out before
+        // stay valid
+        Threads::Mutex::ScopedLock lock(builder_mutex);
+        if (update_flags & update_cell_bounding_boxes_rtree)
+          {
+            cell_bounding_boxes_rtree = std::move(rtree);
+            update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+          }
+      }
+    return *cell_bounding_boxes_rtree;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::get_cells_with_bounding_box_around_point(
+    const Point<spacedim> &p,
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      &cells) const
+  {
+    const CellBoundingBoxRtree &rtree = get_cell_bounding_boxes_rtree();
+
+    cells.clear();
+    for (auto entry = rtree.qbegin(boost::geometry::index::intersects(p));
+         entry != rtree.qend();
+         ++entry)
+      cells.push_back(entry->second);
+    std::sort(cells.begin(), cells.end());
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  Cache<dim, spacedim>::n_cell_bounding_boxes() const
+  {
+    return get_cell_bounding_boxes_rtree().size();
+  }
+
+
+
 #ifdef DEAL_II_WITH_NANOFLANN
   template <int dim, int spacedim>
   const KDTree<spacedim> &
@@ -102,8 +263,12 @@ namespace GridTools
   {
     if (update_flags & update_vertex_kdtree)
       {
-        vertex_kdtree.set_points(tria->get_vertices());
-        update_flags = update_flags & ~update_vertex_kdtree;
+        Threads::Mutex::ScopedLock lock(builder_mutex);
+        if (update_flags & update_vertex_kdtree)
+          {
+            vertex_kdtree.set_points(tria->get_vertices());
+            update_flags = update_flags & ~update_vertex_kdtree;
+          }
       }
     return vertex_kdtree;
   }
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <numeric>
@@ -2024,8 +2025,62 @@ namespace GridTools
     return dof_to_cell_patches;
   }
 
+  /*
+   * Internally used in match_periodic_face_pairs
+   *
+   * Return the center of the face with index face_no of the given cell,
+   * computed as the average of its vertices, after applying the
+   * transformation matrix (if it has the right size) and the offset. The
+   * component in the periodic direction is set to zero, so that the
+   * centers of faces that are periodic to each other coincide.
+   */
+  template <typename CellIterator>
+  Point<CellIterator::AccessorType::space_dimension>
+  projected_face_center(
+    const CellIterator &cell,
+    const unsigned int  face_no,
+    const int           direction,
+    const Tensor<1, CellIterator::AccessorType::space_dimension> *offset,
+    const FullMatrix<double> *                                    matrix)
+  {
+    static const int dim       = CellIterator::AccessorType::dimension;
+    static const int space_dim = CellIterator::AccessorType::space_dimension;
+
+    Point<space_dim> center;
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face; ++v)
+      center += cell->face(face_no)->vertex(v);
+    center /= GeometryInfo<dim>::vertices_per_face;
+
+    if (matrix != nullptr && matrix->m() == space_dim)
+      {
+        Point<space_dim> transformed;
+        for (int i = 0; i < space_dim; ++i)
+          for (int j = 0; j < space_dim; ++j)
+            transformed(i) += (*matrix)(i, j) * center(j);
+        center = transformed;
+      }
+    if (offset != nullptr)
+      center += *offset;
+
+    center(direction) = 0;
+    return center;
+  }
+
+
+
   /*
    * Internally used in collect_periodic_faces
+   *
+   * For each face in pairs1, find the first face in pairs2 that has not
+   * been matched yet and that matches it according to orthogonal_equality.
+   * Instead of testing all pairs, the faces in pairs2 are sorted by the
+   * cell of a fine background grid their (projected) center lies in, and
+   * only the faces in the cell of the transformed center of the face in
+   * pairs1, and in the neighbor cells if that center is close to a face of
+   * its cell, are tested. Matching faces have centers that differ by no
+   * more than the tolerance of the vertex comparison in
+   * orthogonal_equality, so this finds the same faces as a test of all
+   * pairs, in O(n log n) operations.
    */
   template <typename CellIterator>
   void
@@ -2040,47 +2095,138 @@ namespace GridTools
     const FullMatrix<double> &matrix)
   {
     static const int space_dim = CellIterator::AccessorType::space_dimension;
-    (void)space_dim;
     Assert(0 <= direction && direction < space_dim,
            ExcIndexRange(direction, 0, space_dim));
 
     Assert(pairs1.size() == pairs2.size(),
            ExcMessage("Unmatched faces on periodic boundaries"));
 
-    unsigned int n_matches = 0;
-
-    // Match with a complexity of O(n^2). This could be improved...
-    std::bitset<3> orientation;
     using PairIterator =
-      typename std::set<std::pair<CellIterator, unsigned int>>::const_iterator;
+      typename std::set<std::pair<CellIterator, unsigned int>>::iterator;
+    using GridCell =
+      typename GridTools::internal::BackgroundGrid<space_dim>::Cell;
+
+    // the tolerance used for the vertices in orthogonal_equality, which is
+    // then also a bound for the distance of the centers of matching faces
+    const double tolerance = 1.e-10;
+
+    const std::vector<PairIterator> faces2 = [&]() {
+      std::vector<PairIterator> faces;
+      faces.reserve(pairs2.size());
+      for (PairIterator it = pairs2.begin(); it != pairs2.end(); ++it)
+        faces.push_back(it);
+      return faces;
+    }();
+
+    std::vector<Point<space_dim>> centers2(faces2.size());
+    for (unsigned int i = 0; i < faces2.size(); ++i)
+      centers2[i] = projected_face_center(
+        faces2[i]->first, faces2[i]->second, direction, nullptr, nullptr);
+
+    // sort the faces of the second boundary by the cell of a background
+    // grid their centers lie in
+    Point<space_dim> lower, upper;
+    if (faces2.size() > 0)
+      {
+        lower = centers2[0];
+        upper = centers2[0];
+        for (const Point<space_dim> &center : centers2)
+          for (int d = 0; d < space_dim; ++d)
+            {
+              lower(d) = std::min(lower(d), center(d));
+              upper(d) = std::max(upper(d), center(d));
+            }
+      }
+    const GridTools::internal::BackgroundGrid<space_dim> grid(lower,
+                                                              upper,
+                                                              tolerance);
+    const double cell_size = grid.get_cell_size();
+
+    std::vector<std::pair<GridCell, unsigned int>> sorted2(faces2.size());
+    for (unsigned int i = 0; i < faces2.size(); ++i)
+      sorted2[i] = std::make_pair(grid.cell(centers2[i]), i);
+    std::sort(sorted2.begin(), sorted2.end());
+
+    std::vector<bool> is_matched(faces2.size(), false);
+    unsigned int      n_matches = 0;
+    std::bitset<3>    orientation;
     for (PairIterator it1 = pairs1.begin(); it1 != pairs1.end(); ++it1)
       {
-        for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
+        const CellIterator cell1     = it1->first;
+        const unsigned int face_idx1 = it1->second;
+
+        const Point<space_dim> center1 = projected_face_center(
+          cell1, face_idx1, direction, &offset, &matrix);
+        const GridCell cell = grid.cell(center1);
+
+        std::array<int, space_dim> first_offset, last_offset;
+        unsigned int               n_neighbors = 1;
+        for (int d = 0; d < space_dim; ++d)
           {
-            const CellIterator cell1     = it1->first;
-            const CellIterator cell2     = it2->first;
-            const unsigned int face_idx1 = it1->second;
-            const unsigned int face_idx2 = it2->second;
-            if (GridTools::orthogonal_equality(orientation,
-                                               cell1->face(face_idx1),
-                                               cell2->face(face_idx2),
-                                               direction,
-                                               offset,
-                                               matrix))
+            const double position = grid.position_in_cell(center1, cell, d);
+            first_offset[d]       = (position < 2. * tolerance ? -1 : 0);
+            last_offset[d] = (cell_size - position < 2. * tolerance ? 1 : 0);
+            n_neighbors *= 3;
+          }
+
+        // among all candidates, take the first unmatched one in the order
+        // of pairs2
+        unsigned int match = numbers::invalid_unsigned_int;
+        std::bitset<3> match_orientation;
+        for (unsigned int n = 0; n < n_neighbors; ++n)
+          {
+            GridCell neighbor = cell;
+            bool     relevant = true;
+            for (int d = 0, code = n; d < space_dim; ++d, code /= 3)
               {
-                // We have a match, so insert the matching pairs and
-                // remove the matched cell in pairs2 to speed up the
-                // matching:
-                const PeriodicFacePair<CellIterator> matched_face = {
-                  {cell1, cell2}, {face_idx1, face_idx2}, orientation, matrix};
-                matched_pairs.push_back(matched_face);
-                pairs2.erase(it2);
-                ++n_matches;
-                break;
+                const int offset_d = code % 3 - 1;
+                relevant &= (offset_d >= first_offset[d] &&
+                             offset_d <= last_offset[d]);
+                neighbor[d] += offset_d;
               }
+            if (relevant == false)
+              continue;
+
+            for (auto it = std::lower_bound(sorted2.begin(),
+                                            sorted2.end(),
+                                            std::make_pair(neighbor, 0U));
+                 it != sorted2.end() && it->first == neighbor &&
+                 it->second < match;
+                 ++it)
+              if (is_matched[it->second] == false &&
+                  GridTools::orthogonal_equality(
+                    orientation,
+                    cell1->face(face_idx1),
+                    faces2[it->second]->first->face(faces2[it->second]->second),
+                    direction,
+                    offset,
+                    matrix))
+                {
+                  match             = it->second;
+                  match_orientation = orientation;
+                  break;
+                }
+          }
+
+        if (match != numbers::invalid_unsigned_int)
+          {
+            const PeriodicFacePair<CellIterator> matched_face = {
+              {cell1, faces2[match]->first},
+              {face_idx1, faces2[match]->second},
+              match_orientation,
+              matrix};
+            matched_pairs.push_back(matched_face);
+            is_matched[match] = true;
+            ++n_matches;
           }
       }
 
+    // remove the matched faces from pairs2, as the caller might look at the
+    // remaining ones
+    for (unsigned int i = 0; i < faces2.size(); ++i)
+      if (is_matched[i])
+        pairs2.erase(faces2[i]);
+
     // Assure that all faces are matched
     AssertThrow(n_matches == pairs1.size() && pairs2.size() == 0,
                 ExcMessage("Unmatched faces on periodic boundaries"));
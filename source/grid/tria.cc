@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/fe/mapping_q1.h>
@@ -36,6 +37,7 @@
 #include <array>
 #include <cmath>
 #include <functional>
+#include <iomanip>
 #include <list>
 #include <map>
 #include <numeric>
@@ -4197,6 +4199,12 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       *
+       * If the cell is refined
+       * isotropically, @p new_center is
+       * the location of the new vertex
+       * at its center. Otherwise, the
+       * argument is ignored.
        */
       template <int spacedim>
       static void create_children(
@@ -4206,7 +4214,8 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        const Point<spacedim> &                             new_center)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4333,47 +4342,11 @@ namespace internal
 
             new_vertices[8] = next_unused_vertex;
 
-            // if this quad lives
-            // in 2d, then we can
-            // compute the new
-            // central vertex
-            // location just from
-            // the surrounding
-            // ones. If this is
-            // not the case, then
-            // we need to ask a
-            // boundary object
-            if (dim == spacedim)
-              {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
-                // if the user_flag is set, i.e. if the cell is at the
-                // boundary, use a different calculation of the middle vertex
-                // here. this is of advantage if the boundary is strongly
-                // curved (whereas the cell is not) and the cell has a high
-                // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
-              }
-            else
-              {
-                // if this quad lives in a higher dimensional space
-                // then we don't need to worry if it is at the
-                // boundary of the manifold -- we always have to use
-                // the boundary object anyway; so ignore whether the
-                // user flag is set or not
-                cell->clear_user_flag();
-
-                // new vertex is placed on the surface according to
-                // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-              }
+            // the location of the new central vertex has been computed by
+            // the caller, which may have used the user flag to decide how
+            // to compute it. reset the flag now
+            cell->clear_user_flag();
+            triangulation.vertices[next_unused_vertex] = new_center;
           }
 
 
@@ -4636,6 +4609,35 @@ namespace internal
 
 
 
+      /**
+       * Compute the locations of the new vertices created by refining the
+       * objects in @p objects, by calling @p compute_new_point on each of
+       * them. Asking the manifolds for these locations is the most expensive
+       * part of refinement, and the locations of the new vertices of
+       * different objects do not depend on each other, so we compute them in
+       * parallel. The result is stored in the order of @p objects, so that
+       * the sequential creation of the children afterwards assigns them to
+       * vertex slots independently of the number of threads.
+       */
+      template <int spacedim, typename IteratorType, typename PointFunction>
+      static std::vector<Point<spacedim>>
+      compute_new_vertex_locations(const std::vector<IteratorType> &objects,
+                                   const PointFunction &compute_new_point)
+      {
+        std::vector<Point<spacedim>> new_points(objects.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(objects.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              new_points[i] = compute_new_point(objects[i]);
+          },
+          64);
+        return new_points;
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -4729,6 +4731,26 @@ namespace internal
         // index of next unused vertex
         unsigned int next_unused_vertex = 0;
 
+        // compute the new vertices in the order in which the cells are
+        // refined below
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          cells_to_refine;
+        for (int level = triangulation.levels.size() - 2; level >= 0; --level)
+          {
+            typename Triangulation<dim, spacedim>::active_cell_iterator
+              cell = triangulation.begin_active(level),
+              endc = triangulation.begin_active(level + 1);
+            for (; cell != endc; ++cell)
+              if (cell->refine_flag_set())
+                cells_to_refine.push_back(cell);
+          }
+        const std::vector<Point<spacedim>> new_cell_centers =
+          compute_new_vertex_locations<spacedim>(
+            cells_to_refine,
+            [](const typename Triangulation<dim, spacedim>::cell_iterator
+                 &cell) { return cell->center(true); });
+        unsigned int next_cell_center = 0;
+
         for (int level = triangulation.levels.size() - 2; level >= 0; --level)
           {
             typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -4754,11 +4776,13 @@ namespace internal
                     ExcMessage(
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
 
-                  // Now we always ask the cell itself where to put
-                  // the new point. The cell in turn will query the
-                  // manifold object internally.
+                  // the cell itself was asked above where to put the
+                  // new point. The cell in turn queried the manifold
+                  // object internally.
+                  Assert(cells_to_refine[next_cell_center] == cell,
+                         ExcInternalError());
                   triangulation.vertices[next_unused_vertex] =
-                    cell->center(true);
+                    new_cell_centers[next_cell_center++];
 
                   triangulation.vertices_used[next_unused_vertex] = true;
 
@@ -5084,6 +5108,36 @@ namespace internal
         // pairwise
         if (true)
           {
+            // compute the new vertices at the centers of the lines in
+            // the order in which the lines are refined below
+            std::vector<typename Triangulation<dim, spacedim>::line_iterator>
+              lines_to_refine;
+            for (typename Triangulation<dim, spacedim>::active_line_iterator
+                   line = triangulation.begin_active_line();
+                 line != triangulation.end_line();
+                 ++line)
+              if (line->user_flag_set())
+                lines_to_refine.push_back(line);
+            const std::vector<Point<spacedim>> new_line_centers =
+              compute_new_vertex_locations<spacedim>(
+                lines_to_refine,
+                [&triangulation](
+                  const typename Triangulation<dim, spacedim>::line_iterator
+                    &line) {
+                  // for the case of a domain in an equal-dimensional space
+                  // we simply ask the line. however, if spacedim>dim, we
+                  // use the manifold of the cell (which was stored in
+                  // line->user_index() before) unless a manifold_id has
+                  // been set on this very line.
+                  if (spacedim > dim &&
+                      line->manifold_id() == numbers::flat_manifold_id)
+                    return triangulation.get_manifold(line->user_index())
+                      .get_new_point_on_line(line);
+                  else
+                    return line->center(true);
+                });
+            unsigned int next_line_center = 0;
+
             // only active objects can be refined further
             typename Triangulation<dim, spacedim>::active_line_iterator
               line = triangulation.begin_active_line(),
@@ -5107,29 +5161,10 @@ namespace internal
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
-                  if (spacedim == dim)
-                    {
-                      // for the case of a domain in an
-                      // equal-dimensional space we only have to treat
-                      // boundary lines differently; for interior
-                      // lines we can compute the midpoint as the mean
-                      // of the two vertices: if (line->at_boundary())
-                      triangulation.vertices[next_unused_vertex] =
-                        line->center(true);
-                    }
-                  else
-                    // however, if spacedim>dim, we always have to ask
-                    // the boundary object for its answer. We use the
-                    // same object of the cell (which was stored in
-                    // line->user_index() before) unless a manifold_id
-                    // has been set on this very line.
-                    if (line->manifold_id() == numbers::flat_manifold_id)
-                    triangulation.vertices[next_unused_vertex] =
-                      triangulation.get_manifold(line->user_index())
-                        .get_new_point_on_line(line);
-                  else
-                    triangulation.vertices[next_unused_vertex] =
-                      line->center(true);
+                  Assert(lines_to_refine[next_line_center] == line,
+                         ExcInternalError());
+                  triangulation.vertices[next_unused_vertex] =
+                    new_line_centers[next_line_center++];
 
                   // now that we created the right point, make up the
                   // two child lines.  To this end, find a pair of
@@ -5211,6 +5246,41 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
+        // compute the new vertices at the centers of the isotropically
+        // refined cells in the order in which the cells are refined below
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          cells_to_refine;
+        for (int level = 0;
+             level < static_cast<int>(triangulation.levels.size()) - 1;
+             ++level)
+          {
+            typename Triangulation<dim, spacedim>::active_cell_iterator
+              cell = triangulation.begin_active(level),
+              endc = triangulation.begin_active(level + 1);
+            for (; cell != endc; ++cell)
+              if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                cells_to_refine.push_back(cell);
+          }
+        const std::vector<Point<spacedim>> new_cell_centers =
+          compute_new_vertex_locations<spacedim>(
+            cells_to_refine,
+            [](const typename Triangulation<dim, spacedim>::cell_iterator
+                 &cell) {
+              // if the cell lives in 2d and has a user flag set or is at the
+              // boundary, use a different calculation of the middle vertex.
+              // this is of advantage if the boundary is strongly curved
+              // (whereas the cell is not) and the cell has a high aspect
+              // ratio. if the cell lives in a higher dimensional space, we
+              // always have to use the manifold anyway, regardless of
+              // whether it is at the boundary or not
+              if (dim == spacedim &&
+                  (cell->user_flag_set() || cell->at_boundary()))
+                return cell->center(true, true);
+              else
+                return cell->center(true);
+            });
+        unsigned int next_cell_center = 0;
+
         for (int level = 0;
              level < static_cast<int>(triangulation.levels.size()) - 1;
              ++level)
@@ -5238,11 +5308,19 @@ namespace internal
 
                   // actually set up the children and update neighbor
                   // information
+                  Point<spacedim> new_center;
+                  if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                    {
+                      Assert(cells_to_refine[next_cell_center] == cell,
+                             ExcInternalError());
+                      new_center = new_cell_centers[next_cell_center++];
+                    }
                   create_children(triangulation,
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
+                                  cell,
+                                  new_center);
 
                   if ((check_for_distorted_cells == true) &&
                       has_distorted_children(
@@ -5593,6 +5671,23 @@ namespace internal
         // first for lines
         if (true)
           {
+            // compute the new vertices at the centers of the lines in
+            // the order in which the lines are refined below
+            std::vector<typename Triangulation<dim, spacedim>::line_iterator>
+              lines_to_refine;
+            for (typename Triangulation<dim, spacedim>::active_line_iterator
+                   line = triangulation.begin_active_line();
+                 line != triangulation.end_line();
+                 ++line)
+              if (line->user_flag_set())
+                lines_to_refine.push_back(line);
+            const std::vector<Point<spacedim>> new_line_centers =
+              compute_new_vertex_locations<spacedim>(
+                lines_to_refine,
+                [](const typename Triangulation<dim, spacedim>::line_iterator
+                     &line) { return line->center(true); });
+            unsigned int next_line_center = 0;
+
             // only active objects can be refined further
             typename Triangulation<dim, spacedim>::active_line_iterator
               line = triangulation.begin_active_line(),
@@ -5616,8 +5711,10 @@ namespace internal
                       "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
+                  Assert(lines_to_refine[next_line_center] == line,
+                         ExcInternalError());
                   triangulation.vertices[next_unused_vertex] =
-                    line->center(true);
+                    new_line_centers[next_line_center++];
 
                   // now that we created the right point, make up the
                   // two child lines (++ takes care of the end of the
@@ -5701,6 +5798,32 @@ namespace internal
         // anisotropically (this is transformed to case c), however we
         // might have to renumber/rename children...)
 
+        // if all quads fall under case a), none of them changes its
+        // place in the loops below, and we can compute the new vertices
+        // at their centers in advance, in the order in which they are
+        // refined. the other cases are rare enough to simply compute the
+        // new vertices while refining
+        std::vector<typename Triangulation<dim, spacedim>::quad_iterator>
+          quads_to_refine;
+        for (typename Triangulation<dim, spacedim>::quad_iterator quad =
+               triangulation.begin_quad();
+             quad != triangulation.end_quad();
+             ++quad)
+          if (quad->user_index() != 0 ||
+              (quad->user_flag_set() && quad->has_children()))
+            {
+              quads_to_refine.clear();
+              break;
+            }
+          else if (quad->user_flag_set())
+            quads_to_refine.push_back(quad);
+        const std::vector<Point<spacedim>> new_quad_centers =
+          compute_new_vertex_locations<spacedim>(
+            quads_to_refine,
+            [](const typename Triangulation<dim, spacedim>::quad_iterator
+                 &quad) { return quad->center(true, true); });
+        unsigned int next_quad_center = 0;
+
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
         for (unsigned int loop = 0; loop < 2; ++loop)
@@ -6384,8 +6507,16 @@ namespace internal
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
                     // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    if (next_quad_center < quads_to_refine.size())
+                      {
+                        Assert(quads_to_refine[next_quad_center] == quad,
+                               ExcInternalError());
+                        triangulation.vertices[next_unused_vertex] =
+                          new_quad_centers[next_quad_center++];
+                      }
+                    else
+                      triangulation.vertices[next_unused_vertex] =
+                        quad->center(true, true);
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6642,6 +6773,27 @@ namespace internal
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // compute the new vertices at the centers of the isotropically
+        // refined hexes in the order in which the hexes are refined below
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          hexes_to_refine;
+        for (unsigned int level = 0; level != triangulation.levels.size() - 1;
+             ++level)
+          {
+            typename Triangulation<dim, spacedim>::active_hex_iterator
+              hex  = triangulation.begin_active_hex(level),
+              endh = triangulation.begin_active_hex(level + 1);
+            for (; hex != endh; ++hex)
+              if (hex->refine_flag_set() == RefinementCase<dim>::cut_xyz)
+                hexes_to_refine.push_back(hex);
+          }
+        const std::vector<Point<spacedim>> new_hex_centers =
+          compute_new_vertex_locations<spacedim>(
+            hexes_to_refine,
+            [](const typename Triangulation<dim, spacedim>::cell_iterator
+                 &hex) { return hex->center(true, true); });
+        unsigned int next_hex_center = 0;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -8952,11 +9104,13 @@ namespace internal
                           // the new vertex is definitely in the interior,
                           // so we need not worry about the
                           // boundary. However we need to worry about
-                          // Manifolds. Let the cell compute its own
-                          // center, by querying the underlying manifold
+                          // Manifolds. The cell computed its own center
+                          // above, by querying the underlying manifold
                           // object.
+                          Assert(hexes_to_refine[next_hex_center] == hex,
+                                 ExcInternalError());
                           triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                            new_hex_centers[next_hex_center++];
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
@@ -10143,6 +10297,7 @@ Triangulation<dim, spacedim>::Triangulation(
   : smooth_grid(smooth_grid)
   , anisotropic_refinement(false)
   , check_for_distorted_cells(check_for_distorted_cells)
+  , lean_storage(false)
 {
   if (dim == 1)
     {
@@ -10175,6 +10330,7 @@ Triangulation<dim, spacedim>::Triangulation(
   , manifold(std::move(tria.manifold))
   , anisotropic_refinement(tria.anisotropic_refinement)
   , check_for_distorted_cells(tria.check_for_distorted_cells)
+  , lean_storage(tria.lean_storage)
   , number_cache(std::move(tria.number_cache))
   , vertex_to_boundary_id_map_1d(std::move(tria.vertex_to_boundary_id_map_1d))
   , vertex_to_manifold_id_map_1d(std::move(tria.vertex_to_manifold_id_map_1d))
@@ -10199,6 +10355,7 @@ operator=(Triangulation<dim, spacedim> &&tria) noexcept
   vertices_used                = std::move(tria.vertices_used);
   manifold                     = std::move(tria.manifold);
   anisotropic_refinement       = tria.anisotropic_refinement;
+  lean_storage                 = tria.lean_storage;
   number_cache                 = tria.number_cache;
   vertex_to_boundary_id_map_1d = std::move(tria.vertex_to_boundary_id_map_1d);
   vertex_to_manifold_id_map_1d = std::move(tria.vertex_to_manifold_id_map_1d);
@@ -10274,6 +10431,25 @@ Triangulation<dim, spacedim>::get_mesh_smoothing() const
 
 
 
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::set_lean_storage(const bool lean_storage)
+{
+  this->lean_storage = lean_storage;
+  allocate_optional_data();
+}
+
+
+
+template <int dim, int spacedim>
+bool
+Triangulation<dim, spacedim>::has_lean_storage() const
+{
+  return lean_storage;
+}
+
+
+
 template <int dim, int spacedim>
 void
 Triangulation<dim, spacedim>::set_manifold(
@@ -10519,6 +10695,11 @@ Triangulation<dim, spacedim>::copy_triangulation(
 
   number_cache = other_tria.number_cache;
 
+  // use the same storage scheme as the other triangulation. if it uses lean
+  // storage, only the data it has allocated so far was copied
+  lean_storage = other_tria.lean_storage;
+  allocate_optional_data();
+
   if (dim == 1)
     {
       vertex_to_boundary_id_map_1d =
@@ -10594,6 +10775,7 @@ Triangulation<dim, spacedim>::create_triangulation(
   internal::TriangulationImplementation::Implementation ::compute_number_cache(
     *this, levels.size(), number_cache);
   reset_active_cell_indices();
+  allocate_optional_data();
 
   // now verify that there are indeed no distorted cells. as per the
   // documentation of this class, we first collect all distorted cells
@@ -10941,38 +11123,78 @@ Triangulation<dim, spacedim>::get_anisotropic_refinement_flag() const
 
 namespace
 {
-  // clear user data of cells
+  // clear user data of cells, and release its memory if so requested
   template <int dim>
   void
   clear_user_data(
     std::vector<
       std::unique_ptr<internal::TriangulationImplementation::TriaLevel<dim>>>
-      &levels)
+      &        levels,
+    const bool release_memory)
   {
     for (unsigned int level = 0; level < levels.size(); ++level)
-      levels[level]->cells.clear_user_data();
+      if (release_memory)
+        levels[level]->cells.release_user_data();
+      else
+        levels[level]->cells.clear_user_data();
   }
 
 
   // clear user data of faces
-  void clear_user_data(internal::TriangulationImplementation::TriaFaces<1> *)
+  void clear_user_data(internal::TriangulationImplementation::TriaFaces<1> *,
+                       const bool)
   {
     // nothing to do in 1d
   }
 
 
   void
-    clear_user_data(internal::TriangulationImplementation::TriaFaces<2> *faces)
+    clear_user_data(internal::TriangulationImplementation::TriaFaces<2> *faces,
+                    const bool release_memory)
   {
-    faces->lines.clear_user_data();
+    if (release_memory)
+      faces->lines.release_user_data();
+    else
+      faces->lines.clear_user_data();
   }
 
 
   void
-    clear_user_data(internal::TriangulationImplementation::TriaFaces<3> *faces)
+    clear_user_data(internal::TriangulationImplementation::TriaFaces<3> *faces,
+                    const bool release_memory)
   {
-    faces->lines.clear_user_data();
-    faces->quads.clear_user_data();
+    if (release_memory)
+      {
+        faces->lines.release_user_data();
+        faces->quads.release_user_data();
+      }
+    else
+      {
+        faces->lines.clear_user_data();
+        faces->quads.clear_user_data();
+      }
+  }
+
+
+  // allocate user data of faces
+  void allocate_user_data(internal::TriangulationImplementation::TriaFaces<1> *)
+  {
+    // nothing to do in 1d
+  }
+
+
+  void allocate_user_data(
+    internal::TriangulationImplementation::TriaFaces<2> *faces)
+  {
+    faces->lines.allocate_user_data();
+  }
+
+
+  void allocate_user_data(
+    internal::TriangulationImplementation::TriaFaces<3> *faces)
+  {
+    faces->lines.allocate_user_data();
+    faces->quads.allocate_user_data();
   }
 } // namespace
 
@@ -10982,8 +11204,27 @@ void
 Triangulation<dim, spacedim>::clear_user_data()
 {
   // let functions in anonymous namespace do their work
-  dealii::clear_user_data(levels);
-  dealii::clear_user_data(faces.get());
+  dealii::clear_user_data(levels, lean_storage);
+  dealii::clear_user_data(faces.get(), lean_storage);
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::allocate_optional_data()
+{
+  if (lean_storage)
+    return;
+
+  for (unsigned int level = 0; level < levels.size(); ++level)
+    {
+      levels[level]->cells.allocate_user_data();
+      levels[level]->level_subdomain_ids.resize(
+        levels[level]->refine_flags.size(), 0);
+    }
+  if (faces)
+    dealii::allocate_user_data(faces.get());
 }
 
 
@@ -13181,6 +13422,26 @@ Triangulation<dim, spacedim>::locally_owned_subdomain() const
 
 
 
+template <int dim, int spacedim>
+unsigned int
+Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+  const unsigned int coarse_cell_id) const
+{
+  return coarse_cell_id;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+  const unsigned int coarse_cell_index) const
+{
+  return coarse_cell_index;
+}
+
+
+
 template <int dim, int spacedim>
 Triangulation<dim, spacedim> &
 Triangulation<dim, spacedim>::get_triangulation()
@@ -13257,6 +13518,7 @@ Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
   // active cell indices
   update_neighbors(*this);
   reset_active_cell_indices();
+  allocate_optional_data();
 
   // Inform all listeners about end of refinement.
   signals.post_refinement();
@@ -15047,6 +15309,37 @@ Triangulation<dim, spacedim>::memory_consumption() const
 
 
 
+template <int dim, int spacedim>
+std::map<std::string, std::size_t>
+Triangulation<dim, spacedim>::memory_consumption_by_array() const
+{
+  std::map<std::string, std::size_t> memory;
+  for (const auto &level : levels)
+    level->add_memory_consumption("levels.", memory);
+  if (faces)
+    faces->add_memory_consumption("faces.", memory);
+  memory["vertices"] = MemoryConsumption::memory_consumption(vertices);
+  memory["vertices_used"] =
+    MemoryConsumption::memory_consumption(vertices_used);
+  return memory;
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::print_memory_consumption(std::ostream &out) const
+{
+  for (const auto &entry : memory_consumption_by_array())
+    out << "  " << std::left << std::setw(40) << entry.first << " "
+        << std::right << std::setw(12) << entry.second << std::endl;
+  out << "  " << std::left << std::setw(40) << "total"
+      << " " << std::right << std::setw(12) << memory_consumption()
+      << std::endl;
+}
+
+
+
 template <int dim, int spacedim>
 Triangulation<dim, spacedim>::DistortedCellList::~DistortedCellList() noexcept
 {
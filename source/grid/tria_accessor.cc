@@ -2026,8 +2026,13 @@ types::subdomain_id
 CellAccessor<dim, spacedim>::level_subdomain_id() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->tria->levels[this->present_level]
-    ->level_subdomain_ids[this->present_index];
+  // with lean storage, the level subdomain ids are only allocated once the
+  // first one is set
+  const std::vector<types::subdomain_id> &level_subdomain_ids =
+    this->tria->levels[this->present_level]->level_subdomain_ids;
+  if (level_subdomain_ids.empty())
+    return 0;
+  return level_subdomain_ids[this->present_index];
 }
 
 
@@ -2038,8 +2043,12 @@ CellAccessor<dim, spacedim>::set_level_subdomain_id(
   const types::subdomain_id new_level_subdomain_id) const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  this->tria->levels[this->present_level]
-    ->level_subdomain_ids[this->present_index] = new_level_subdomain_id;
+  std::vector<types::subdomain_id> &level_subdomain_ids =
+    this->tria->levels[this->present_level]->level_subdomain_ids;
+  if (level_subdomain_ids.empty())
+    level_subdomain_ids.resize(
+      this->tria->levels[this->present_level]->refine_flags.size(), 0);
+  level_subdomain_ids[this->present_index] = new_level_subdomain_id;
 }
 
 
@@ -2218,7 +2227,9 @@ CellAccessor<dim, spacedim>::id() const
   Assert(ptr.level() == 0, ExcInternalError());
   const unsigned int coarse_index = ptr.index();
 
-  return CellId(coarse_index, n_child_indices, &(id[0]));
+  return CellId(this->tria->coarse_cell_index_to_coarse_cell_id(coarse_index),
+                n_child_indices,
+                &(id[0]));
 }
 
 
@@ -32,6 +32,13 @@ namespace internal
     }
 
 
+    void
+    TriaFaces<1>::add_memory_consumption(
+      const std::string &,
+      std::map<std::string, std::size_t> &) const
+    {}
+
+
     std::size_t
     TriaFaces<2>::memory_consumption() const
     {
@@ -39,12 +46,31 @@ namespace internal
     }
 
 
+    void
+    TriaFaces<2>::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      lines.add_memory_consumption(prefix + "lines.", memory);
+    }
+
+
     std::size_t
     TriaFaces<3>::memory_consumption() const
     {
       return (MemoryConsumption::memory_consumption(quads) +
               MemoryConsumption::memory_consumption(lines));
     }
+
+
+    void
+    TriaFaces<3>::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      quads.add_memory_consumption(prefix + "quads.", memory);
+      lines.add_memory_consumption(prefix + "lines.", memory);
+    }
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -58,10 +58,17 @@ namespace internal
                                total_cells - subdomain_ids.size(),
                                0);
 
-          level_subdomain_ids.reserve(total_cells);
-          level_subdomain_ids.insert(level_subdomain_ids.end(),
-                                     total_cells - level_subdomain_ids.size(),
-                                     0);
+          // only grow the level subdomain ids if they have been allocated
+          // already. they are only needed for multigrid, so triangulations
+          // with lean storage only allocate them once they are set
+          if (level_subdomain_ids.size() > 0)
+            {
+              level_subdomain_ids.reserve(total_cells);
+              level_subdomain_ids.insert(level_subdomain_ids.end(),
+                                         total_cells -
+                                           level_subdomain_ids.size(),
+                                         0);
+            }
 
           if (dimension < space_dimension)
             {
@@ -113,6 +120,31 @@ namespace internal
               MemoryConsumption::memory_consumption(cells));
     }
 
+    template <int dim>
+    void
+    TriaLevel<dim>::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      memory[prefix + "refine_flags"] +=
+        MemoryConsumption::memory_consumption(refine_flags);
+      memory[prefix + "coarsen_flags"] +=
+        MemoryConsumption::memory_consumption(coarsen_flags);
+      memory[prefix + "active_cell_indices"] +=
+        MemoryConsumption::memory_consumption(active_cell_indices);
+      memory[prefix + "neighbors"] +=
+        MemoryConsumption::memory_consumption(neighbors);
+      memory[prefix + "subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(subdomain_ids);
+      memory[prefix + "level_subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(level_subdomain_ids);
+      memory[prefix + "parents"] +=
+        MemoryConsumption::memory_consumption(parents);
+      memory[prefix + "direction_flags"] +=
+        MemoryConsumption::memory_consumption(direction_flags);
+      cells.add_memory_consumption(prefix + "cells.", memory);
+    }
+
     // This specialization should be only temporary, until the TriaObjects
     // classes are straightened out.
 
@@ -150,10 +182,17 @@ namespace internal
                                total_cells - subdomain_ids.size(),
                                0);
 
-          level_subdomain_ids.reserve(total_cells);
-          level_subdomain_ids.insert(level_subdomain_ids.end(),
-                                     total_cells - level_subdomain_ids.size(),
-                                     0);
+          // only grow the level subdomain ids if they have been allocated
+          // already. they are only needed for multigrid, so triangulations
+          // with lean storage only allocate them once they are set
+          if (level_subdomain_ids.size() > 0)
+            {
+              level_subdomain_ids.reserve(total_cells);
+              level_subdomain_ids.insert(level_subdomain_ids.end(),
+                                         total_cells -
+                                           level_subdomain_ids.size(),
+                                         0);
+            }
 
           if (dimension < space_dimension)
             {
@@ -197,10 +236,35 @@ namespace internal
               MemoryConsumption::memory_consumption(active_cell_indices) +
               MemoryConsumption::memory_consumption(neighbors) +
               MemoryConsumption::memory_consumption(subdomain_ids) +
+              MemoryConsumption::memory_consumption(level_subdomain_ids) +
               MemoryConsumption::memory_consumption(parents) +
               MemoryConsumption::memory_consumption(direction_flags) +
               MemoryConsumption::memory_consumption(cells));
     }
+
+    void
+    TriaLevel<3>::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      memory[prefix + "refine_flags"] +=
+        MemoryConsumption::memory_consumption(refine_flags);
+      memory[prefix + "coarsen_flags"] +=
+        MemoryConsumption::memory_consumption(coarsen_flags);
+      memory[prefix + "active_cell_indices"] +=
+        MemoryConsumption::memory_consumption(active_cell_indices);
+      memory[prefix + "neighbors"] +=
+        MemoryConsumption::memory_consumption(neighbors);
+      memory[prefix + "subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(subdomain_ids);
+      memory[prefix + "level_subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(level_subdomain_ids);
+      memory[prefix + "parents"] +=
+        MemoryConsumption::memory_consumption(parents);
+      memory[prefix + "direction_flags"] +=
+        MemoryConsumption::memory_consumption(direction_flags);
+      cells.add_memory_consumption(prefix + "cells.", memory);
+    }
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -118,8 +118,13 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          // only grow the user data if it has been allocated already, see
+          // allocate_user_data()
+          if (user_data.size() > 0)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           manifold_id.reserve(new_size);
           manifold_id.insert(manifold_id.end(),
@@ -205,8 +210,13 @@ namespace internal
                              new_size - manifold_id.size(),
                              numbers::flat_manifold_id);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          // only grow the user data if it has been allocated already, see
+          // allocate_user_data()
+          if (user_data.size() > 0)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           face_orientations.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_orientations.insert(face_orientations.end(),
@@ -319,7 +329,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -340,7 +350,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -358,7 +368,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
       Assert(cells.size() * GeometryInfo<3>::faces_per_cell ==
                face_orientations.size(),
@@ -438,6 +448,29 @@ namespace internal
     }
 
 
+    template <typename G>
+    void
+    TriaObjects<G>::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      memory[prefix + "cells"] += MemoryConsumption::memory_consumption(cells);
+      memory[prefix + "children"] +=
+        MemoryConsumption::memory_consumption(children);
+      memory[prefix + "used"] += MemoryConsumption::memory_consumption(used);
+      memory[prefix + "user_flags"] +=
+        MemoryConsumption::memory_consumption(user_flags);
+      memory[prefix + "boundary_or_material_id"] +=
+        MemoryConsumption::memory_consumption(boundary_or_material_id);
+      memory[prefix + "manifold_id"] +=
+        MemoryConsumption::memory_consumption(manifold_id);
+      memory[prefix + "refinement_cases"] +=
+        MemoryConsumption::memory_consumption(refinement_cases);
+      memory[prefix + "user_data"] +=
+        user_data.capacity() * sizeof(UserData) + sizeof(user_data);
+    }
+
+
     std::size_t
     TriaObjectsHex::memory_consumption() const
     {
@@ -457,6 +490,33 @@ namespace internal
 
 
 
+    void
+    TriaObjectsHex::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      TriaObjects<TriaObject<3>>::add_memory_consumption(prefix, memory);
+      memory[prefix + "face_orientations"] +=
+        MemoryConsumption::memory_consumption(face_orientations);
+      memory[prefix + "face_flips"] +=
+        MemoryConsumption::memory_consumption(face_flips);
+      memory[prefix + "face_rotations"] +=
+        MemoryConsumption::memory_consumption(face_rotations);
+    }
+
+
+    void
+    TriaObjectsQuad3D::add_memory_consumption(
+      const std::string &                  prefix,
+      std::map<std::string, std::size_t> &memory) const
+    {
+      TriaObjects<TriaObject<2>>::add_memory_consumption(prefix, memory);
+      memory[prefix + "line_orientations"] +=
+        MemoryConsumption::memory_consumption(line_orientations);
+    }
+
+
+
     // explicit instantiations
     template class TriaObjects<TriaObject<1>>;
     template class TriaObjects<TriaObject<2>>;
@@ -0,0 +1,308 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/assembly_plan.h>
+
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace AssemblyPlanImplementation
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * Minimal number of cells handed to one task when setting up the plan.
+     */
+    const unsigned int minimum_parallel_grain_size = 64;
+
+    /**
+     * Express each local degree of freedom of a cell as a linear combination
+     * of unconstrained global degrees of freedom: an unconstrained degree of
+     * freedom is represented by itself with weight one, a constrained one by
+     * the entries of its constraint. Entries with zero weight are dropped
+     * since they do not contribute anything. The combination for local
+     * degree of freedom @p i is stored in the range
+     * <tt>[start[i], start[i+1])</tt> of @p expansion. Return the number of
+     * unconstrained local degrees of freedom.
+     */
+    template <typename number>
+    unsigned int
+    expand_local_dofs(const std::vector<size_type> &          dof_indices,
+                      const AffineConstraints<number> &       constraints,
+                      std::vector<std::pair<size_type, number>> &expansion,
+                      std::vector<unsigned int> &                start)
+    {
+      const unsigned int n_dofs = dof_indices.size();
+      expansion.clear();
+      start.resize(n_dofs + 1);
+      start[0]                      = 0;
+      unsigned int n_unconstrained = 0;
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          const std::vector<std::pair<size_type, number>> *entries =
+            constraints.get_constraint_entries(dof_indices[i]);
+          if (entries == nullptr)
+            {
+              expansion.emplace_back(dof_indices[i], number(1.));
+              ++n_unconstrained;
+            }
+          else
+            for (const auto &entry : *entries)
+              if (entry.second != number())
+                expansion.push_back(entry);
+          start[i + 1] = expansion.size();
+        }
+      return n_unconstrained;
+    }
+
+
+
+    /**
+     * Return the position of the diagonal entry of @p row in the value array
+     * of matrices based on @p sparsity, and throw an exception if the entry
+     * does not exist.
+     */
+    template <typename number>
+    inline std::size_t
+    find_diagonal_position(const SparsityPattern &sparsity,
+                           const size_type        row)
+    {
+      const size_type position = sparsity(row, row);
+      AssertThrow(position != SparsityPattern::invalid_entry,
+                  typename SparseMatrix<number>::ExcInvalidIndex(row, row));
+      return position;
+    }
+  } // namespace AssemblyPlanImplementation
+} // namespace internal
+
+
+
+template <typename number>
+AssemblyPlan<number>::AssemblyPlan()
+  : access_mode(exclusive_access)
+{}
+
+
+
+template <typename number>
+void
+AssemblyPlan<number>::reinit(
+  const std::vector<std::vector<size_type>> &cell_dof_indices,
+  const AffineConstraints<number> &          constraints,
+  const SparsityPattern &                    sparsity)
+{
+  using namespace internal::AssemblyPlanImplementation;
+
+  this->constraints = &constraints;
+  this->sparsity    = &sparsity;
+
+  const unsigned int n_cells = cell_dof_indices.size();
+  n_local_dofs.resize(n_cells);
+  direct_start.assign(n_cells + 1, 0);
+  indirect_start.assign(n_cells + 1, 0);
+  constrained_start.assign(n_cells + 1, 0);
+  vector_start.assign(n_cells + 1, 0);
+
+  // first pass: count the contributions of each cell. with S the total
+  // length of the expansions of the local degrees of freedom and U the
+  // number of unconstrained ones, the cell has U*U direct and S*S-U*U
+  // indirect matrix contributions
+  parallel::apply_to_subranges(
+    0U,
+    n_cells,
+    [&](const unsigned int begin, const unsigned int end) {
+      std::vector<std::pair<size_type, number>> expansion;
+      std::vector<unsigned int>                 start;
+      for (unsigned int cell = begin; cell < end; ++cell)
+        {
+          const std::vector<size_type> &dofs = cell_dof_indices[cell];
+          const std::size_t             n_unconstrained =
+            expand_local_dofs(dofs, constraints, expansion, start);
+          const std::size_t n_expanded = expansion.size();
+
+          n_local_dofs[cell]          = dofs.size();
+          direct_start[cell + 1]      = n_unconstrained * n_unconstrained;
+          indirect_start[cell + 1]    = n_expanded * n_expanded -
+                                     n_unconstrained * n_unconstrained;
+          constrained_start[cell + 1] = dofs.size() - n_unconstrained;
+          vector_start[cell + 1]      = n_expanded;
+        }
+    },
+    minimum_parallel_grain_size);
+
+  std::partial_sum(direct_start.begin(),
+                   direct_start.end(),
+                   direct_start.begin());
+  std::partial_sum(indirect_start.begin(),
+                   indirect_start.end(),
+                   indirect_start.begin());
+  std::partial_sum(constrained_start.begin(),
+                   constrained_start.end(),
+                   constrained_start.begin());
+  std::partial_sum(vector_start.begin(),
+                   vector_start.end(),
+                   vector_start.begin());
+
+  direct_positions.resize(direct_start.back());
+  direct_entries.resize(direct_start.back());
+  indirect_positions.resize(indirect_start.back());
+  indirect_entries.resize(indirect_start.back());
+  indirect_weights.resize(indirect_start.back());
+  constrained_rows.resize(constrained_start.back());
+  constrained_dofs.resize(constrained_start.back());
+  constrained_diagonals.resize(constrained_start.back());
+  vector_indices.resize(vector_start.back());
+  vector_rows.resize(vector_start.back());
+  vector_weights.resize(vector_start.back());
+
+  // second pass: fill the ranges of each cell, which are disjoint between
+  // cells and can hence be written in parallel
+  parallel::apply_to_subranges(
+    0U,
+    n_cells,
+    [&](const unsigned int begin, const unsigned int end) {
+      std::vector<std::pair<size_type, number>> expansion;
+      std::vector<unsigned int>                 start;
+      for (unsigned int cell = begin; cell < end; ++cell)
+        {
+          const std::vector<size_type> &dofs   = cell_dof_indices[cell];
+          const unsigned int            n_dofs = dofs.size();
+          expand_local_dofs(dofs, constraints, expansion, start);
+
+          std::size_t direct      = direct_start[cell];
+          std::size_t indirect    = indirect_start[cell];
+          std::size_t constrained = constrained_start[cell];
+          std::size_t vector      = vector_start[cell];
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            {
+              const bool row_is_constrained =
+                constraints.is_constrained(dofs[i]);
+              if (row_is_constrained)
+                {
+                  constrained_rows[constrained] = i;
+                  constrained_dofs[constrained] = dofs[i];
+                  constrained_diagonals[constrained] =
+                    find_diagonal_position<number>(sparsity, dofs[i]);
+                  ++constrained;
+                }
+
+              for (unsigned int q = start[i]; q < start[i + 1]; ++q)
+                {
+                  vector_indices[vector] = expansion[q].first;
+                  vector_rows[vector]    = i;
+                  vector_weights[vector] = expansion[q].second;
+                  ++vector;
+                }
+
+              // entries that are not part of the sparsity pattern, e.g.
+              // because it has been built with a coupling table, get the
+              // position SparsityPattern::invalid_entry and are skipped when
+              // distributing, as long as the local matrix is zero there
+              for (unsigned int j = 0; j < n_dofs; ++j)
+                {
+                  const unsigned int entry = i * n_dofs + j;
+                  if (row_is_constrained == false &&
+                      constraints.is_constrained(dofs[j]) == false)
+                    {
+                      direct_positions[direct] = sparsity(dofs[i], dofs[j]);
+                      direct_entries[direct] = entry;
+                      ++direct;
+                    }
+                  else
+                    for (unsigned int q = start[i]; q < start[i + 1]; ++q)
+                      for (unsigned int p = start[j]; p < start[j + 1]; ++p)
+                        {
+                          indirect_positions[indirect] =
+                            sparsity(expansion[q].first, expansion[p].first);
+                          indirect_entries[indirect] = entry;
+                          indirect_weights[indirect] =
+                            expansion[q].second * expansion[p].second;
+                          ++indirect;
+                        }
+                }
+            }
+          Assert(direct == direct_start[cell + 1], ExcInternalError());
+          Assert(indirect == indirect_start[cell + 1], ExcInternalError());
+          Assert(constrained == constrained_start[cell + 1],
+                 ExcInternalError());
+          Assert(vector == vector_start[cell + 1], ExcInternalError());
+        }
+    },
+    minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+void
+AssemblyPlan<number>::clear()
+{
+  constraints = nullptr;
+  sparsity    = nullptr;
+  n_local_dofs.clear();
+  direct_start.clear();
+  direct_positions.clear();
+  direct_entries.clear();
+  indirect_start.clear();
+  indirect_positions.clear();
+  indirect_entries.clear();
+  indirect_weights.clear();
+  constrained_start.clear();
+  constrained_rows.clear();
+  constrained_dofs.clear();
+  constrained_diagonals.clear();
+  vector_start.clear();
+  vector_indices.clear();
+  vector_rows.clear();
+  vector_weights.clear();
+}
+
+
+
+template <typename number>
+std::size_t
+AssemblyPlan<number>::memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(n_local_dofs) +
+         MemoryConsumption::memory_consumption(direct_start) +
+         MemoryConsumption::memory_consumption(direct_positions) +
+         MemoryConsumption::memory_consumption(direct_entries) +
+         MemoryConsumption::memory_consumption(indirect_start) +
+         MemoryConsumption::memory_consumption(indirect_positions) +
+         MemoryConsumption::memory_consumption(indirect_entries) +
+         MemoryConsumption::memory_consumption(indirect_weights) +
+         MemoryConsumption::memory_consumption(constrained_start) +
+         MemoryConsumption::memory_consumption(constrained_rows) +
+         MemoryConsumption::memory_consumption(constrained_dofs) +
+         MemoryConsumption::memory_consumption(constrained_diagonals) +
+         MemoryConsumption::memory_consumption(vector_start) +
+         MemoryConsumption::memory_consumption(vector_indices) +
+         MemoryConsumption::memory_consumption(vector_rows) +
+         MemoryConsumption::memory_consumption(vector_weights);
+}
+
+
+
+// explicit instantiations
+template class AssemblyPlan<double>;
+template class AssemblyPlan<float>;
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,951 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/lac/precondition_amg.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace PreconditionAMGImplementation
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * Minimal number of rows handed to one task in the parallel loops of
+     * the setup phase.
+     */
+    const unsigned int minimum_parallel_grain_size = 256;
+
+    /**
+     * A compressed row storage of a graph without values, used for the
+     * strength-of-connection graph.
+     */
+    struct Graph
+    {
+      std::vector<size_type> rowstart;
+      std::vector<size_type> colnums;
+    };
+
+
+
+    /**
+     * Return whether the off-diagonal entry @p a_ij is a strong connection
+     * given the magnitudes of the diagonal entries of rows i and j.
+     */
+    template <typename number>
+    inline bool
+    is_strong(const number a_ij,
+              const double diag_i,
+              const double diag_j,
+              const double threshold)
+    {
+      return std::abs(a_ij) >= threshold * std::sqrt(diag_i * diag_j);
+    }
+
+
+
+    /**
+     * Compute the strength-of-connection graph of the given matrix. The
+     * diagonal is not part of the graph.
+     */
+    template <typename number>
+    void
+    compute_strength_graph(const SparseMatrix<number> &matrix,
+                           const std::vector<double> & diagonal,
+                           const double                threshold,
+                           Graph &                     graph)
+    {
+      const size_type n_rows = matrix.m();
+      graph.rowstart.assign(n_rows + 1, 0);
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              size_type count = 0;
+              for (auto p = matrix.begin(row); p != matrix.end(row); ++p)
+                if (p->column() != row &&
+                    is_strong(p->value(),
+                              diagonal[row],
+                              diagonal[p->column()],
+                              threshold))
+                  ++count;
+              graph.rowstart[row + 1] = count;
+            }
+        },
+        minimum_parallel_grain_size);
+
+      for (size_type row = 0; row < n_rows; ++row)
+        graph.rowstart[row + 1] += graph.rowstart[row];
+      graph.colnums.resize(graph.rowstart[n_rows]);
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              size_type index = graph.rowstart[row];
+              for (auto p = matrix.begin(row); p != matrix.end(row); ++p)
+                if (p->column() != row &&
+                    is_strong(p->value(),
+                              diagonal[row],
+                              diagonal[p->column()],
+                              threshold))
+                  graph.colnums[index++] = p->column();
+            }
+        },
+        minimum_parallel_grain_size);
+    }
+
+
+
+    /**
+     * Aggregate the rows in the half-open range [begin, end) of the given
+     * graph, only considering connections within this range. The aggregate
+     * numbers are counted from zero and written into @p aggregates; the
+     * number of aggregates found is returned. Rows without any strong
+     * connection stay unaggregated.
+     */
+    inline size_type
+    aggregate_chunk(const Graph &           graph,
+                    const size_type         begin,
+                    const size_type         end,
+                    std::vector<size_type> &aggregates)
+    {
+      const size_type invalid = numbers::invalid_dof_index;
+      size_type       n_aggregates = 0;
+
+      // phase 1: rows whose neighbors are all unaggregated form a new
+      // aggregate together with their neighbors
+      for (size_type row = begin; row < end; ++row)
+        {
+          if (aggregates[row] != invalid)
+            continue;
+          bool has_neighbor = false, neighbors_free = true;
+          for (size_type k = graph.rowstart[row]; k < graph.rowstart[row + 1];
+               ++k)
+            {
+              const size_type col = graph.colnums[k];
+              if (col < begin || col >= end)
+                continue;
+              has_neighbor = true;
+              if (aggregates[col] != invalid)
+                {
+                  neighbors_free = false;
+                  break;
+                }
+            }
+          if (has_neighbor && neighbors_free)
+            {
+              aggregates[row] = n_aggregates;
+              for (size_type k = graph.rowstart[row];
+                   k < graph.rowstart[row + 1];
+                   ++k)
+                {
+                  const size_type col = graph.colnums[k];
+                  if (col >= begin && col < end)
+                    aggregates[col] = n_aggregates;
+                }
+              ++n_aggregates;
+            }
+        }
+
+      // phase 2: attach the remaining rows to the aggregate of a neighbor
+      // that was aggregated in phase 1. to not chain aggregates, only
+      // consider the assignment from before this phase started
+      const std::vector<size_type> phase_one_aggregates(aggregates.begin() +
+                                                          begin,
+                                                        aggregates.begin() +
+                                                          end);
+      for (size_type row = begin; row < end; ++row)
+        if (aggregates[row] == invalid)
+          for (size_type k = graph.rowstart[row]; k < graph.rowstart[row + 1];
+               ++k)
+            {
+              const size_type col = graph.colnums[k];
+              if (col >= begin && col < end &&
+                  phase_one_aggregates[col - begin] != invalid)
+                {
+                  aggregates[row] = phase_one_aggregates[col - begin];
+                  break;
+                }
+            }
+
+      // phase 3: the rows still left over form new aggregates with their
+      // unaggregated neighbors. this includes rows whose strong neighbors
+      // all live in other chunks
+      for (size_type row = begin; row < end; ++row)
+        if (aggregates[row] == invalid &&
+            graph.rowstart[row + 1] > graph.rowstart[row])
+          {
+            aggregates[row] = n_aggregates;
+            for (size_type k = graph.rowstart[row];
+                 k < graph.rowstart[row + 1];
+                 ++k)
+              {
+                const size_type col = graph.colnums[k];
+                if (col >= begin && col < end && aggregates[col] == invalid)
+                  aggregates[col] = n_aggregates;
+              }
+            ++n_aggregates;
+          }
+
+      return n_aggregates;
+    }
+
+
+
+    /**
+     * Compute aggregates of the given graph in parallel, processing chunks
+     * of @p chunk_size rows independently. Return the total number of
+     * aggregates.
+     */
+    inline size_type
+    compute_aggregates(const Graph &           graph,
+                       const size_type         chunk_size,
+                       std::vector<size_type> &aggregates)
+    {
+      const size_type n_rows = graph.rowstart.size() - 1;
+      aggregates.assign(n_rows, numbers::invalid_dof_index);
+      if (n_rows == 0)
+        return 0;
+
+      const size_type n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+      std::vector<size_type> chunk_offsets(n_chunks + 1, 0);
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_chunks,
+        [&](const size_type begin, const size_type end) {
+          for (size_type chunk = begin; chunk < end; ++chunk)
+            chunk_offsets[chunk + 1] =
+              aggregate_chunk(graph,
+                              chunk * chunk_size,
+                              std::min(n_rows, (chunk + 1) * chunk_size),
+                              aggregates);
+        },
+        1);
+
+      for (size_type chunk = 0; chunk < n_chunks; ++chunk)
+        chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            if (aggregates[row] != numbers::invalid_dof_index)
+              aggregates[row] += chunk_offsets[row / chunk_size];
+        },
+        minimum_parallel_grain_size);
+
+      return chunk_offsets[n_chunks];
+    }
+
+
+
+    /**
+     * Build the smoothed prolongator $P = (I - \omega D_F^{-1} A_F)
+     * P_\text{tent}$ for the given aggregates. Both factors are set up as
+     * sparse matrices, the first one on the pattern of the strength graph
+     * plus the diagonal, and multiplied with SparseMatrix::mmult().
+     */
+    template <typename number>
+    void
+    compute_prolongator(const SparseMatrix<number> &  matrix,
+                        const Graph &                 graph,
+                        const std::vector<double> &   diagonal,
+                        const double                  threshold,
+                        const double                  damping,
+                        const std::vector<size_type> &aggregates,
+                        const size_type               n_aggregates,
+                        SparsityPattern &             sparsity,
+                        SparseMatrix<number> &        prolongation)
+    {
+      const size_type n_rows  = matrix.m();
+      const size_type invalid = numbers::invalid_dof_index;
+
+      // the tentative prolongator interpolates the normalized constant
+      // vector on each aggregate
+      std::vector<size_type>    aggregate_sizes(n_aggregates, 0);
+      std::vector<unsigned int> row_lengths(n_rows, 0);
+      for (size_type row = 0; row < n_rows; ++row)
+        if (aggregates[row] != invalid)
+          {
+            ++aggregate_sizes[aggregates[row]];
+            row_lengths[row] = 1;
+          }
+      SparsityPattern tentative_sparsity(n_rows, n_aggregates, row_lengths);
+      for (size_type row = 0; row < n_rows; ++row)
+        if (aggregates[row] != invalid)
+          tentative_sparsity.add(row, aggregates[row]);
+      tentative_sparsity.compress();
+      SparseMatrix<number> tentative(tentative_sparsity);
+      for (size_type row = 0; row < n_rows; ++row)
+        if (aggregates[row] != invalid)
+          {
+            const double size = aggregate_sizes[aggregates[row]];
+            tentative.set(row, aggregates[row], 1. / std::sqrt(size));
+          }
+
+      // diagonal of the filtered matrix, where weak connections are lumped
+      // to the diagonal, and the Gershgorin bound of each row of
+      // D_F^{-1} A_F
+      std::vector<double> filtered_diagonal(n_rows);
+      std::vector<double> row_bound(n_rows);
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              double d = 0, strong_sum = 0;
+              for (auto p = matrix.begin(row); p != matrix.end(row); ++p)
+                if (p->column() == row || !is_strong(p->value(),
+                                                     diagonal[row],
+                                                     diagonal[p->column()],
+                                                     threshold))
+                  d += p->value();
+                else
+                  strong_sum += std::abs(p->value());
+              filtered_diagonal[row] = d;
+              row_bound[row] =
+                (d != 0. ? (std::abs(d) + strong_sum) / std::abs(d) : 0.);
+            }
+        },
+        minimum_parallel_grain_size);
+      const double rho =
+        (n_rows > 0 ? *std::max_element(row_bound.begin(), row_bound.end()) :
+                      0.);
+      const double omega = (rho > 0. ? damping / rho : 0.);
+
+      // the smoother I - omega D_F^{-1} A_F only couples strongly connected
+      // rows. SparsityPattern::add_entries() only touches the given row, so
+      // the rows can be filled concurrently
+      for (size_type row = 0; row < n_rows; ++row)
+        row_lengths[row] = graph.rowstart[row + 1] - graph.rowstart[row] + 1;
+      SparsityPattern smoother_sparsity(n_rows, n_rows, row_lengths);
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            smoother_sparsity.add_entries(
+              row,
+              graph.colnums.begin() + graph.rowstart[row],
+              graph.colnums.begin() + graph.rowstart[row + 1],
+              true);
+        },
+        minimum_parallel_grain_size);
+      smoother_sparsity.compress();
+
+      SparseMatrix<number> smoother(smoother_sparsity);
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              smoother.diag_element(row) = 1. - omega;
+              if (filtered_diagonal[row] == 0.)
+                continue;
+              const double factor = omega / filtered_diagonal[row];
+              for (auto p = matrix.begin(row); p != matrix.end(row); ++p)
+                if (p->column() != row && is_strong(p->value(),
+                                                    diagonal[row],
+                                                    diagonal[p->column()],
+                                                    threshold))
+                  smoother.set(row, p->column(), -factor * p->value());
+            }
+        },
+        minimum_parallel_grain_size);
+
+      prolongation.reinit(sparsity);
+      smoother.mmult(prolongation, tentative);
+    }
+
+
+
+    /**
+     * Compute the transpose @p R of the matrix @p P by multiplying the
+     * transpose of @p P with the identity matrix through
+     * SparseMatrix::Tmmult(), which sets up the rows of @p R in parallel.
+     */
+    template <typename number>
+    void
+    compute_restriction(const SparseMatrix<number> &P,
+                        SparsityPattern &           sparsity,
+                        SparseMatrix<number> &      R)
+    {
+      SparsityPattern identity_sparsity(P.m(), P.m(), 1);
+      identity_sparsity.compress();
+      SparseMatrix<number> identity(identity_sparsity);
+      for (size_type row = 0; row < P.m(); ++row)
+        identity.diag_element(row) = 1.;
+
+      R.reinit(sparsity);
+      P.Tmmult(R, identity);
+    }
+
+
+
+    /**
+     * Compute the factorization $A = LDL^T$ of the symmetric positive
+     * semidefinite matrix @p matrix in place. On return, the strict lower
+     * triangle holds $L$ and the diagonal holds $D$.
+     *
+     * A pivot that is not larger than a small multiple of the original
+     * diagonal entry of its row marks a direction in which the matrix is
+     * singular up to round-off, as for the constant vector in a pure Neumann
+     * problem. Such pivots and the corresponding columns of $L$ are set to
+     * zero, and solve_ldlt() skips them. This still yields a symmetric
+     * operator that solves consistent systems.
+     */
+    template <typename number>
+    void
+    factorize_ldlt(FullMatrix<number> &matrix)
+    {
+      const size_type n = matrix.m();
+      const number    tolerance =
+        1000. * std::numeric_limits<number>::epsilon();
+
+      std::vector<number> original_diagonal(n);
+      for (size_type i = 0; i < n; ++i)
+        original_diagonal[i] = matrix(i, i);
+
+      std::vector<number> column(n);
+      for (size_type k = 0; k < n; ++k)
+        {
+          const number pivot = matrix(k, k);
+          if (!(pivot > tolerance * original_diagonal[k]))
+            {
+              matrix(k, k) = 0.;
+              for (size_type i = k + 1; i < n; ++i)
+                matrix(i, k) = 0.;
+              continue;
+            }
+
+          // eliminate column k from the remaining lower triangle. the rows
+          // are independent of each other
+          for (size_type i = k + 1; i < n; ++i)
+            column[i] = matrix(i, k);
+          parallel::apply_to_subranges(
+            k + 1,
+            n,
+            [&](const size_type begin, const size_type end) {
+              for (size_type i = begin; i < end; ++i)
+                {
+                  const number factor = column[i] / pivot;
+                  for (size_type j = k + 1; j <= i; ++j)
+                    matrix(i, j) -= factor * column[j];
+                  matrix(i, k) = factor;
+                }
+            },
+            32);
+        }
+    }
+
+
+
+    /**
+     * Apply the operator defined by the factorization computed by
+     * factorize_ldlt() to @p src, i.e., solve $LDL^T x = b$ where the
+     * components belonging to zero pivots are set to zero.
+     */
+    template <typename number>
+    void
+    solve_ldlt(const FullMatrix<number> &factorization,
+               Vector<number> &          dst,
+               const Vector<number> &    src)
+    {
+      const size_type n = factorization.m();
+      dst               = src;
+
+      // forward substitution with L
+      for (size_type i = 0; i < n; ++i)
+        {
+          number sum = dst(i);
+          for (size_type j = 0; j < i; ++j)
+            sum -= factorization(i, j) * dst(j);
+          dst(i) = sum;
+        }
+
+      for (size_type i = 0; i < n; ++i)
+        dst(i) = (factorization(i, i) > number(0.) ?
+                    dst(i) / factorization(i, i) :
+                    number(0.));
+
+      // backward substitution with L^T, going through L row by row
+      for (size_type i = n; i-- > 0;)
+        {
+          const number value = dst(i);
+          for (size_type j = 0; j < i; ++j)
+            dst(j) -= factorization(i, j) * value;
+        }
+    }
+  } // namespace PreconditionAMGImplementation
+} // namespace internal
+
+
+
+template <typename number>
+PreconditionAMG<number>::AdditionalData::AdditionalData(
+  const double       aggregation_threshold,
+  const size_type    coarse_size,
+  const unsigned int max_levels,
+  const SmootherType smoother_type,
+  const unsigned int smoother_sweeps,
+  const double       smoothing_range,
+  const double       jacobi_relaxation,
+  const double       prolongator_damping,
+  const unsigned int n_cycles,
+  const size_type    aggregation_chunk_size,
+  const size_type    max_coarse_direct_size)
+  : aggregation_threshold(aggregation_threshold)
+  , coarse_size(coarse_size)
+  , max_levels(max_levels)
+  , smoother_type(smoother_type)
+  , smoother_sweeps(smoother_sweeps)
+  , smoothing_range(smoothing_range)
+  , jacobi_relaxation(jacobi_relaxation)
+  , prolongator_damping(prolongator_damping)
+  , n_cycles(n_cycles)
+  , aggregation_chunk_size(aggregation_chunk_size)
+  , max_coarse_direct_size(max_coarse_direct_size)
+{}
+
+
+
+template <typename number>
+PreconditionAMG<number>::SetupStatistics::SetupStatistics()
+  : strength_graph_time(0.)
+  , aggregation_time(0.)
+  , prolongator_time(0.)
+  , galerkin_time(0.)
+  , smoother_time(0.)
+  , total_time(0.)
+{}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::initialize(const SparseMatrix<number> &matrix,
+                                    const AdditionalData &additional_data)
+{
+  using namespace internal::PreconditionAMGImplementation;
+
+  AssertDimension(matrix.m(), matrix.n());
+  Assert(additional_data.max_levels > 0, ExcInvalidState());
+  Assert(additional_data.aggregation_chunk_size > 0, ExcInvalidState());
+  Assert(additional_data.n_cycles > 0, ExcInvalidState());
+
+  clear();
+  data = additional_data;
+
+  Timer total_timer;
+  Timer timer;
+
+  levels.emplace_back(new Level());
+  levels.back()->matrix = &matrix;
+
+  Graph                  graph;
+  std::vector<size_type> aggregates;
+  std::vector<double>    diagonal;
+  while (levels.size() < data.max_levels &&
+         levels.back()->matrix->m() > data.coarse_size)
+    {
+      Level &                     fine = *levels.back();
+      const SparseMatrix<number> &A    = *fine.matrix;
+
+      timer.restart();
+      diagonal.resize(A.m());
+      for (size_type row = 0; row < A.m(); ++row)
+        diagonal[row] = std::abs(A.diag_element(row));
+      compute_strength_graph(A, diagonal, data.aggregation_threshold, graph);
+      statistics.strength_graph_time += timer.wall_time();
+
+      timer.restart();
+      const size_type n_aggregates =
+        compute_aggregates(graph, data.aggregation_chunk_size, aggregates);
+      statistics.aggregation_time += timer.wall_time();
+
+      if (n_aggregates == 0 || n_aggregates >= A.m())
+        break;
+
+      timer.restart();
+      compute_prolongator(A,
+                          graph,
+                          diagonal,
+                          data.aggregation_threshold,
+                          data.prolongator_damping,
+                          aggregates,
+                          n_aggregates,
+                          fine.prolongation_sparsity,
+                          fine.prolongation);
+      compute_restriction(fine.prolongation,
+                          fine.restriction_sparsity,
+                          fine.restriction);
+      statistics.prolongator_time += timer.wall_time();
+
+      timer.restart();
+      std::unique_ptr<Level> coarse(new Level());
+      coarse->owned_matrix.reinit(coarse->sparsity);
+      fine.restriction.triple_mmult(coarse->owned_matrix,
+                                    A,
+                                    fine.prolongation);
+      coarse->matrix = &coarse->owned_matrix;
+      levels.push_back(std::move(coarse));
+      statistics.galerkin_time += timer.wall_time();
+    }
+
+  timer.restart();
+  for (unsigned int level = 0; level < levels.size(); ++level)
+    {
+      Level &                     l = *levels[level];
+      const SparseMatrix<number> &A = *l.matrix;
+      if (level > 0)
+        {
+          l.solution.reinit(A.m());
+          l.rhs.reinit(A.m());
+        }
+      if (level + 1 == levels.size() && use_direct_coarse_solver())
+        break;
+
+      l.residual.reinit(A.m());
+      if (data.smoother_type == chebyshev)
+        {
+          typename PreconditionChebyshev<SparseMatrix<number>,
+                                         Vector<number>>::AdditionalData
+            chebyshev_data;
+          chebyshev_data.degree              = data.smoother_sweeps;
+          chebyshev_data.smoothing_range     = data.smoothing_range;
+          chebyshev_data.eig_cg_n_iterations = 10;
+          l.chebyshev.initialize(A, chebyshev_data);
+        }
+      else
+        {
+          l.inverse_diagonal.reinit(A.m());
+          for (size_type row = 0; row < A.m(); ++row)
+            {
+              Assert(A.diag_element(row) != number(),
+                     ExcMessage("The diagonal of the matrix on level " +
+                                Utilities::to_string(level) +
+                                " contains a zero entry in row " +
+                                Utilities::to_string(row) + "."));
+              l.inverse_diagonal(row) = 1. / A.diag_element(row);
+            }
+        }
+    }
+
+  if (use_direct_coarse_solver() && levels.back()->matrix->m() > 0)
+    {
+      coarse_factorization.copy_from(*levels.back()->matrix);
+      factorize_ldlt(coarse_factorization);
+    }
+  statistics.smoother_time = timer.wall_time();
+
+  if (data.n_cycles > 1)
+    {
+      cycle_residual.reinit(matrix.m());
+      cycle_correction.reinit(matrix.m());
+    }
+
+  statistics.total_time = total_timer.wall_time();
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::clear()
+{
+  levels.clear();
+  coarse_factorization = FullMatrix<number>();
+  statistics           = SetupStatistics();
+  cycle_residual       = Vector<number>();
+  cycle_correction     = Vector<number>();
+}
+
+
+
+template <typename number>
+bool
+PreconditionAMG<number>::use_direct_coarse_solver() const
+{
+  return levels.back()->matrix->m() <= data.max_coarse_direct_size;
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::smooth(const unsigned int    level,
+                                Vector<number> &      dst,
+                                const Vector<number> &src,
+                                const bool            zero_start) const
+{
+  const Level &l = *levels[level];
+  if (data.smoother_type == chebyshev)
+    {
+      if (zero_start)
+        l.chebyshev.vmult(dst, src);
+      else
+        l.chebyshev.step(dst, src);
+      return;
+    }
+
+  for (unsigned int sweep = 0; sweep < data.smoother_sweeps; ++sweep)
+    if (sweep == 0 && zero_start)
+      {
+        dst = src;
+        dst.scale(l.inverse_diagonal);
+        dst *= data.jacobi_relaxation;
+      }
+    else
+      {
+        l.matrix->residual(l.residual, dst, src);
+        l.residual.scale(l.inverse_diagonal);
+        dst.add(data.jacobi_relaxation, l.residual);
+      }
+
+  if (data.smoother_sweeps == 0 && zero_start)
+    dst = 0;
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::v_cycle(const unsigned int    level,
+                                 Vector<number> &      dst,
+                                 const Vector<number> &src) const
+{
+  if (level + 1 == levels.size())
+    {
+      if (use_direct_coarse_solver())
+        internal::PreconditionAMGImplementation::solve_ldlt(
+          coarse_factorization, dst, src);
+      else
+        {
+          smooth(level, dst, src, true);
+          smooth(level, dst, src, false);
+        }
+      return;
+    }
+
+  const Level &fine   = *levels[level];
+  const Level &coarse = *levels[level + 1];
+
+  smooth(level, dst, src, true);
+
+  fine.matrix->residual(fine.residual, dst, src);
+  fine.restriction.vmult(coarse.rhs, fine.residual);
+  v_cycle(level + 1, coarse.solution, coarse.rhs);
+  fine.prolongation.vmult_add(dst, coarse.solution);
+
+  smooth(level, dst, src, false);
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::vmult(Vector<number> &      dst,
+                               const Vector<number> &src) const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+
+  Threads::Mutex::ScopedLock lock(mutex);
+
+  v_cycle(0, dst, src);
+  for (unsigned int cycle = 1; cycle < data.n_cycles; ++cycle)
+    {
+      levels[0]->matrix->residual(cycle_residual, dst, src);
+      v_cycle(0, cycle_correction, cycle_residual);
+      dst += cycle_correction;
+    }
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::Tvmult(Vector<number> &      dst,
+                                const Vector<number> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+template <typename number>
+typename PreconditionAMG<number>::size_type
+PreconditionAMG<number>::m() const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  return levels[0]->matrix->m();
+}
+
+
+
+template <typename number>
+typename PreconditionAMG<number>::size_type
+PreconditionAMG<number>::n() const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  return levels[0]->matrix->n();
+}
+
+
+
+template <typename number>
+unsigned int
+PreconditionAMG<number>::n_levels() const
+{
+  return levels.size();
+}
+
+
+
+template <typename number>
+const SparseMatrix<number> &
+PreconditionAMG<number>::get_level_matrix(const unsigned int level) const
+{
+  AssertIndexRange(level, levels.size());
+  return *levels[level]->matrix;
+}
+
+
+
+template <typename number>
+const SparseMatrix<number> &
+PreconditionAMG<number>::get_prolongation_matrix(
+  const unsigned int level) const
+{
+  AssertIndexRange(level + 1, levels.size());
+  return levels[level]->prolongation;
+}
+
+
+
+template <typename number>
+double
+PreconditionAMG<number>::operator_complexity() const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  std::size_t n_nonzero = 0;
+  for (const auto &level : levels)
+    n_nonzero += level->matrix->n_nonzero_elements();
+  return static_cast<double>(n_nonzero) /
+         levels[0]->matrix->n_nonzero_elements();
+}
+
+
+
+template <typename number>
+double
+PreconditionAMG<number>::grid_complexity() const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+  size_type n_rows = 0;
+  for (const auto &level : levels)
+    n_rows += level->matrix->m();
+  return static_cast<double>(n_rows) / levels[0]->matrix->m();
+}
+
+
+
+template <typename number>
+const typename PreconditionAMG<number>::SetupStatistics &
+PreconditionAMG<number>::get_setup_statistics() const
+{
+  return statistics;
+}
+
+
+
+template <typename number>
+void
+PreconditionAMG<number>::print_statistics(std::ostream &out) const
+{
+  Assert(levels.size() > 0, ExcNotInitialized());
+
+  out << "Level         Rows     Nonzeros" << std::endl;
+  for (unsigned int level = 0; level < levels.size(); ++level)
+    out << std::setw(5) << level << std::setw(13) << levels[level]->matrix->m()
+        << std::setw(13) << levels[level]->matrix->n_nonzero_elements()
+        << std::endl;
+  out << "Operator complexity: " << operator_complexity() << std::endl
+      << "Grid complexity:     " << grid_complexity() << std::endl
+      << "Setup time [s]: strength graph " << statistics.strength_graph_time
+      << ", aggregation " << statistics.aggregation_time << ", prolongator "
+      << statistics.prolongator_time << ", Galerkin "
+      << statistics.galerkin_time << ", smoothers "
+      << statistics.smoother_time << ", total " << statistics.total_time
+      << std::endl
+      << "Memory [bytes]: " << memory_consumption() << std::endl;
+}
+
+
+
+template <typename number>
+std::size_t
+PreconditionAMG<number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) +
+                       coarse_factorization.memory_consumption() +
+                       cycle_residual.memory_consumption() +
+                       cycle_correction.memory_consumption();
+  for (unsigned int level = 0; level < levels.size(); ++level)
+    {
+      const Level &l = *levels[level];
+      memory += sizeof(Level) + l.inverse_diagonal.memory_consumption() +
+                l.solution.memory_consumption() +
+                l.rhs.memory_consumption() + l.residual.memory_consumption() +
+                l.prolongation_sparsity.memory_consumption() +
+                l.prolongation.memory_consumption() +
+                l.restriction_sparsity.memory_consumption() +
+                l.restriction.memory_consumption();
+      if (level > 0)
+        memory += l.sparsity.memory_consumption() +
+                  l.owned_matrix.memory_consumption();
+    }
+  return memory;
+}
+
+
+
+// explicit instantiations
+template class PreconditionAMG<double>;
+template class PreconditionAMG<float>;
+
+DEAL_II_NAMESPACE_CLOSE
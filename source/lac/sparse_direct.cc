@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
@@ -101,7 +102,8 @@ SparseDirectUMFPACK::clear()
 
 template <typename number>
 void
-SparseDirectUMFPACK::sort_arrays(const SparseMatrix<number> &matrix)
+SparseDirectUMFPACK::sort_arrays(const SparseMatrix<number> &,
+                                 const size_type row)
 {
   // do the copying around of entries so that the diagonal entry is in the
   // right place. note that this is easy to detect: since all entries apart
@@ -110,26 +112,23 @@ SparseDirectUMFPACK::sort_arrays(const SparseMatrix<number> &matrix)
   // column index of the second entry in a row
   //
   // ignore rows with only one or no entry
-  for (size_type row = 0; row < matrix.m(); ++row)
+  //
+  // we may have to move some elements that are left of the diagonal but
+  // presently after the diagonal entry to the left, whereas the diagonal
+  // entry has to move to the right. we could first figure out where to move
+  // everything to, but for simplicity we just make a series of swaps instead
+  // (this is kind of a single run of bubble-sort, which gives us the desired
+  // result since the array is already "almost" sorted)
+  //
+  // in the first loop, the condition in the while-header also checks that
+  // the row has at least two entries and that the diagonal entry is really
+  // in the wrong place
+  long int cursor = Ap[row];
+  while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] > Ai[cursor + 1]))
     {
-      // we may have to move some elements that are left of the diagonal
-      // but presently after the diagonal entry to the left, whereas the
-      // diagonal entry has to move to the right. we could first figure out
-      // where to move everything to, but for simplicity we just make a
-      // series of swaps instead (this is kind of a single run of
-      // bubble-sort, which gives us the desired result since the array is
-      // already "almost" sorted)
-      //
-      // in the first loop, the condition in the while-header also checks
-      // that the row has at least two entries and that the diagonal entry
-      // is really in the wrong place
-      long int cursor = Ap[row];
-      while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] > Ai[cursor + 1]))
-        {
-          std::swap(Ai[cursor], Ai[cursor + 1]);
-          std::swap(Ax[cursor], Ax[cursor + 1]);
-          ++cursor;
-        }
+      std::swap(Ai[cursor], Ai[cursor + 1]);
+      std::swap(Ax[cursor], Ax[cursor + 1]);
+      ++cursor;
     }
 }
 
@@ -137,18 +136,16 @@ SparseDirectUMFPACK::sort_arrays(const SparseMatrix<number> &matrix)
 
 template <typename number>
 void
-SparseDirectUMFPACK::sort_arrays(const SparseMatrixEZ<number> &matrix)
+SparseDirectUMFPACK::sort_arrays(const SparseMatrixEZ<number> &,
+                                 const size_type row)
 {
   // same thing for SparseMatrixEZ
-  for (size_type row = 0; row < matrix.m(); ++row)
+  long int cursor = Ap[row];
+  while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] > Ai[cursor + 1]))
     {
-      long int cursor = Ap[row];
-      while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] > Ai[cursor + 1]))
-        {
-          std::swap(Ai[cursor], Ai[cursor + 1]);
-          std::swap(Ax[cursor], Ax[cursor + 1]);
-          ++cursor;
-        }
+      std::swap(Ai[cursor], Ai[cursor + 1]);
+      std::swap(Ax[cursor], Ax[cursor + 1]);
+      ++cursor;
     }
 }
 
@@ -156,35 +153,33 @@ SparseDirectUMFPACK::sort_arrays(const SparseMatrixEZ<number> &matrix)
 
 template <typename number>
 void
-SparseDirectUMFPACK::sort_arrays(const BlockSparseMatrix<number> &matrix)
+SparseDirectUMFPACK::sort_arrays(const BlockSparseMatrix<number> &matrix,
+                                 const size_type                  row)
 {
   // the case for block matrices is a bit more difficult, since all we know
   // is that *within each block*, the diagonal of that block may come
   // first. however, that means that there may be as many entries per row
   // in the wrong place as there are block columns. we can do the same
   // thing as above, but we have to do it multiple times
-  for (size_type row = 0; row < matrix.m(); ++row)
+  long int cursor = Ap[row];
+  for (size_type block = 0; block < matrix.n_block_cols(); ++block)
     {
-      long int cursor = Ap[row];
-      for (size_type block = 0; block < matrix.n_block_cols(); ++block)
+      // find the next out-of-order element
+      while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] < Ai[cursor + 1]))
+        ++cursor;
+
+      // if there is none, then just go on
+      if (cursor == Ap[row + 1] - 1)
+        break;
+
+      // otherwise swap this entry with successive ones as long as
+      // necessary
+      long int element = cursor;
+      while ((element < Ap[row + 1] - 1) && (Ai[element] > Ai[element + 1]))
         {
-          // find the next out-of-order element
-          while ((cursor < Ap[row + 1] - 1) && (Ai[cursor] < Ai[cursor + 1]))
-            ++cursor;
-
-          // if there is none, then just go on
-          if (cursor == Ap[row + 1] - 1)
-            break;
-
-          // otherwise swap this entry with successive ones as long as
-          // necessary
-          long int element = cursor;
-          while ((element < Ap[row + 1] - 1) && (Ai[element] > Ai[element + 1]))
-            {
-              std::swap(Ai[element], Ai[element + 1]);
-              std::swap(Ax[element], Ax[element + 1]);
-              ++element;
-            }
+          std::swap(Ai[element], Ai[element + 1]);
+          std::swap(Ax[element], Ax[element + 1]);
+          ++element;
         }
     }
 }
@@ -193,15 +188,8 @@ SparseDirectUMFPACK::sort_arrays(const BlockSparseMatrix<number> &matrix)
 
 template <class Matrix>
 void
-SparseDirectUMFPACK::factorize(const Matrix &matrix)
+SparseDirectUMFPACK::copy_matrix_to_arrays(const Matrix &matrix)
 {
-  Assert(matrix.m() == matrix.n(), ExcNotQuadratic())
-
-    clear();
-
-  _m = matrix.m();
-  _n = matrix.n();
-
   const size_type N = matrix.m();
 
   // copy over the data from the matrix to the data structures UMFPACK
@@ -232,41 +220,55 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
     Ap[row] = Ap[row - 1] + matrix.get_row_length(row - 1);
   Assert(static_cast<size_type>(Ap.back()) == Ai.size(), ExcInternalError());
 
-  // then copy over matrix elements. note that for sparse matrices,
-  // iterators are sorted so that they traverse each row from start to end
-  // before moving on to the next row. however, this isn't true for block
-  // matrices, so we have to do a bit of book keeping
-  {
-    // have an array that for each row points to the first entry not yet
-    // written to
-    std::vector<long int> row_pointers = Ap;
-
-    // loop over the elements of the matrix row by row, as suggested in the
-    // documentation of the sparse matrix iterator class
-    for (size_type row = 0; row < matrix.m(); ++row)
-      {
-        for (typename Matrix::const_iterator p = matrix.begin(row);
-             p != matrix.end(row);
-             ++p)
-          {
-            // write entry into the first free one for this row
-            Ai[row_pointers[row]] = p->column();
-            Ax[row_pointers[row]] = p->value();
-
-            // then move pointer ahead
-            ++row_pointers[row];
-          }
-      }
-
-    // at the end, we should have written all rows completely
-    for (size_type i = 0; i < Ap.size() - 1; ++i)
-      Assert(row_pointers[i] == Ap[i + 1], ExcInternalError());
-  }
+  // then copy over matrix elements. since we know where each row starts,
+  // the rows are independent of each other and can be copied and sorted in
+  // parallel. note that for sparse matrices, iterators are sorted so that
+  // they traverse each row from start to end before moving on to the next
+  // row. we loop over the elements of the matrix row by row, as suggested
+  // in the documentation of the sparse matrix iterator class
+  parallel::apply_to_subranges(
+    size_type(0),
+    N,
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        {
+          long int index = Ap[row];
+          for (typename Matrix::const_iterator p = matrix.begin(row);
+               p != matrix.end(row);
+               ++p, ++index)
+            {
+              Ai[index] = p->column();
+              Ax[index] = p->value();
+            }
 
-  // make sure that the elements in each row are sorted. we have to be more
-  // careful for block sparse matrices, so ship this task out to a
-  // different function
-  sort_arrays(matrix);
+          // at the end, we should have written the row completely
+          Assert(index == Ap[row + 1], ExcInternalError());
+
+          // make sure that the elements in each row are sorted. we have to
+          // be more careful for block sparse matrices, so ship this task out
+          // to a different function
+          sort_arrays(matrix, row);
+        }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::factorize(const Matrix &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic())
+
+    clear();
+
+  _m = matrix.m();
+  _n = matrix.n();
+
+  const size_type N = matrix.m();
+
+  copy_matrix_to_arrays(matrix);
 
   int status;
   status = umfpack_dl_symbolic(N,
@@ -289,8 +291,52 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                               nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::refactorize(const Matrix &matrix)
+{
+  if (symbolic_decomposition == nullptr)
+    {
+      factorize(matrix);
+      return;
+    }
+
+  Assert(matrix.m() == _m, ExcDimensionMismatch(matrix.m(), _m));
+  Assert(matrix.n() == _n, ExcDimensionMismatch(matrix.n(), _n));
+
+#  ifdef DEBUG
+  const std::vector<SuiteSparse_long> old_Ap = Ap;
+  const std::vector<SuiteSparse_long> old_Ai = Ai;
+#  endif
+
+  copy_matrix_to_arrays(matrix);
+
+#  ifdef DEBUG
+  Assert(Ap == old_Ap && Ai == old_Ai,
+         ExcMessage("The sparsity pattern of the matrix passed to "
+                    "refactorize() differs from the one of the matrix "
+                    "passed to factorize(). Call factorize() instead."));
+#  endif
 
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  const int status = umfpack_dl_numeric(Ap.data(),
+                                        Ai.data(),
+                                        Ax.data(),
+                                        symbolic_decomposition,
+                                        &numeric_decomposition,
+                                        control.data(),
+                                        nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_dl_numeric", status));
 }
 
 
@@ -342,6 +388,47 @@ SparseDirectUMFPACK::solve(BlockVector<double> &rhs_and_solution,
 
 
 
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &rhs_and_solutions,
+                           bool transpose /*=false*/) const
+{
+  // umfpack_dl_solve only reads from the factorization and allocates its
+  // own workspace, so the right hand sides can be solved for concurrently
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    rhs_and_solutions.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        solve(rhs_and_solutions[i], transpose);
+    },
+    1);
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &rhs_and_solution,
+                           bool                transpose /*=false*/) const
+{
+  AssertDimension(rhs_and_solution.m(), _m);
+
+  // UMFPACK wants each right hand side as a contiguous array, whereas the
+  // columns of a FullMatrix are strided, so copy them into vectors and back
+  std::vector<Vector<double>> columns(rhs_and_solution.n(),
+                                      Vector<double>(rhs_and_solution.m()));
+  for (size_type i = 0; i < rhs_and_solution.m(); ++i)
+    for (size_type j = 0; j < rhs_and_solution.n(); ++j)
+      columns[j](i) = rhs_and_solution(i, j);
+
+  solve(columns, transpose);
+
+  for (size_type i = 0; i < rhs_and_solution.m(); ++i)
+    for (size_type j = 0; j < rhs_and_solution.n(); ++j)
+      rhs_and_solution(i, j) = columns[j](i);
+}
+
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &  matrix,
@@ -392,6 +479,17 @@ SparseDirectUMFPACK::factorize(const Matrix &)
 }
 
 
+template <class Matrix>
+void
+SparseDirectUMFPACK::refactorize(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 void
 SparseDirectUMFPACK::solve(Vector<double> &, bool) const
 {
@@ -413,6 +511,28 @@ SparseDirectUMFPACK::solve(BlockVector<double> &, bool) const
 }
 
 
+
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &, bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &, bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &, Vector<double> &, bool)
@@ -498,15 +618,16 @@ SparseDirectUMFPACK::n() const
 
 
 // explicit instantiations for SparseMatrixUMFPACK
-#define InstantiateUMFPACK(MatrixType)                              \
-  template void SparseDirectUMFPACK::factorize(const MatrixType &); \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           Vector<double> &,        \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           BlockVector<double> &,   \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::initialize(const MatrixType &, \
+#define InstantiateUMFPACK(MatrixType)                                \
+  template void SparseDirectUMFPACK::factorize(const MatrixType &);   \
+  template void SparseDirectUMFPACK::refactorize(const MatrixType &); \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,        \
+                                           Vector<double> &,          \
+                                           bool);                     \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,        \
+                                           BlockVector<double> &,     \
+                                           bool);                     \
+  template void SparseDirectUMFPACK::initialize(const MatrixType &,   \
                                                 const AdditionalData)
 
 InstantiateUMFPACK(SparseMatrix<double>);
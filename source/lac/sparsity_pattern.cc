@@ -373,6 +373,21 @@ SparsityPattern::compress()
                   std::bind(std::not_equal_to<size_type>(),
                             std::placeholders::_1,
                             invalid_entry));
+
+  // if all entries are in use, as happens if reinit() was called with the
+  // exact row lengths, the rows only need to be sorted, and we can avoid
+  // holding two copies of the column numbers
+  if (nonzero_elements == rowstart[rows])
+    {
+      for (size_type line = 0; line < rows; ++line)
+        if (rowstart[line + 1] - rowstart[line] > 1)
+          std::sort(&colnums[rowstart[line]] +
+                      (store_diagonal_first_in_row ? 1 : 0),
+                    &colnums[rowstart[line + 1]]);
+      compressed = true;
+      return;
+    }
+
   // now allocate the respective memory
   std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
 
@@ -15,6 +15,7 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/lac/exceptions.h>
@@ -23,6 +24,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
 #include <set>
 
 #ifdef DEAL_II_WITH_MPI
@@ -33,6 +35,10 @@
 #  include <deal.II/lac/dynamic_sparsity_pattern.h>
 #endif
 
+#ifdef DEAL_II_WITH_THREADS
+#  include <tbb/parallel_sort.h>
+#endif
+
 #ifdef DEAL_II_WITH_METIS
 extern "C"
 {
@@ -524,52 +530,17 @@ namespace SparsityTools
   namespace internal
   {
     /**
-     * Given a connectivity graph and a list of indices (where
-     * invalid_size_type indicates that a node has not been numbered yet),
-     * pick a valid starting index among the as-yet unnumbered one.
+     * Sort the given range, using all available threads if possible.
      */
-    DynamicSparsityPattern::size_type
-    find_unnumbered_starting_index(
-      const DynamicSparsityPattern &                        sparsity,
-      const std::vector<DynamicSparsityPattern::size_type> &new_indices)
+    template <typename Iterator>
+    void
+    sort_in_parallel(const Iterator begin, const Iterator end)
     {
-      DynamicSparsityPattern::size_type starting_point =
-        numbers::invalid_size_type;
-      DynamicSparsityPattern::size_type min_coordination = sparsity.n_rows();
-      for (DynamicSparsityPattern::size_type row = 0; row < sparsity.n_rows();
-           ++row)
-        // look over all as-yet unnumbered indices
-        if (new_indices[row] == numbers::invalid_size_type)
-          {
-            if (sparsity.row_length(row) < min_coordination)
-              {
-                min_coordination = sparsity.row_length(row);
-                starting_point   = row;
-              }
-          }
-
-      // now we still have to care for the case that no unnumbered dof has a
-      // coordination number less than sparsity.n_rows(). this rather exotic
-      // case only happens if we only have one cell, as far as I can see,
-      // but there may be others as well.
-      //
-      // if that should be the case, we can chose an arbitrary dof as
-      // starting point, e.g. the first unnumbered one
-      if (starting_point == numbers::invalid_size_type)
-        {
-          for (DynamicSparsityPattern::size_type i = 0; i < new_indices.size();
-               ++i)
-            if (new_indices[i] == numbers::invalid_size_type)
-              {
-                starting_point = i;
-                break;
-              }
-
-          Assert(starting_point != numbers::invalid_size_type,
-                 ExcInternalError());
-        }
-
-      return starting_point;
+#ifdef DEAL_II_WITH_THREADS
+      tbb::parallel_sort(begin, end);
+#else
+      std::sort(begin, end);
+#endif
     }
   } // namespace internal
 
@@ -581,6 +552,8 @@ namespace SparsityTools
     std::vector<DynamicSparsityPattern::size_type> &      new_indices,
     const std::vector<DynamicSparsityPattern::size_type> &starting_indices)
   {
+    using size_type = DynamicSparsityPattern::size_type;
+
     Assert(sparsity.n_rows() == sparsity.n_cols(),
            ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
     Assert(sparsity.n_rows() == new_indices.size(),
@@ -598,59 +571,123 @@ namespace SparsityTools
                         "to be between zero and the number of rows in the "
                         "sparsity pattern."));
 
+    // the algorithm is a breadth-first search that numbers all dofs of one
+    // front at once. the work on each front (finding the neighbors of the
+    // last front, and ordering them by their coordination numbers) is done
+    // in parallel
+    const size_type    n_rows     = sparsity.n_rows();
+    const unsigned int grain_size = 512;
+
     // store the indices of the dofs renumbered in the last round. Default to
     // starting points
-    std::vector<DynamicSparsityPattern::size_type> last_round_dofs(
-      starting_indices);
+    std::vector<size_type> last_round_dofs(starting_indices);
 
     // initialize the new_indices array with invalid values
     std::fill(new_indices.begin(),
               new_indices.end(),
               numbers::invalid_size_type);
 
+    // the dofs sorted by their coordination numbers, and by their index for
+    // equal coordination numbers. we walk through this list to find the
+    // as-yet unnumbered dof with the lowest coordination number whenever we
+    // need a starting point for a component of the graph. since all dofs
+    // before the current position have already been numbered, this costs
+    // only linear time for all components together
+    std::vector<std::pair<size_type, size_type>> dofs_by_coordination;
+    size_type                                    next_starting_candidate = 0;
+
+    const auto find_unnumbered_starting_index = [&]() -> size_type {
+      if (dofs_by_coordination.empty())
+        {
+          dofs_by_coordination.resize(n_rows);
+          parallel::apply_to_subranges(
+            size_type(0),
+            n_rows,
+            [&](const size_type begin, const size_type end) {
+              for (size_type row = begin; row < end; ++row)
+                dofs_by_coordination[row] = {sparsity.row_length(row), row};
+            },
+            grain_size);
+          internal::sort_in_parallel(dofs_by_coordination.begin(),
+                                     dofs_by_coordination.end());
+        }
+      while (new_indices[dofs_by_coordination[next_starting_candidate]
+                           .second] != numbers::invalid_size_type)
+        ++next_starting_candidate;
+      return dofs_by_coordination[next_starting_candidate].second;
+    };
+
     // if no starting indices were given: find dof with lowest coordination
     // number
     if (last_round_dofs.empty())
-      last_round_dofs.push_back(
-        internal::find_unnumbered_starting_index(sparsity, new_indices));
+      last_round_dofs.push_back(find_unnumbered_starting_index());
 
     // store next free dof index
-    DynamicSparsityPattern::size_type next_free_number = 0;
+    size_type next_free_number = 0;
 
     // enumerate the first round dofs
-    for (DynamicSparsityPattern::size_type i = 0; i != last_round_dofs.size();
-         ++i)
+    for (size_type i = 0; i != last_round_dofs.size(); ++i)
       new_indices[last_round_dofs[i]] = next_free_number++;
 
+    std::vector<size_type>                       neighbors_start;
+    std::vector<size_type>                       next_round_dofs;
+    std::vector<std::pair<size_type, size_type>> front_by_coordination;
+
     // now do as many steps as needed to renumber all dofs
     while (true)
       {
-        // store the indices of the dofs to be renumbered in the next round
-        std::vector<DynamicSparsityPattern::size_type> next_round_dofs;
-
-        // find all neighbors of the dofs numbered in the last round
-        for (DynamicSparsityPattern::size_type i = 0;
-             i < last_round_dofs.size();
-             ++i)
-          for (DynamicSparsityPattern::iterator j =
-                 sparsity.begin(last_round_dofs[i]);
-               j < sparsity.end(last_round_dofs[i]);
-               ++j)
-            next_round_dofs.push_back(j->column());
-
-        // sort dof numbers
-        std::sort(next_round_dofs.begin(), next_round_dofs.end());
-
-        // delete multiple entries
-        std::vector<DynamicSparsityPattern::size_type>::iterator end_sorted;
-        end_sorted =
-          std::unique(next_round_dofs.begin(), next_round_dofs.end());
-        next_round_dofs.erase(end_sorted, next_round_dofs.end());
-
-        // eliminate dofs which are already numbered
-        for (int s = next_round_dofs.size() - 1; s >= 0; --s)
-          if (new_indices[next_round_dofs[s]] != numbers::invalid_size_type)
-            next_round_dofs.erase(next_round_dofs.begin() + s);
+        // find all unnumbered neighbors of the dofs numbered in the last
+        // round. count them first, so that each task can then write them
+        // into its own part of the list
+        neighbors_start.resize(last_round_dofs.size() + 1);
+        neighbors_start[0] = 0;
+        parallel::apply_to_subranges(
+          size_type(0),
+          last_round_dofs.size(),
+          [&](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              {
+                const size_type row          = last_round_dofs[i];
+                const size_type row_length   = sparsity.row_length(row);
+                size_type       n_unnumbered = 0;
+                for (size_type j = 0; j < row_length; ++j)
+                  if (new_indices[sparsity.column_number(row, j)] ==
+                      numbers::invalid_size_type)
+                    ++n_unnumbered;
+                neighbors_start[i + 1] = n_unnumbered;
+              }
+          },
+          grain_size);
+        std::partial_sum(neighbors_start.begin(),
+                         neighbors_start.end(),
+                         neighbors_start.begin());
+
+        next_round_dofs.resize(neighbors_start.back());
+        parallel::apply_to_subranges(
+          size_type(0),
+          last_round_dofs.size(),
+          [&](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              {
+                const size_type row        = last_round_dofs[i];
+                const size_type row_length = sparsity.row_length(row);
+                size_type       position   = neighbors_start[i];
+                for (size_type j = 0; j < row_length; ++j)
+                  {
+                    const size_type column = sparsity.column_number(row, j);
+                    if (new_indices[column] == numbers::invalid_size_type)
+                      next_round_dofs[position++] = column;
+                  }
+              }
+          },
+          grain_size);
+
+        // sort dof numbers and delete multiple entries
+        internal::sort_in_parallel(next_round_dofs.begin(),
+                                   next_round_dofs.end());
+        next_round_dofs.erase(std::unique(next_round_dofs.begin(),
+                                          next_round_dofs.end()),
+                              next_round_dofs.end());
 
         // check whether there are any new dofs in the list. if there are
         // none, then we have completely numbered the current component of the
@@ -658,9 +695,7 @@ namespace SparsityTools
         // that we would then have to do next
         if (next_round_dofs.empty())
           {
-            if (std::find(new_indices.begin(),
-                          new_indices.end(),
-                          numbers::invalid_size_type) == new_indices.end())
+            if (next_free_number == n_rows)
               // no unnumbered indices, so we can leave now
               break;
 
@@ -676,41 +711,37 @@ namespace SparsityTools
                               "starting indices are given. The function was "
                               "called with starting indices, however."))
 
-              next_round_dofs.push_back(
-                internal::find_unnumbered_starting_index(sparsity,
-                                                         new_indices));
+              next_round_dofs.push_back(find_unnumbered_starting_index());
           }
 
-
-
-        // store for each coordination number the dofs with these coordination
-        // number
-        std::multimap<DynamicSparsityPattern::size_type, int>
-          dofs_by_coordination;
-
-        // find coordination number for each of these dofs
-        for (std::vector<DynamicSparsityPattern::size_type>::iterator s =
-               next_round_dofs.begin();
-             s != next_round_dofs.end();
-             ++s)
-          {
-            const DynamicSparsityPattern::size_type coordination =
-              sparsity.row_length(*s);
-
-            // insert this dof at its coordination number
-            const std::pair<const DynamicSparsityPattern::size_type, int>
-              new_entry(coordination, *s);
-            dofs_by_coordination.insert(new_entry);
-          }
-
-        // assign new DoF numbers to the elements of the present front:
-        std::multimap<DynamicSparsityPattern::size_type, int>::iterator i;
-        for (i = dofs_by_coordination.begin(); i != dofs_by_coordination.end();
-             ++i)
-          new_indices[i->second] = next_free_number++;
-
-        // after that: copy this round's dofs for the next round
-        last_round_dofs = next_round_dofs;
+        // assign new DoF numbers to the elements of the present front, in
+        // the order of their coordination numbers. dofs with equal
+        // coordination numbers are numbered in the order of their indices
+        front_by_coordination.resize(next_round_dofs.size());
+        parallel::apply_to_subranges(
+          size_type(0),
+          next_round_dofs.size(),
+          [&](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              front_by_coordination[i] = {
+                sparsity.row_length(next_round_dofs[i]), next_round_dofs[i]};
+          },
+          grain_size);
+        internal::sort_in_parallel(front_by_coordination.begin(),
+                                   front_by_coordination.end());
+        parallel::apply_to_subranges(
+          size_type(0),
+          front_by_coordination.size(),
+          [&](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              new_indices[front_by_coordination[i].second] =
+                next_free_number + i;
+          },
+          grain_size);
+        next_free_number += front_by_coordination.size();
+
+        // after that: this round's dofs are the front for the next round
+        last_round_dofs.swap(next_round_dofs);
       }
 
     // test for all indices numbered. this mostly tests whether the
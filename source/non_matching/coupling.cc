@@ -14,12 +14,17 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
 
 #include <deal.II/grid/grid_tools.h>
@@ -40,6 +45,362 @@
 DEAL_II_NAMESPACE_OPEN
 namespace NonMatching
 {
+  namespace
+  {
+    /**
+     * Return whether the point @p p lies inside the cell @p cell of the
+     * triangulation of the @p cache and compute its reference coordinates.
+     */
+    template <int dim, int spacedim>
+    bool
+    point_inside_cell(
+      const GridTools::Cache<dim, spacedim> &                           cache,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const Point<spacedim> &                                           p,
+      Point<dim> &                                                      p_unit)
+    {
+      try
+        {
+          p_unit = cache.get_mapping().transform_real_to_unit_cell(cell, p);
+        }
+      catch (const typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+        {
+          return false;
+        }
+      return GeometryInfo<dim>::is_inside_unit_cell(p_unit, 1e-10);
+    }
+
+
+
+    /**
+     * Group the quadrature points of the immersed cell with active cell index
+     * @p immersed_cell_index by the locally owned cells of the space
+     * triangulation around them. The cells are returned in @p space_cells in
+     * the order in which they are first encountered, and the indices of the
+     * quadrature points in each of them in @p points_per_cell. Points that
+     * were not found or lie in cells that are not locally owned are skipped.
+     */
+    template <int dim0, int dim1, int spacedim>
+    void
+    group_points_by_space_cell(
+      const CouplingPlan<dim0, dim1, spacedim> &plan,
+      const unsigned int                        immersed_cell_index,
+      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+        &                                     space_cells,
+      std::vector<std::vector<unsigned int>> &points_per_cell)
+    {
+      space_cells.clear();
+      for (auto &points : points_per_cell)
+        points.clear();
+
+      for (unsigned int q = 0; q < plan.get_quadrature().size(); ++q)
+        {
+          const auto &space_cell =
+            plan.get_space_cell(immersed_cell_index, q);
+          if (space_cell.state() != IteratorState::valid ||
+              !space_cell->is_locally_owned())
+            continue;
+
+          // the number of different cells is small, so a linear search is
+          // fine
+          const unsigned int c =
+            std::find(space_cells.begin(), space_cells.end(), space_cell) -
+            space_cells.begin();
+          if (c == space_cells.size())
+            {
+              space_cells.push_back(space_cell);
+              if (points_per_cell.size() < space_cells.size())
+                points_per_cell.emplace_back();
+            }
+          points_per_cell[c].push_back(q);
+        }
+    }
+
+
+
+    /**
+     * Make sure that all quadrature points of the @p plan were found, unless
+     * the space triangulation is distributed, in which case points outside
+     * the part of the mesh known to the current process are skipped.
+     */
+    template <int dim0, int dim1, int spacedim>
+    void
+    check_all_points_found(const CouplingPlan<dim0, dim1, spacedim> &plan)
+    {
+      if (dynamic_cast<
+            const parallel::distributed::Triangulation<dim0, spacedim> *>(
+            &plan.get_cache().get_triangulation()) != nullptr)
+        return;
+
+      const auto &immersed_tria =
+        plan.get_immersed_dof_handler().get_triangulation();
+      for (unsigned int c = 0; c < immersed_tria.n_active_cells(); ++c)
+        for (unsigned int q = 0; q < plan.get_quadrature().size(); ++q)
+          AssertThrow(plan.get_space_cell(c, q).state() ==
+                        IteratorState::valid,
+                      GridTools::ExcPointNotFound<spacedim>(
+                        plan.get_point(c, q)));
+    }
+
+
+
+    /**
+     * Scratch data for the assembly of the coupling mass matrix.
+     */
+    template <int dim0, int dim1, int spacedim>
+    struct CouplingScratchData
+    {
+      CouplingScratchData(const Mapping<dim1, spacedim> &       mapping,
+                          const FiniteElement<dim1, spacedim> &fe,
+                          const Quadrature<dim1> &             quadrature)
+        : fe_values(mapping, fe, quadrature, update_values | update_JxW_values)
+      {}
+
+      CouplingScratchData(const CouplingScratchData &scratch)
+        : fe_values(scratch.fe_values.get_mapping(),
+                    scratch.fe_values.get_fe(),
+                    scratch.fe_values.get_quadrature(),
+                    scratch.fe_values.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_values;
+
+      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+                                             space_cells;
+      std::vector<std::vector<unsigned int>> points_per_cell;
+      std::vector<Point<dim0>>               space_points;
+      Table<2, double>                       space_values;
+    };
+
+
+
+    /**
+     * Copy data for the assembly of the coupling mass matrix: one local
+     * matrix for each of the space cells the immersed cell intersects.
+     */
+    template <typename number>
+    struct CouplingCopyData
+    {
+      unsigned int                                      n_space_cells;
+      std::vector<types::global_dof_index>              dofs;
+      std::vector<std::vector<types::global_dof_index>> odofs;
+      std::vector<FullMatrix<number>>                   cell_matrices;
+    };
+  } // namespace
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  CouplingPlan<dim0, dim1, spacedim>::CouplingPlan(
+    const GridTools::Cache<dim0, spacedim> &cache,
+    const DoFHandler<dim1, spacedim> &      immersed_dh,
+    const Quadrature<dim1> &                quadrature,
+    const Mapping<dim1, spacedim> &         immersed_mapping)
+    : cache(&cache)
+    , immersed_dh(&immersed_dh)
+    , quadrature(quadrature)
+    , immersed_mapping(&immersed_mapping)
+    , n_searched(0)
+  {
+    static_assert(dim1 <= dim0, "This class can only work if dim1 <= dim0");
+    update();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  void
+  CouplingPlan<dim0, dim1, spacedim>::update()
+  {
+    const unsigned int n_q_points = quadrature.size();
+    const unsigned int n_points =
+      immersed_dh->get_triangulation().n_active_cells() * n_q_points;
+
+    // if the immersed mesh has changed, start from scratch
+    if (points.size() != n_points)
+      {
+        points.assign(n_points, Point<spacedim>());
+        space_cells.assign(
+          n_points,
+          typename Triangulation<dim0, spacedim>::active_cell_iterator());
+        reference_points.assign(n_points, Point<dim0>());
+      }
+
+    std::vector<typename DoFHandler<dim1, spacedim>::active_cell_iterator>
+      immersed_cells;
+    immersed_cells.reserve(immersed_dh->get_triangulation().n_active_cells());
+    for (const auto &cell : immersed_dh->active_cell_iterators())
+      immersed_cells.push_back(cell);
+
+    // compute the new positions of the points and look for them in the
+    // cells they were in before, and in the neighbors of these cells. this
+    // is done in parallel, as every point is only written by one task
+    std::vector<char> missing(n_points, 0);
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(immersed_cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        FEValues<dim1, spacedim> fe_values(*immersed_mapping,
+                                           immersed_dh->get_fe(),
+                                           quadrature,
+                                           update_quadrature_points);
+        std::vector<
+          typename Triangulation<dim0, spacedim>::active_cell_iterator>
+          neighbors;
+
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            fe_values.reinit(immersed_cells[c]);
+            const unsigned int offset =
+              immersed_cells[c]->active_cell_index() * n_q_points;
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                const unsigned int i = offset + q;
+                points[i]            = fe_values.quadrature_point(q);
+
+                bool found = false;
+                if (space_cells[i].state() == IteratorState::valid)
+                  {
+                    found = point_inside_cell(*cache,
+                                              space_cells[i],
+                                              points[i],
+                                              reference_points[i]);
+                    if (!found)
+                      {
+                        GridTools::get_active_neighbors<
+                          Triangulation<dim0, spacedim>>(space_cells[i],
+                                                         neighbors);
+                        for (const auto &neighbor : neighbors)
+                          if (neighbor->is_locally_owned() &&
+                              point_inside_cell(*cache,
+                                                neighbor,
+                                                points[i],
+                                                reference_points[i]))
+                            {
+                              space_cells[i] = neighbor;
+                              found          = true;
+                              break;
+                            }
+                      }
+                  }
+                missing[i] = !found;
+              }
+          }
+      },
+      16);
+
+    // search for all other points at once
+    std::vector<unsigned int>    missing_indices;
+    std::vector<Point<spacedim>> missing_points;
+    for (unsigned int i = 0; i < n_points; ++i)
+      if (missing[i])
+        {
+          missing_indices.push_back(i);
+          missing_points.push_back(points[i]);
+        }
+    n_searched = missing_points.size();
+
+    if (missing_points.size() > 0)
+      {
+        const auto cells_and_points =
+          GridTools::find_active_cells_around_points(*cache, missing_points);
+        for (unsigned int p = 0; p < missing_indices.size(); ++p)
+          {
+            space_cells[missing_indices[p]] = cells_and_points[p].first;
+            reference_points[missing_indices[p]] = cells_and_points[p].second;
+          }
+      }
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const GridTools::Cache<dim0, spacedim> &
+  CouplingPlan<dim0, dim1, spacedim>::get_cache() const
+  {
+    return *cache;
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const DoFHandler<dim1, spacedim> &
+  CouplingPlan<dim0, dim1, spacedim>::get_immersed_dof_handler() const
+  {
+    return *immersed_dh;
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const Quadrature<dim1> &
+  CouplingPlan<dim0, dim1, spacedim>::get_quadrature() const
+  {
+    return quadrature;
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const Mapping<dim1, spacedim> &
+  CouplingPlan<dim0, dim1, spacedim>::get_immersed_mapping() const
+  {
+    return *immersed_mapping;
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const Point<spacedim> &
+  CouplingPlan<dim0, dim1, spacedim>::get_point(
+    const unsigned int immersed_cell_index,
+    const unsigned int q) const
+  {
+    AssertIndexRange(q, quadrature.size());
+    AssertIndexRange(immersed_cell_index * quadrature.size() + q,
+                     points.size());
+    return points[immersed_cell_index * quadrature.size() + q];
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const typename Triangulation<dim0, spacedim>::active_cell_iterator &
+  CouplingPlan<dim0, dim1, spacedim>::get_space_cell(
+    const unsigned int immersed_cell_index,
+    const unsigned int q) const
+  {
+    AssertIndexRange(q, quadrature.size());
+    AssertIndexRange(immersed_cell_index * quadrature.size() + q,
+                     space_cells.size());
+    return space_cells[immersed_cell_index * quadrature.size() + q];
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  const Point<dim0> &
+  CouplingPlan<dim0, dim1, spacedim>::get_reference_point(
+    const unsigned int immersed_cell_index,
+    const unsigned int q) const
+  {
+    AssertIndexRange(q, quadrature.size());
+    AssertIndexRange(immersed_cell_index * quadrature.size() + q,
+                     reference_points.size());
+    return reference_points[immersed_cell_index * quadrature.size() + q];
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  unsigned int
+  CouplingPlan<dim0, dim1, spacedim>::n_searched_points() const
+  {
+    return n_searched;
+  }
+
+
+
   template <int dim0,
             int dim1,
             int spacedim,
@@ -89,8 +450,39 @@ namespace NonMatching
     const ComponentMask &                   immersed_comps,
     const Mapping<dim1, spacedim> &         immersed_mapping)
   {
+    const CouplingPlan<dim0, dim1, spacedim> plan(cache,
+                                                  immersed_dh,
+                                                  quad,
+                                                  immersed_mapping);
+    check_all_points_found(plan);
+    create_coupling_sparsity_pattern(
+      plan, space_dh, sparsity, constraints, space_comps, immersed_comps);
+  }
+
+
+
+  template <int dim0,
+            int dim1,
+            int spacedim,
+            typename Sparsity,
+            typename number>
+  void
+  create_coupling_sparsity_pattern(
+    const CouplingPlan<dim0, dim1, spacedim> &plan,
+    const DoFHandler<dim0, spacedim> &        space_dh,
+    Sparsity &                                sparsity,
+    const AffineConstraints<number> &         constraints,
+    const ComponentMask &                     space_comps,
+    const ComponentMask &                     immersed_comps)
+  {
+    const auto &immersed_dh = plan.get_immersed_dof_handler();
+
     AssertDimension(sparsity.n_rows(), space_dh.n_dofs());
     AssertDimension(sparsity.n_cols(), immersed_dh.n_dofs());
+    Assert(&space_dh.get_triangulation() ==
+             &plan.get_cache().get_triangulation(),
+           ExcMessage("The space DoFHandler must be based on the "
+                      "triangulation of the cache of the CouplingPlan."));
     static_assert(dim1 <= dim0, "This function can only work if dim1 <= dim0");
     Assert((dynamic_cast<
               const parallel::distributed::Triangulation<dim1, spacedim> *>(
@@ -100,20 +492,10 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Now we run on ech cell, get a quadrature formula
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
-
     // Dof indices
     std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
     std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
 
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_fe,
-                                  quad,
-                                  update_quadrature_points);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -160,34 +542,30 @@ namespace NonMatching
     //        }
     //  }
 
-    for (; cell != endc; ++cell)
+    std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>
+                                           cells;
+    std::vector<std::vector<unsigned int>> points_per_cell;
+
+    for (const auto &cell : immersed_dh.active_cell_iterators())
       {
-        // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
         cell->get_dof_indices(dofs);
 
-        const std::vector<Point<spacedim>> &Xpoints =
-          fe_v.get_quadrature_points();
-
-        // Get a list of outer cells, qpoints and maps.
-        const auto  cpm   = GridTools::compute_point_locations(cache, Xpoints);
-        const auto &cells = std::get<0>(cpm);
+        // Get the locally owned outer cells around the quadrature points
+        group_points_by_space_cell(plan,
+                                   cell->active_cell_index(),
+                                   cells,
+                                   points_per_cell);
 
         for (unsigned int c = 0; c < cells.size(); ++c)
           {
-            // Get the ones in the current outer cell
-            typename DoFHandler<dim0, spacedim>::cell_iterator ocell(*cells[c],
-                                                                     &space_dh);
-            // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                ocell->get_dof_indices(odofs);
-                // [TODO]: When the following function will be implemented
-                // for the case of non-trivial dof_mask, we should
-                // uncomment the missing part.
-                constraints.add_entries_local_to_global(
-                  odofs, dofs, sparsity); //, true, dof_mask);
-              }
+            typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
+              *cells[c], &space_dh);
+            ocell->get_dof_indices(odofs);
+            // [TODO]: When the following function will be implemented
+            // for the case of non-trivial dof_mask, we should
+            // uncomment the missing part.
+            constraints.add_entries_local_to_global(
+              odofs, dofs, sparsity); //, true, dof_mask);
           }
       }
   }
@@ -235,8 +613,36 @@ namespace NonMatching
     const ComponentMask &                                 immersed_comps,
     const Mapping<dim1, spacedim> &                       immersed_mapping)
   {
+    const CouplingPlan<dim0, dim1, spacedim> plan(cache,
+                                                  immersed_dh,
+                                                  quad,
+                                                  immersed_mapping);
+    check_all_points_found(plan);
+    create_coupling_mass_matrix(
+      plan, space_dh, matrix, constraints, space_comps, immersed_comps);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim, typename Matrix>
+  void
+  create_coupling_mass_matrix(
+    const CouplingPlan<dim0, dim1, spacedim> &            plan,
+    const DoFHandler<dim0, spacedim> &                    space_dh,
+    Matrix &                                              matrix,
+    const AffineConstraints<typename Matrix::value_type> &constraints,
+    const ComponentMask &                                 space_comps,
+    const ComponentMask &                                 immersed_comps)
+  {
+    using number            = typename Matrix::value_type;
+    const auto &immersed_dh = plan.get_immersed_dof_handler();
+
     AssertDimension(matrix.m(), space_dh.n_dofs());
     AssertDimension(matrix.n(), immersed_dh.n_dofs());
+    Assert(&space_dh.get_triangulation() ==
+             &plan.get_cache().get_triangulation(),
+           ExcMessage("The space DoFHandler must be based on the "
+                      "triangulation of the cache of the CouplingPlan."));
     static_assert(dim1 <= dim0, "This function can only work if dim1 <= dim0");
     Assert((dynamic_cast<
               const parallel::distributed::Triangulation<dim1, spacedim> *>(
@@ -246,10 +652,6 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -276,92 +678,130 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().dofs_per_cell, immersed_dh.get_fe().dofs_per_cell);
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
-
-    // Now we run on ech cell, get a quadrature formula
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
+    // The shape functions of polynomial elements like FE_Q do not depend on
+    // the mapping, so we can evaluate them directly at the reference points
+    // stored in the plan. Otherwise, we need an FEValues object for every
+    // outer cell.
+    const bool use_reference_values =
+      FETools::has_mapping_independent_shape_values(space_fe);
+
+    auto worker =
+      [&](const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+          CouplingScratchData<dim0, dim1, spacedim> &scratch,
+          CouplingCopyData<number> &                 copy_data) {
+        // Get a list of locally owned outer cells and of the quadrature
+        // points in each of them
+        group_points_by_space_cell(plan,
+                                   cell->active_cell_index(),
+                                   scratch.space_cells,
+                                   scratch.points_per_cell);
+        copy_data.n_space_cells = scratch.space_cells.size();
+        if (copy_data.n_space_cells == 0)
+          return;
 
-    for (; cell != endc; ++cell)
-      {
         // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
+        const FEValues<dim1, spacedim> &fe_v = scratch.fe_values;
+        scratch.fe_values.reinit(cell);
+        copy_data.dofs.resize(immersed_fe.dofs_per_cell);
+        cell->get_dof_indices(copy_data.dofs);
 
-        const std::vector<Point<spacedim>> &Xpoints =
-          fe_v.get_quadrature_points();
-
-        // Get a list of outer cells, qpoints and maps.
-        const auto  cpm   = GridTools::compute_point_locations(cache, Xpoints);
-        const auto &cells = std::get<0>(cpm);
-        const auto &qpoints = std::get<1>(cpm);
-        const auto &maps    = std::get<2>(cpm);
+        if (copy_data.cell_matrices.size() < copy_data.n_space_cells)
+          {
+            copy_data.odofs.resize(copy_data.n_space_cells,
+                                   std::vector<types::global_dof_index>(
+                                     space_fe.dofs_per_cell));
+            copy_data.cell_matrices.resize(
+              copy_data.n_space_cells,
+              FullMatrix<number>(space_fe.dofs_per_cell,
+                                 immersed_fe.dofs_per_cell));
+          }
 
-        for (unsigned int c = 0; c < cells.size(); ++c)
+        for (unsigned int c = 0; c < copy_data.n_space_cells; ++c)
           {
-            // Get the ones in the current outer cell
             typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
-              *cells[c], &space_dh);
-            // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                const std::vector<Point<dim0>> & qps = qpoints[c];
-                const std::vector<unsigned int> &ids = maps[c];
+              *scratch.space_cells[c], &space_dh);
+            ocell->get_dof_indices(copy_data.odofs[c]);
 
-                FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
-                                                space_dh.get_fe(),
-                                                qps,
-                                                update_values);
-                o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
+            const std::vector<unsigned int> &ids = scratch.points_per_cell[c];
 
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
-
-                for (unsigned int i = 0; i < space_dh.get_fe().dofs_per_cell;
-                     ++i)
+            // Compute the values of the outer shape functions at the
+            // quadrature points in the outer cell
+            scratch.space_values.reinit(space_fe.dofs_per_cell, ids.size());
+            if (use_reference_values)
+              {
+                for (unsigned int oq = 0; oq < ids.size(); ++oq)
                   {
-                    const auto comp_i =
-                      space_dh.get_fe().system_to_component_index(i).first;
-                    if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
-                      for (unsigned int j = 0;
-                           j < immersed_dh.get_fe().dofs_per_cell;
-                           ++j)
-                        {
-                          const auto comp_j = immersed_dh.get_fe()
-                                                .system_to_component_index(j)
-                                                .first;
-                          if (space_gtl[comp_i] == immersed_gtl[comp_j])
-                            for (unsigned int oq = 0;
-                                 oq < o_fe_v.n_quadrature_points;
-                                 ++oq)
-                              {
-                                // Get the corresponding q point
-                                const unsigned int q = ids[oq];
-
-                                cell_matrix(i, j) +=
-                                  (fe_v.shape_value(j, q) *
-                                   o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
-                              }
-                        }
+                    const Point<dim0> &p =
+                      plan.get_reference_point(cell->active_cell_index(),
+                                               ids[oq]);
+                    for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                      scratch.space_values(i, oq) = space_fe.shape_value(i, p);
                   }
+              }
+            else
+              {
+                scratch.space_points.resize(ids.size());
+                for (unsigned int oq = 0; oq < ids.size(); ++oq)
+                  scratch.space_points[oq] =
+                    plan.get_reference_point(cell->active_cell_index(),
+                                             ids[oq]);
+                FEValues<dim0, spacedim> o_fe_v(plan.get_cache().get_mapping(),
+                                                space_fe,
+                                                scratch.space_points,
+                                                update_values);
+                o_fe_v.reinit(ocell);
+                for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                  for (unsigned int oq = 0; oq < ids.size(); ++oq)
+                    scratch.space_values(i, oq) = o_fe_v.shape_value(i, oq);
+              }
+
+            // Reset the matrices.
+            FullMatrix<number> &cell_matrix = copy_data.cell_matrices[c];
+            cell_matrix                     = number();
 
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
+            for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+              {
+                const auto comp_i = space_fe.system_to_component_index(i).first;
+                if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
+                  for (unsigned int j = 0; j < immersed_fe.dofs_per_cell; ++j)
+                    {
+                      const auto comp_j =
+                        immersed_fe.system_to_component_index(j).first;
+                      if (space_gtl[comp_i] == immersed_gtl[comp_j])
+                        for (unsigned int oq = 0; oq < ids.size(); ++oq)
+                          {
+                            // Get the corresponding q point
+                            const unsigned int q = ids[oq];
+
+                            cell_matrix(i, j) +=
+                              (fe_v.shape_value(j, q) *
+                               scratch.space_values(i, oq) * fe_v.JxW(q));
+                          }
+                    }
               }
           }
-      }
+      };
+
+    // Now assemble the matrices
+    auto copier = [&](const CouplingCopyData<number> &copy_data) {
+      for (unsigned int c = 0; c < copy_data.n_space_cells; ++c)
+        constraints.distribute_local_to_global(copy_data.cell_matrices[c],
+                                               copy_data.odofs[c],
+                                               copy_data.dofs,
+                                               matrix);
+    };
+
+    CouplingScratchData<dim0, dim1, spacedim> scratch(
+      plan.get_immersed_mapping(), immersed_fe, plan.get_quadrature());
+    CouplingCopyData<number> copy_data;
+    copy_data.n_space_cells = 0;
+
+    WorkStream::run(immersed_dh.begin_active(),
+                    immersed_dh.end(),
+                    worker,
+                    copier,
+                    scratch,
+                    copy_data);
   }
 
 #include "coupling.inst"
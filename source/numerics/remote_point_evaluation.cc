@@ -0,0 +1,462 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/config.h>
+
+// include boost.geometry before any other header pulls in boost's concept
+// checks, see the comment in grid_tools_cache.cc
+DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/boost_adaptors/bounding_box.h>
+
+#include <boost/geometry/index/rtree.hpp>
+DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_vector.h>
+#include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/trilinos_parallel_block_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/remote_point_evaluation.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation()
+  : communicator(MPI_COMM_SELF)
+{}
+
+
+
+template <int dim, int spacedim>
+void
+RemotePointEvaluation<dim, spacedim>::reinit(
+  const std::vector<Point<spacedim>> &points,
+  const Triangulation<dim, spacedim> &tria,
+  const Mapping<dim, spacedim> &      mapping)
+{
+  this->triangulation = &tria;
+  this->mapping       = &mapping;
+
+  communicator = MPI_COMM_SELF;
+  if (const parallel::Triangulation<dim, spacedim> *parallel_tria =
+        dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&tria))
+    communicator = parallel_tria->get_communicator();
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+
+  // Step 1: decide which processes might own each point. On a serial
+  // triangulation, or if there is only one process, this is the current
+  // process, otherwise all processes whose locally owned part of the mesh
+  // has a bounding box that contains the point. the points for each rank
+  // are kept in increasing order of their index
+  std::map<unsigned int, std::vector<unsigned int>> requested_indices;
+  if (Utilities::MPI::n_mpi_processes(communicator) == 1)
+    {
+      std::vector<unsigned int> &indices = requested_indices[my_rank];
+      indices.resize(points.size());
+      for (unsigned int i = 0; i < points.size(); ++i)
+        indices[i] = i;
+    }
+  else
+    {
+#ifdef DEAL_II_WITH_MPI
+      std::function<bool(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator &)>
+        predicate = IteratorFilters::LocallyOwnedCell();
+      const std::vector<BoundingBox<spacedim>> local_boxes =
+        GridTools::compute_mesh_predicate_bounding_box(tria,
+                                                       predicate,
+                                                       1,
+                                                       true);
+      const std::vector<std::vector<BoundingBox<spacedim>>> global_boxes =
+        GridTools::exchange_local_bounding_boxes(local_boxes, communicator);
+
+      // put the boxes of all processes into an R-tree, so that the processes
+      // whose boxes contain a point are found in logarithmic rather than
+      // linear time in the number of processes. the boxes are slightly
+      // enlarged to catch points on their boundary despite round-off
+      using BoxAndRank = std::pair<BoundingBox<spacedim>, unsigned int>;
+      std::vector<BoxAndRank> boxes_and_ranks;
+      for (unsigned int rank = 0; rank < global_boxes.size(); ++rank)
+        for (const BoundingBox<spacedim> &box : global_boxes[rank])
+          {
+            Point<spacedim> lower  = box.get_boundary_points().first;
+            Point<spacedim> upper  = box.get_boundary_points().second;
+            double          extent = 0.;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              extent = std::max(extent, upper[d] - lower[d]);
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                lower[d] -= 1e-10 * extent;
+                upper[d] += 1e-10 * extent;
+              }
+            boxes_and_ranks.emplace_back(
+              BoundingBox<spacedim>(std::make_pair(lower, upper)), rank);
+          }
+      const boost::geometry::index::rtree<BoxAndRank,
+                                          boost::geometry::index::rstar<16>>
+        rtree(boxes_and_ranks.begin(), boxes_and_ranks.end());
+
+      std::vector<unsigned int> ranks;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          ranks.clear();
+          for (auto entry =
+                 rtree.qbegin(boost::geometry::index::intersects(points[i]));
+               entry != rtree.qend();
+               ++entry)
+            ranks.push_back(entry->second);
+
+          // a point may lie in several boxes of the same process
+          std::sort(ranks.begin(), ranks.end());
+          ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+          for (const unsigned int rank : ranks)
+            requested_indices[rank].push_back(i);
+        }
+#else
+      Assert(false, ExcInternalError());
+#endif
+    }
+
+  // Step 2: send the points to the processes that might own them. the
+  // points the current process might own itself are not communicated
+  std::map<unsigned int, std::vector<Point<spacedim>>> requested_points;
+  for (const auto &rank_and_indices : requested_indices)
+    {
+      std::vector<Point<spacedim>> &rank_points =
+        requested_points[rank_and_indices.first];
+      for (const unsigned int i : rank_and_indices.second)
+        rank_points.push_back(points[i]);
+    }
+
+  std::map<unsigned int, std::vector<Point<spacedim>>> received_points;
+  if (requested_points.find(my_rank) != requested_points.end())
+    {
+      received_points[my_rank].swap(requested_points[my_rank]);
+      requested_points.erase(my_rank);
+    }
+  if (Utilities::MPI::n_mpi_processes(communicator) > 1)
+    {
+      const std::map<unsigned int, std::vector<Point<spacedim>>> other_points =
+        Utilities::MPI::some_to_some(communicator, requested_points);
+      received_points.insert(other_points.begin(), other_points.end());
+    }
+
+  // Step 3: find the points in the locally owned cells. for each rank, the
+  // points found are numbered in the order in which they were received,
+  // which determines their position in the buffer sent in evaluate()
+  const GridTools::Cache<dim, spacedim> cache(tria, mapping);
+
+  cells.clear();
+  reference_points.clear();
+  send_positions.clear();
+  send_ranks.clear();
+  send_offsets.assign(1, 0);
+
+  std::unordered_map<unsigned int, unsigned int> cell_to_index;
+  std::map<unsigned int, std::vector<unsigned int>> found_indices;
+  for (const auto &rank_and_points : received_points)
+    {
+      const auto cells_and_positions =
+        GridTools::find_active_cells_around_points(cache,
+                                                   rank_and_points.second);
+
+      std::vector<unsigned int> &rank_found =
+        found_indices[rank_and_points.first];
+      for (unsigned int p = 0; p < cells_and_positions.size(); ++p)
+        {
+          const auto &cell = cells_and_positions[p].first;
+          if (cell.state() != IteratorState::valid ||
+              cell->is_locally_owned() == false)
+            continue;
+
+          const auto index =
+            cell_to_index.emplace(cell->active_cell_index(), cells.size());
+          if (index.second == true)
+            {
+              cells.push_back(cell);
+              reference_points.emplace_back();
+              send_positions.emplace_back();
+            }
+          reference_points[index.first->second].push_back(
+            cells_and_positions[p].second);
+          send_positions[index.first->second].push_back(send_offsets.back() +
+                                                        rank_found.size());
+          rank_found.push_back(p);
+        }
+
+      if (rank_found.size() > 0)
+        {
+          send_ranks.push_back(rank_and_points.first);
+          send_offsets.push_back(send_offsets.back() + rank_found.size());
+        }
+    }
+
+  // Step 4: tell the requesting processes which of their points were found
+  std::map<unsigned int, std::vector<unsigned int>> answers;
+  for (auto &rank_and_found : found_indices)
+    if (rank_and_found.first != my_rank && rank_and_found.second.size() > 0)
+      answers[rank_and_found.first].swap(rank_and_found.second);
+
+  std::map<unsigned int, std::vector<unsigned int>> received_answers;
+  if (found_indices.find(my_rank) != found_indices.end() &&
+      found_indices[my_rank].size() > 0)
+    received_answers[my_rank].swap(found_indices[my_rank]);
+  if (Utilities::MPI::n_mpi_processes(communicator) > 1)
+    {
+      const std::map<unsigned int, std::vector<unsigned int>> other_answers =
+        Utilities::MPI::some_to_some(communicator, answers);
+      received_answers.insert(other_answers.begin(), other_answers.end());
+    }
+
+  // Step 5: set up the receive side. the answers arrive in increasing order
+  // of the ranks, so a point found on several processes is taken from the
+  // process with the lowest rank
+  found.assign(points.size(), false);
+  receive_ranks.clear();
+  receive_offsets.assign(1, 0);
+  receive_point_indices.clear();
+  for (const auto &rank_and_answer : received_answers)
+    {
+      const std::vector<unsigned int> &indices =
+        requested_indices[rank_and_answer.first];
+      for (const unsigned int j : rank_and_answer.second)
+        {
+          AssertIndexRange(j, indices.size());
+          const unsigned int i = indices[j];
+          if (found[i] == false)
+            {
+              found[i] = true;
+              receive_point_indices.push_back(i);
+            }
+          else
+            receive_point_indices.push_back(numbers::invalid_unsigned_int);
+        }
+      receive_ranks.push_back(rank_and_answer.first);
+      receive_offsets.push_back(receive_point_indices.size());
+    }
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+RemotePointEvaluation<dim, spacedim>::evaluate(
+  const DoFHandler<dim, spacedim> &                     dof_handler,
+  const VectorType &                                    vector,
+  std::vector<Vector<typename VectorType::value_type>> &values) const
+{
+  using Number = typename VectorType::value_type;
+
+  Assert(triangulation != nullptr,
+         ExcMessage("The object has not been initialized with reinit()."));
+  Assert(&dof_handler.get_triangulation() == &*triangulation,
+         ExcMessage("The DoFHandler must be based on the triangulation that "
+                    "was given to reinit()."));
+
+  const unsigned int n_components = dof_handler.get_fe().n_components();
+
+  // evaluate the points on the locally owned cells, in parallel over the
+  // cells, and write the values to their position in the send buffer
+  std::vector<Number> send_values(send_offsets.back() * n_components);
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(cells.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      std::vector<Vector<Number>> cell_values;
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator
+            dof_cell(&*triangulation,
+                     cells[c]->level(),
+                     cells[c]->index(),
+                     &dof_handler);
+          FEValues<dim, spacedim> fe_values(*mapping,
+                                            dof_handler.get_fe(),
+                                            Quadrature<dim>(
+                                              reference_points[c]),
+                                            update_values);
+          fe_values.reinit(dof_cell);
+
+          cell_values.resize(reference_points[c].size(),
+                             Vector<Number>(n_components));
+          fe_values.get_function_values(vector, cell_values);
+          for (unsigned int q = 0; q < cell_values.size(); ++q)
+            for (unsigned int d = 0; d < n_components; ++d)
+              send_values[send_positions[c][q] * n_components + d] =
+                cell_values[q][d];
+        }
+    },
+    16);
+
+  std::vector<Number> receive_values(receive_offsets.back() * n_components);
+  std::vector<char>   send_buffer(send_values.size() * sizeof(Number));
+  std::vector<char>   receive_buffer(receive_values.size() * sizeof(Number));
+  if (send_values.size() > 0)
+    std::memcpy(send_buffer.data(), send_values.data(), send_buffer.size());
+  exchange(send_buffer, receive_buffer, n_components * sizeof(Number));
+  if (receive_values.size() > 0)
+    std::memcpy(receive_values.data(),
+                receive_buffer.data(),
+                receive_buffer.size());
+
+  values.resize(found.size());
+  for (Vector<Number> &value : values)
+    value.reinit(n_components);
+  for (unsigned int i = 0; i < receive_point_indices.size(); ++i)
+    if (receive_point_indices[i] != numbers::invalid_unsigned_int)
+      for (unsigned int d = 0; d < n_components; ++d)
+        values[receive_point_indices[i]][d] =
+          receive_values[i * n_components + d];
+}
+
+
+
+template <int dim, int spacedim>
+void
+RemotePointEvaluation<dim, spacedim>::exchange(
+  const std::vector<char> &send_buffer,
+  std::vector<char> &      receive_buffer,
+  const unsigned int       bytes_per_point) const
+{
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+
+  // the values the current process computed for itself are copied
+  for (unsigned int r = 0; r < send_ranks.size(); ++r)
+    if (send_ranks[r] == my_rank)
+      {
+        const unsigned int receive_index =
+          std::lower_bound(receive_ranks.begin(),
+                           receive_ranks.end(),
+                           my_rank) -
+          receive_ranks.begin();
+        Assert(receive_index < receive_ranks.size() &&
+                 receive_offsets[receive_index + 1] -
+                     receive_offsets[receive_index] ==
+                   send_offsets[r + 1] - send_offsets[r],
+               ExcInternalError());
+        std::memcpy(receive_buffer.data() +
+                      receive_offsets[receive_index] * bytes_per_point,
+                    send_buffer.data() + send_offsets[r] * bytes_per_point,
+                    (send_offsets[r + 1] - send_offsets[r]) * bytes_per_point);
+      }
+
+#ifdef DEAL_II_WITH_MPI
+  if (Utilities::MPI::n_mpi_processes(communicator) == 1)
+    return;
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(send_ranks.size() + receive_ranks.size());
+  for (unsigned int r = 0; r < receive_ranks.size(); ++r)
+    if (receive_ranks[r] != my_rank)
+      {
+        requests.emplace_back();
+        const int ierr =
+          MPI_Irecv(receive_buffer.data() +
+                      receive_offsets[r] * bytes_per_point,
+                    (receive_offsets[r + 1] - receive_offsets[r]) *
+                      bytes_per_point,
+                    MPI_BYTE,
+                    receive_ranks[r],
+                    22,
+                    communicator,
+                    &requests.back());
+        AssertThrowMPI(ierr);
+      }
+
+  for (unsigned int r = 0; r < send_ranks.size(); ++r)
+    if (send_ranks[r] != my_rank)
+      {
+        requests.emplace_back();
+        const int ierr =
+          MPI_Isend(const_cast<char *>(send_buffer.data()) +
+                      send_offsets[r] * bytes_per_point,
+                    (send_offsets[r + 1] - send_offsets[r]) * bytes_per_point,
+                    MPI_BYTE,
+                    send_ranks[r],
+                    22,
+                    communicator,
+                    &requests.back());
+        AssertThrowMPI(ierr);
+      }
+
+  if (requests.size() > 0)
+    {
+      const int ierr =
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+bool
+RemotePointEvaluation<dim, spacedim>::point_found(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, found.size());
+  return found[point_index];
+}
+
+
+
+template <int dim, int spacedim>
+bool
+RemotePointEvaluation<dim, spacedim>::all_points_found() const
+{
+  return std::find(found.begin(), found.end(), false) == found.end();
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+RemotePointEvaluation<dim, spacedim>::n_evaluation_points() const
+{
+  return send_offsets.empty() ? 0 : send_offsets.back();
+}
+
+
+// explicit instantiations
+#include "remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
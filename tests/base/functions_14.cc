@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test Function::value() for points of VectorizedArray type: the result in
+// each lane must be the value of the function at the point in that lane, both
+// for the functions that evaluate all lanes at once and for the default
+// implementation that calls value() for each lane
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename Number>
+void
+check(const Function<dim> &function, const std::string &name)
+{
+  const unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+
+  double error = 0;
+  for (unsigned int i = 0; i < 10; ++i)
+    {
+      Point<dim, VectorizedArray<Number>> p;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int d = 0; d < dim; ++d)
+          p[d][v] = 0.1 * (i + 1) - 0.13 * v + 0.07 * d;
+
+      const VectorizedArray<Number> values = function.value(p);
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          Point<dim> point;
+          for (unsigned int d = 0; d < dim; ++d)
+            point[d] = p[d][v];
+          error = std::max(error, std::abs(values[v] - function.value(point)));
+        }
+    }
+
+  const bool is_double = (sizeof(Number) == sizeof(double));
+  deallog << name << (is_double ? " double" : " float")
+          << " correct: " << (error < (is_double ? 1e-14 : 1e-6)) << std::endl;
+}
+
+
+
+template <int dim>
+double
+quadratic(const Point<dim> &p)
+{
+  return p.square() + p[0];
+}
+
+
+
+template <int dim>
+void
+check_all()
+{
+  deallog.push(std::to_string(dim) + "d");
+
+  Tensor<1, dim> coefficients;
+  for (unsigned int d = 0; d < dim; ++d)
+    coefficients[d] = 1. + d;
+
+  check<dim, double>(Functions::ConstantFunction<dim>(2.5), "Constant");
+  check<dim, double>(Functions::SquareFunction<dim>(), "Square");
+  if (dim > 1)
+    check<dim, double>(Functions::Q1WedgeFunction<dim>(), "Q1Wedge");
+  check<dim, double>(Functions::PillowFunction<dim>(0.5), "Pillow");
+  check<dim, double>(Functions::CosineFunction<dim>(), "Cosine");
+  check<dim, double>(Functions::ExpFunction<dim>(), "Exp");
+  check<dim, double>(Functions::FourierCosineFunction<dim>(coefficients),
+                     "FourierCosine");
+  check<dim, double>(Functions::FourierSineFunction<dim>(coefficients),
+                     "FourierSine");
+  check<dim, double>(ScalarFunctionFromFunctionObject<dim>(&quadratic<dim>),
+                     "FunctionObject");
+
+  check<dim, float>(Functions::ConstantFunction<dim>(2.5), "Constant");
+  check<dim, float>(Functions::CosineFunction<dim>(), "Cosine");
+  check<dim, float>(Functions::FourierSineFunction<dim>(coefficients),
+                    "FourierSine");
+  check<dim, float>(ScalarFunctionFromFunctionObject<dim>(&quadratic<dim>),
+                    "FunctionObject");
+
+  // the derived classes make the function visible with a using declaration
+  Functions::CosineFunction<dim>      cosine;
+  Point<dim, VectorizedArray<double>> p;
+  for (unsigned int d = 0; d < dim; ++d)
+    p[d] = 0.3;
+  deallog << "Cosine through derived class: " << cosine.value(p)[0]
+          << std::endl;
+
+  deallog.pop();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check_all<1>();
+  check_all<2>();
+  check_all<3>();
+}
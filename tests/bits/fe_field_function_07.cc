@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test the evaluation of FEFieldFunction at many points with locations that
+// are computed once and reused, also after the solution vector has changed,
+// and check that the result does not depend on the number of threads
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/fe_field_function.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// a quadratic function that is represented exactly by FE_Q(2)
+template <int dim>
+class Quadratic : public Function<dim>
+{
+public:
+  Quadratic()
+    : Function<dim>(2)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    if (component == 0)
+      return p[0] * p[0] + p[dim - 1];
+    else
+      return p[0] * p[dim - 1] - 1.;
+  }
+
+  virtual Tensor<1, dim>
+  gradient(const Point<dim> &p, const unsigned int component) const override
+  {
+    Tensor<1, dim> grad;
+    if (component == 0)
+      {
+        grad[0] += 2. * p[0];
+        grad[dim - 1] += 1.;
+      }
+    else
+      {
+        grad[0] += p[dim - 1];
+        grad[dim - 1] += p[0];
+      }
+    return grad;
+  }
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(4 - dim / 2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FESystem<dim>   fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Quadratic<dim> function;
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, function, solution);
+
+  std::vector<Point<dim>> points(5000);
+  for (auto &point : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      point[d] = 2. * random_value<double>() - 1.;
+
+  Functions::FEFieldFunction<dim> fe_function(dof_handler, solution);
+  const auto locations = fe_function.compute_point_locations(points);
+  deallog << "Points: " << locations.n_points
+          << ", cells: " << locations.cells.size() << std::endl;
+
+  std::vector<Vector<double>> values(points.size(), Vector<double>(2));
+  std::vector<std::vector<Tensor<1, dim>>> gradients(
+    points.size(), std::vector<Tensor<1, dim>>(2));
+  fe_function.vector_value_list(locations, values);
+  fe_function.vector_gradient_list(locations, gradients);
+
+  double value_error = 0, gradient_error = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    for (unsigned int c = 0; c < 2; ++c)
+      {
+        value_error = std::max(value_error,
+                               std::abs(values[i][c] -
+                                        function.value(points[i], c)));
+        gradient_error =
+          std::max(gradient_error,
+                   (gradients[i][c] - function.gradient(points[i], c)).norm());
+      }
+  deallog << "Values exact: " << (value_error < 1e-12)
+          << ", gradients exact: " << (gradient_error < 1e-12) << std::endl;
+
+  // the locations remain valid when the vector changes, and the result does
+  // not depend on the number of threads
+  solution *= 2.;
+  std::vector<double> component_values(points.size());
+  MultithreadInfo::set_thread_limit(1);
+  fe_function.value_list(locations, component_values, 1);
+  std::vector<double> threaded_values(points.size());
+  MultithreadInfo::set_thread_limit(4);
+  fe_function.value_list(locations, threaded_values, 1);
+  MultithreadInfo::set_thread_limit();
+
+  double scaled_error = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    scaled_error = std::max(
+      scaled_error,
+      std::abs(component_values[i] - 2. * function.value(points[i], 1)));
+  deallog << "Values exact after update: " << (scaled_error < 1e-12)
+          << std::endl;
+  deallog << "Same with threads: " << (component_values == threaded_values)
+          << std::endl;
+
+  // and the list version agrees with the evaluation at single points
+  std::vector<double> list_values(10);
+  fe_function.value_list(std::vector<Point<dim>>(points.begin(),
+                                                 points.begin() + 10),
+                         list_values);
+  double single_error = 0;
+  for (unsigned int i = 0; i < 10; ++i)
+    single_error =
+      std::max(single_error,
+               std::abs(list_values[i] - fe_function.value(points[i])));
+  deallog << "Same as single points: " << (single_error < 1e-12)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
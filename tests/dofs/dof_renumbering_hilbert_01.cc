@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Cuthill_McKee and component_wise work on chunks of the degrees of freedom
+// in parallel. check that they give the same numbering independent of the
+// number of threads, and that the new DoFRenumbering::hilbert() gives a
+// valid numbering that keeps the entries of the matrix close to the
+// diagonal on a mesh that is numbered badly to begin with
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+// return the bandwidth and the average distance of the entries of the
+// sparsity pattern from the diagonal
+template <int dim>
+std::pair<types::global_dof_index, double>
+bandwidth(const DoFHandler<dim> &dof_handler)
+{
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  types::global_dof_index max_distance = 0;
+  double                  sum_distance = 0;
+  for (types::global_dof_index row = 0; row < dsp.n_rows(); ++row)
+    for (auto entry = dsp.begin(row); entry != dsp.end(row); ++entry)
+      {
+        const types::global_dof_index distance =
+          (row > entry->column() ? row - entry->column() :
+                                   entry->column() - row);
+        max_distance = std::max(max_distance, distance);
+        sum_distance += distance;
+      }
+  return std::make_pair(max_distance, sum_distance / dsp.n_nonzero_elements());
+}
+
+
+
+template <int dim>
+std::vector<types::global_dof_index>
+all_dof_indices(const DoFHandler<dim> &dof_handler)
+{
+  std::vector<types::global_dof_index> indices;
+  std::vector<types::global_dof_index> local_dof_indices(
+    dof_handler.get_fe().dofs_per_cell);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(local_dof_indices);
+      indices.insert(indices.end(),
+                     local_dof_indices.begin(),
+                     local_dof_indices.end());
+    }
+  return indices;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.refine_global(6 - dim);
+  GridTools::distort_random(0.1, tria, false);
+
+  FESystem<dim>   fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  // start with a bad numbering to make the effect of the renumbering
+  // visible
+  DoFRenumbering::random(dof_handler);
+  const std::vector<types::global_dof_index> initial_indices =
+    all_dof_indices(dof_handler);
+  const double random_distance = bandwidth(dof_handler).second;
+  deallog << "Number of dofs: " << dof_handler.n_dofs() << std::endl;
+
+  std::vector<types::global_dof_index> serial_indices[2], threaded_indices[2];
+  for (unsigned int n_threads = 1; n_threads <= 4; n_threads += 3)
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      std::vector<types::global_dof_index>(&indices)[2] =
+        (n_threads == 1 ? serial_indices : threaded_indices);
+
+      DoFRenumbering::Cuthill_McKee(dof_handler);
+      indices[0] = all_dof_indices(dof_handler);
+      if (n_threads == 1)
+        deallog << "Bandwidth Cuthill_McKee: " << bandwidth(dof_handler).first
+                << std::endl;
+
+      DoFRenumbering::component_wise(dof_handler);
+      indices[1] = all_dof_indices(dof_handler);
+
+      // go back to the initial numbering
+      std::vector<types::global_dof_index> renumbering(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < indices[1].size(); ++i)
+        renumbering[indices[1][i]] = initial_indices[i];
+      dof_handler.renumber_dofs(renumbering);
+    }
+  MultithreadInfo::set_thread_limit();
+  deallog << "Same Cuthill_McKee: "
+          << (serial_indices[0] == threaded_indices[0]) << std::endl;
+  deallog << "Same component_wise: "
+          << (serial_indices[1] == threaded_indices[1]) << std::endl;
+
+  DoFRenumbering::hilbert(dof_handler);
+  std::vector<types::global_dof_index> hilbert_indices =
+    all_dof_indices(dof_handler);
+  std::sort(hilbert_indices.begin(), hilbert_indices.end());
+  hilbert_indices.erase(std::unique(hilbert_indices.begin(),
+                                    hilbert_indices.end()),
+                        hilbert_indices.end());
+  deallog << "Hilbert numbering complete: "
+          << (hilbert_indices.size() == dof_handler.n_dofs() &&
+              hilbert_indices.back() == dof_handler.n_dofs() - 1)
+          << ", distance reduced: "
+          << (bandwidth(dof_handler).second < random_distance / 5)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that DoFTools::make_exact_sparsity_pattern() creates the same
+// pattern as DoFTools::make_sparsity_pattern() with a
+// DynamicSparsityPattern, with hanging node and boundary constraints and
+// for hp::DoFHandler objects
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <typename DoFHandlerType>
+void
+check(const DoFHandlerType &dof)
+{
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  VectorTools::interpolate_boundary_values(
+    dof,
+    0,
+    Functions::ZeroFunction<DoFHandlerType::space_dimension>(
+      dof.get_fe(0).n_components()),
+    constraints);
+  constraints.close();
+
+  for (const bool keep_constrained_dofs : {true, false})
+    {
+      DynamicSparsityPattern dsp(dof.n_dofs());
+      DoFTools::make_sparsity_pattern(dof,
+                                      dsp,
+                                      constraints,
+                                      keep_constrained_dofs);
+      SparsityPattern reference;
+      reference.copy_from(dsp);
+
+      SparsityPattern sparsity;
+      DoFTools::make_exact_sparsity_pattern(dof,
+                                            sparsity,
+                                            constraints,
+                                            keep_constrained_dofs);
+
+      deallog << "keep constrained dofs: " << keep_constrained_dofs << ", "
+              << sparsity.n_nonzero_elements() << " entries, compressed "
+              << sparsity.is_compressed()
+              << ", identical: " << (sparsity == reference) << std::endl;
+    }
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center().norm() < 0.5)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(FESystem<dim>(FE_Q<dim>(2), 2, FE_Q<dim>(1), 1));
+  deallog << dof.n_dofs() << " dofs" << std::endl;
+  check(dof);
+
+  hp::FECollection<dim> fe;
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    fe.push_back(FE_Q<dim>(degree));
+  hp::DoFHandler<dim> hp_dof(tria);
+  for (const auto &cell : hp_dof.active_cell_iterators())
+    cell->set_active_fe_index(cell->index() % fe.size());
+  hp_dof.distribute_dofs(fe);
+  deallog << "hp: " << hp_dof.n_dofs() << " dofs" << std::endl;
+  check(hp_dof);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// create the descriptions of the partitions of a serial mesh for
+// parallel::fullydistributed::Triangulation, and check that they survive
+// writing them to a file and reading them back
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+bool
+is_same(const parallel::fullydistributed::CellData<dim> &a,
+        const parallel::fullydistributed::CellData<dim> &b)
+{
+  return a.id == b.id && a.subdomain_id == b.subdomain_id &&
+         a.manifold_id == b.manifold_id &&
+         a.manifold_line_ids == b.manifold_line_ids &&
+         a.manifold_quad_ids == b.manifold_quad_ids &&
+         a.boundary_ids == b.boundary_ids;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  // partition the mesh into the 2^dim corners of the cube
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      types::subdomain_id subdomain = 0;
+      for (unsigned int d = 0; d < dim; ++d)
+        if (cell->center()[d] > 0.5)
+          subdomain += 1 << d;
+      cell->set_subdomain_id(subdomain);
+    }
+
+  for (unsigned int subdomain = 0; subdomain < (1u << dim); ++subdomain)
+    {
+      const parallel::fullydistributed::ConstructionData<dim> data =
+        parallel::fullydistributed::create_construction_data_from_triangulation(
+          tria, subdomain);
+
+      unsigned int n_owned = 0, n_ghost = 0;
+      deallog << dim << "d subdomain " << subdomain << ": coarse cells "
+              << data.coarse_cells.size() << ", coarse vertices "
+              << data.coarse_cell_vertices.size() << ", cells per level";
+      for (const auto &level_cell_infos : data.cell_infos)
+        {
+          deallog << ' ' << level_cell_infos.size();
+          for (const auto &cell_info : level_cell_infos)
+            if (cell_info.subdomain_id == subdomain)
+              ++n_owned;
+            else if (cell_info.subdomain_id !=
+                     numbers::artificial_subdomain_id)
+              ++n_ghost;
+        }
+      deallog << ", owned " << n_owned << ", ghosts " << n_ghost << std::endl;
+
+      parallel::fullydistributed::save_construction_data(data,
+                                                         "construction_data");
+      parallel::fullydistributed::ConstructionData<dim> loaded_data;
+      parallel::fullydistributed::load_construction_data("construction_data",
+                                                         loaded_data);
+
+      bool same =
+        (data.coarse_cells.size() == loaded_data.coarse_cells.size()) &&
+        (data.coarse_cell_vertices == loaded_data.coarse_cell_vertices) &&
+        (data.coarse_cell_index_to_coarse_cell_id ==
+         loaded_data.coarse_cell_index_to_coarse_cell_id) &&
+        (data.cell_infos.size() == loaded_data.cell_infos.size());
+      for (unsigned int l = 0; same && l < data.cell_infos.size(); ++l)
+        {
+          same =
+            (data.cell_infos[l].size() == loaded_data.cell_infos[l].size());
+          for (unsigned int c = 0; same && c < data.cell_infos[l].size(); ++c)
+            same = is_same(data.cell_infos[l][c], loaded_data.cell_infos[l][c]);
+        }
+      for (unsigned int c = 0; same && c < data.coarse_cells.size(); ++c)
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          same = same && (data.coarse_cells[c].vertices[v] ==
+                          loaded_data.coarse_cells[c].vertices[v]);
+      deallog << "Round trip through file: " << (same ? "OK" : "failed")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
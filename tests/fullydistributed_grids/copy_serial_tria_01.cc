@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// partition an adaptively refined serial mesh, set up a
+// parallel::fullydistributed::Triangulation on each processor from the
+// description of its partition read from a file, and distribute degrees of
+// freedom on it
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+
+  Triangulation<dim> serial_tria;
+  GridGenerator::hyper_cube(serial_tria);
+  serial_tria.refine_global(dim == 2 ? 2 : 1);
+  serial_tria.begin_active()->set_refine_flag();
+  serial_tria.execute_coarsening_and_refinement();
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), serial_tria);
+
+  const std::string filename =
+    "construction_data_" + Utilities::int_to_string(dim) + "d_" +
+    Utilities::int_to_string(my_rank);
+  parallel::fullydistributed::save_construction_data(
+    parallel::fullydistributed::create_construction_data_from_triangulation(
+      serial_tria, my_rank),
+    filename);
+
+  parallel::fullydistributed::ConstructionData<dim> construction_data;
+  parallel::fullydistributed::load_construction_data(filename,
+                                                     construction_data);
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(construction_data);
+
+  // the locally owned cells must be the ones of the partition
+  unsigned int n_wrong_cells = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned() &&
+        cell->id().to_cell(serial_tria)->subdomain_id() != my_rank)
+      ++n_wrong_cells;
+
+  deallog << "n_global_active_cells: " << tria.n_global_active_cells()
+          << std::endl;
+  deallog << "has_hanging_nodes: " << tria.has_hanging_nodes() << std::endl;
+  deallog << "wrongly owned cells: " << Utilities::MPI::sum(n_wrong_cells, comm)
+          << std::endl;
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  deallog << "n_dofs: " << dof_handler.n_dofs() << std::endl;
+  deallog << "sum of n_locally_owned_dofs: "
+          << Utilities::MPI::sum(dof_handler.n_locally_owned_dofs(), comm)
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPILogInitAll all;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
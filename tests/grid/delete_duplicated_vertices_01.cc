@@ -0,0 +1,188 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test GridTools::delete_duplicated_vertices: stitch a mesh from blocks
+// whose vertices on common faces are duplicated (with some noise below the
+// tolerance), and compare with a straightforward quadratic search on a point
+// cloud with clusters of nearby points
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+// the algorithm the function used to implement: compare each vertex that has
+// not been identified with another one yet with all later vertices
+template <int dim>
+void
+reference_delete_duplicated_vertices(std::vector<Point<dim>> &   vertices,
+                                     std::vector<CellData<dim>> &cells,
+                                     const double                tol)
+{
+  std::vector<unsigned int> new_vertex_numbers(vertices.size());
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    new_vertex_numbers[i] = i;
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    {
+      if (new_vertex_numbers[i] != i)
+        continue;
+      for (unsigned int j = i + 1; j < vertices.size(); ++j)
+        {
+          bool equal = true;
+          for (unsigned int d = 0; d < dim; ++d)
+            equal &= (std::abs(vertices[j][d] - vertices[i][d]) < tol);
+          if (equal)
+            new_vertex_numbers[j] = i;
+        }
+    }
+  for (auto &cell : cells)
+    for (auto &vertex_index : cell.vertices)
+      vertex_index = new_vertex_numbers[vertex_index];
+  SubCellData subcelldata;
+  GridTools::delete_unused_vertices(vertices, cells, subcelldata);
+}
+
+
+
+template <int dim>
+void
+test_blocks()
+{
+  const unsigned int      n_blocks = 3, n_subdivisions = 2;
+  std::vector<Point<dim>> vertices;
+  std::vector<CellData<dim>> cells;
+
+  const unsigned int n_per_direction = n_subdivisions + 1;
+  unsigned int       n_block_vertices = 1;
+  for (unsigned int d = 0; d < dim; ++d)
+    n_block_vertices *= n_per_direction;
+
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const unsigned int offset = vertices.size();
+      for (unsigned int v = 0; v < n_block_vertices; ++v)
+        {
+          Point<dim> p;
+          for (unsigned int d = 0, code = v; d < dim;
+               ++d, code /= n_per_direction)
+            p[d] = 1. * (code % n_per_direction) / n_subdivisions;
+          p[0] += b;
+          p[dim - 1] += 1e-14 * random_value<double>();
+          vertices.push_back(p);
+        }
+
+      unsigned int n_block_cells = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        n_block_cells *= n_subdivisions;
+      for (unsigned int c = 0; c < n_block_cells; ++c)
+        {
+          unsigned int lower_left = 0, stride = 1;
+          for (unsigned int d = 0, code = c; d < dim;
+               ++d, code /= n_subdivisions, stride *= n_per_direction)
+            lower_left += (code % n_subdivisions) * stride;
+
+          CellData<dim> cell;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              unsigned int index = lower_left;
+              stride             = 1;
+              for (unsigned int d = 0; d < dim; ++d, stride *= n_per_direction)
+                if (v & (1 << d))
+                  index += stride;
+              cell.vertices[v] = offset + index;
+            }
+          cells.push_back(cell);
+        }
+    }
+
+  SubCellData               subcelldata;
+  std::vector<unsigned int> considered_vertices;
+  GridTools::delete_duplicated_vertices(
+    vertices, cells, subcelldata, considered_vertices, 1e-12);
+
+  deallog << dim << "d blocks: " << vertices.size() << " vertices"
+          << std::endl;
+
+  Triangulation<dim> tria;
+  tria.create_triangulation(vertices, cells, subcelldata);
+  deallog << dim << "d blocks: " << tria.n_active_cells() << " cells, "
+          << tria.n_vertices() << " vertices in triangulation" << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_cloud()
+{
+  // clusters of points around a few centers, in random order, each cell
+  // consisting of random vertices
+  const double            tol = 1e-3;
+  std::vector<Point<dim>> vertices;
+  for (unsigned int i = 0; i < 4000; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = 0.1 * Testing::rand() / RAND_MAX +
+               0.3 * tol * random_value<double>();
+      vertices.push_back(p);
+    }
+  std::vector<CellData<dim>> cells(vertices.size() /
+                                   GeometryInfo<dim>::vertices_per_cell);
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      cells[c].vertices[v] = c * GeometryInfo<dim>::vertices_per_cell + v;
+
+  std::vector<Point<dim>>    reference_vertices = vertices;
+  std::vector<CellData<dim>> reference_cells    = cells;
+  reference_delete_duplicated_vertices(reference_vertices,
+                                       reference_cells,
+                                       tol);
+
+  SubCellData               subcelldata;
+  std::vector<unsigned int> considered_vertices;
+  GridTools::delete_duplicated_vertices(
+    vertices, cells, subcelldata, considered_vertices, tol);
+
+  AssertThrow(vertices.size() == reference_vertices.size(),
+              ExcInternalError());
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    AssertThrow(vertices[v] == reference_vertices[v], ExcInternalError());
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      AssertThrow(cells[c].vertices[v] == reference_cells[c].vertices[v],
+                  ExcInternalError());
+  deallog << dim << "d cloud: same result as reference with "
+          << (vertices.size() < 4000 ? "merged" : "no merged") << " vertices"
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_blocks<2>();
+  test_blocks<3>();
+
+  test_cloud<1>();
+  test_cloud<2>();
+  test_cloud<3>();
+}
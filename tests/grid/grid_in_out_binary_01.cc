@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// write meshes with GridOut::write_binary() and read them back in with
+// GridIn::read_binary(), both completely and in parts
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+// check that the active cells of the two meshes, starting at the active cell
+// with index first_cell of tria_1, have the same vertices and ids. faces at
+// the boundary of tria_2 only must have the default boundary id, which is
+// the number of the face in 1d
+template <int dim>
+bool
+is_same(const Triangulation<dim> &tria_1,
+        const Triangulation<dim> &tria_2,
+        const unsigned int        first_cell)
+{
+  auto cell_1 = tria_1.begin_active();
+  std::advance(cell_1, first_cell);
+  for (auto cell_2 = tria_2.begin_active(); cell_2 != tria_2.end();
+       ++cell_1, ++cell_2)
+    {
+      if (cell_1->material_id() != cell_2->material_id() ||
+          cell_1->manifold_id() != cell_2->manifold_id())
+        return false;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        if (cell_1->vertex(v).distance(cell_2->vertex(v)) != 0.)
+          return false;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell_2->at_boundary(f) &&
+            ((cell_1->at_boundary(f) &&
+              cell_1->face(f)->boundary_id() !=
+                cell_2->face(f)->boundary_id()) ||
+             (!cell_1->at_boundary(f) &&
+              cell_2->face(f)->boundary_id() != (dim == 1 ? f : 0))))
+          return false;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell_1->face(f)->manifold_id() != cell_2->face(f)->manifold_id())
+          return false;
+      if (dim == 3)
+        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+          if (cell_1->line(l)->manifold_id() != cell_2->line(l)->manifold_id())
+            return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0., 1., true);
+  tria.refine_global(dim == 3 ? 1 : 2);
+  unsigned int index = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell->set_material_id(index % 3);
+      if (index % 2 == 0)
+        cell->set_all_manifold_ids(index % 5 + 1);
+      ++index;
+    }
+
+  std::ostringstream out;
+  GridOut().write_binary(tria, out);
+
+  {
+    Triangulation<dim> tria_in;
+    GridIn<dim>        grid_in;
+    grid_in.attach_triangulation(tria_in);
+    std::istringstream in(out.str());
+    grid_in.read_binary(in);
+    deallog << "complete mesh: " << tria_in.n_active_cells() << " cells, "
+            << tria_in.n_used_vertices() << " vertices, identical: "
+            << is_same(tria, tria_in, 0) << std::endl;
+  }
+
+  const std::string filename = "mesh_" + Utilities::to_string(dim) + ".dmsh";
+  {
+    std::ofstream file(filename, std::ios::binary);
+    GridOut().write_binary(tria, file);
+  }
+  for (unsigned int first_cell = 0; first_cell < tria.n_active_cells();
+       first_cell += tria.n_active_cells() / 3)
+    {
+      Triangulation<dim> tria_in;
+      GridIn<dim>        grid_in;
+      grid_in.attach_triangulation(tria_in);
+      grid_in.read_binary(filename, first_cell, tria.n_active_cells() / 3);
+      deallog << "cells from " << first_cell << ": "
+              << tria_in.n_active_cells() << " cells, "
+              << tria_in.n_used_vertices() << " vertices, identical: "
+              << is_same(tria, tria_in, first_cell) << std::endl;
+    }
+
+  // GridIn::read() selects the binary format by the suffix of the file
+  Triangulation<dim> tria_in;
+  GridIn<dim>        grid_in;
+  grid_in.attach_triangulation(tria_in);
+  grid_in.read(filename);
+  deallog << "read(): " << tria_in.n_active_cells() << " cells" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("1d");
+  test<1>();
+  deallog.pop();
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,71 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that GridIn::read_binary() rejects truncated files and headers
+// with numbers of records so large that the size of a section overflows
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+void
+read(const std::string &name, const std::string &data)
+{
+  Triangulation<2> tria;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria);
+  std::istringstream in(data);
+  try
+    {
+      grid_in.read_binary(in);
+      deallog << name << ": " << tria.n_active_cells() << " cells"
+              << std::endl;
+    }
+  catch (const ExceptionBase &exc)
+    {
+      deallog << name << ": " << exc.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> tria;
+  GridGenerator::hyper_cube(tria, 0., 1., true);
+  tria.refine_global(2);
+
+  std::ostringstream out;
+  GridOut().write_binary(tria, out);
+  const std::string data = out.str();
+
+  read("unchanged", data);
+  read("truncated", data.substr(0, data.size() - 8));
+
+  // set the number of cells, stored at byte 32, to 2^62. multiplied by the
+  // size of a cell record in 2d, 24 bytes, this overflows to zero
+  std::string huge = data;
+  for (unsigned int i = 0; i < 8; ++i)
+    huge[32 + i] = (i == 7 ? 0x40 : 0);
+  read("huge number of cells", huge);
+}
@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// GridIn::read_msh(), read_ucd(), and read_vtk() parse the lists of vertices
+// and cells in parallel. check that meshes large enough to be split into
+// several chunks are read correctly, and that points in VTK files may be
+// spread over lines arbitrarily
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+Point<3>
+transform(const Point<3> &p)
+{
+  return Point<3>(p[0] + 0.1 * std::sin(3. * p[1]), p[1], p[2] + p[0] * p[1]);
+}
+
+
+
+void
+check(const GridOut::OutputFormat out_format,
+      const GridIn<3>::Format     in_format)
+{
+  Triangulation<3> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 12);
+  GridTools::transform(&transform, tria);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell->set_material_id(cell->index() % 4);
+      for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          cell->face(f)->set_boundary_id(f);
+    }
+
+  GridOut grid_out;
+  grid_out.set_flags(GridOutFlags::Msh(true));
+  grid_out.set_flags(GridOutFlags::Ucd(false, true));
+  std::ostringstream out;
+  out << std::setprecision(16);
+  grid_out.write(tria, out, out_format);
+
+  Triangulation<3> tria_in;
+  GridIn<3>        grid_in;
+  grid_in.attach_triangulation(tria_in);
+  std::istringstream in(out.str());
+  grid_in.read(in, in_format);
+
+  // the cells may have been reordered, so compare the sums of vertex
+  // coordinates and the numbers of cells and faces with each id
+  Point<3>                             sum, sum_in;
+  std::map<unsigned int, unsigned int> ids, ids_in;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      sum += cell->center();
+      ++ids[100 + cell->material_id()];
+      for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          ++ids[cell->face(f)->boundary_id()];
+    }
+  for (const auto &cell : tria_in.active_cell_iterators())
+    {
+      sum_in += cell->center();
+      ++ids_in[100 + cell->material_id()];
+      for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          ++ids_in[cell->face(f)->boundary_id()];
+    }
+
+  deallog << GridIn<3>::default_suffix(in_format) << ": "
+          << tria_in.n_active_cells() << " cells, " << tria_in.n_used_vertices()
+          << " vertices, same vertices: " << (sum.distance(sum_in) < 1e-8)
+          << ", same ids: " << (ids == ids_in) << std::endl;
+}
+
+
+
+// a VTK file with two cells, whose points are given two and a half per line
+void
+check_vtk()
+{
+  const std::string vtk = "# vtk DataFile Version 3.0\n"
+                          "Test\n"
+                          "ASCII\n"
+                          "DATASET UNSTRUCTURED_GRID\n"
+                          "POINTS 6 double\n"
+                          "0 0 0 1 0 0 2 0\n"
+                          "0 0 1 0 1 1\n"
+                          "\n"
+                          "0 2 1 0\n"
+                          "\n"
+                          "CELLS 2 10\n"
+                          "4 0 1 4 3\n"
+                          "4 1 2 5 4\n"
+                          "\n"
+                          "CELL_TYPES 2\n"
+                          "9 9\n"
+                          "\n"
+                          "CELL_DATA 2\n"
+                          "SCALARS MaterialID double\n"
+                          "LOOKUP_TABLE default\n"
+                          "1 2\n";
+
+  Triangulation<2> tria;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria);
+  std::istringstream in(vtk);
+  grid_in.read_vtk(in);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      deallog << "vtk: cell " << cell->index() << " with material id "
+              << static_cast<unsigned int>(cell->material_id()) << ':';
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        deallog << " (" << cell->vertex(v) << ')';
+      deallog << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check(GridOut::msh, GridIn<3>::msh);
+  check(GridOut::ucd, GridIn<3>::ucd);
+  check_vtk();
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2001 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the R-tree of cell bounding boxes of GridTools::Cache and the
+// threaded point location through GridTools::find_active_cells_around_points
+// on a strongly graded mesh with hanging nodes
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim: " << dim << std::endl;
+
+  // cells of width 2^-11, 2^-11, 2^-10, ..., 2^-1 in x-direction, 4 cells
+  // in the other directions
+  std::vector<std::vector<double>> step_sizes(dim,
+                                              std::vector<double>(4, 0.25));
+  step_sizes[0].clear();
+  for (unsigned int i = 1; i < 12; ++i)
+    step_sizes[0].push_back(std::pow(0.5, i));
+  step_sizes[0].push_back(std::pow(0.5, 11));
+  std::reverse(step_sizes[0].begin(), step_sizes[0].end());
+
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            step_sizes,
+                                            Point<dim>(),
+                                            Point<dim>::unit_vector(0) +
+                                              Point<dim>::unit_vector(1) +
+                                              (dim == 3 ?
+                                                 Point<dim>::unit_vector(2) :
+                                                 Point<dim>()));
+  for (auto cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 1e-3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  GridTools::Cache<dim> cache(tria);
+  deallog << "Cells: " << tria.n_active_cells()
+          << ", boxes: " << cache.n_cell_bounding_boxes()
+          << std::endl;
+
+  // points clustered towards the finest cells at x=0, and one point outside
+  // the domain
+  const unsigned int      n_points = 1000;
+  std::vector<Point<dim>> points(n_points);
+  for (auto &p : points)
+    {
+      p    = random_point<dim>();
+      p[0] = std::pow(p[0], 6);
+    }
+  points.push_back(Point<dim>::unit_vector(0) * -0.5);
+
+  const auto cells_and_positions =
+    GridTools::find_active_cells_around_points(cache, points);
+
+  unsigned int n_found = 0;
+  for (unsigned int i = 0; i < n_points; ++i)
+    if (cells_and_positions[i].first.state() == IteratorState::valid)
+      {
+        ++n_found;
+        const auto &cell   = cells_and_positions[i].first;
+        const auto &p_unit = cells_and_positions[i].second;
+        AssertThrow(GeometryInfo<dim>::is_inside_unit_cell(p_unit, 1e-10),
+                    ExcInternalError());
+        AssertThrow(cache.get_mapping()
+                        .transform_unit_to_real_cell(cell, p_unit)
+                        .distance(points[i]) < 1e-12,
+                    ExcInternalError());
+
+        // the single point version has to find the same cell
+        AssertThrow(GridTools::find_active_cell_around_point(cache, points[i])
+                        .first == cell,
+                    ExcInternalError());
+      }
+  deallog << "Points found: " << n_found << " of " << n_points << std::endl;
+  deallog << "Point outside found: "
+          << (cells_and_positions.back().first.state() ==
+                  IteratorState::valid ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  // compute_point_locations has to return every point exactly once
+  points.pop_back();
+  const auto cell_qpoint_map =
+    GridTools::compute_point_locations(cache, points);
+  std::vector<unsigned int> n_occurrences(n_points);
+  for (unsigned int c = 0; c < std::get<0>(cell_qpoint_map).size(); ++c)
+    for (unsigned int q = 0; q < std::get<2>(cell_qpoint_map)[c].size(); ++q)
+      {
+        const unsigned int i = std::get<2>(cell_qpoint_map)[c][q];
+        ++n_occurrences[i];
+        AssertThrow(std::get<0>(cell_qpoint_map)[c] ==
+                      cells_and_positions[i].first,
+                    ExcInternalError());
+      }
+  for (const unsigned int n : n_occurrences)
+    AssertThrow(n == 1, ExcInternalError());
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  test<2>();
+  test<3>();
+}
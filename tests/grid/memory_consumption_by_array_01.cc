@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check Triangulation::memory_consumption_by_array() and that the user data
+// and the level subdomain ids are only allocated once they are set if the
+// triangulation uses lean storage, but right away otherwise
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test_default()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  const std::size_t empty_size = tria.n_levels() * sizeof(std::vector<int>);
+  std::map<std::string, std::size_t> memory =
+    tria.memory_consumption_by_array();
+  deallog << "lean storage: " << tria.has_lean_storage() << std::endl;
+  deallog << "user data allocated: "
+          << (memory["levels.cells.user_data"] > empty_size) << std::endl;
+  deallog << "level subdomain ids allocated: "
+          << (memory["levels.level_subdomain_ids"] > empty_size)
+          << std::endl;
+
+  // clearing the user data keeps the memory
+  tria.begin_active()->set_user_index(42);
+  tria.clear_user_data();
+  memory = tria.memory_consumption_by_array();
+  deallog << "user index after clear: " << tria.begin_active()->user_index()
+          << std::endl;
+  deallog << "user data allocated after clear: "
+          << (memory["levels.cells.user_data"] > empty_size) << std::endl;
+}
+
+
+template <int dim>
+void
+test_lean()
+{
+  Triangulation<dim> tria;
+  tria.set_lean_storage(true);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  const std::map<std::string, std::size_t> initial =
+    tria.memory_consumption_by_array();
+  std::size_t sum = 0;
+  for (const auto &entry : initial)
+    {
+      deallog << entry.first << std::endl;
+      sum += entry.second;
+    }
+  deallog << "sum <= total: " << (sum <= tria.memory_consumption())
+          << std::endl;
+
+  // reading the user data or the level subdomain ids does not allocate them
+  const auto cell  = tria.begin_active();
+  auto       other = cell;
+  ++other;
+  deallog << "user index: " << cell->user_index() << std::endl;
+  deallog << "level subdomain id: " << cell->level_subdomain_id()
+          << std::endl;
+  deallog << "user data allocated: "
+          << (tria.memory_consumption_by_array()["levels.cells.user_data"] >
+              initial.at("levels.cells.user_data"))
+          << std::endl;
+
+  // setting them does
+  cell->set_user_index(42);
+  cell->set_level_subdomain_id(3);
+  std::map<std::string, std::size_t> memory =
+    tria.memory_consumption_by_array();
+  deallog << "user index: " << cell->user_index() << ' '
+          << other->user_index() << std::endl;
+  deallog << "level subdomain id: " << cell->level_subdomain_id() << ' '
+          << other->level_subdomain_id() << std::endl;
+  deallog << "user data allocated: "
+          << (memory["levels.cells.user_data"] >
+              initial.at("levels.cells.user_data"))
+          << std::endl;
+  deallog << "level subdomain ids allocated: "
+          << (memory["levels.level_subdomain_ids"] >
+              initial.at("levels.level_subdomain_ids"))
+          << std::endl;
+
+  // the user data survives refinement, and clearing it releases the memory
+  tria.refine_global(1);
+  deallog << "user index after refinement: " << cell->user_index()
+          << std::endl;
+  tria.clear_user_data();
+  memory = tria.memory_consumption_by_array();
+  deallog << "user data allocated after clear: "
+          << (memory["levels.cells.user_data"] >
+              tria.n_levels() * sizeof(std::vector<unsigned int>))
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test_lean<2>();
+  test_default<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test_lean<3>();
+  test_default<3>();
+  deallog.pop();
+}
@@ -0,0 +1,73 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that Triangulation::copy_triangulation() copies the lean storage
+// setting, and that the copy of a lean triangulation does not allocate the
+// user data and level subdomain ids either
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const bool lean_storage)
+{
+  Triangulation<dim> tria;
+  tria.set_lean_storage(lean_storage);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  Triangulation<dim> copy;
+  copy.copy_triangulation(tria);
+
+  const std::size_t empty_size = copy.n_levels() * sizeof(std::vector<int>);
+  std::map<std::string, std::size_t> memory =
+    copy.memory_consumption_by_array();
+  deallog << "lean storage: " << copy.has_lean_storage() << std::endl;
+  deallog << "user data allocated: "
+          << (memory["levels.cells.user_data"] > empty_size) << std::endl;
+  deallog << "level subdomain ids allocated: "
+          << (memory["levels.level_subdomain_ids"] > empty_size)
+          << std::endl;
+
+  // the copy can still be used like the original
+  copy.begin_active()->set_user_index(42);
+  copy.refine_global(1);
+  deallog << "cells: " << copy.n_active_cells()
+          << ", user index: " << copy.begin(2)->user_index()
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(true);
+  test<2>(false);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(true);
+  test<3>(false);
+  deallog.pop();
+}
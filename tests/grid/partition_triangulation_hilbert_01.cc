@@ -0,0 +1,117 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check GridTools::partition_triangulation_hilbert() with and without
+// weights, given as a vector and through the cell_weight signal, and that
+// partition_multigrid_levels() can be used on its result
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+unsigned int
+weight(const typename Triangulation<dim>::cell_iterator &cell)
+{
+  return (cell->center()[0] < 0.5 ? 3 : 1);
+}
+
+
+
+template <int dim>
+void
+print_partition(const Triangulation<dim> &       tria,
+                const unsigned int               n_partitions,
+                const std::vector<unsigned int> &cell_weights)
+{
+  std::vector<unsigned int> n_cells(n_partitions), weights(n_partitions);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      ++n_cells[cell->subdomain_id()];
+      weights[cell->subdomain_id()] +=
+        (cell_weights.size() > 0 ? cell_weights[cell->active_cell_index()] :
+                                   1);
+    }
+  for (unsigned int p = 0; p < n_partitions; ++p)
+    deallog << "subdomain " << p << ": " << n_cells[p] << " cells, weight "
+            << weights[p] << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements, const unsigned int n_partitions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  GridTools::partition_triangulation_hilbert(n_partitions, tria);
+  print_partition(tria, n_partitions, std::vector<unsigned int>());
+
+  std::vector<unsigned int> cell_weights(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_weights[cell->active_cell_index()] = weight<dim>(cell);
+  GridTools::partition_triangulation_hilbert(n_partitions, cell_weights, tria);
+  print_partition(tria, n_partitions, cell_weights);
+
+  std::vector<types::subdomain_id> subdomains(tria.n_active_cells());
+  GridTools::get_subdomain_association(tria, subdomains);
+
+  // the same weights given through the signal must lead to the same
+  // partition
+  tria.signals.cell_weight.connect(
+    [](const typename Triangulation<dim>::cell_iterator &cell,
+       const typename Triangulation<dim>::CellStatus) {
+      return weight<dim>(cell);
+    });
+  GridTools::partition_triangulation_hilbert(n_partitions, tria);
+  std::vector<types::subdomain_id> subdomains_signal(tria.n_active_cells());
+  GridTools::get_subdomain_association(tria, subdomains_signal);
+  deallog << "same partition with signal: " << (subdomains == subdomains_signal)
+          << std::endl;
+
+  // all children of a cell are on the same subdomain, which becomes the
+  // level subdomain of the parent
+  GridTools::partition_multigrid_levels(tria);
+  bool consistent = true;
+  for (const auto &cell : tria.cell_iterators_on_level(n_refinements - 1))
+    for (unsigned int c = 0; c < cell->n_children(); ++c)
+      if (cell->child(c)->subdomain_id() != cell->level_subdomain_id())
+        consistent = false;
+  deallog << "consistent multigrid levels: " << consistent << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(4, 3);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(3, 5);
+  deallog.pop();
+}
@@ -0,0 +1,77 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check GridTools::collect_periodic_faces on coarse meshes with many
+// boundary faces: every face must be matched with the face whose center is
+// the translated center of the first one
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const std::vector<unsigned int> &repetitions)
+{
+  Point<dim> p1, p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1. + d;
+
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria, repetitions, p1, p2, true);
+
+  for (unsigned int direction = 0; direction < dim; ++direction)
+    {
+      std::vector<
+        GridTools::PeriodicFacePair<typename Triangulation<dim>::cell_iterator>>
+        matched_pairs;
+      GridTools::collect_periodic_faces(
+        tria, 2 * direction, 2 * direction + 1, direction, matched_pairs);
+
+      unsigned int n_standard = 0;
+      for (const auto &pair : matched_pairs)
+        {
+          Point<dim> center_0 = pair.cell[0]->face(pair.face_idx[0])->center();
+          const Point<dim> center_1 =
+            pair.cell[1]->face(pair.face_idx[1])->center();
+          center_0[direction] = center_1[direction];
+          AssertThrow(center_0.distance(center_1) < 1e-12,
+                      ExcInternalError());
+          if (pair.orientation == 1)
+            ++n_standard;
+        }
+
+      deallog << dim << "d, direction " << direction << ": "
+              << matched_pairs.size() << " pairs, " << n_standard
+              << " in standard orientation" << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>({40, 30});
+  test<3>({6, 5, 4});
+}
@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Triangulation::execute_coarsening_and_refinement() computes the locations
+// of the new vertices in parallel before creating the children. check that
+// every new vertex ends up at the location the refined object asks its
+// manifold for, and that the vertices are bit for bit the same for any
+// number of threads
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &tria, const SphericalManifold<dim> &manifold)
+{
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, manifold);
+
+  // refine enough for the new vertices to be computed in several chunks
+  tria.refine_global(dim == 2 ? 3 : 2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  SphericalManifold<dim> manifold;
+
+  Triangulation<dim> tria;
+  MultithreadInfo::set_thread_limit(1);
+  create_mesh(tria, manifold);
+
+  Triangulation<dim> threaded_tria;
+  MultithreadInfo::set_thread_limit(4);
+  create_mesh(threaded_tria, manifold);
+  MultithreadInfo::set_thread_limit();
+
+  deallog << dim << "d: same vertices with threads: "
+          << (tria.get_vertices() == threaded_tria.get_vertices())
+          << std::endl;
+
+  const double tolerance = 1e-12;
+  unsigned int n_wrong   = 0;
+
+  // lines and quads are shared between cells, so they are checked more
+  // than once, which does not matter here
+  for (const auto &cell : tria.cell_iterators())
+    {
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        if (cell->line(l)->has_children() &&
+            cell->line(l)->child(0)->vertex(1).distance(
+              cell->line(l)->center(true)) > tolerance)
+          ++n_wrong;
+
+      if (dim == 3)
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->has_children() &&
+              cell->face(f)->child(0)->vertex(3).distance(
+                cell->face(f)->center(true, true)) > tolerance)
+            ++n_wrong;
+
+      if (cell->has_children())
+        {
+          const Point<dim> new_center =
+            (dim == 2 ? cell->child(0)->vertex(3) : cell->child(0)->vertex(7));
+          const bool use_interpolation = (dim == 3 || cell->at_boundary());
+          if (new_center.distance(cell->center(true, use_interpolation)) >
+              tolerance)
+            ++n_wrong;
+        }
+    }
+
+  deallog << dim << "d: misplaced vertices: " << n_wrong << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
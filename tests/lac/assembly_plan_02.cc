@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check AssemblyPlan with concurrent access: distribute the local matrices
+// and vectors of all cells from parallel tasks without any coloring and
+// compare with a serial assembly through AffineConstraints
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/assembly_plan.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(
+    dof_handler, 0, Functions::SquareFunction<dim>(), constraints);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  const unsigned int n_cells = tria.n_active_cells();
+  std::vector<std::vector<types::global_dof_index>> cell_dof_indices(
+    n_cells);
+  std::vector<FullMatrix<double>> cell_matrices(
+    n_cells, FullMatrix<double>(fe.dofs_per_cell, fe.dofs_per_cell));
+  std::vector<Vector<double>> cell_rhs(n_cells,
+                                       Vector<double>(fe.dofs_per_cell));
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      const unsigned int index = cell->active_cell_index();
+      cell_dof_indices[index].resize(fe.dofs_per_cell);
+      cell->get_dof_indices(cell_dof_indices[index]);
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        {
+          cell_rhs[index](i) = random_value<double>();
+          for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+            cell_matrices[index](i, j) = random_value<double>();
+        }
+    }
+
+  SparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+  Vector<double>       reference_rhs(dof_handler.n_dofs()),
+    rhs(dof_handler.n_dofs());
+  for (unsigned int c = 0; c < n_cells; ++c)
+    constraints.distribute_local_to_global(cell_matrices[c],
+                                           cell_rhs[c],
+                                           cell_dof_indices[c],
+                                           reference_matrix,
+                                           reference_rhs);
+
+  AssemblyPlan<double> plan;
+  plan.set_access_mode(AssemblyPlan<double>::concurrent_access);
+  plan.reinit(cell_dof_indices, constraints, sparsity);
+  AssertThrow(plan.get_access_mode() ==
+                AssemblyPlan<double>::concurrent_access,
+              ExcInternalError());
+
+  parallel::apply_to_subranges(
+    0U,
+    n_cells,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int c = begin; c < end; ++c)
+        plan.distribute_local_to_global(
+          c, cell_matrices[c], cell_rhs[c], matrix, rhs);
+    },
+    1);
+
+  matrix.add(-1., reference_matrix);
+  rhs -= reference_rhs;
+  deallog << "dim " << dim << ": matrix "
+          << (matrix.frobenius_norm() <
+                  1e-12 * reference_matrix.frobenius_norm() ?
+                "OK" :
+                "wrong")
+          << ", vector "
+          << (rhs.l2_norm() < 1e-12 * reference_rhs.l2_norm() ? "OK" :
+                                                                "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that AssemblyPlan works with a sparsity pattern that has been built
+// with a coupling table, as for a Stokes problem in which the pressure does
+// not couple to itself. the local matrices are zero in the masked block, and
+// the plan must give the same result as
+// AffineConstraints::distribute_local_to_global
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/assembly_plan.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FESystem<dim>   fe(FE_Q<dim>(2), dim, FE_Q<dim>(1), 1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(
+    dof_handler,
+    0,
+    Functions::ConstantFunction<dim>(1., dim + 1),
+    constraints,
+    fe.component_mask(FEValuesExtractors::Vector(0)));
+  constraints.close();
+
+  Table<2, DoFTools::Coupling> coupling(dim + 1, dim + 1);
+  for (unsigned int c = 0; c < dim + 1; ++c)
+    for (unsigned int d = 0; d < dim + 1; ++d)
+      coupling[c][d] =
+        ((c == dim && d == dim) ? DoFTools::none : DoFTools::always);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(
+    dof_handler, coupling, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  std::vector<std::vector<types::global_dof_index>> cell_dof_indices(
+    tria.n_active_cells());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell_dof_indices[cell->active_cell_index()].resize(fe.dofs_per_cell);
+      cell->get_dof_indices(cell_dof_indices[cell->active_cell_index()]);
+    }
+
+  AssemblyPlan<double> plan;
+  plan.reinit(cell_dof_indices, constraints, sparsity);
+
+  SparseMatrix<double> reference_matrix(sparsity), matrix(sparsity);
+  Vector<double>       reference_rhs(dof_handler.n_dofs()),
+    rhs(dof_handler.n_dofs());
+
+  FullMatrix<double> cell_matrix(fe.dofs_per_cell, fe.dofs_per_cell);
+  Vector<double>     cell_rhs(fe.dofs_per_cell);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        {
+          cell_rhs(i) = random_value<double>();
+          for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+            cell_matrix(i, j) =
+              ((fe.system_to_component_index(i).first == dim &&
+                fe.system_to_component_index(j).first == dim) ?
+                 0. :
+                 random_value<double>());
+        }
+
+      constraints.distribute_local_to_global(
+        cell_matrix,
+        cell_rhs,
+        cell_dof_indices[cell->active_cell_index()],
+        reference_matrix,
+        reference_rhs,
+        true);
+      plan.distribute_local_to_global(
+        cell->active_cell_index(), cell_matrix, cell_rhs, matrix, rhs, true);
+    }
+
+  matrix.add(-1., reference_matrix);
+  rhs -= reference_rhs;
+  deallog << "dim " << dim << ": matrix "
+          << (matrix.frobenius_norm() <
+                  1e-12 * reference_matrix.frobenius_norm() ?
+                "OK" :
+                "wrong")
+          << ", vector "
+          << (rhs.l2_norm() < 1e-12 * reference_rhs.l2_norm() ? "OK" :
+                                                                "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
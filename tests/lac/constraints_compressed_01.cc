@@ -0,0 +1,153 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// close() resolves chains of constraints and distribute() applies them on
+// chunks of constraint lines in parallel. build a large set of chained,
+// inhomogeneous constraints and check that the result does not depend on
+// the number of threads, and that distribute(), get_dof_values() and
+// distribute_local_to_global() agree with what is stored in the lines.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+make_constraints(const unsigned int n, AffineConstraints<double> &constraints)
+{
+  // every third dof is constrained to its left neighbor and, for three out
+  // of four of them, also to the previous constrained dof. this gives
+  // chains of length up to three
+  for (unsigned int i = 3; i < n; i += 3)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, i - 1, 0.25);
+      if ((i / 3) % 4 != 0)
+        constraints.add_entry(i, i - 3, 0.75);
+      else
+        constraints.add_entry(i, i + 1, 0.75);
+      constraints.set_inhomogeneity(i, 0.001 * i);
+    }
+  // and one constraint that only has an inhomogeneity
+  constraints.add_line(n - 1);
+  constraints.set_inhomogeneity(n - 1, 1.);
+  constraints.add_entry(n - 3, n - 1, 0.5);
+  constraints.close();
+}
+
+
+
+void
+test()
+{
+  const unsigned int n = 30000;
+
+  MultithreadInfo::set_thread_limit(1);
+  AffineConstraints<double> serial;
+  make_constraints(n, serial);
+  MultithreadInfo::set_thread_limit(4);
+  AffineConstraints<double> threaded;
+  make_constraints(n, threaded);
+
+  unsigned int n_entries = 0;
+  bool         same_constraints =
+    (serial.n_constraints() == threaded.n_constraints());
+  auto serial_line   = serial.get_lines().begin();
+  auto threaded_line = threaded.get_lines().begin();
+  for (; serial_line != serial.get_lines().end();
+       ++serial_line, ++threaded_line)
+    {
+      n_entries += serial_line->entries.size();
+      same_constraints &= (serial_line->index == threaded_line->index &&
+                           serial_line->entries == threaded_line->entries &&
+                           serial_line->inhomogeneity ==
+                             threaded_line->inhomogeneity);
+    }
+  deallog << "Constraints: " << serial.n_constraints()
+          << ", entries: " << n_entries
+          << ", max indirections: " << serial.max_constraint_indirections()
+          << std::endl;
+  deallog << "Same constraints: " << same_constraints << std::endl;
+
+  // compute the expected result of distribute() from the lines
+  Vector<double> vec(n);
+  for (unsigned int i = 0; i < n; ++i)
+    vec(i) = std::sin(1. * i);
+  Vector<double> reference(vec);
+  for (const auto &line : serial.get_lines())
+    {
+      double value = line.inhomogeneity;
+      for (const auto &entry : line.entries)
+        value += entry.second * vec(entry.first);
+      reference(line.index) = value;
+    }
+
+  Vector<double> distributed(vec);
+  threaded.distribute(distributed);
+  distributed -= reference;
+  deallog << "Error distribute: " << distributed.linfty_norm() << std::endl;
+
+  std::vector<types::global_dof_index> indices;
+  for (unsigned int i = n - 20; i < n; ++i)
+    indices.push_back(i);
+  Vector<double> local_values(indices.size());
+  threaded.get_dof_values(reference,
+                          indices.begin(),
+                          local_values.begin(),
+                          local_values.end());
+  double error = 0;
+  for (unsigned int i = 0; i < indices.size(); ++i)
+    error = std::max(error, std::abs(local_values(i) - reference(indices[i])));
+  deallog << "Error get_dof_values: " << error << std::endl;
+
+  // add a local vector with ones: constrained entries are distributed to
+  // the dofs they are constrained to, with their weights
+  Vector<double> global(n);
+  local_values = 1.;
+  threaded.distribute_local_to_global(local_values, indices, global);
+  deallog << "Sum distribute_local_to_global: " << global.l1_norm()
+          << std::endl;
+
+  // shifting a closed object also shifts the compressed representation
+  AffineConstraints<double> shifted;
+  shifted.copy_from(threaded);
+  shifted.shift(n);
+  Vector<double> long_vec(2 * n);
+  for (unsigned int i = 0; i < n; ++i)
+    long_vec(n + i) = vec(i);
+  shifted.distribute(long_vec);
+  double shift_error = 0;
+  for (unsigned int i = 0; i < n; ++i)
+    shift_error =
+      std::max(shift_error, std::abs(long_vec(n + i) - reference(i)));
+  deallog << "Error shifted: " << shift_error << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
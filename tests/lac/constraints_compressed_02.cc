@@ -0,0 +1,87 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// set_inhomogeneity() may be called after close(), e.g. to update boundary
+// values in a time-dependent problem. check that the new value is used by
+// distribute(), get_dof_values() and distribute_local_to_global().
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+test()
+{
+  const unsigned int n = 10;
+
+  AffineConstraints<double> constraints;
+  constraints.add_line(2);
+  constraints.add_entry(2, 1, 0.5);
+  constraints.add_entry(2, 3, 0.5);
+  constraints.set_inhomogeneity(2, 1.);
+  constraints.add_line(7);
+  constraints.set_inhomogeneity(7, 2.);
+  constraints.close();
+
+  constraints.set_inhomogeneity(2, 10.);
+  constraints.set_inhomogeneity(7, 20.);
+
+  Vector<double> vec(n);
+  for (unsigned int i = 0; i < n; ++i)
+    vec(i) = i;
+  constraints.distribute(vec);
+  deallog << "distribute: " << vec(2) << ' ' << vec(7) << std::endl;
+
+  std::vector<types::global_dof_index> indices = {2, 7};
+  Vector<double>                       local_values(2);
+  constraints.get_dof_values(vec,
+                             indices.begin(),
+                             local_values.begin(),
+                             local_values.end());
+  deallog << "get_dof_values: " << local_values(0) << ' ' << local_values(1)
+          << std::endl;
+
+  // with a local matrix, the inhomogeneities enter the right hand side
+  std::vector<types::global_dof_index> cell_indices = {6, 7};
+  FullMatrix<double>                   cell_matrix(2, 2);
+  cell_matrix(0, 0) = 2.;
+  cell_matrix(0, 1) = 1.;
+  cell_matrix(1, 0) = 1.;
+  cell_matrix(1, 1) = 2.;
+  Vector<double> cell_rhs(2);
+  Vector<double> rhs(n);
+  constraints.distribute_local_to_global(cell_rhs,
+                                         cell_indices,
+                                         rhs,
+                                         cell_matrix);
+  deallog << "distribute_local_to_global: " << rhs(6) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
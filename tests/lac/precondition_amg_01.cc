@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test PreconditionAMG as a preconditioner for CG on the five-point
+// Laplacian, with both smoothers, and as a coarse grid solver wrapped in
+// MGCoarseGridIterativeSolver
+
+#include <deal.II/lac/precondition_amg.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+void
+test(const unsigned int                          size,
+     const PreconditionAMG<double>::SmootherType smoother)
+{
+  FDMatrix           testproblem(size, size);
+  const unsigned int dim = (size - 1) * (size - 1);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionAMG<double>::AdditionalData data;
+  data.coarse_size   = 50;
+  data.smoother_type = smoother;
+
+  PreconditionAMG<double> amg;
+  amg.initialize(A, data);
+
+  deallog << "Size " << dim << ", levels " << amg.n_levels() << ":";
+  for (unsigned int level = 0; level < amg.n_levels(); ++level)
+    deallog << ' ' << amg.get_level_matrix(level).m();
+  deallog << std::endl;
+
+  // the coarse matrices must be symmetric
+  for (unsigned int level = 1; level < amg.n_levels(); ++level)
+    {
+      const SparseMatrix<double> &Ac = amg.get_level_matrix(level);
+      for (unsigned int row = 0; row < Ac.m(); ++row)
+        for (auto p = Ac.begin(row); p != Ac.end(row); ++p)
+          AssertThrow(std::abs(p->value() - Ac.el(p->column(), row)) <
+                        1e-12 * std::abs(Ac.diag_element(row)),
+                      ExcInternalError());
+    }
+
+  Vector<double> f(dim), u(dim);
+  f = 1.;
+
+  SolverControl control(100, 1e-8 * f.l2_norm());
+  SolverCG<>    solver(control);
+  check_solver_within_range(solver.solve(A, u, f, amg),
+                            control.last_step(),
+                            3,
+                            20);
+
+  // use the preconditioner as coarse grid solver in the multigrid
+  // framework and check that it solves the system
+  SolverControl coarse_control(100, 1e-10 * f.l2_norm(), false, false);
+  SolverCG<>    coarse_solver(coarse_control);
+  MGCoarseGridIterativeSolver<Vector<double>,
+                              SolverCG<>,
+                              SparseMatrix<double>,
+                              PreconditionAMG<double>>
+    mg_coarse(coarse_solver, A, amg);
+  u = 0.;
+  mg_coarse(0, u, f);
+  Vector<double> residual(dim);
+  A.residual(residual, u, f);
+  deallog << "Coarse grid solver residual small: "
+          << (residual.l2_norm() < 1e-9 * f.l2_norm() ? "yes" : "no")
+          << std::endl;
+
+  AssertThrow(amg.operator_complexity() > 1., ExcInternalError());
+  AssertThrow(amg.memory_consumption() > 0, ExcInternalError());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int size = 16; size <= 128; size *= 2)
+    {
+      test(size, PreconditionAMG<double>::chebyshev);
+      test(size, PreconditionAMG<double>::jacobi);
+    }
+}
@@ -0,0 +1,109 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test PreconditionAMG on the singular five-point Laplacian with pure
+// Neumann boundary conditions: once with a small coarsest level that is
+// solved by the dense factorization, which must skip the zero pivot, and
+// once with a single level that is larger than
+// AdditionalData::max_coarse_direct_size and hence only smoothed
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition_amg.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int size,
+     const unsigned int max_levels,
+     const unsigned int min_iterations,
+     const unsigned int max_iterations)
+{
+  const unsigned int     n = size * size;
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = 0; j < size; ++j)
+      {
+        const unsigned int row = i * size + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - size);
+        if (i + 1 < size)
+          dsp.add(row, row + size);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j + 1 < size)
+          dsp.add(row, row + 1);
+      }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int row = 0; row < n; ++row)
+    for (auto p = A.begin(row); p != A.end(row); ++p)
+      if (p->column() != row)
+        {
+          p->value() = -1.;
+          A.diag_element(row) += 1.;
+        }
+
+  PreconditionAMG<double>::AdditionalData data;
+  data.coarse_size            = 50;
+  data.max_levels             = max_levels;
+  data.max_coarse_direct_size = 100;
+
+  PreconditionAMG<double> amg;
+  amg.initialize(A, data);
+
+  deallog << "Size " << n << ", levels " << amg.n_levels() << ":";
+  for (unsigned int level = 0; level < amg.n_levels(); ++level)
+    deallog << ' ' << amg.get_level_matrix(level).m();
+  deallog << std::endl;
+
+  // a right hand side with zero mean, so that the system is consistent
+  Vector<double> f(n), u(n);
+  for (unsigned int i = 0; i < n; ++i)
+    f(i) = (i % 3 == 0 ? 2. : -1.);
+  f.add(-f.mean_value());
+
+  SolverControl control(1000, 1e-8 * f.l2_norm());
+  SolverCG<>    solver(control);
+  check_solver_within_range(solver.solve(A, u, f, amg),
+                            control.last_step(),
+                            min_iterations,
+                            max_iterations);
+
+  Vector<double> residual(n);
+  A.residual(residual, u, f);
+  deallog << "Residual small: "
+          << (residual.l2_norm() < 1e-7 * f.l2_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(32, 20, 3, 20);
+  test(32, 1, 10, 200);
+}
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that SparseMatrix::mmult, SparseMatrix::Tmmult and
+// SparseMatrix::triple_mmult add the product to the entries already stored
+// in the result if the sparsity pattern is not rebuilt
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n)
+{
+  SparsityPattern sp(n, n, 3);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      if (i > 0)
+        sp.add(i, i - 1);
+      if (i + 1 < n)
+        sp.add(i, i + 1);
+    }
+  sp.compress();
+
+  SparseMatrix<double> A(sp), B(sp);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      for (auto p = A.begin(i); p != A.end(i); ++p)
+        p->value() = Testing::rand() * 1. / RAND_MAX;
+      for (auto p = B.begin(i); p != B.end(i); ++p)
+        p->value() = Testing::rand() * 1. / RAND_MAX;
+    }
+
+  Vector<double> x(n), y(n), z(n), tmp(n), tmp2(n);
+  for (unsigned int j = 0; j < n; ++j)
+    x(j) = Testing::rand() * 1. / RAND_MAX;
+
+  // compute each product once with a new sparsity pattern, then add it a
+  // second time on the same pattern, and compare with twice the product
+  {
+    SparsityPattern      C_sp;
+    SparseMatrix<double> C(C_sp);
+    A.mmult(C, B);
+    A.mmult(C, B, Vector<double>(), false);
+
+    C.vmult(y, x);
+    B.vmult(tmp, x);
+    A.vmult(z, tmp);
+    z *= 2.;
+    y -= z;
+    deallog << "mmult: " << (y.l2_norm() <= 1e-12 * z.l2_norm()) << std::endl;
+  }
+
+  {
+    SparsityPattern      C_sp;
+    SparseMatrix<double> C(C_sp);
+    A.Tmmult(C, B);
+    A.Tmmult(C, B, Vector<double>(), false);
+
+    C.vmult(y, x);
+    B.vmult(tmp, x);
+    A.Tvmult(z, tmp);
+    z *= 2.;
+    y -= z;
+    deallog << "Tmmult: " << (y.l2_norm() <= 1e-12 * z.l2_norm())
+            << std::endl;
+  }
+
+  {
+    SparsityPattern      C_sp;
+    SparseMatrix<double> C(C_sp);
+    A.triple_mmult(C, B, A);
+    A.triple_mmult(C, B, A, false);
+
+    C.vmult(y, x);
+    A.vmult(tmp, x);
+    B.vmult(tmp2, tmp);
+    A.vmult(z, tmp2);
+    z *= 2.;
+    y -= z;
+    deallog << "triple_mmult: " << (y.l2_norm() <= 1e-12 * z.l2_norm())
+            << std::endl;
+  }
+}
+
+
+int
+main()
+{
+  initlog();
+  Testing::srand(3391466);
+
+  test(7);
+  test(100);
+}
@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SparseMatrix::triple_mmult for the Galerkin product R*A*P with
+// rectangular R and P, and the recomputation of the entries alone after
+// the values of A have changed
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n, const unsigned int n_coarse)
+{
+  // a tridiagonal matrix A and a prolongation P that interpolates linearly
+  // from n_coarse to n points, with some random perturbation
+  SparsityPattern A_sp(n, n, 3);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      if (i > 0)
+        A_sp.add(i, i - 1);
+      if (i + 1 < n)
+        A_sp.add(i, i + 1);
+    }
+  A_sp.compress();
+  SparseMatrix<double> A(A_sp);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      A.set(i, i, 2. + Testing::rand() * 0.1 / RAND_MAX);
+      if (i > 0)
+        A.set(i, i - 1, -1.);
+      if (i + 1 < n)
+        A.set(i, i + 1, -1.);
+    }
+
+  SparsityPattern P_sp(n, n_coarse, 2);
+  SparsityPattern R_sp(n_coarse, n, 2 * n / n_coarse + 2);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      const unsigned int j = (i * (n_coarse - 1)) / (n - 1);
+      P_sp.add(i, j);
+      R_sp.add(j, i);
+      if (j + 1 < n_coarse)
+        {
+          P_sp.add(i, j + 1);
+          R_sp.add(j + 1, i);
+        }
+    }
+  P_sp.compress();
+  R_sp.compress();
+  SparseMatrix<double> P(P_sp), R(R_sp);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto p = P.begin(i); p != P.end(i); ++p)
+      {
+        p->value() = Testing::rand() * 1. / RAND_MAX;
+        R.set(p->column(), i, p->value());
+      }
+
+  SparsityPattern      C_sp;
+  SparseMatrix<double> C(C_sp);
+  R.triple_mmult(C, A, P);
+
+  Vector<double> x(n_coarse), y(n_coarse), z(n_coarse), tmp1(n), tmp2(n);
+  for (unsigned int j = 0; j < n_coarse; ++j)
+    x(j) = Testing::rand() * 1. / RAND_MAX;
+
+  for (unsigned int repetition = 0; repetition < 2; ++repetition)
+    {
+      C.vmult(y, x);
+      P.vmult(tmp1, x);
+      A.vmult(tmp2, tmp1);
+      R.vmult(z, tmp2);
+      y -= z;
+      AssertThrow(y.l2_norm() <= 1e-12 * z.l2_norm(), ExcInternalError());
+
+      // change the values but not the pattern of A and only recompute the
+      // entries of C, which are added to the ones already present
+      A *= 3.;
+      C = 0.;
+      R.triple_mmult(C, A, P, false);
+    }
+
+  // compare with two calls to mmult
+  SparsityPattern      AP_sp, RAP_sp;
+  SparseMatrix<double> AP(AP_sp), RAP(RAP_sp);
+  A.mmult(AP, P);
+  R.mmult(RAP, AP);
+  AssertThrow(RAP.n_nonzero_elements() == C.n_nonzero_elements(),
+              ExcInternalError());
+  for (unsigned int i = 0; i < n_coarse; ++i)
+    for (auto p = RAP.begin(i); p != RAP.end(i); ++p)
+      AssertThrow(std::abs(p->value() - C.el(i, p->column())) <=
+                    1e-12 * std::abs(C.diag_element(i)),
+                  ExcInternalError());
+
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  Testing::srand(3391466);
+
+  test(7, 3);
+  test(100, 17);
+  test(10000, 1001);
+}
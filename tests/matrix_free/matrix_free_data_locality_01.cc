@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// tests DoFRenumbering::matrix_free_data_locality: starting from a random
+// numbering, the number of cache lines touched by the cell batches of
+// MatrixFree must go down, discontinuous elements must get contiguous
+// indices on all cell batches, and the Laplace operator must give the same
+// result as before the renumbering
+
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// count the number of distinct cache lines of 64 bytes that the cells of
+// each batch touch in a vector of doubles, summed over all batches
+template <int dim>
+unsigned int
+count_cache_lines(const MatrixFree<dim, double> &matrix_free)
+{
+  unsigned int                         n_cache_lines = 0;
+  std::vector<types::global_dof_index> dof_indices;
+  std::vector<types::global_dof_index> lines;
+  for (unsigned int batch = 0; batch < matrix_free.n_macro_cells(); ++batch)
+    {
+      lines.clear();
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(batch);
+           ++v)
+        {
+          const typename DoFHandler<dim>::cell_iterator cell =
+            matrix_free.get_cell_iterator(batch, v);
+          dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(dof_indices);
+          for (const types::global_dof_index index : dof_indices)
+            lines.push_back(index / 8);
+        }
+      std::sort(lines.begin(), lines.end());
+      n_cache_lines +=
+        std::unique(lines.begin(), lines.end()) - lines.begin();
+    }
+  return n_cache_lines;
+}
+
+
+
+template <int dim, int fe_degree>
+double
+apply_laplace(const DoFHandler<dim> &                   dof_handler,
+              std::shared_ptr<MatrixFree<dim, double>> &matrix_free)
+{
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  matrix_free.reset(new MatrixFree<dim, double>());
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, double>::AdditionalData::none;
+  matrix_free->reinit(dof_handler, constraints, QGauss<1>(fe_degree + 1), data);
+
+  MatrixFreeOperators::LaplaceOperator<
+    dim,
+    fe_degree,
+    fe_degree + 1,
+    1,
+    LinearAlgebra::distributed::Vector<double>>
+    laplace;
+  laplace.initialize(matrix_free);
+
+  LinearAlgebra::distributed::Vector<double> src, dst;
+  matrix_free->initialize_dof_vector(src);
+  matrix_free->initialize_dof_vector(dst);
+  VectorTools::interpolate(dof_handler,
+                           Functions::SquareFunction<dim>(),
+                           src);
+  constraints.distribute(src);
+  laplace.vmult(dst, src);
+  return dst.l2_norm();
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::random(dof_handler);
+  deallog << "Testing " << fe.get_name() << " with " << dof_handler.n_dofs()
+          << " dofs" << std::endl;
+
+  std::shared_ptr<MatrixFree<dim, double>> matrix_free;
+  const double norm_before = apply_laplace<dim, fe_degree>(dof_handler,
+                                                           matrix_free);
+  const unsigned int lines_before = count_cache_lines(*matrix_free);
+
+  DoFRenumbering::matrix_free_data_locality(dof_handler, *matrix_free);
+
+  const double norm_after = apply_laplace<dim, fe_degree>(dof_handler,
+                                                          matrix_free);
+  const unsigned int lines_after = count_cache_lines(*matrix_free);
+
+  unsigned int n_contiguous = 0;
+  const std::vector<internal::MatrixFreeFunctions::DoFInfo::
+                      IndexStorageVariants> &storage_variants =
+    matrix_free->get_dof_info().index_storage_variants
+      [internal::MatrixFreeFunctions::DoFInfo::dof_access_cell];
+  for (unsigned int batch = 0; batch < matrix_free->n_macro_cells(); ++batch)
+    if (storage_variants[batch] >=
+        internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
+          contiguous)
+      ++n_contiguous;
+
+  deallog << "Laplace result unchanged: "
+          << (std::abs(norm_before - norm_after) < 1e-10 * norm_before)
+          << std::endl;
+  deallog << "Fewer cache lines: " << (lines_after < lines_before / 2)
+          << std::endl;
+  deallog << "All batches contiguous: "
+          << (n_contiguous == matrix_free->n_macro_cells()) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2>(FE_Q<2>(2));
+  test<2, 2>(FE_DGQ<2>(2));
+  test<3, 1>(FE_Q<3>(1));
+  test<3, 1>(FE_DGQ<3>(1));
+}
@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// record costs that are five times as high on the cells at the left of the
+// domain than on the others with parallel::distributed::MeasuredCellCosts,
+// and check that repartitioning based on them balances the costs
+
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/measured_cell_costs.h>
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+record_costs(parallel::distributed::MeasuredCellCosts<dim> &  costs,
+             const parallel::distributed::Triangulation<dim> &tr)
+{
+  for (const auto &cell : tr.active_cell_iterators())
+    if (cell->is_locally_owned())
+      costs.add_cost(cell, cell->center()[0] < 0.25 ? 5. : 1.);
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  parallel::distributed::Triangulation<dim> tr(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tr);
+  tr.refine_global(4);
+
+  parallel::distributed::MeasuredCellCosts<dim> costs(tr);
+  record_costs(costs, tr);
+
+  // the exact imbalance depends on where p4est puts the boundaries between
+  // the processors, so only check that it is significant
+  const auto imbalance = costs.compute_imbalance();
+  deallog << "average " << imbalance.average_cost << ", imbalanced: "
+          << (imbalance.ratio() > 1.2) << std::endl;
+
+  // the triangulation is only repartitioned if the imbalance exceeds the
+  // threshold
+  auto report = costs.repartition_if_imbalanced(1.5);
+  deallog << "repartitioned " << report.repartitioned << std::endl;
+
+  record_costs(costs, tr);
+  report = costs.repartition_if_imbalanced(1.2);
+  deallog << "repartitioned " << report.repartitioned
+          << ", estimated to be balanced: "
+          << (report.estimated_ratio_after < 1.1) << std::endl;
+
+  // the costs were discarded, so measure them again on the new partition
+  record_costs(costs, tr);
+  report = costs.repartition_if_imbalanced(1.2);
+  deallog << "balanced after: " << (report.before.ratio() < 1.1)
+          << ", repartitioned " << report.repartitioned << std::endl;
+  deallog << "number of reports: " << costs.get_reports().size() << std::endl;
+
+  // refining the mesh discards the costs as well
+  record_costs(costs, tr);
+  tr.refine_global(1);
+  deallog << "cost after refinement: "
+          << costs.compute_imbalance().max_cost << std::endl;
+
+  // costs on different cells can be recorded from different threads right
+  // after refinement, without a serial call in between
+  std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+  for (const auto &cell : tr.active_cell_iterators())
+    if (cell->is_locally_owned())
+      cells.push_back(cell);
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int t = 0; t < 4; ++t)
+    tasks += Threads::new_task([&, t]() {
+      for (unsigned int i = t; i < cells.size(); i += 4)
+        costs.add_cost(cells[i], cells[i]->center()[0] < 0.25 ? 5. : 1.);
+    });
+  tasks.join_all();
+  deallog << "average cost recorded by threads: "
+          << costs.compute_imbalance().average_cost << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      initlog();
+
+      deallog.push("2d");
+      test<2>();
+      deallog.pop();
+    }
+  else
+    test<2>();
+}
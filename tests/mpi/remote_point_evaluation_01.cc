@@ -0,0 +1,162 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test RemotePointEvaluation on a parallel triangulation: every process asks
+// for a different set of points, most of which lie on the parts of the mesh
+// owned by other processes. the values of a function that is represented
+// exactly must be reproduced, also after the vector has changed, and points
+// outside the mesh must not be found
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/remote_point_evaluation.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// a quadratic function that is represented exactly by FE_Q(2)
+template <int dim>
+class Quadratic : public Function<dim>
+{
+public:
+  Quadratic()
+    : Function<dim>(2)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    if (component == 0)
+      return p[0] * p[0] + p[dim - 1];
+    else
+      return p[0] * p[dim - 1] - 1.;
+  }
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  parallel::shared::Triangulation<dim> tria(
+    MPI_COMM_WORLD,
+    ::Triangulation<dim>::none,
+    false,
+    parallel::shared::Triangulation<dim>::partition_zorder);
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(4 - dim / 2);
+
+  FESystem<dim>   fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Quadratic<dim> function;
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, function, solution);
+
+  // a different set of points on every process, spread over the whole
+  // domain. every tenth point lies outside of the mesh
+  std::vector<Point<dim>> points(200 + 10 * myid);
+  for (unsigned int i = 0; i < points.size(); ++i)
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        const double x = (i + 1) * (0.6180339887 + 0.1 * myid) + 0.3771 * d;
+        points[i][d] = (i % 10 == 0 ? 1.5 : 2. * (x - std::floor(x)) - 1.);
+      }
+
+  RemotePointEvaluation<dim> evaluator;
+  evaluator.reinit(points, tria);
+
+  bool         found_correct = true;
+  unsigned int n_found       = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      if (evaluator.point_found(i) != (i % 10 != 0))
+        found_correct = false;
+      if (evaluator.point_found(i))
+        ++n_found;
+    }
+  const unsigned int n_evaluated =
+    Utilities::MPI::sum(evaluator.n_evaluation_points(), MPI_COMM_WORLD);
+  n_found = Utilities::MPI::sum(n_found, MPI_COMM_WORLD);
+  found_correct = Utilities::MPI::min(found_correct ? 1U : 0U,
+                                      MPI_COMM_WORLD) == 1;
+  if (myid == 0)
+    deallog << "Points found correctly: " << found_correct
+            << ", each point evaluated once: " << (n_evaluated == n_found)
+            << std::endl;
+
+  std::vector<Vector<double>> values;
+  for (unsigned int step = 1; step <= 2; ++step)
+    {
+      evaluator.evaluate(dof_handler, solution, values);
+
+      double error = 0;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        for (unsigned int c = 0; c < 2; ++c)
+          error = std::max(error,
+                           std::abs(values[i][c] -
+                                    (evaluator.point_found(i) ?
+                                       step * function.value(points[i], c) :
+                                       0.)));
+      error = Utilities::MPI::max(error, MPI_COMM_WORLD);
+      if (myid == 0)
+        deallog << "Step " << step << ", values exact: " << (error < 1e-12)
+                << std::endl;
+
+      solution *= 2.;
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      initlog();
+
+      deallog.push("2d");
+      test<2>();
+      deallog.pop();
+      deallog.push("3d");
+      test<3>();
+      deallog.pop();
+    }
+  else
+    {
+      test<2>();
+      test<3>();
+    }
+}
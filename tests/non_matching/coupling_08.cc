@@ -0,0 +1,141 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <deal.II/non_matching/coupling.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+// Test NonMatching::CouplingPlan: after the immersed mesh has moved, the
+// points must be found again starting from their old cells, and the coupling
+// matrix assembled with the plan must be the same as the one assembled from
+// scratch, independently of the number of threads.
+
+template <int dim, int spacedim>
+void
+test()
+{
+  deallog << "dim: " << dim << ", spacedim: " << spacedim << std::endl;
+
+  Triangulation<dim, spacedim>      tria;
+  Triangulation<spacedim, spacedim> space_tria;
+
+  GridGenerator::hyper_sphere(tria, Point<spacedim>(), 0.3);
+  GridGenerator::hyper_cube(space_tria, -1, 1);
+
+  tria.refine_global(4 - spacedim);
+  space_tria.refine_global(5 - spacedim);
+  space_tria.begin_active()->set_refine_flag();
+  space_tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim, spacedim>      fe(1);
+  FE_Q<spacedim, spacedim> space_fe(1);
+
+  DoFHandler<dim, spacedim>      dh(tria);
+  DoFHandler<spacedim, spacedim> space_dh(space_tria);
+
+  dh.distribute_dofs(fe);
+  space_dh.distribute_dofs(space_fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(space_dh, constraints);
+  constraints.close();
+
+  QGauss<dim> quad(3); // Quadrature for coupling
+
+  GridTools::Cache<spacedim, spacedim>               cache(space_tria);
+  NonMatching::CouplingPlan<spacedim, dim, spacedim> plan(cache, dh, quad);
+
+  deallog << "Points searched initially: "
+          << (plan.n_searched_points() == tria.n_active_cells() * quad.size())
+          << std::endl;
+
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      if (step > 0)
+        {
+          // move the immersed mesh, by a fraction of a cell of the space
+          // mesh in the first step, and over several cells in the second
+          Tensor<1, spacedim> shift;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            shift[d] = (step == 1 ? 0.01 : 0.15) * (d + 1);
+          GridTools::shift(shift, tria);
+          plan.update();
+
+          deallog << "Step " << step
+                  << ", points searched: " << plan.n_searched_points()
+                  << std::endl;
+        }
+
+      SparsityPattern sparsity;
+      {
+        DynamicSparsityPattern dsp(space_dh.n_dofs(), dh.n_dofs());
+        NonMatching::create_coupling_sparsity_pattern(
+          plan, space_dh, dsp, constraints);
+        sparsity.copy_from(dsp);
+      }
+
+      SparseMatrix<double> coupling(sparsity);
+      MultithreadInfo::set_thread_limit(1);
+      NonMatching::create_coupling_mass_matrix(
+        plan, space_dh, coupling, constraints);
+
+      SparseMatrix<double> threaded_coupling(sparsity);
+      MultithreadInfo::set_thread_limit(4);
+      NonMatching::create_coupling_mass_matrix(
+        plan, space_dh, threaded_coupling, constraints);
+      MultithreadInfo::set_thread_limit();
+
+      SparseMatrix<double> scratch_coupling(sparsity);
+      NonMatching::create_coupling_mass_matrix(
+        space_dh, dh, quad, scratch_coupling, constraints);
+
+      threaded_coupling.add(-1., coupling);
+      scratch_coupling.add(-1., coupling);
+      deallog << "Same with threads: "
+              << (threaded_coupling.frobenius_norm() == 0.)
+              << ", same as from scratch: "
+              << (scratch_coupling.frobenius_norm() <
+                  1e-12 * coupling.frobenius_norm())
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  test<1, 2>();
+  test<2, 3>();
+}
@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// the KellyErrorEstimator integrates every face once and writes the result
+// for both adjacent cells. check on meshes with hanging nodes and Neumann
+// boundaries that the result does not depend on the number of threads and
+// that several solution vectors are estimated independently of each other
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0., 1., true);
+  tria.refine_global(5 - dim);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center().norm() < 0.5)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler,
+                           Functions::CosineFunction<dim>(),
+                           solution);
+  Vector<double> scaled_solution(solution);
+  scaled_solution *= 3.;
+
+  Functions::ConstantFunction<dim> neumann_function(0.5);
+  std::map<types::boundary_id, const Function<dim> *> neumann_bc;
+  neumann_bc[0] = &neumann_function;
+  neumann_bc[1] = &neumann_function;
+
+  const std::vector<const Vector<double> *> solutions = {&solution,
+                                                         &scaled_solution};
+
+  Vector<float>                serial_error, serial_scaled_error;
+  std::vector<Vector<float> *> serial_errors = {&serial_error,
+                                                &serial_scaled_error};
+  MultithreadInfo::set_thread_limit(1);
+  KellyErrorEstimator<dim>::estimate(dof_handler,
+                                     QGauss<dim - 1>(3),
+                                     neumann_bc,
+                                     solutions,
+                                     serial_errors);
+
+  Vector<float> threaded_error;
+  MultithreadInfo::set_thread_limit(4);
+  KellyErrorEstimator<dim>::estimate(dof_handler,
+                                     QGauss<dim - 1>(3),
+                                     neumann_bc,
+                                     solution,
+                                     threaded_error);
+  MultithreadInfo::set_thread_limit();
+
+  deallog << "Cells: " << tria.n_active_cells()
+          << ", norm of estimate: " << serial_error.l2_norm() << std::endl;
+  deallog << "Same with threads: " << (serial_error == threaded_error)
+          << std::endl;
+
+  // without the Neumann boundary conditions, the estimate is linear in the
+  // solution
+  std::map<types::boundary_id, const Function<dim> *> no_neumann_bc;
+  KellyErrorEstimator<dim>::estimate(dof_handler,
+                                     QGauss<dim - 1>(3),
+                                     no_neumann_bc,
+                                     solutions,
+                                     serial_errors);
+  serial_error *= 3.;
+  serial_scaled_error -= serial_error;
+  deallog << "Estimates of several vectors independent: "
+          << (serial_scaled_error.linfty_norm() <
+              1e-5 * serial_error.linfty_norm())
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
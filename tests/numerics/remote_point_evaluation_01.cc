@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test RemotePointEvaluation on a serial triangulation: the values of a
+// vector-valued function that is represented exactly must be reproduced at
+// all points inside the mesh, points outside the mesh must be reported as not
+// found, and the points must not need to be located again when the vector
+// changes
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/remote_point_evaluation.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+// a quadratic function that is represented exactly by FE_Q(2)
+template <int dim>
+class Quadratic : public Function<dim>
+{
+public:
+  Quadratic()
+    : Function<dim>(2)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    if (component == 0)
+      return p[0] * p[0] + p[dim - 1];
+    else
+      return p[0] * p[dim - 1] - 1.;
+  }
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1., 1.);
+  tria.refine_global(4 - dim / 2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FESystem<dim>   fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Quadratic<dim> function;
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, function, solution);
+
+  // every tenth point lies outside of the mesh
+  std::vector<Point<dim>> points(1000);
+  for (unsigned int i = 0; i < points.size(); ++i)
+    for (unsigned int d = 0; d < dim; ++d)
+      points[i][d] = (i % 10 == 0 ? 1.5 : 2. * random_value<double>() - 1.);
+
+  MappingQ<dim>              mapping(2);
+  RemotePointEvaluation<dim> evaluator;
+  evaluator.reinit(points, tria, mapping);
+
+  bool found_correct = true;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    if (evaluator.point_found(i) != (i % 10 != 0))
+      found_correct = false;
+  deallog << "Points found correctly: " << found_correct
+          << ", all found: " << evaluator.all_points_found()
+          << ", evaluation points: " << evaluator.n_evaluation_points()
+          << std::endl;
+
+  std::vector<Vector<double>> values;
+  for (unsigned int step = 1; step <= 2; ++step)
+    {
+      evaluator.evaluate(dof_handler, solution, values);
+
+      double error = 0;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        for (unsigned int c = 0; c < 2; ++c)
+          error = std::max(error,
+                           std::abs(values[i][c] -
+                                    (evaluator.point_found(i) ?
+                                       step * function.value(points[i], c) :
+                                       0.)));
+      deallog << "Step " << step << ", values exact: " << (error < 1e-12)
+              << std::endl;
+
+      solution *= 2.;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
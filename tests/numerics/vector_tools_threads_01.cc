@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// VectorTools::interpolate(), create_right_hand_side(), and
+// integrate_difference() work on the cells in parallel. check that their
+// results do not depend on how the cells are scheduled onto threads, down
+// to the last bit. (FEValues only detects similar cells if there is a
+// single thread, which leads to different roundoff, so compare different
+// numbers of threads larger than one.)
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+class TestFunction : public Function<dim>
+{
+public:
+  TestFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return std::sin(p[0] + 2. * component) * std::exp(p[dim - 1]);
+  }
+};
+
+
+
+template <int dim>
+void
+compute(const DoFHandler<dim> &          dof,
+        const AffineConstraints<double> &constraints,
+        Vector<double> &                 interpolant,
+        Vector<double> &                 rhs,
+        Vector<double> &                 cell_errors)
+{
+  const TestFunction<dim> function(dof.get_fe().n_components());
+  const QGauss<dim>       quadrature(dof.get_fe().degree + 1);
+
+  interpolant.reinit(dof.n_dofs());
+  VectorTools::interpolate(dof, function, interpolant);
+
+  rhs.reinit(dof.n_dofs());
+  VectorTools::create_right_hand_side(
+    dof, quadrature, function, rhs, constraints);
+
+  Vector<double> solution(rhs);
+  solution *= 1e3;
+  VectorTools::integrate_difference(dof,
+                                    solution,
+                                    function,
+                                    cell_errors,
+                                    quadrature,
+                                    VectorTools::H1_norm);
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(5 - dim);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  Vector<double> interpolant_1, rhs_1, cell_errors_1;
+  MultithreadInfo::set_thread_limit(2);
+  compute(dof, constraints, interpolant_1, rhs_1, cell_errors_1);
+
+  Vector<double> interpolant_n, rhs_n, cell_errors_n;
+  MultithreadInfo::set_thread_limit(4);
+  compute(dof, constraints, interpolant_n, rhs_n, cell_errors_n);
+
+  deallog << fe.get_name() << ": " << dof.n_dofs() << " dofs" << std::endl;
+  deallog << "interpolant: " << interpolant_1.l2_norm()
+          << ", identical: " << (interpolant_1 == interpolant_n) << std::endl;
+  deallog << "right hand side: " << rhs_1.l2_norm()
+          << ", identical: " << (rhs_1 == rhs_n) << std::endl;
+  deallog << "error: " << cell_errors_1.l2_norm()
+          << ", identical: " << (cell_errors_1 == cell_errors_n)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_Q<2>(2));
+  test<2>(FESystem<2>(FE_Q<2>(1), 1, FE_RaviartThomas<2>(1), 1));
+  test<3>(FE_Q<3>(2));
+}
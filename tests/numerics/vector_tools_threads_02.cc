@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// VectorTools::interpolate() evaluates the function on several threads at
+// the same time. check that this works for Functions::FEFieldFunction,
+// which builds the data structures of its GridTools::Cache the first time
+// a point is searched for, i.e., from within the worker threads
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/fe_field_function.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> coarse_tria;
+  GridGenerator::hyper_cube(coarse_tria);
+  coarse_tria.refine_global(4 - dim);
+  DoFHandler<dim> coarse_dof(coarse_tria);
+  coarse_dof.distribute_dofs(FE_Q<dim>(2));
+  Vector<double> coarse_solution(coarse_dof.n_dofs());
+  VectorTools::interpolate(coarse_dof,
+                           Functions::CosineFunction<dim>(),
+                           coarse_solution);
+
+  Triangulation<dim> fine_tria;
+  GridGenerator::hyper_cube(fine_tria);
+  fine_tria.refine_global(6 - dim);
+  DoFHandler<dim> fine_dof(fine_tria);
+  fine_dof.distribute_dofs(FE_Q<dim>(1));
+
+  Vector<double> fine_solution_1(fine_dof.n_dofs());
+  {
+    MultithreadInfo::set_thread_limit(1);
+    const Functions::FEFieldFunction<dim> function(coarse_dof,
+                                                   coarse_solution);
+    VectorTools::interpolate(fine_dof, function, fine_solution_1);
+  }
+
+  Vector<double> fine_solution_n(fine_dof.n_dofs());
+  {
+    MultithreadInfo::set_thread_limit(8);
+    const Functions::FEFieldFunction<dim> function(coarse_dof,
+                                                   coarse_solution);
+    VectorTools::interpolate(fine_dof, function, fine_solution_n);
+  }
+
+  deallog << "dim=" << dim << ": " << fine_dof.n_dofs() << " dofs, norm "
+          << fine_solution_1.l2_norm()
+          << ", identical: " << (fine_solution_1 == fine_solution_n)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// create a shared tria mesh and distribute it with the Hilbert curve
+// partitioner, and compare against GridTools::partition_triangulation_hilbert
+// on a serial mesh
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+refine(Triangulation<dim> &tria)
+{
+  GridGenerator::subdivided_hyper_cube(tria, 2, -1, 1);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.55)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->at_boundary() && cell->center()[0] < 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  parallel::shared::Triangulation<dim> shared_tria(
+    MPI_COMM_WORLD,
+    Triangulation<dim>::none,
+    false,
+    parallel::shared::Triangulation<dim>::partition_hilbert);
+  refine(shared_tria);
+
+  Triangulation<dim> tria;
+  refine(tria);
+  GridTools::partition_triangulation_hilbert(
+    Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD), tria);
+
+  std::map<CellId, types::subdomain_id> serial_owners;
+  for (const auto &cell : tria.active_cell_iterators())
+    serial_owners[cell->id()] = cell->subdomain_id();
+
+  bool same = true;
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    same &= (serial_owners[cell->id()] == cell->subdomain_id());
+
+  deallog << "cells: " << shared_tria.n_global_active_cells()
+          << ", locally owned: " << shared_tria.n_locally_owned_active_cells()
+          << ", same as serial partition: " << same << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test SparseDirectUMFPACK::refactorize, which reuses the symbolic
+// factorization for a matrix with the same sparsity pattern, and the solve
+// functions for several right hand sides at once
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+void
+check_residual(const SparseMatrix<double> &A,
+               const Vector<double> &      x,
+               const Vector<double> &      b,
+               const bool                  transpose = false)
+{
+  Vector<double> residual(b.size());
+  if (transpose)
+    A.Tvmult(residual, x);
+  else
+    A.vmult(residual, x);
+  residual -= b;
+  AssertThrow(residual.l2_norm() < 1e-10 * b.l2_norm(), ExcInternalError());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  SparseDirectUMFPACK umfpack;
+  umfpack.factorize(A);
+
+  const unsigned int          n_rhs = 5;
+  std::vector<Vector<double>> rhs(n_rhs, Vector<double>(dim));
+  for (unsigned int r = 0; r < n_rhs; ++r)
+    for (unsigned int i = 0; i < dim; ++i)
+      rhs[r](i) = random_value<double>();
+
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      // change the values but not the sparsity pattern of the matrix, as in
+      // a Newton iteration
+      if (step > 0)
+        {
+          for (unsigned int i = 0; i < dim; ++i)
+            A.diag_element(i) += step;
+          umfpack.refactorize(A);
+        }
+
+      for (unsigned int transpose = 0; transpose < 2; ++transpose)
+        {
+          std::vector<Vector<double>> solutions = rhs;
+          umfpack.solve(solutions, transpose == 1);
+          for (unsigned int r = 0; r < n_rhs; ++r)
+            check_residual(A, solutions[r], rhs[r], transpose == 1);
+
+          FullMatrix<double> X(dim, n_rhs);
+          for (unsigned int i = 0; i < dim; ++i)
+            for (unsigned int r = 0; r < n_rhs; ++r)
+              X(i, r) = rhs[r](i);
+          umfpack.solve(X, transpose == 1);
+          for (unsigned int r = 0; r < n_rhs; ++r)
+            {
+              Vector<double> x(dim);
+              for (unsigned int i = 0; i < dim; ++i)
+                x(i) = X(i, r);
+              check_residual(A, x, rhs[r], transpose == 1);
+            }
+        }
+      deallog << "Step " << step << " OK" << std::endl;
+    }
+}